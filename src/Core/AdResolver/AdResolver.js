@@ -1,679 +1,2239 @@
-// ----------------------------------------------------------------------------
-// Copyright (c) Microsoft Corporation. All rights reserved.
-// ----------------------------------------------------------------------------
-//
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-// http://www.apache.org/licenses/LICENSE-2.0
-//
-// THIS CODE IS PROVIDED *AS IS* BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
-// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
-// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
-//
-
-// AdResolver module implementation.
-
-// Inform linters of our namespaces:
-/*global PLAYER_SEQUENCER_TEST_LIBRARY, DOMParser, Text, Document, Element, Attr, CDATASection */
-
-//
-// The namespace object
-//
-var PLAYER_SEQUENCER = PLAYER_SEQUENCER || {};
-
-// custom AdResolver Error derivation:
-PLAYER_SEQUENCER.AdResolverError = function (message) {
-    ///<summary>Constructor for the custom Sequencer Error derivation.</summary>
-    ///<param name="message" type="String">A human readable error message within the Sequencer Error context.</param>
-    ///<returns type="Object">A new Sequencer Error object instance.</returns>
-    "use strict";
-    if (this === PLAYER_SEQUENCER) {
-        throw new PLAYER_SEQUENCER.AdResolverError("AdResolverError constructor called without new operator!");
-    }
-    this.name = "PLAYER_SEQUENCER:AdResolverError";
-    this.message = message || "[no message]";
-    // For V8 capture the stack trace:
-    if (Error.captureStackTrace) {
-        Error.captureStackTrace(this, PLAYER_SEQUENCER.AdResolverError);    
-    }
-};
-PLAYER_SEQUENCER.AdResolverError.prototype = new Error();
-PLAYER_SEQUENCER.AdResolverError.prototype.constructor = PLAYER_SEQUENCER.AdResolverError;
-
-// -------------------------
-// The AdResolver Entry pool
-// -------------------------
-// Note: The purpose of this pool is to provide a unique mapping of id numbers to adResolverEntry
-//       objects which allows holding references to objects through the JSON thunk.
-//       Therefore, the pool can be a Singleton since the objects are independent.
-//
-PLAYER_SEQUENCER.theAdResolverEntryPool = (function () {
-"use strict";
-
-    var poolNextEntryId = 1,          // start with 1 so id is always truthy
-        poolBaseId = poolNextEntryId, // the segmentId of the zeroth pool element
-        pool = [],
-    
-    // private methods
-    throwSetterInhibited = function ( value ) {
-        throw new PLAYER_SEQUENCER.AdResolverError('setter not allowed. value: ' + value.toString());
-    };
-
-    return {
-        createEntry: function (aParsedDocument) {
-            ///<summary>Create a new AdResolverEntry object</summary>
-            ///<param name="aParsedDocument" type="Object">A reference to a DOM document object</param>
-            ///<returns type="Number">The idNumber of the AdResolver entry created</param>
-            var myIdNumber = poolNextEntryId,
-                myParsedDocument = aParsedDocument,
-                adResolverEntry;
-
-            poolNextEntryId += 1;
-
-            // DEFINITION of a AdResolverEntry:
-            adResolverEntry = {
-                /// <field name="idNumber" type="Number">unique id number of the AdResolver entry</field>
-                get idNumber() { return myIdNumber; },
-                set idNumber(value) { throwSetterInhibited(value); },
-                /// <field name="parsedDocument" type="Object">reference to a parsed XML document object</field>
-                get parsedDocument() { return myParsedDocument; },
-                set parsedDocument(value) { 
-                    if (myParsedDocument) {
-                        throwSetterInhibited(value); 
-                    } else {
-                        myParsedDocument = value;
-                    }
-                }
-            };
-            pool[myIdNumber - poolBaseId] = adResolverEntry;
-            return adResolverEntry;
-        },
-
-        releaseEntry: function (idNumber) {
-            ///<summary>Release the entry pool reference to the AdResolver entry object so it can be GCed</summary>
-            ///<param name="idNumber" type="Number">The idNumber of the AdResolver entry to be released from the pool</param>
-            if (pool[idNumber - poolBaseId] === undefined) {
-                throw new PLAYER_SEQUENCER.AdResolverError('invalid releaseEntry Id: ' + idNumber.toString());
-            }
-            if (idNumber === poolBaseId) {
-                do {
-                    // shift out all contiguous released items starting at the base Id
-                    pool.shift();
-                    poolBaseId += 1;
-                } while (pool.length > 0 && pool[0] === null); 
-            }
-            else {
-                // just release the Id and it will be shifted out once all those before it have been released
-                pool[idNumber - poolBaseId] = null;
-            }
-        },
-
-        getEntryFromId: function (idNumber) {
-            ///<summary>Get a a reference to the AdResolver entry object with the given idNumber</summary>
-            ///<param name="idNumber" type="Number">The id number of the AdResolver entry to be referenced</param>
-            ///<returns type="Object">adResolverEntry object reference</returns>
-            var entry = pool[idNumber - poolBaseId], 
-                ex;
-            if (!entry) {
-                ex = new PLAYER_SEQUENCER.AdResolverError('invalid getEntryFromId Id: ' + idNumber.toString());
-                throw ex;
-            }
-            return entry;
-        },
-
-        testProbe_toJSON: function () {
-            ///<summary>For testing purposes, return JSON string of the entire AdResolver entry pool</summary>
-            ///<returns type="String">JSON of the entire playbackSegment pool</returns>
-            return '{' + JSON.stringify(pool) + ',"poolBaseId":' + poolBaseId.toString() + ',"poolNextEntryId":' + poolNextEntryId.toString() + '}';
-        },
-
-        testProbe_reset: function () {
-            ///<summary>For testing purposes, reset the entire AdResolver entry pool</summary>
-            pool = [];
-            poolBaseId = poolNextEntryId; // the segmentId of the zeroth pool element
-        }
-    };
-}());
-
-
-// -------------------------
-// The AdResolver Handler
-// -------------------------
-// Note: The purpose of this object is to provide an API for AdResolver XML documents.
-//       This can be a singleton since the objects are independent.
-//
-PLAYER_SEQUENCER.theAdResolver = (function () {
-"use strict";
-    // private variables
-    var myDOMParser = new DOMParser(),
-        myAdResolverEntryPool = PLAYER_SEQUENCER.theAdResolverEntryPool,
-
-    // private methods
-
-    // Note: When dealing with element names, only the "localName" (without any namespace identifier) is used
-    //       instead of the "nodeName" (fully qualified) since the namespace identifier is arbitrary.
-    //       The fully qualified name for attributes is always given in the results list.
-
-    myDocNodeFromElementPath = function(parsedDocument, eltPathNameArray) {
-        ///<summary>Walk the parsedDocument tree following the path of elements provided in eltPathNameArray and return the document node found.</summary>
-        ///<param name="eltPathNameArray" type="Array">Array of strings containing eltName:index where eltName is element name (or "*"" for wildcard) and index is the ordinal of the Element child</param>
-        ///<returns type="Object">A reference to the node in the document</returns>
-        var paramIx,
-            currentDocNode = parsedDocument,
-            currentPathElt,
-            nodeIx,
-            nodeCount;
-
-        for (paramIx = 0; paramIx < eltPathNameArray.length; paramIx += 1) {
-            currentPathElt = eltPathNameArray[paramIx].split(':');
-            nodeCount = currentDocNode.childNodes.length;
-            for (nodeIx = 0; nodeIx < nodeCount; nodeIx += 1) {
-                if (Element.prototype.isPrototypeOf(currentDocNode.childNodes[nodeIx]) && 
-                    ( currentPathElt[0] === '*' || currentPathElt[0] === currentDocNode.childNodes[nodeIx].localName)) {
-                    if (currentPathElt.length === 1 || currentPathElt[1] < 1) {
-                        currentDocNode = currentDocNode.childNodes[nodeIx];
-                        break;
-                    }
-                    if (currentPathElt.length > 1) {
-                        currentPathElt[1] -= 1;
-                    }
-                }
-            }
-            if (nodeIx === nodeCount) {
-                throw new PLAYER_SEQUENCER.AdResolverError("Failed to find path " + JSON.stringify(eltPathNameArray));
-            }
-        }
-
-        return currentDocNode;
-    },
-
-    myArrayFromDocNode = function(docNode, nodeNameFilter) {
-        ///<summary>Create object from next level elements and their attributes.</summary>
-        ///<param name="docNode" type="Object">document sub-node to use</param>
-        ///<param name="nodeNameFilter" type="String">Element name filter</param>
-        ///<returns type="Array">Array of Element 'name', 'value' and 'attrs' properties</returns>
-        var result = [],
-            docChildIndex,
-            contentIndex,
-            eltNode,
-            childEltNames,
-            resultObj;
-
-        for (docChildIndex = 0; docChildIndex < docNode.childNodes.length; docChildIndex += 1) {
-            eltNode = docNode.childNodes[docChildIndex];
-            if (Element.prototype.isPrototypeOf(eltNode) && (!nodeNameFilter || eltNode.localName === nodeNameFilter)) {
-                if (nodeNameFilter) {
-                    resultObj = {};
-                } else {
-                    resultObj = { name: eltNode.localName };
-                }
-                // CDATA text
-                for (contentIndex = 0; contentIndex < eltNode.childNodes.length; contentIndex += 1) {
-                    if (CDATASection.prototype.isPrototypeOf(eltNode.childNodes[contentIndex])) {
-                        resultObj.value = eltNode.childNodes[contentIndex].nodeValue;
-                        break;
-                    }
-                }
-                // If no CDATA
-                if (contentIndex === eltNode.childNodes.length) {
-                    // Count the number of contained elements
-                    childEltNames = [];
-                    for (contentIndex = 0; contentIndex < eltNode.childNodes.length; contentIndex += 1) {
-                        if (Element.prototype.isPrototypeOf(eltNode.childNodes[contentIndex])) {
-                            childEltNames.push(eltNode.childNodes[contentIndex].localName);
-                        }
-                    }
-                    // If contained elements just give count
-                    if (childEltNames.length > 0) {
-                        if (nodeNameFilter) {
-                            resultObj.elements = childEltNames;
-                        } else {
-                            resultObj.elements = childEltNames.length;
-                        }
-                    } else {
-                        // give value of first Text element that is not just a newline // TODO: should be: is not just white space
-                        for (contentIndex = 0; contentIndex < eltNode.childNodes.length; contentIndex += 1) {
-                            if (Text.prototype.isPrototypeOf(eltNode.childNodes[contentIndex])) {
-                                if (eltNode.childNodes[contentIndex].nodeValue !== '\n') {
-                                    resultObj.value = eltNode.firstChild.nodeValue;
-                                    break;
-                                }                            
-                            }
-                        }
-                    }
-                }
-                // attributes
-                if (eltNode.attributes && eltNode.attributes.length > 0) {
-                    resultObj.attrs = {};
-                    for (contentIndex = 0; contentIndex < eltNode.attributes.length; contentIndex += 1) {
-                        resultObj.attrs[eltNode.attributes[contentIndex].nodeName] = eltNode.attributes[contentIndex].nodeValue;
-                    }
-                }
-                result.push(resultObj);
-            }
-        }
-        return result;
-    },
-
-    myArrayOfChildrenFromDocNode = function(docNode, parentName) {
-        ///<summary>Create object from next level elements and their attributes.</summary>
-        ///<param name="docNode" type="Object">document sub-node to use</param>
-        ///<returns type="Array">Array of type, parentAttrs, and elements (with 'name', 'value' and 'attrs' properties)</returns>
-        var 
-        result = [],
-            nodeObj,
-            docNodeParent,
-            docNodeChild,
-            contentIndex,
-            parentIndex,
-            childIndex,
-            childElements,
-            parentOrdinal = 0;
-
-        for (parentIndex = 0; parentIndex < docNode.childNodes.length; parentIndex += 1) {
-            docNodeParent = docNode.childNodes[parentIndex];
-            if (Element.prototype.isPrototypeOf(docNodeParent) && docNodeParent.localName === parentName) {
-                for (childIndex = 0; childIndex < docNodeParent.childNodes.length; childIndex += 1) {
-                    docNodeChild = docNodeParent.childNodes[childIndex];
-                    if (Element.prototype.isPrototypeOf(docNodeChild)) {
-                        nodeObj = { type: docNodeChild.localName };
-                        // Parent attributes
-                        if (docNodeParent.attributes && docNodeParent.attributes.length > 0) {
-                            nodeObj.parentAttrs = {};
-                            for (contentIndex = 0; contentIndex < docNodeParent.attributes.length; contentIndex += 1) {
-                                nodeObj.parentAttrs[docNodeParent.attributes[contentIndex].nodeName] = docNodeParent.attributes[contentIndex].nodeValue;
-                            }
-                        }
-                        // Child attributes
-                        if (docNodeChild.attributes && docNodeChild.attributes.length > 0) {
-                            nodeObj.attrs = {};
-                            for (contentIndex = 0; contentIndex < docNodeChild.attributes.length; contentIndex += 1) {
-                                nodeObj.attrs[docNodeChild.attributes[contentIndex].nodeName] = docNodeChild.attributes[contentIndex].nodeValue;
-                            }
-                        }
-                        // Child elements if any, else CDATA section if one.
-                        childElements = myArrayFromDocNode(docNodeChild);
-                        if (childElements.length > 0) {
-                            nodeObj.elements = childElements;
-                        } else {
-                            for (contentIndex = 0; contentIndex < docNodeChild.childNodes.length; contentIndex += 1) {
-                                if (CDATASection.prototype.isPrototypeOf(docNodeChild.childNodes[contentIndex])) {
-                                    nodeObj.value = docNodeChild.childNodes[contentIndex].nodeValue;
-                                    break;
-                                }
-                            }
-                        }
-                        result.push(nodeObj);
-                        break;
-                    }
-                }
-                parentOrdinal += 1;
-            }
-        }
-        return result;
-    },
-
-    // ---------------------------------
-    // public methods
-    // ---------------------------------
-
-    // Note: Error codes are in VAST 3.0 spec: 2.4.2.3 and VMAP 1.0 spec: 2.5
-
-    publicAPI = {
-        vast: { // === VAST Parsed document information access ===
-
-            createEntry: function (aManifest) {
-                ///<summary>Create a AdResolverEntry by parsing an XML string or using a DOM Document.</summary>
-                ///<param name="aManifest" type="String">The manifest as an XML string</param>
-                ///<param name="aManifest" type="Object">The manifest as an object derived from Document</param>
-                ///<returns type="Number">The idNumber for the AdResolverEntry that was created. Throws AdResolverError if invalid AdResolver document.</returns>
-                var parsedDocument;
-
-                if (typeof aManifest === 'string') {
-                    parsedDocument = myDOMParser.parseFromString(aManifest, "application/xml");
-                }
-                else if (Document.prototype.isPrototypeOf(aManifest) || Element.prototype.isPrototypeOf(aManifest)) {
-                    parsedDocument = aManifest;
-                }
-                else {
-                    throw new PLAYER_SEQUENCER.AdResolverError('vast.createEntry parameter invalid! ' + aManifest.toString());
-                }
-
-                // Assert the top level element is <VAST> and it contains at least one <Ad>.
-                myDocNodeFromElementPath(parsedDocument, ['VAST', 'Ad']);
-                // myDocNodeFromElementPath throws an exception if path not found
-
-                return myAdResolverEntryPool.createEntry(parsedDocument).idNumber;
-            },
-
-            getAdList: function (params) {
-                ///<summary>Release the AdResolverEntry obtained from the create functions</summary>
-                ///<param name="params" type="Object">An object with "entryId" (result of the create function)</param>
-                ///<returns type="Array">Array of objects for each 'Ad': { type: "InLine" | "Wrapper", attrs: { Ad attrs }, elements: [<childElts>] }</returns>
-                var entry = myAdResolverEntryPool.getEntryFromId(params.entryId),
-                    docNodeVAST = myDocNodeFromElementPath(entry.parsedDocument, ['VAST']);
-
-                return myArrayOfChildrenFromDocNode(docNodeVAST, 'Ad');
-            },
-
-            getCreativeList: function (params) {
-                ///<summary>Get a list of Creative entries given Ad ordinal number.</summary>
-                ///<param name="params" type="Object">An object with "entryId" (result of the create function), "adOrdinal" (which of multiple <Ad>) and "adType" from Ad list</param>
-                ///<returns type="Array">Array of objects { type (Linear/Companion/NonLinear), Creative attributes }</returns>
-                var entry = myAdResolverEntryPool.getEntryFromId(params.entryId),
-                    adIndex = params.adOrdinal || 0,
-                    docNodeCreatives;
-
-                docNodeCreatives = myDocNodeFromElementPath(entry.parsedDocument,
-                    [
-                        'VAST',
-                        'Ad:' + adIndex.toString(),
-                        params.adType,
-                        'Creatives'
-                    ]);
-
-                return myArrayOfChildrenFromDocNode(docNodeCreatives, 'Creative');
-            },
-
-            getLinearTrackingEventsList: function (params) {
-                ///<summary>Get a list of TrackingEvents entries given Ad and Creative ordinal numbers.</summary>
-                ///<param name="params" type="Object">An object with "entryId" (result of the create function), "adOrdinal" (which of multiple <Ad>), and "creativeOrdinal" (which of multiple <Creative></param>
-                ///<returns type="Array">An array of objects with a 'name' string (should be "Tracking"), 'value' string with the CDATA URL string, and an 'attrs' object containing the <MediaFile> attributes</returns>
-                var entry = myAdResolverEntryPool.getEntryFromId(params.entryId),
-                    adIndex = params.adOrdinal || 0,
-                    creativeIndex = params.creativeOrdinal || 0,
-                    docTrackingEvents;
-
-                docTrackingEvents = myDocNodeFromElementPath(entry.parsedDocument,
-                    [
-                        'VAST',
-                        'Ad:' + adIndex.toString(),
-                        '*', // allows either InLine or Wrapper
-                        'Creatives',
-                        'Creative:' + creativeIndex.toString(),
-                        'Linear',
-                        'TrackingEvents'
-                    ]);
-
-                return myArrayFromDocNode(docTrackingEvents);
-            },
-
-            getVideoClicksList: function (params) {
-                ///<summary>Get a list of VideoClicks entries given Ad and Creative ordinal numbers.</summary>
-                ///<param name="params" type="Object">An object with "entryId" (result of the create function), "adOrdinal" (which of multiple <Ad>), and "creativeOrdinal" (which of multiple <Creative></param>
-                ///<returns type="Array">An array of objects with a 'name' string, 'value' string with the CDATA URL string, and an 'attrs' object containing the <MediaFile> attributes</returns>
-                var entry = myAdResolverEntryPool.getEntryFromId(params.entryId),
-                    adIndex = params.adOrdinal || 0,
-                    creativeIndex = params.creativeOrdinal || 0,
-                    docVideoClicks;
-
-                docVideoClicks = myDocNodeFromElementPath(entry.parsedDocument,
-                    [
-                        'VAST',
-                        'Ad:' + adIndex.toString(),
-                        '*', // allows either InLine or Wrapper
-                        'Creatives',
-                        'Creative:' + creativeIndex.toString(),
-                        'Linear',
-                        'VideoClicks'
-                    ]);
-
-                return myArrayFromDocNode(docVideoClicks);
-            },
-
-            getIconsList: function (params) {
-                ///<summary>Get a list of Icons entries given Ad and Creative ordinal numbers.</summary>
-                ///<param name="params" type="Object">An object with "entryId" (result of the create function), "adOrdinal" (which of multiple <Ad>), and "creativeOrdinal" (which of multiple <Creative></param>
-                ///<returns type="Array">An array of Icon objects</returns>
-                var entry = myAdResolverEntryPool.getEntryFromId(params.entryId),
-                    adIndex = params.adOrdinal || 0,
-                    creativeIndex = params.creativeOrdinal || 0,
-                    docIcons;
-
-                docIcons = myDocNodeFromElementPath(entry.parsedDocument,
-                    [
-                        'VAST',
-                        'Ad:' + adIndex.toString(),
-                        '*', // allows either InLine or Wrapper
-                        'Creatives',
-                        'Creative:' + creativeIndex.toString(),
-                        'Linear',
-                        'Icons'
-                    ]);
-
-                return myArrayOfChildrenFromDocNode(docIcons, 'Icon');
-            },
-
-            getMediaFileList: function (params) {
-                ///<summary>Get a list of MediaFile entries given Ad and Creative ordinal numbers.</summary>
-                ///<param name="params" type="Object">An object with "entryId" (result of the create function), "adOrdinal" (which of multiple <Ad>), and "creativeOrdinal" (which of multiple <Creative></param>
-                ///<returns type="Object">An array of objects with a 'name' string (should be "MediaFile"), 'value' string with the CDATA URL string, and an 'attrs' object containing the <MediaFile> attributes</returns>
-                var entry = myAdResolverEntryPool.getEntryFromId(params.entryId),
-                    adIndex = params.adOrdinal || 0,
-                    creativeIndex = params.creativeOrdinal || 0,
-                    docNodeMediaFiles;
-
-                docNodeMediaFiles = myDocNodeFromElementPath(entry.parsedDocument,
-                    [
-                        'VAST',
-                        'Ad:' + adIndex.toString(),
-                        'InLine',
-                        'Creatives',
-                        'Creative:' + creativeIndex.toString(),
-                        'Linear',
-                        'MediaFiles'
-                    ]);
-
-                return myArrayFromDocNode(docNodeMediaFiles);
-            },
-
-            getCompanionAdsList: function (params) {
-                ///<summary>Get a list of CompanionAds entries given Ad and Creative ordinal numbers.</summary>
-                ///<param name="params" type="Object">An object with "entryId" (result of the create function), "adOrdinal" (which of multiple <Ad>), and "creativeOrdinal" (which of multiple <Creative></param>
-                ///<returns type="Array">An array of Companion objects</returns>
-                var entry = myAdResolverEntryPool.getEntryFromId(params.entryId),
-                    adIndex = params.adOrdinal || 0,
-                    creativeIndex = params.creativeOrdinal || 0,
-                    docCompanionAds;
-
-                docCompanionAds = myDocNodeFromElementPath(entry.parsedDocument,
-                    [
-                        'VAST',
-                        'Ad:' + adIndex.toString(),
-                        '*', // allows either InLine or Wrapper
-                        'Creatives',
-                        'Creative:' + creativeIndex.toString(),
-                        'CompanionAds'
-                    ]);
-
-                return myArrayOfChildrenFromDocNode(docCompanionAds, 'Companion');
-            },
-
-            getNonLinearAdsList: function (params) {
-                ///<summary>Get a list of NonLinearAds entries given Ad and Creative ordinal numbers.</summary>
-                ///<param name="params" type="Object">An object with "entryId" (result of the create function), "adOrdinal" (which of multiple <Ad>), and "creativeOrdinal" (which of multiple <Creative></param>
-                ///<returns type="Array">An array of Companion objects</returns>
-                var entry = myAdResolverEntryPool.getEntryFromId(params.entryId),
-                    adIndex = params.adOrdinal || 0,
-                    creativeIndex = params.creativeOrdinal || 0,
-                    docNonLinearAds;
-
-                docNonLinearAds = myDocNodeFromElementPath(entry.parsedDocument,
-                    [
-                        'VAST',
-                        'Ad:' + adIndex.toString(),
-                        '*', // allows either InLine or Wrapper
-                        'Creatives',
-                        'Creative:' + creativeIndex.toString(),
-                        'NonLinearAds'
-                    ]);
-
-                return myArrayOfChildrenFromDocNode(docNonLinearAds, 'Companion');
-            },
-        },
-
-        vmap: { // === VMAP Parsed document information access ===
-
-            createEntry: function (aManifest) {
-                ///<summary>Create a AdResolverEntry by parsing an XML string or using a DOM Document.</summary>
-                ///<param name="aManifest" type="String">The manifest as an XML string</param>
-                ///<param name="aManifest" type="Object">The manifest as an object derived from Document</param>
-                ///<returns type="Number">The idNumber for the AdResolverEntry that was created. Throws AdResolverError if invalid AdResolver document.</returns>
-                var parsedDocument;
-
-                if (typeof aManifest === 'string') {
-                    parsedDocument = myDOMParser.parseFromString(aManifest, "application/xml");
-                }
-                else if (Document.prototype.isPrototypeOf(aManifest)) {
-                    parsedDocument = aManifest;
-                }
-                else {
-                    throw new PLAYER_SEQUENCER.AdResolverError('vmap.createEntry parameter invalid! ' + aManifest.toString());
-                }
-
-                // Assert the top level element is <VMAP> and it contains at least one <AdBreak>.
-                myDocNodeFromElementPath(parsedDocument, ['VMAP', 'AdBreak']);
-                // myDocNodeFromElementPath throws an exception if path not found
-
-                return myAdResolverEntryPool.createEntry(parsedDocument).idNumber;
-            },
-
-            getAdBreakList: function (params) {
-                ///<summary>Get a list of AdBreak items</summary>
-                ///<param name="params" type="Object">An object with "entryId" (result of the createEntry function)</param>
-                ///<returns type="Array">Array of objects, one for each 'AdBreak' element: [{elements:[string array of next level elements],attrs:{set of attribute name:value pairs}]</returns>
-                var entry = myAdResolverEntryPool.getEntryFromId(params.entryId),
-                    docNodeVMAP = myDocNodeFromElementPath(entry.parsedDocument, ['VMAP']);
-
-                return myArrayFromDocNode(docNodeVMAP, 'AdBreak');
-            },
-
-            getAdSource: function (params) {
-                ///<summary>Get the AdSource item for a given AdBreak</summary>
-                ///<param name="params" type="Object">An object with "entryId" (result of the createEntry function) and "adBreakOrdinal" (index into AdBreakList)</param>
-                ///<returns type="Object">An Object containing: {type:(enum VASTData,CustomAdData,AdTagURI),attrs:{set of attribute name:value pairs},value</returns>
-                var entry = myAdResolverEntryPool.getEntryFromId(params.entryId),
-                    adBreakIndex = params.adBreakOrdinal || 0,
-                    docNode = myDocNodeFromElementPath(entry.parsedDocument, ['VMAP', 'AdBreak:' + adBreakIndex.toString()]);
-
-                return myArrayOfChildrenFromDocNode(docNode, 'AdSource');
-            },
-
-            createVASTEntryFromAdBreak: function (params) {
-                ///<summary>Create a VASTEntry for a given AdBreak which is assumed to contain an AdSource/VASTData element.</summary>
-                ///<param name="params" type="Object">An object with "entryId" (result of the createEntry function) and "adBreakOrdinal" (index into AdBreakList)</param>
-                ///<returns type="Number">A VASTEntry idNumber</returns>
-                var entry = myAdResolverEntryPool.getEntryFromId(params.entryId),
-                    adBreakIndex = params.adBreakOrdinal || 0,
-                    docNode;
-
-                    docNode = myDocNodeFromElementPath(entry.parsedDocument, 
-                        [
-                            'VMAP', 
-                            'AdBreak:' + adBreakIndex.toString(), 
-                            'AdSource', 
-                            'VASTData'
-                        ]);
-
-                return publicAPI.vast.createEntry(docNode);
-            },
-
-            getTrackingEventsList: function (params) {
-                ///<summary>Get the list of Tracking elements for the TrackingEvents element in a given AdBreak</summary>
-                ///<param name="params" type="Object">An object with "entryId" (result of the createEntry function) and "adBreakOrdinal" (index into AdBreakList)</param>
-                ///<returns type="Array">An array of Tracking element objects: { value, attrs }</returns>
-                var entry = myAdResolverEntryPool.getEntryFromId(params.entryId),
-                    adBreakIndex = params.adBreakOrdinal || 0,
-                    docNode = myDocNodeFromElementPath(entry.parsedDocument, ['VMAP', 'AdBreak:' + adBreakIndex.toString(), 'TrackingEvents']);
-
-                return myArrayFromDocNode(docNode, 'Tracking');
-            },
-
-            getExtensionsList: function (params) {
-                ///<summary>Get the list of Extension elements for the Extensions element in a given AdBreak</summary>
-                ///<param name="params" type="Object">An object with "entryId" (result of the createEntry function) and "adBreakOrdinal" (index into AdBreakList)</param>
-                ///<returns type="Array">An array of Extension element objects: {elements, attrs}</returns>
-                var entry = myAdResolverEntryPool.getEntryFromId(params.entryId),
-                    adBreakIndex = params.adBreakOrdinal || 0,
-                    docNode = myDocNodeFromElementPath(entry.parsedDocument, ['VMAP', 'AdBreak:' + adBreakIndex.toString(), 'Extensions']);
-
-                return myArrayFromDocNode(docNode, 'Extension');
-            },
-
-        },
-
-        // === Generic element access and entry release===
-
-        getElementListFromPath: function (params) {
-            ///<summary>Get an arbitrary element list given a document tree path</summary>
-            ///<param name="params" type="Object">An object with "entryId" (result of the create function) and "path" (array of Element name:count strings) optionally filtered by "nodeName"</param>
-            ///<returns type="Array">An array of objects representing the elements within the node specified. </returns>
-            var entry = myAdResolverEntryPool.getEntryFromId(params.entryId),
-                docNode = myDocNodeFromElementPath(entry.parsedDocument, params.path);
-
-            return myArrayFromDocNode(docNode, params.nodeName);
-        },
-
-        releaseEntry: function (adResolverEntryIdNumber) {
-            ///<summary>Release the AdResolverEntry obtained from the create functions</summary>
-            ///<param name="params" type="Number">The AdResolverEntry id number (result of the create function)</param>
-            myAdResolverEntryPool.releaseEntry(adResolverEntryIdNumber);
-        },
-
-        // === JSON thunk ===
-        runJSON: function (paramsJSON) {
-            ///<summary>Invoke theAdResolver methods using a JSON string and returning the result as a JSON string.</summary>
-            ///<param name="paramsJSON" type="String">The method name and params expressed in a JSON string. There must be a top level property "func" string with the name of the method to invoke. Method params can either be all top level or within a containing "params" object.</param>
-            ///<returns type="String">The method results expressed is a JSON string. If an exception was thrown, a top level object "EXCEPTION" will contain standard Error fields.</returns>
-
-            var funcArray, params, result, stackArray, stackAsJSON, i;
-
-            try {
-                params = JSON.parse(paramsJSON);
-
-                if (!params || (typeof params.func !== 'string')) {
-                    throw new PLAYER_SEQUENCER.AdResolverError('runJSON func property missing or not a string');
-                }
-
-                funcArray = params.func.split('.');
-                if (funcArray.length > 1) {
-                    if (params.params) {
-                        result = PLAYER_SEQUENCER.theAdResolver[funcArray[0]][funcArray[1]](params.params);
-                    }
-                    else {
-                        result = PLAYER_SEQUENCER.theAdResolver[funcArray[0]][funcArray[1]](params);
-                    }
-                } else {
-                    if (params.params) {
-                        result = PLAYER_SEQUENCER.theAdResolver[params.func](params.params);
-                    }
-                    else {
-                        result = PLAYER_SEQUENCER.theAdResolver[params.func](params);
-                    }
-                }
-
-            }
-            catch (ex) {
-                // JSON.stringify() does not appear to work for exceptions, so generate explicitly:
-                if (ex.stack) {
-                    stackArray = ex.stack.split('\n');
-                    stackAsJSON = "";
-                    for (i = 0; i < stackArray.length; i += 1)
-                    {
-                        if (i > 0) {
-                            stackAsJSON += ',';
-                        }
-                        stackAsJSON += '"' + stackArray[i] + '"';
-                    }
-                    return '{"EXCEPTION":{"name":"' + ex.name + '","message":"' + ex.message + '","stack":[' + stackAsJSON + ']}}';
-                }
-                return '{"EXCEPTION":{"name":"' + ex.name + '","message":"' + ex.message + '"}}';
-            }
-            return JSON.stringify(result);
-        }
-    };
-
-    return publicAPI;
-}());
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// AdResolver module implementation.
+
+// Inform linters of our namespaces:
+/*global PLAYER_SEQUENCER_TEST_LIBRARY, DOMParser */
+
+//
+// The namespace object
+//
+var PLAYER_SEQUENCER = PLAYER_SEQUENCER || {};
+
+// custom AdResolver Error derivation:
+PLAYER_SEQUENCER.AdResolverError = function (message) {
+    ///<summary>Constructor for the custom Sequencer Error derivation.</summary>
+    ///<param name="message" type="String">A human readable error message within the Sequencer Error context.</param>
+    ///<returns type="Object">A new Sequencer Error object instance.</returns>
+    "use strict";
+    if (this === PLAYER_SEQUENCER) {
+        throw new PLAYER_SEQUENCER.AdResolverError("AdResolverError constructor called without new operator!");
+    }
+    this.name = "PLAYER_SEQUENCER:AdResolverError";
+    this.message = message || "[no message]";
+    // For V8 capture the stack trace:
+    if (Error.captureStackTrace) {
+        Error.captureStackTrace(this, PLAYER_SEQUENCER.AdResolverError);    
+    }
+};
+PLAYER_SEQUENCER.AdResolverError.prototype = new Error();
+PLAYER_SEQUENCER.AdResolverError.prototype.constructor = PLAYER_SEQUENCER.AdResolverError;
+
+// -------------------------
+// The AdResolver Entry pool
+// -------------------------
+// Note: The purpose of this pool is to provide a unique mapping of id numbers to adResolverEntry
+//       objects which allows holding references to objects through the JSON thunk.
+//       Therefore, the pool can be a Singleton since the objects are independent.
+//       The parsed documents are held within a memory budget: when the estimated size of the resident
+//       documents exceeds the budget the least recently used entries that are not pinned are evicted.
+//       An evicted entry keeps its id and its source text (when created from a string) so it can be restored.
+//       The AdResolver queries restore an evicted entry from its source text transparently; an entry created
+//       from a DOM object has no source text and must be pinned while it is queried.
+//
+PLAYER_SEQUENCER.theAdResolverEntryPool = (function () {
+"use strict";
+
+    var poolNextEntryId = 1,          // start with 1 so id is always truthy
+        records = {},                 // the record of each live entry by idNumber
+        lruHead = null,               // least recently used resident record
+        lruTail = null,               // most recently used resident record
+        memoryBudget = 8 * 1024 * 1024, // bytes of estimated parsed document size
+        residentBytes = 0,
+        residentCount = 0,
+        entryCount = 0,
+        sourceBytes = 0,
+        evictionCount = 0,
+        restoreCount = 0,
+    
+    // private methods
+    throwSetterInhibited = function ( value ) {
+        throw new PLAYER_SEQUENCER.AdResolverError('setter not allowed. value: ' + value.toString());
+    },
+
+    lruRemove = function ( record ) {
+        if (record.lruPrev) {
+            record.lruPrev.lruNext = record.lruNext;
+        } else {
+            lruHead = record.lruNext;
+        }
+        if (record.lruNext) {
+            record.lruNext.lruPrev = record.lruPrev;
+        } else {
+            lruTail = record.lruPrev;
+        }
+        record.lruPrev = null;
+        record.lruNext = null;
+    },
+
+    lruAppend = function ( record ) {
+        record.lruPrev = lruTail;
+        record.lruNext = null;
+        if (lruTail) {
+            lruTail.lruNext = record;
+        } else {
+            lruHead = record;
+        }
+        lruTail = record;
+    },
+
+    evictRecord = function ( record ) {
+        lruRemove(record);
+        record.parsedDocument = null;
+        record.queryCache = null;
+        residentBytes -= record.byteSize;
+        residentCount -= 1;
+        evictionCount += 1;
+    },
+
+    enforceBudget = function ( recordToKeep ) {
+        ///<summary>Evict least recently used, unpinned entries until the resident documents fit within the memory budget</summary>
+        ///<param name="recordToKeep" type="Object">The record which must stay resident, normally the one just created or accessed</param>
+        var record = lruHead,
+            nextRecord;
+
+        while (record && residentBytes > memoryBudget) {
+            nextRecord = record.lruNext;
+            if (record !== recordToKeep && record.pinCount === 0) {
+                evictRecord(record);
+            }
+            record = nextRecord;
+        }
+    },
+
+    recordFromId = function ( idNumber, callerName ) {
+        var record = records.hasOwnProperty(idNumber) ? records[idNumber] : null;
+        if (!record) {
+            throw new PLAYER_SEQUENCER.AdResolverError('invalid ' + callerName + ' Id: ' + String(idNumber));
+        }
+        return record;
+    };
+
+    return {
+        createEntry: function (aParsedDocument, aByteSize, aSourceText) {
+            ///<summary>Create a new AdResolverEntry object</summary>
+            ///<param name="aParsedDocument" type="Object">A reference to a DOM document object</param>
+            ///<param name="aByteSize" type="Number">The estimated memory size of the parsed document in bytes</param>
+            ///<param name="aSourceText" type="String" mayBeNull="true">The XML text the document was parsed from, kept so an evicted entry can be restored</param>
+            ///<returns type="Object">The AdResolver entry created</returns>
+            var myIdNumber = poolNextEntryId,
+                record = {
+                    parsedDocument: aParsedDocument,
+                    byteSize: aByteSize || 0,
+                    sourceText: (typeof aSourceText === 'string') ? aSourceText : null,
+                    pinCount: 0,
+                    queryCache: null,
+                    lruPrev: null,
+                    lruNext: null,
+                    entry: null
+                };
+
+            poolNextEntryId += 1;
+
+            // DEFINITION of a AdResolverEntry:
+            record.entry = {
+                /// <field name="idNumber" type="Number">unique id number of the AdResolver entry</field>
+                get idNumber() { return myIdNumber; },
+                set idNumber(value) { throwSetterInhibited(value); },
+                /// <field name="parsedDocument" type="Object" mayBeNull="true">reference to a parsed XML document object, null when evicted</field>
+                get parsedDocument() { return record.parsedDocument; },
+                set parsedDocument(value) { throwSetterInhibited(value); },
+                /// <field name="queryCache" type="Object">memoized query results and document nodes for the parsed document, dropped with the document</field>
+                get queryCache() {
+                    if (!record.queryCache) {
+                        record.queryCache = {};
+                    }
+                    return record.queryCache;
+                },
+                set queryCache(value) { throwSetterInhibited(value); }
+            };
+            records[myIdNumber] = record;
+            entryCount += 1;
+            if (record.sourceText) {
+                sourceBytes += 2 * record.sourceText.length;
+            }
+            residentBytes += record.byteSize;
+            residentCount += 1;
+            lruAppend(record);
+            enforceBudget(record);
+            return record.entry;
+        },
+
+        releaseEntry: function (idNumber) {
+            ///<summary>Release the entry pool reference to the AdResolver entry object so it can be GCed</summary>
+            ///<param name="idNumber" type="Number">The idNumber of the AdResolver entry to be released from the pool</param>
+            var record = recordFromId(idNumber, 'releaseEntry');
+
+            if (record.parsedDocument !== null) {
+                lruRemove(record);
+                residentBytes -= record.byteSize;
+                residentCount -= 1;
+            }
+            if (record.sourceText) {
+                sourceBytes -= 2 * record.sourceText.length;
+            }
+            delete records[idNumber];
+            entryCount -= 1;
+        },
+
+        getEntryFromId: function (idNumber) {
+            ///<summary>Get a a reference to the AdResolver entry object with the given idNumber. Throws AdResolverError if the entry has been evicted.</summary>
+            ///<param name="idNumber" type="Number">The id number of the AdResolver entry to be referenced</param>
+            ///<returns type="Object">adResolverEntry object reference</returns>
+            var record = recordFromId(idNumber, 'getEntryFromId');
+
+            if (record.parsedDocument === null) {
+                throw new PLAYER_SEQUENCER.AdResolverError('evicted getEntryFromId Id: ' + String(idNumber));
+            }
+            // mark as most recently used
+            if (record !== lruTail) {
+                lruRemove(record);
+                lruAppend(record);
+            }
+            return record.entry;
+        },
+
+        isEntryResident: function (idNumber) {
+            ///<summary>Check whether the parsed document of an AdResolver entry is in memory</summary>
+            ///<param name="idNumber" type="Number">The id number of the AdResolver entry</param>
+            ///<returns type="Boolean">false when the entry has been evicted by the memory budget</returns>
+            return recordFromId(idNumber, 'isEntryResident').parsedDocument !== null;
+        },
+
+        getSourceText: function (idNumber) {
+            ///<summary>Get the XML text an AdResolver entry was parsed from</summary>
+            ///<param name="idNumber" type="Number">The id number of the AdResolver entry</param>
+            ///<returns type="String" mayBeNull="true">The source text, or null when the entry was created from a DOM object</returns>
+            return recordFromId(idNumber, 'getSourceText').sourceText;
+        },
+
+        restoreEntry: function (idNumber, aParsedDocument, aByteSize) {
+            ///<summary>Make an evicted AdResolver entry resident again with a re-parsed document, keeping its idNumber</summary>
+            ///<param name="idNumber" type="Number">The id number of the evicted AdResolver entry</param>
+            ///<param name="aParsedDocument" type="Object">A reference to the re-parsed DOM document object</param>
+            ///<param name="aByteSize" type="Number">The estimated memory size of the parsed document in bytes</param>
+            ///<returns type="Object">adResolverEntry object reference</returns>
+            var record = recordFromId(idNumber, 'restoreEntry');
+
+            if (record.parsedDocument === null && aParsedDocument) {
+                record.parsedDocument = aParsedDocument;
+                record.byteSize = aByteSize || 0;
+                residentBytes += record.byteSize;
+                residentCount += 1;
+                restoreCount += 1;
+                lruAppend(record);
+                enforceBudget(record);
+            }
+            return record.entry;
+        },
+
+        pinEntry: function (idNumber) {
+            ///<summary>Prevent an AdResolver entry from being evicted until it is unpinned. Pins are counted.</summary>
+            ///<param name="idNumber" type="Number">The id number of the AdResolver entry</param>
+            recordFromId(idNumber, 'pinEntry').pinCount += 1;
+        },
+
+        unpinEntry: function (idNumber) {
+            ///<summary>Undo one pinEntry call, allowing the AdResolver entry to be evicted once all pins are undone</summary>
+            ///<param name="idNumber" type="Number">The id number of the AdResolver entry</param>
+            var record = recordFromId(idNumber, 'unpinEntry');
+
+            if (record.pinCount > 0) {
+                record.pinCount -= 1;
+            }
+            if (record.pinCount === 0) {
+                enforceBudget(null);
+            }
+        },
+
+        setMemoryBudget: function (bytes) {
+            ///<summary>Set the memory budget for the resident parsed documents and evict entries as needed</summary>
+            ///<param name="bytes" type="Number">The budget in bytes of estimated parsed document size</param>
+            if (typeof bytes !== 'number' || bytes < 0) {
+                throw new PLAYER_SEQUENCER.AdResolverError('invalid memory budget: ' + String(bytes));
+            }
+            memoryBudget = bytes;
+            enforceBudget(null);
+        },
+
+        getStatistics: function () {
+            ///<summary>Get the pool memory usage counters</summary>
+            ///<returns type="Object">An object with properties: entryCount, residentCount, residentBytes, memoryBudget, sourceBytes, evictionCount, restoreCount</returns>
+            return {
+                entryCount: entryCount,
+                residentCount: residentCount,
+                residentBytes: residentBytes,
+                memoryBudget: memoryBudget,
+                sourceBytes: sourceBytes,
+                evictionCount: evictionCount,
+                restoreCount: restoreCount
+            };
+        },
+
+        testProbe_toJSON: function () {
+            ///<summary>For testing purposes, return JSON string of the entire AdResolver entry pool</summary>
+            ///<returns type="String">JSON of the entire AdResolver entry pool</returns>
+            var ids = [],
+                id;
+
+            for (id in records) {
+                if (records.hasOwnProperty(id)) {
+                    ids.push({ idNumber: Number(id), isResident: records[id].parsedDocument !== null, byteSize: records[id].byteSize, pinCount: records[id].pinCount });
+                }
+            }
+            return JSON.stringify({ entries: ids, poolNextEntryId: poolNextEntryId, statistics: PLAYER_SEQUENCER.theAdResolverEntryPool.getStatistics() });
+        },
+
+        testProbe_reset: function () {
+            ///<summary>For testing purposes, reset the entire AdResolver entry pool</summary>
+            records = {};
+            lruHead = null;
+            lruTail = null;
+            residentBytes = 0;
+            residentCount = 0;
+            entryCount = 0;
+            sourceBytes = 0;
+            evictionCount = 0;
+            restoreCount = 0;
+        }
+    };
+}());
+
+// -------------------------
+// The compact XML parser
+// -------------------------
+// Note: The purpose of this parser is to build the AdResolver document tree in a single streaming pass over
+//       the XML text without a browser DOM. The nodes are plain objects with only the DOM node properties the
+//       AdResolver queries use (nodeType, nodeName, localName, nodeValue, attributes, childNodes), so query
+//       results are the same as for a DOMParser document while retaining much less memory.
+//       DTD internal subsets and entities other than the predefined and numeric character references are not supported.
+//
+PLAYER_SEQUENCER.theCompactXMLParser = (function () {
+"use strict";
+
+    var ELEMENT_NODE = 1,
+        TEXT_NODE = 3,
+        CDATA_SECTION_NODE = 4,
+        COMMENT_NODE = 8,
+        DOCUMENT_NODE = 9,
+        ENTITY_PATTERN = /&(#x[0-9a-fA-F]+|#[0-9]+|amp|lt|gt|quot|apos);/g,
+        PREDEFINED_ENTITIES = { amp: '&', lt: '<', gt: '>', quot: '"', apos: "'" },
+
+    // private methods
+    throwParseError = function ( message, position ) {
+        throw new PLAYER_SEQUENCER.AdResolverError('XML parse error: ' + message + ' at position ' + position.toString());
+    },
+
+    decodeEntity = function ( match, entity ) {
+        var codePoint;
+
+        if (entity.charAt(0) !== '#') {
+            return PREDEFINED_ENTITIES[entity];
+        }
+        codePoint = (entity.charAt(1) === 'x') ? parseInt(entity.substring(2), 16) : parseInt(entity.substring(1), 10);
+        if (codePoint > 0xFFFF) {
+            // encode as a UTF-16 surrogate pair
+            codePoint -= 0x10000;
+            return String.fromCharCode(0xD800 + (codePoint >> 10), 0xDC00 + (codePoint & 0x3FF));
+        }
+        return String.fromCharCode(codePoint);
+    },
+
+    decodeText = function ( text ) {
+        return (text.indexOf('&') < 0) ? text : text.replace(ENTITY_PATTERN, decodeEntity);
+    },
+
+    isWhiteSpace = function ( charCode ) {
+        return charCode === 32 || charCode === 9 || charCode === 10 || charCode === 13;
+    },
+
+    createElement = function ( qualifiedName ) {
+        var colonIndex = qualifiedName.indexOf(':');
+        return {
+            nodeType: ELEMENT_NODE,
+            nodeName: qualifiedName,
+            localName: (colonIndex < 0) ? qualifiedName : qualifiedName.substring(colonIndex + 1),
+            attributes: [],
+            childNodes: []
+        };
+    },
+
+    parseStartTag = function ( xmlText, position, parentNode ) {
+        ///<summary>Parse a start tag or empty element tag and append the new element to parentNode</summary>
+        ///<returns type="Object">{ element, isEmpty, end } where end is the position after the closing '&gt;'</returns>
+        var length = xmlText.length,
+            nameStart = position + 1,
+            index = nameStart,
+            nextChar,
+            element,
+            attrName,
+            attrStart,
+            quote,
+            valueEnd;
+
+        while (index < length && !isWhiteSpace(xmlText.charCodeAt(index)) && xmlText.charAt(index) !== '>' && xmlText.charAt(index) !== '/') {
+            index += 1;
+        }
+        if (index === nameStart) {
+            throwParseError('missing element name', position);
+        }
+        element = createElement(xmlText.substring(nameStart, index));
+        parentNode.childNodes.push(element);
+
+        for (;;) {
+            while (index < length && isWhiteSpace(xmlText.charCodeAt(index))) {
+                index += 1;
+            }
+            if (index >= length) {
+                throwParseError('unterminated tag <' + element.nodeName, position);
+            }
+            nextChar = xmlText.charAt(index);
+            if (nextChar === '>') {
+                return { element: element, isEmpty: false, end: index + 1 };
+            }
+            if (nextChar === '/') {
+                if (xmlText.charAt(index + 1) !== '>') {
+                    throwParseError('expected /> in tag <' + element.nodeName, index);
+                }
+                return { element: element, isEmpty: true, end: index + 2 };
+            }
+
+            // attribute: name = "value"
+            attrStart = index;
+            while (index < length && xmlText.charAt(index) !== '=' && !isWhiteSpace(xmlText.charCodeAt(index)) && xmlText.charAt(index) !== '>') {
+                index += 1;
+            }
+            attrName = xmlText.substring(attrStart, index);
+            while (index < length && isWhiteSpace(xmlText.charCodeAt(index))) {
+                index += 1;
+            }
+            if (xmlText.charAt(index) !== '=') {
+                throwParseError('expected = after attribute ' + attrName, index);
+            }
+            index += 1;
+            while (index < length && isWhiteSpace(xmlText.charCodeAt(index))) {
+                index += 1;
+            }
+            quote = xmlText.charAt(index);
+            if (quote !== '"' && quote !== "'") {
+                throwParseError('expected quoted value for attribute ' + attrName, index);
+            }
+            valueEnd = xmlText.indexOf(quote, index + 1);
+            if (valueEnd < 0) {
+                throwParseError('unterminated value for attribute ' + attrName, index);
+            }
+            element.attributes.push({ nodeName: attrName, nodeValue: decodeText(xmlText.substring(index + 1, valueEnd)) });
+            index = valueEnd + 1;
+        }
+    };
+
+    return {
+        ELEMENT_NODE: ELEMENT_NODE,
+        TEXT_NODE: TEXT_NODE,
+        CDATA_SECTION_NODE: CDATA_SECTION_NODE,
+        COMMENT_NODE: COMMENT_NODE,
+        DOCUMENT_NODE: DOCUMENT_NODE,
+
+        parseFromString: function (xmlText) {
+            ///<summary>Parse an XML string into a compact document tree in a single pass</summary>
+            ///<param name="xmlText" type="String">The XML text</param>
+            ///<returns type="Object">The document node. Throws AdResolverError if the XML is not well formed.</returns>
+            var documentNode = { nodeType: DOCUMENT_NODE, nodeName: '#document', childNodes: [] },
+                nodeStack = [documentNode],
+                currentNode = documentNode,
+                length = xmlText.length,
+                position = 0,
+                end,
+                tag,
+                closingName;
+
+            while (position < length) {
+                if (xmlText.charAt(position) !== '<') {
+                    // character data up to the next markup
+                    end = xmlText.indexOf('<', position);
+                    if (end < 0) {
+                        end = length;
+                    }
+                    // Note: like a DOM document, text outside the root element is not kept
+                    if (currentNode !== documentNode) {
+                        currentNode.childNodes.push({ nodeType: TEXT_NODE, nodeName: '#text', nodeValue: decodeText(xmlText.substring(position, end)) });
+                    }
+                    position = end;
+                }
+                else if (xmlText.substr(position, 9) === '<![CDATA[') {
+                    end = xmlText.indexOf(']]>', position + 9);
+                    if (end < 0) {
+                        throwParseError('unterminated CDATA section', position);
+                    }
+                    currentNode.childNodes.push({ nodeType: CDATA_SECTION_NODE, nodeName: '#cdata-section', nodeValue: xmlText.substring(position + 9, end) });
+                    position = end + 3;
+                }
+                else if (xmlText.substr(position, 4) === '<!--') {
+                    end = xmlText.indexOf('-->', position + 4);
+                    if (end < 0) {
+                        throwParseError('unterminated comment', position);
+                    }
+                    currentNode.childNodes.push({ nodeType: COMMENT_NODE, nodeName: '#comment', nodeValue: xmlText.substring(position + 4, end) });
+                    position = end + 3;
+                }
+                else if (xmlText.charAt(position + 1) === '?') {
+                    // XML declaration or processing instruction
+                    end = xmlText.indexOf('?>', position + 2);
+                    if (end < 0) {
+                        throwParseError('unterminated processing instruction', position);
+                    }
+                    position = end + 2;
+                }
+                else if (xmlText.charAt(position + 1) === '!') {
+                    // DOCTYPE
+                    end = xmlText.indexOf('>', position + 2);
+                    if (end < 0) {
+                        throwParseError('unterminated declaration', position);
+                    }
+                    position = end + 1;
+                }
+                else if (xmlText.charAt(position + 1) === '/') {
+                    end = xmlText.indexOf('>', position + 2);
+                    if (end < 0) {
+                        throwParseError('unterminated end tag', position);
+                    }
+                    closingName = xmlText.substring(position + 2, end).replace(/\s+$/, '');
+                    if (currentNode === documentNode || closingName !== currentNode.nodeName) {
+                        throwParseError('mismatched end tag </' + closingName + '>', position);
+                    }
+                    nodeStack.pop();
+                    currentNode = nodeStack[nodeStack.length - 1];
+                    position = end + 1;
+                }
+                else {
+                    tag = parseStartTag(xmlText, position, currentNode);
+                    if (!tag.isEmpty) {
+                        nodeStack.push(tag.element);
+                        currentNode = tag.element;
+                    }
+                    position = tag.end;
+                }
+            }
+
+            if (currentNode !== documentNode) {
+                throwParseError('unclosed element <' + currentNode.nodeName + '>', length);
+            }
+            return documentNode;
+        }
+    };
+}());
+
+// -------------------------
+// The AdResolver Handler
+// -------------------------
+// Note: The purpose of this object is to provide an API for AdResolver XML documents.
+//       This can be a singleton since the objects are independent.
+//
+PLAYER_SEQUENCER.theAdResolver = (function () {
+"use strict";
+    // private variables
+    var myDOMParser = null,         // created on first use so the core can load where DOMParser is not available
+        myUseCompactParser = false,
+        myQueryHitCount = 0,
+        myQueryMissCount = 0,
+        myAdResolverEntryPool = PLAYER_SEQUENCER.theAdResolverEntryPool,
+        myCompactXMLParser = PLAYER_SEQUENCER.theCompactXMLParser,
+        ELEMENT_NODE = myCompactXMLParser.ELEMENT_NODE,
+        TEXT_NODE = myCompactXMLParser.TEXT_NODE,
+        CDATA_SECTION_NODE = myCompactXMLParser.CDATA_SECTION_NODE,
+        DOCUMENT_NODE = myCompactXMLParser.DOCUMENT_NODE,
+
+    // private methods
+
+    myParseFromString = function(aManifest) {
+        ///<summary>Parse an XML string into a document tree: a compact document when the compact parser is selected or no DOMParser is available, otherwise a DOM document.</summary>
+        ///<param name="aManifest" type="String">The manifest as an XML string</param>
+        ///<returns type="Object">A reference to the parsed document</returns>
+        if (myUseCompactParser || typeof DOMParser === 'undefined') {
+            return myCompactXMLParser.parseFromString(aManifest);
+        }
+        if (!myDOMParser) {
+            myDOMParser = new DOMParser();
+        }
+        return myDOMParser.parseFromString(aManifest, "application/xml");
+    },
+
+    myIsNodeType = function(node, nodeType) {
+        // Note: nodeType is used rather than the DOM prototypes so compact documents are handled the same way
+        return !!node && node.nodeType === nodeType;
+    },
+
+    myEstimateDocumentSize = function(docNode) {
+        ///<summary>Estimate the memory size of a parsed document tree: a fixed cost per node and attribute plus the name and value text.</summary>
+        ///<param name="docNode" type="Object">The document or sub-node to measure</param>
+        ///<returns type="Number">The estimated size in bytes</returns>
+        var NODE_BYTES = 64,
+            size = 0,
+            nodeStack = [docNode],
+            node,
+            attrIndex,
+            childIndex;
+
+        while (nodeStack.length > 0) {
+            node = nodeStack.pop();
+            size += NODE_BYTES + 2 * ((node.nodeName ? node.nodeName.length : 0) + (node.nodeValue ? node.nodeValue.length : 0));
+            if (node.attributes) {
+                for (attrIndex = 0; attrIndex < node.attributes.length; attrIndex += 1) {
+                    size += NODE_BYTES + 2 * (node.attributes[attrIndex].nodeName.length + node.attributes[attrIndex].nodeValue.length);
+                }
+            }
+            if (node.childNodes) {
+                for (childIndex = 0; childIndex < node.childNodes.length; childIndex += 1) {
+                    nodeStack.push(node.childNodes[childIndex]);
+                }
+            }
+        }
+        return size;
+    },
+
+    myRestoreFromSourceText = function(entryId) {
+        ///<summary>Re-parse an AdResolverEntry evicted by the memory budget from its source text, keeping its id number</summary>
+        ///<param name="entryId" type="Number">The AdResolverEntry id number</param>
+        ///<returns type="Boolean">false if the entry is evicted and was created from a DOM object, so it has no source text</returns>
+        var sourceText,
+            parsedDocument;
+
+        if (myAdResolverEntryPool.isEntryResident(entryId)) {
+            return true;
+        }
+        sourceText = myAdResolverEntryPool.getSourceText(entryId);
+        if (!sourceText) {
+            return false;
+        }
+        parsedDocument = myParseFromString(sourceText);
+        myAdResolverEntryPool.restoreEntry(entryId, parsedDocument, myEstimateDocumentSize(parsedDocument));
+        return true;
+    },
+
+    myGetEntry = function(entryId) {
+        ///<summary>Get the AdResolverEntry for a query, restoring it first if it was evicted by the memory budget.
+        ///Throws AdResolverError if the entry is invalid, or evicted without source text.</summary>
+        ///<param name="entryId" type="Number">The AdResolverEntry id number</param>
+        ///<returns type="Object">The resident AdResolverEntry</returns>
+        myRestoreFromSourceText(entryId);
+        return myAdResolverEntryPool.getEntryFromId(entryId);
+    },
+
+    // Note: When dealing with element names, only the "localName" (without any namespace identifier) is used
+    //       instead of the "nodeName" (fully qualified) since the namespace identifier is arbitrary.
+    //       The fully qualified name for attributes is always given in the results list.
+
+    myDocNodeFromElementPath = function(parsedDocument, eltPathNameArray) {
+        ///<summary>Walk the parsedDocument tree following the path of elements provided in eltPathNameArray and return the document node found.</summary>
+        ///<param name="eltPathNameArray" type="Array">Array of strings containing eltName:index where eltName is element name (or "*"" for wildcard) and index is the ordinal of the Element child</param>
+        ///<returns type="Object">A reference to the node in the document</returns>
+        var paramIx,
+            currentDocNode = parsedDocument,
+            currentPathElt,
+            nodeIx,
+            nodeCount;
+
+        for (paramIx = 0; paramIx < eltPathNameArray.length; paramIx += 1) {
+            currentPathElt = eltPathNameArray[paramIx].split(':');
+            nodeCount = currentDocNode.childNodes.length;
+            for (nodeIx = 0; nodeIx < nodeCount; nodeIx += 1) {
+                if (myIsNodeType(currentDocNode.childNodes[nodeIx], ELEMENT_NODE) && 
+                    ( currentPathElt[0] === '*' || currentPathElt[0] === currentDocNode.childNodes[nodeIx].localName)) {
+                    if (currentPathElt.length === 1 || currentPathElt[1] < 1) {
+                        currentDocNode = currentDocNode.childNodes[nodeIx];
+                        break;
+                    }
+                    if (currentPathElt.length > 1) {
+                        currentPathElt[1] -= 1;
+                    }
+                }
+            }
+            if (nodeIx === nodeCount) {
+                throw new PLAYER_SEQUENCER.AdResolverError("Failed to find path " + JSON.stringify(eltPathNameArray));
+            }
+        }
+
+        return currentDocNode;
+    },
+
+    myDocNodeFromEntryPath = function(entry, eltPathNameArray) {
+        ///<summary>Get the document node for a path within an AdResolverEntry, indexed by path so each path is only walked once per parsed document.</summary>
+        ///<param name="entry" type="Object">The AdResolverEntry</param>
+        ///<param name="eltPathNameArray" type="Array">Array of strings containing eltName:index (see myDocNodeFromElementPath)</param>
+        ///<returns type="Object">A reference to the node in the document</returns>
+        var cache = entry.queryCache,
+            pathKey = 'path:' + eltPathNameArray.join('/');
+
+        if (!cache.hasOwnProperty(pathKey)) {
+            cache[pathKey] = myDocNodeFromElementPath(entry.parsedDocument, eltPathNameArray);
+        }
+        return cache[pathKey];
+    },
+
+    myFreezeResult = function (result) {
+        ///<summary>Deep freeze a query result (arrays and objects of strings and numbers) so a memoized result can be shared</summary>
+        ///<returns type="Object">The frozen result</returns>
+        var key;
+
+        if (result !== null && typeof result === 'object' && !Object.isFrozen(result)) {
+            for (key in result) {
+                if (result.hasOwnProperty(key)) {
+                    myFreezeResult(result[key]);
+                }
+            }
+            Object.freeze(result);
+        }
+        return result;
+    },
+
+    myMemoizeQueries = function(queryObject, queryPrefix, queryNames) {
+        ///<summary>Replace query methods with versions memoizing their results per AdResolverEntry and params. Parsed documents are immutable, so results stay valid until the entry is evicted or released.
+        ///The memoized results are shared by every caller, so they are frozen: a caller wanting to modify a result must copy it.</summary>
+        ///<param name="queryObject" type="Object">The object holding the query methods</param>
+        ///<param name="queryPrefix" type="String">Prefix for the cache keys, unique per queryObject</param>
+        ///<param name="queryNames" type="Array">The names of the query methods; each takes a params object with "entryId"</param>
+        var i,
+            memoize = function (queryName) {
+                var query = queryObject[queryName],
+                    keyPrefix = 'query:' + queryPrefix + queryName + ':';
+
+                queryObject[queryName] = function (params) {
+                    var cache = myGetEntry(params.entryId).queryCache,
+                        queryKey = keyPrefix + JSON.stringify(params);
+
+                    if (cache.hasOwnProperty(queryKey)) {
+                        myQueryHitCount += 1;
+                        return cache[queryKey];
+                    }
+                    myQueryMissCount += 1;
+                    cache[queryKey] = myFreezeResult(query(params));
+                    return cache[queryKey];
+                };
+            };
+
+        for (i = 0; i < queryNames.length; i += 1) {
+            memoize(queryNames[i]);
+        }
+    },
+
+    myArrayFromDocNode = function(docNode, nodeNameFilter) {
+        ///<summary>Create object from next level elements and their attributes.</summary>
+        ///<param name="docNode" type="Object">document sub-node to use</param>
+        ///<param name="nodeNameFilter" type="String">Element name filter</param>
+        ///<returns type="Array">Array of Element 'name', 'value' and 'attrs' properties</returns>
+        var result = [],
+            docChildIndex,
+            contentIndex,
+            eltNode,
+            childEltNames,
+            resultObj;
+
+        for (docChildIndex = 0; docChildIndex < docNode.childNodes.length; docChildIndex += 1) {
+            eltNode = docNode.childNodes[docChildIndex];
+            if (myIsNodeType(eltNode, ELEMENT_NODE) && (!nodeNameFilter || eltNode.localName === nodeNameFilter)) {
+                if (nodeNameFilter) {
+                    resultObj = {};
+                } else {
+                    resultObj = { name: eltNode.localName };
+                }
+                // CDATA text
+                for (contentIndex = 0; contentIndex < eltNode.childNodes.length; contentIndex += 1) {
+                    if (myIsNodeType(eltNode.childNodes[contentIndex], CDATA_SECTION_NODE)) {
+                        resultObj.value = eltNode.childNodes[contentIndex].nodeValue;
+                        break;
+                    }
+                }
+                // If no CDATA
+                if (contentIndex === eltNode.childNodes.length) {
+                    // Count the number of contained elements
+                    childEltNames = [];
+                    for (contentIndex = 0; contentIndex < eltNode.childNodes.length; contentIndex += 1) {
+                        if (myIsNodeType(eltNode.childNodes[contentIndex], ELEMENT_NODE)) {
+                            childEltNames.push(eltNode.childNodes[contentIndex].localName);
+                        }
+                    }
+                    // If contained elements just give count
+                    if (childEltNames.length > 0) {
+                        if (nodeNameFilter) {
+                            resultObj.elements = childEltNames;
+                        } else {
+                            resultObj.elements = childEltNames.length;
+                        }
+                    } else {
+                        // give value of first Text element that is not just a newline // TODO: should be: is not just white space
+                        for (contentIndex = 0; contentIndex < eltNode.childNodes.length; contentIndex += 1) {
+                            if (myIsNodeType(eltNode.childNodes[contentIndex], TEXT_NODE)) {
+                                if (eltNode.childNodes[contentIndex].nodeValue !== '\n') {
+                                    resultObj.value = eltNode.childNodes[0].nodeValue;
+                                    break;
+                                }                            
+                            }
+                        }
+                    }
+                }
+                // attributes
+                if (eltNode.attributes && eltNode.attributes.length > 0) {
+                    resultObj.attrs = {};
+                    for (contentIndex = 0; contentIndex < eltNode.attributes.length; contentIndex += 1) {
+                        resultObj.attrs[eltNode.attributes[contentIndex].nodeName] = eltNode.attributes[contentIndex].nodeValue;
+                    }
+                }
+                result.push(resultObj);
+            }
+        }
+        return result;
+    },
+
+    myArrayOfChildrenFromDocNode = function(docNode, parentName) {
+        ///<summary>Create object from next level elements and their attributes.</summary>
+        ///<param name="docNode" type="Object">document sub-node to use</param>
+        ///<returns type="Array">Array of type, parentAttrs, and elements (with 'name', 'value' and 'attrs' properties)</returns>
+        var 
+        result = [],
+            nodeObj,
+            docNodeParent,
+            docNodeChild,
+            contentIndex,
+            parentIndex,
+            childIndex,
+            childElements,
+            parentOrdinal = 0;
+
+        for (parentIndex = 0; parentIndex < docNode.childNodes.length; parentIndex += 1) {
+            docNodeParent = docNode.childNodes[parentIndex];
+            if (myIsNodeType(docNodeParent, ELEMENT_NODE) && docNodeParent.localName === parentName) {
+                for (childIndex = 0; childIndex < docNodeParent.childNodes.length; childIndex += 1) {
+                    docNodeChild = docNodeParent.childNodes[childIndex];
+                    if (myIsNodeType(docNodeChild, ELEMENT_NODE)) {
+                        nodeObj = { type: docNodeChild.localName };
+                        // Parent attributes
+                        if (docNodeParent.attributes && docNodeParent.attributes.length > 0) {
+                            nodeObj.parentAttrs = {};
+                            for (contentIndex = 0; contentIndex < docNodeParent.attributes.length; contentIndex += 1) {
+                                nodeObj.parentAttrs[docNodeParent.attributes[contentIndex].nodeName] = docNodeParent.attributes[contentIndex].nodeValue;
+                            }
+                        }
+                        // Child attributes
+                        if (docNodeChild.attributes && docNodeChild.attributes.length > 0) {
+                            nodeObj.attrs = {};
+                            for (contentIndex = 0; contentIndex < docNodeChild.attributes.length; contentIndex += 1) {
+                                nodeObj.attrs[docNodeChild.attributes[contentIndex].nodeName] = docNodeChild.attributes[contentIndex].nodeValue;
+                            }
+                        }
+                        // Child elements if any, else CDATA section if one.
+                        childElements = myArrayFromDocNode(docNodeChild);
+                        if (childElements.length > 0) {
+                            nodeObj.elements = childElements;
+                        } else {
+                            for (contentIndex = 0; contentIndex < docNodeChild.childNodes.length; contentIndex += 1) {
+                                if (myIsNodeType(docNodeChild.childNodes[contentIndex], CDATA_SECTION_NODE)) {
+                                    nodeObj.value = docNodeChild.childNodes[contentIndex].nodeValue;
+                                    break;
+                                }
+                            }
+                        }
+                        result.push(nodeObj);
+                        break;
+                    }
+                }
+                parentOrdinal += 1;
+            }
+        }
+        return result;
+    },
+
+    // ---------------------------------
+    // public methods
+    // ---------------------------------
+
+    // Note: Error codes are in VAST 3.0 spec: 2.4.2.3 and VMAP 1.0 spec: 2.5
+
+    publicAPI = {
+        vast: { // === VAST Parsed document information access ===
+
+            createEntry: function (aManifest) {
+                ///<summary>Create a AdResolverEntry by parsing an XML string or using a DOM Document.</summary>
+                ///<param name="aManifest" type="String">The manifest as an XML string</param>
+                ///<param name="aManifest" type="Object">The manifest as an object derived from Document</param>
+                ///<returns type="Number">The idNumber for the AdResolverEntry that was created. Throws AdResolverError if invalid AdResolver document.</returns>
+                var parsedDocument;
+
+                if (typeof aManifest === 'string') {
+                    parsedDocument = myParseFromString(aManifest);
+                }
+                else if (myIsNodeType(aManifest, DOCUMENT_NODE) || myIsNodeType(aManifest, ELEMENT_NODE)) {
+                    parsedDocument = aManifest;
+                }
+                else {
+                    throw new PLAYER_SEQUENCER.AdResolverError('vast.createEntry parameter invalid! ' + aManifest.toString());
+                }
+
+                // Assert the top level element is <VAST> and it contains at least one <Ad>.
+                myDocNodeFromElementPath(parsedDocument, ['VAST', 'Ad']);
+                // myDocNodeFromElementPath throws an exception if path not found
+
+                return myAdResolverEntryPool.createEntry(parsedDocument, myEstimateDocumentSize(parsedDocument), aManifest).idNumber;
+            },
+
+            getAdList: function (params) {
+                ///<summary>Release the AdResolverEntry obtained from the create functions</summary>
+                ///<param name="params" type="Object">An object with "entryId" (result of the create function)</param>
+                ///<returns type="Array">Array of objects for each 'Ad': { type: "InLine" | "Wrapper", attrs: { Ad attrs }, elements: [<childElts>] }</returns>
+                var entry = myGetEntry(params.entryId),
+                    docNodeVAST = myDocNodeFromEntryPath(entry, ['VAST']);
+
+                return myArrayOfChildrenFromDocNode(docNodeVAST, 'Ad');
+            },
+
+            getCreativeList: function (params) {
+                ///<summary>Get a list of Creative entries given Ad ordinal number.</summary>
+                ///<param name="params" type="Object">An object with "entryId" (result of the create function), "adOrdinal" (which of multiple <Ad>) and "adType" from Ad list</param>
+                ///<returns type="Array">Array of objects { type (Linear/Companion/NonLinear), Creative attributes }</returns>
+                var entry = myGetEntry(params.entryId),
+                    adIndex = params.adOrdinal || 0,
+                    docNodeCreatives;
+
+                docNodeCreatives = myDocNodeFromEntryPath(entry,
+                    [
+                        'VAST',
+                        'Ad:' + adIndex.toString(),
+                        params.adType,
+                        'Creatives'
+                    ]);
+
+                return myArrayOfChildrenFromDocNode(docNodeCreatives, 'Creative');
+            },
+
+            getLinearTrackingEventsList: function (params) {
+                ///<summary>Get a list of TrackingEvents entries given Ad and Creative ordinal numbers.</summary>
+                ///<param name="params" type="Object">An object with "entryId" (result of the create function), "adOrdinal" (which of multiple <Ad>), and "creativeOrdinal" (which of multiple <Creative></param>
+                ///<returns type="Array">An array of objects with a 'name' string (should be "Tracking"), 'value' string with the CDATA URL string, and an 'attrs' object containing the <MediaFile> attributes</returns>
+                var entry = myGetEntry(params.entryId),
+                    adIndex = params.adOrdinal || 0,
+                    creativeIndex = params.creativeOrdinal || 0,
+                    docTrackingEvents;
+
+                docTrackingEvents = myDocNodeFromEntryPath(entry,
+                    [
+                        'VAST',
+                        'Ad:' + adIndex.toString(),
+                        '*', // allows either InLine or Wrapper
+                        'Creatives',
+                        'Creative:' + creativeIndex.toString(),
+                        'Linear',
+                        'TrackingEvents'
+                    ]);
+
+                return myArrayFromDocNode(docTrackingEvents);
+            },
+
+            getVideoClicksList: function (params) {
+                ///<summary>Get a list of VideoClicks entries given Ad and Creative ordinal numbers.</summary>
+                ///<param name="params" type="Object">An object with "entryId" (result of the create function), "adOrdinal" (which of multiple <Ad>), and "creativeOrdinal" (which of multiple <Creative></param>
+                ///<returns type="Array">An array of objects with a 'name' string, 'value' string with the CDATA URL string, and an 'attrs' object containing the <MediaFile> attributes</returns>
+                var entry = myGetEntry(params.entryId),
+                    adIndex = params.adOrdinal || 0,
+                    creativeIndex = params.creativeOrdinal || 0,
+                    docVideoClicks;
+
+                docVideoClicks = myDocNodeFromEntryPath(entry,
+                    [
+                        'VAST',
+                        'Ad:' + adIndex.toString(),
+                        '*', // allows either InLine or Wrapper
+                        'Creatives',
+                        'Creative:' + creativeIndex.toString(),
+                        'Linear',
+                        'VideoClicks'
+                    ]);
+
+                return myArrayFromDocNode(docVideoClicks);
+            },
+
+            getIconsList: function (params) {
+                ///<summary>Get a list of Icons entries given Ad and Creative ordinal numbers.</summary>
+                ///<param name="params" type="Object">An object with "entryId" (result of the create function), "adOrdinal" (which of multiple <Ad>), and "creativeOrdinal" (which of multiple <Creative></param>
+                ///<returns type="Array">An array of Icon objects</returns>
+                var entry = myGetEntry(params.entryId),
+                    adIndex = params.adOrdinal || 0,
+                    creativeIndex = params.creativeOrdinal || 0,
+                    docIcons;
+
+                docIcons = myDocNodeFromEntryPath(entry,
+                    [
+                        'VAST',
+                        'Ad:' + adIndex.toString(),
+                        '*', // allows either InLine or Wrapper
+                        'Creatives',
+                        'Creative:' + creativeIndex.toString(),
+                        'Linear',
+                        'Icons'
+                    ]);
+
+                return myArrayOfChildrenFromDocNode(docIcons, 'Icon');
+            },
+
+            getMediaFileList: function (params) {
+                ///<summary>Get a list of MediaFile entries given Ad and Creative ordinal numbers.</summary>
+                ///<param name="params" type="Object">An object with "entryId" (result of the create function), "adOrdinal" (which of multiple <Ad>), and "creativeOrdinal" (which of multiple <Creative></param>
+                ///<returns type="Object">An array of objects with a 'name' string (should be "MediaFile"), 'value' string with the CDATA URL string, and an 'attrs' object containing the <MediaFile> attributes</returns>
+                var entry = myGetEntry(params.entryId),
+                    adIndex = params.adOrdinal || 0,
+                    creativeIndex = params.creativeOrdinal || 0,
+                    docNodeMediaFiles;
+
+                docNodeMediaFiles = myDocNodeFromEntryPath(entry,
+                    [
+                        'VAST',
+                        'Ad:' + adIndex.toString(),
+                        'InLine',
+                        'Creatives',
+                        'Creative:' + creativeIndex.toString(),
+                        'Linear',
+                        'MediaFiles'
+                    ]);
+
+                return myArrayFromDocNode(docNodeMediaFiles);
+            },
+
+            getCompanionAdsList: function (params) {
+                ///<summary>Get a list of CompanionAds entries given Ad and Creative ordinal numbers.</summary>
+                ///<param name="params" type="Object">An object with "entryId" (result of the create function), "adOrdinal" (which of multiple <Ad>), and "creativeOrdinal" (which of multiple <Creative></param>
+                ///<returns type="Array">An array of Companion objects</returns>
+                var entry = myGetEntry(params.entryId),
+                    adIndex = params.adOrdinal || 0,
+                    creativeIndex = params.creativeOrdinal || 0,
+                    docCompanionAds;
+
+                docCompanionAds = myDocNodeFromEntryPath(entry,
+                    [
+                        'VAST',
+                        'Ad:' + adIndex.toString(),
+                        '*', // allows either InLine or Wrapper
+                        'Creatives',
+                        'Creative:' + creativeIndex.toString(),
+                        'CompanionAds'
+                    ]);
+
+                return myArrayOfChildrenFromDocNode(docCompanionAds, 'Companion');
+            },
+
+            getNonLinearAdsList: function (params) {
+                ///<summary>Get a list of NonLinearAds entries given Ad and Creative ordinal numbers.</summary>
+                ///<param name="params" type="Object">An object with "entryId" (result of the create function), "adOrdinal" (which of multiple <Ad>), and "creativeOrdinal" (which of multiple <Creative></param>
+                ///<returns type="Array">An array of Companion objects</returns>
+                var entry = myGetEntry(params.entryId),
+                    adIndex = params.adOrdinal || 0,
+                    creativeIndex = params.creativeOrdinal || 0,
+                    docNonLinearAds;
+
+                docNonLinearAds = myDocNodeFromEntryPath(entry,
+                    [
+                        'VAST',
+                        'Ad:' + adIndex.toString(),
+                        '*', // allows either InLine or Wrapper
+                        'Creatives',
+                        'Creative:' + creativeIndex.toString(),
+                        'NonLinearAds'
+                    ]);
+
+                return myArrayOfChildrenFromDocNode(docNonLinearAds, 'Companion');
+            },
+        },
+
+        vmap: { // === VMAP Parsed document information access ===
+
+            createEntry: function (aManifest) {
+                ///<summary>Create a AdResolverEntry by parsing an XML string or using a DOM Document.</summary>
+                ///<param name="aManifest" type="String">The manifest as an XML string</param>
+                ///<param name="aManifest" type="Object">The manifest as an object derived from Document</param>
+                ///<returns type="Number">The idNumber for the AdResolverEntry that was created. Throws AdResolverError if invalid AdResolver document.</returns>
+                var parsedDocument;
+
+                if (typeof aManifest === 'string') {
+                    parsedDocument = myParseFromString(aManifest);
+                }
+                else if (myIsNodeType(aManifest, DOCUMENT_NODE)) {
+                    parsedDocument = aManifest;
+                }
+                else {
+                    throw new PLAYER_SEQUENCER.AdResolverError('vmap.createEntry parameter invalid! ' + aManifest.toString());
+                }
+
+                // Assert the top level element is <VMAP> and it contains at least one <AdBreak>.
+                myDocNodeFromElementPath(parsedDocument, ['VMAP', 'AdBreak']);
+                // myDocNodeFromElementPath throws an exception if path not found
+
+                return myAdResolverEntryPool.createEntry(parsedDocument, myEstimateDocumentSize(parsedDocument), aManifest).idNumber;
+            },
+
+            getAdBreakList: function (params) {
+                ///<summary>Get a list of AdBreak items</summary>
+                ///<param name="params" type="Object">An object with "entryId" (result of the createEntry function)</param>
+                ///<returns type="Array">Array of objects, one for each 'AdBreak' element: [{elements:[string array of next level elements],attrs:{set of attribute name:value pairs}]</returns>
+                var entry = myGetEntry(params.entryId),
+                    docNodeVMAP = myDocNodeFromEntryPath(entry, ['VMAP']);
+
+                return myArrayFromDocNode(docNodeVMAP, 'AdBreak');
+            },
+
+            getAdSource: function (params) {
+                ///<summary>Get the AdSource item for a given AdBreak</summary>
+                ///<param name="params" type="Object">An object with "entryId" (result of the createEntry function) and "adBreakOrdinal" (index into AdBreakList)</param>
+                ///<returns type="Object">An Object containing: {type:(enum VASTData,CustomAdData,AdTagURI),attrs:{set of attribute name:value pairs},value</returns>
+                var entry = myGetEntry(params.entryId),
+                    adBreakIndex = params.adBreakOrdinal || 0,
+                    docNode = myDocNodeFromEntryPath(entry, ['VMAP', 'AdBreak:' + adBreakIndex.toString()]);
+
+                return myArrayOfChildrenFromDocNode(docNode, 'AdSource');
+            },
+
+            createVASTEntryFromAdBreak: function (params) {
+                ///<summary>Create a VASTEntry for a given AdBreak which is assumed to contain an AdSource/VASTData element.</summary>
+                ///<param name="params" type="Object">An object with "entryId" (result of the createEntry function) and "adBreakOrdinal" (index into AdBreakList)</param>
+                ///<returns type="Number">A VASTEntry idNumber</returns>
+                var entry = myGetEntry(params.entryId),
+                    adBreakIndex = params.adBreakOrdinal || 0,
+                    docNode;
+
+                    docNode = myDocNodeFromEntryPath(entry, 
+                        [
+                            'VMAP', 
+                            'AdBreak:' + adBreakIndex.toString(), 
+                            'AdSource', 
+                            'VASTData'
+                        ]);
+
+                return publicAPI.vast.createEntry(docNode);
+            },
+
+            getTrackingEventsList: function (params) {
+                ///<summary>Get the list of Tracking elements for the TrackingEvents element in a given AdBreak</summary>
+                ///<param name="params" type="Object">An object with "entryId" (result of the createEntry function) and "adBreakOrdinal" (index into AdBreakList)</param>
+                ///<returns type="Array">An array of Tracking element objects: { value, attrs }</returns>
+                var entry = myGetEntry(params.entryId),
+                    adBreakIndex = params.adBreakOrdinal || 0,
+                    docNode = myDocNodeFromEntryPath(entry, ['VMAP', 'AdBreak:' + adBreakIndex.toString(), 'TrackingEvents']);
+
+                return myArrayFromDocNode(docNode, 'Tracking');
+            },
+
+            getExtensionsList: function (params) {
+                ///<summary>Get the list of Extension elements for the Extensions element in a given AdBreak</summary>
+                ///<param name="params" type="Object">An object with "entryId" (result of the createEntry function) and "adBreakOrdinal" (index into AdBreakList)</param>
+                ///<returns type="Array">An array of Extension element objects: {elements, attrs}</returns>
+                var entry = myGetEntry(params.entryId),
+                    adBreakIndex = params.adBreakOrdinal || 0,
+                    docNode = myDocNodeFromEntryPath(entry, ['VMAP', 'AdBreak:' + adBreakIndex.toString(), 'Extensions']);
+
+                return myArrayFromDocNode(docNode, 'Extension');
+            },
+
+        },
+
+        // === Generic element access and entry release===
+
+        getElementListFromPath: function (params) {
+            ///<summary>Get an arbitrary element list given a document tree path</summary>
+            ///<param name="params" type="Object">An object with "entryId" (result of the create function) and "path" (array of Element name:count strings) optionally filtered by "nodeName"</param>
+            ///<returns type="Array">An array of objects representing the elements within the node specified. </returns>
+            var entry = myGetEntry(params.entryId),
+                docNode = myDocNodeFromEntryPath(entry, params.path);
+
+            return myArrayFromDocNode(docNode, params.nodeName);
+        },
+
+        releaseEntry: function (adResolverEntryIdNumber) {
+            ///<summary>Release the AdResolverEntry obtained from the create functions</summary>
+            ///<param name="params" type="Number">The AdResolverEntry id number (result of the create function)</param>
+            myAdResolverEntryPool.releaseEntry(adResolverEntryIdNumber);
+        },
+
+        restoreEntry: function (adResolverEntryIdNumber) {
+            ///<summary>Re-parse an AdResolverEntry evicted by the memory budget from its cached source text, keeping its id number</summary>
+            ///<param name="params" type="Number">The AdResolverEntry id number (result of the create function)</param>
+            ///<returns type="Number">The AdResolverEntry id number. Throws AdResolverError if the entry was created from a DOM object and has no source text.</returns>
+            if (!myRestoreFromSourceText(adResolverEntryIdNumber)) {
+                throw new PLAYER_SEQUENCER.AdResolverError('restoreEntry no source text for Id: ' + String(adResolverEntryIdNumber));
+            }
+            return adResolverEntryIdNumber;
+        },
+
+        pinEntry: function (adResolverEntryIdNumber) {
+            ///<summary>Prevent the AdResolverEntry from being evicted by the memory budget until unpinEntry is called</summary>
+            ///<param name="params" type="Number">The AdResolverEntry id number (result of the create function)</param>
+            myAdResolverEntryPool.pinEntry(adResolverEntryIdNumber);
+        },
+
+        unpinEntry: function (adResolverEntryIdNumber) {
+            ///<summary>Allow the AdResolverEntry to be evicted by the memory budget again</summary>
+            ///<param name="params" type="Number">The AdResolverEntry id number (result of the create function)</param>
+            myAdResolverEntryPool.unpinEntry(adResolverEntryIdNumber);
+        },
+
+        setMemoryBudget: function (bytes) {
+            ///<summary>Set the memory budget for the parsed documents of all AdResolverEntries</summary>
+            ///<param name="params" type="Number">The budget in bytes of estimated parsed document size</param>
+            myAdResolverEntryPool.setMemoryBudget(bytes);
+        },
+
+        setCompactParser: function (useCompactParser) {
+            ///<summary>Select the parser for XML strings: the single pass compact parser, or the DOMParser (default when available). Entries already created keep their documents.</summary>
+            ///<param name="params" type="Boolean">true to use the compact parser</param>
+            myUseCompactParser = (useCompactParser === true);
+        },
+
+        getStatistics: function () {
+            ///<summary>Get the memory usage and eviction counters of the AdResolverEntry pool and the query cache hit/miss counters</summary>
+            ///<returns type="Object">An object with properties: entryCount, residentCount, residentBytes, memoryBudget, sourceBytes, evictionCount, restoreCount, queryHitCount, queryMissCount</returns>
+            var statistics = myAdResolverEntryPool.getStatistics();
+
+            statistics.queryHitCount = myQueryHitCount;
+            statistics.queryMissCount = myQueryMissCount;
+            return statistics;
+        },
+
+        resetQueryStatistics: function () {
+            ///<summary>Reset the query cache hit/miss counters</summary>
+            myQueryHitCount = 0;
+            myQueryMissCount = 0;
+        },
+
+        // === JSON thunk ===
+        runJSON: function (paramsJSON) {
+            ///<summary>Invoke theAdResolver methods using a JSON string and returning the result as a JSON string.</summary>
+            ///<param name="paramsJSON" type="String">The method name and params expressed in a JSON string. There must be a top level property "func" string with the name of the method to invoke. Method params can either be all top level or within a containing "params" object. An optional top level "fields" array of dotted field paths limits the result to those fields.</param>
+            ///<returns type="String">The method results expressed is a JSON string. If an exception was thrown, a top level object "EXCEPTION" will contain standard Error fields.</returns>
+
+            var funcArray, params, result;
+
+            try {
+                params = JSON.parse(paramsJSON);
+
+                if (!params || (typeof params.func !== 'string')) {
+                    throw new PLAYER_SEQUENCER.AdResolverError('runJSON func property missing or not a string');
+                }
+
+                funcArray = params.func.split('.');
+                if (funcArray.length > 1) {
+                    if (params.params) {
+                        result = PLAYER_SEQUENCER.theAdResolver[funcArray[0]][funcArray[1]](params.params);
+                    }
+                    else {
+                        result = PLAYER_SEQUENCER.theAdResolver[funcArray[0]][funcArray[1]](params);
+                    }
+                } else {
+                    if (params.params) {
+                        result = PLAYER_SEQUENCER.theAdResolver[params.func](params.params);
+                    }
+                    else {
+                        result = PLAYER_SEQUENCER.theAdResolver[params.func](params);
+                    }
+                }
+
+            }
+            catch (ex) {
+                return PLAYER_SEQUENCER.exceptionToJSON(ex);
+            }
+            return PLAYER_SEQUENCER.stringifyResult(result, params.fields);
+        }
+    };
+
+    // Note: the memoized results are shared between calls, and frozen
+    myMemoizeQueries(publicAPI.vast, 'vast.', [
+        'getAdList',
+        'getCreativeList',
+        'getLinearTrackingEventsList',
+        'getVideoClicksList',
+        'getIconsList',
+        'getMediaFileList',
+        'getCompanionAdsList',
+        'getNonLinearAdsList'
+    ]);
+    myMemoizeQueries(publicAPI.vmap, 'vmap.', [
+        'getAdBreakList',
+        'getAdSource',
+        'getTrackingEventsList',
+        'getExtensionsList'
+    ]);
+    myMemoizeQueries(publicAPI, '', [
+        'getElementListFromPath'
+    ]);
+
+    return publicAPI;
+}());
+
+// -------------------------
+// The AdResolver wrapper chain resolver
+// -------------------------
+// Note: The purpose of this object is to resolve VAST Wrapper chains down to the InLine ads, and the AdTagURI
+//       sources of VMAP AdBreaks, with the fetches for independent Ads and AdBreaks issued concurrently.
+//       Fetches go through a pluggable function (XMLHttpRequest by default), duplicate in-flight requests for
+//       the same URI are coalesced and responses are cached for a TTL.
+//       Resolution is asynchronous: the resolve functions return a requestId and getResult is polled for the result
+//       (or the optional params.onComplete callback is invoked when called directly from JavaScript).
+//       The entry resolved and the entries created while resolving are pinned against the memory budget until the
+//       result is delivered: until onComplete returns, or until getResult returns the complete result.
+//       It is reached through theAdResolver so runJSON can invoke it as "chain.<method>".
+//
+PLAYER_SEQUENCER.theAdResolver.chain = (function () {
+"use strict";
+
+    // Note: Error codes are in VAST 3.0 spec: 2.4.2.3
+    var ERROR_XML_PARSING = 100,
+        ERROR_SCHEMA_VALIDATION = 101,
+        ERROR_WRAPPER_FETCH = 301,
+        ERROR_WRAPPER_LIMIT = 302,
+        ERROR_NO_ADS = 303,
+        myAdResolver = PLAYER_SEQUENCER.theAdResolver,
+        myFetchFunction = null,
+        myCacheTTL = 5 * 60 * 1000,     // milliseconds
+        myMaxWrapperDepth = 5,          // VAST 3.0 recommends a limit of 5 wrappers
+        myResponseCache = {},           // uri -> { text, expiryTime }
+        myInFlight = {},                // uri -> array of callbacks waiting for the response
+        myRequests = {},                // requestId -> request
+        myNextRequestId = 1,            // start with 1 so id is always truthy
+        myFetchCount = 0,
+        myCacheHitCount = 0,
+        myCoalescedCount = 0,
+        myFetchErrorCount = 0,
+
+    // private methods
+    myXMLHttpRequestFetch = function (uri, callback) {
+        ///<summary>The default fetch function, using an asynchronous XMLHttpRequest GET</summary>
+        var xhr;
+
+        if (typeof XMLHttpRequest === 'undefined') {
+            callback('no fetch function available');
+            return;
+        }
+        xhr = new XMLHttpRequest();
+        xhr.onreadystatechange = function () {
+            if (xhr.readyState === 4) {
+                if (xhr.status >= 200 && xhr.status < 300) {
+                    callback(null, xhr.responseText);
+                } else {
+                    callback('HTTP status ' + xhr.status.toString());
+                }
+            }
+        };
+        xhr.open('GET', uri, true);
+        xhr.send();
+    },
+
+    myFetch = function (uri, callback) {
+        ///<summary>Fetch a URI through the response cache, coalescing duplicate in-flight requests</summary>
+        ///<param name="uri" type="String">The URI to fetch</param>
+        ///<param name="callback" type="Function">function (error, text, isCached) invoked once with the response</param>
+        var cached = myResponseCache.hasOwnProperty(uri) ? myResponseCache[uri] : null,
+            fetchFunction = myFetchFunction || myXMLHttpRequestFetch,
+            isDone = false,
+            onResponse = function (error, text) {
+                var waiters = myInFlight[uri],
+                    i;
+
+                if (isDone) {
+                    return;
+                }
+                isDone = true;
+                delete myInFlight[uri];
+                if (error || typeof text !== 'string') {
+                    myFetchErrorCount += 1;
+                    error = error || 'empty response';
+                } else {
+                    myResponseCache[uri] = { text: text, expiryTime: Date.now() + myCacheTTL };
+                }
+                for (i = 0; i < waiters.length; i += 1) {
+                    waiters[i](error || null, text, false);
+                }
+            };
+
+        if (cached) {
+            if (cached.expiryTime > Date.now()) {
+                myCacheHitCount += 1;
+                callback(null, cached.text, true);
+                return;
+            }
+            delete myResponseCache[uri];
+        }
+        if (myInFlight.hasOwnProperty(uri)) {
+            myCoalescedCount += 1;
+            myInFlight[uri].push(callback);
+            return;
+        }
+        myInFlight[uri] = [callback];
+        myFetchCount += 1;
+        try {
+            fetchFunction(uri, onResponse);
+        }
+        catch (ex) {
+            onResponse(ex.message || String(ex));
+        }
+    },
+
+    myCreateRequest = function (params) {
+        var request = {
+            requestId: myNextRequestId,
+            maxWrapperDepth: (typeof params.maxWrapperDepth === 'number') ? params.maxWrapperDepth : myMaxWrapperDepth,
+            onComplete: (typeof params.onComplete === 'function') ? params.onComplete : null,
+            isComplete: false,
+            entryIds: [],           // AdResolverEntries created while resolving, to be released by the caller
+            pinnedEntryIds: [],     // AdResolverEntries kept from eviction until the result is delivered
+            errors: [],
+            startTime: Date.now(),
+            firstInlineTime: -1,
+            stages: []
+        };
+
+        myNextRequestId += 1;
+        myRequests[request.requestId] = request;
+        return request;
+    },
+
+    myPinEntry = function (request, entryId) {
+        ///<summary>Keep an AdResolverEntry of a request from being evicted by the memory budget until the result is delivered</summary>
+        myAdResolver.pinEntry(entryId);
+        request.pinnedEntryIds.push(entryId);
+    },
+
+    myUnpinEntries = function (request) {
+        var i;
+
+        for (i = 0; i < request.pinnedEntryIds.length; i += 1) {
+            try {
+                myAdResolver.unpinEntry(request.pinnedEntryIds[i]);
+            }
+            catch (ex) {
+                // already released by the application
+            }
+        }
+        request.pinnedEntryIds = [];
+    },
+
+    myCompleteRequest = function (request) {
+        request.isComplete = true;
+        request.totalTime = Date.now() - request.startTime;
+        if (request.onComplete) {
+            // direct JavaScript callers get the result now instead of polling getResult
+            delete myRequests[request.requestId];
+            try {
+                request.onComplete(PLAYER_SEQUENCER.theAdResolver.chain.getResultFromRequest(request));
+            }
+            finally {
+                myUnpinEntries(request);
+            }
+        }
+    },
+
+    myAddError = function (request, errorCode, message, entryId, adOrdinal, adBreakOrdinal) {
+        ///<summary>Record an error of a request, at an Ad (adOrdinal) or at a VMAP AdBreak (adBreakOrdinal) of entryId; the other ordinal is -1</summary>
+        request.errors.push({ errorCode: errorCode, message: message, entryId: entryId, adOrdinal: adOrdinal, adBreakOrdinal: (adBreakOrdinal === undefined) ? -1 : adBreakOrdinal });
+    },
+
+    myJoinWhenDone = function (count, callback) {
+        ///<summary>Collect count asynchronous array results in order and invoke callback with their concatenation</summary>
+        ///<returns type="Function">function (index) returning the completion function for the result at index</returns>
+        var results = [],
+            pending = count;
+
+        if (count === 0) {
+            callback([]);
+        }
+        return function (index) {
+            return function (result) {
+                var joined = [],
+                    i;
+
+                results[index] = result;
+                pending -= 1;
+                if (pending === 0) {
+                    for (i = 0; i < count; i += 1) {
+                        joined = joined.concat(results[i]);
+                    }
+                    callback(joined);
+                }
+            };
+        };
+    },
+
+    myResolveVASTEntry,
+    myResolveAdBreak,
+
+    myFetchAndResolveVAST = function (request, uri, depth, wrappers, errorEntryId, errorAdOrdinal, errorAdBreakOrdinal, callback) {
+        ///<summary>Fetch a VAST document, create its AdResolverEntry and resolve its ads. Errors are recorded at the Wrapper Ad or AdBreak of errorEntryId the URI came from.</summary>
+        var stage = { uri: uri, depth: depth, isCached: false, fetchTime: 0, parseTime: 0 },
+            fetchStartTime = Date.now();
+
+        request.stages.push(stage);
+        myFetch(uri, function (error, text, isCached) {
+            var parseStartTime,
+                entryId;
+
+            stage.isCached = isCached;
+            stage.fetchTime = Date.now() - fetchStartTime;
+            if (error) {
+                stage.error = String(error);
+                myAddError(request, ERROR_WRAPPER_FETCH, 'failed to fetch ' + uri + ': ' + stage.error, errorEntryId, errorAdOrdinal, errorAdBreakOrdinal);
+                callback([]);
+                return;
+            }
+            parseStartTime = Date.now();
+            try {
+                entryId = myAdResolver.vast.createEntry(text);
+            }
+            catch (ex) {
+                stage.parseTime = Date.now() - parseStartTime;
+                stage.error = String((ex && ex.message) || ex);
+                // Note: createEntry throws a parse error, or a path error for a VAST document without Ad
+                myAddError(request, (stage.error.indexOf('XML parse error') === 0) ? ERROR_XML_PARSING : ERROR_NO_ADS, stage.error, errorEntryId, errorAdOrdinal, errorAdBreakOrdinal);
+                callback([]);
+                return;
+            }
+            stage.parseTime = Date.now() - parseStartTime;
+            request.entryIds.push(entryId);
+            myPinEntry(request, entryId);
+            myResolveVASTEntry(request, entryId, depth, wrappers, callback);
+        });
+    },
+
+    myResolveWrapper = function (request, entryId, adOrdinal, depth, wrappers, callback) {
+        ///<summary>Follow the VASTAdTagURI of a Wrapper ad</summary>
+        var tagURIList,
+            uri;
+
+        if (depth >= request.maxWrapperDepth) {
+            myAddError(request, ERROR_WRAPPER_LIMIT, 'wrapper limit of ' + request.maxWrapperDepth.toString() + ' reached', entryId, adOrdinal);
+            callback([]);
+            return;
+        }
+        tagURIList = myAdResolver.getElementListFromPath({ entryId: entryId, path: ['VAST', 'Ad:' + adOrdinal.toString(), 'Wrapper'], nodeName: 'VASTAdTagURI' });
+        uri = (tagURIList.length > 0 && typeof tagURIList[0].value === 'string') ? tagURIList[0].value.replace(/^\s+|\s+$/g, '') : '';
+        if (!uri) {
+            myAddError(request, ERROR_SCHEMA_VALIDATION, 'Wrapper without VASTAdTagURI', entryId, adOrdinal);
+            callback([]);
+            return;
+        }
+        myFetchAndResolveVAST(request, uri, depth + 1, wrappers.concat([{ entryId: entryId, adOrdinal: adOrdinal }]), entryId, adOrdinal, -1, callback);
+    };
+
+    myResolveVASTEntry = function (request, entryId, depth, wrappers, callback) {
+        ///<summary>Resolve all the ads of a VAST AdResolverEntry to InLine ads, following Wrapper ads concurrently</summary>
+        ///<param name="callback" type="Function">function (ads) invoked with the array of resolved InLine ads, in document order</param>
+        var adList,
+            join,
+            wrapper,
+            i;
+
+        try {
+            adList = myAdResolver.vast.getAdList({ entryId: entryId });
+        }
+        catch (ex) {
+            myAddError(request, ERROR_NO_ADS, String((ex && ex.message) || ex), entryId, -1);
+            callback([]);
+            return;
+        }
+        if (wrappers.length > 0 && !adList.some(function (ad) { return ad.type === 'InLine' || ad.type === 'Wrapper'; })) {
+            // the response of a Wrapper has no Ad to play
+            wrapper = wrappers[wrappers.length - 1];
+            myAddError(request, ERROR_NO_ADS, 'no InLine or Wrapper Ad in the VAST response of the Wrapper', wrapper.entryId, wrapper.adOrdinal);
+        }
+
+        join = myJoinWhenDone(adList.length, callback);
+        for (i = 0; i < adList.length; i += 1) {
+            if (adList[i].type === 'InLine') {
+                if (request.firstInlineTime < 0) {
+                    request.firstInlineTime = Date.now() - request.startTime;
+                }
+                join(i)([{ entryId: entryId, adOrdinal: i, attrs: adList[i].parentAttrs || {}, wrappers: wrappers }]);
+            } else if (adList[i].type === 'Wrapper') {
+                myResolveWrapper(request, entryId, i, depth, wrappers, join(i));
+            } else {
+                join(i)([]);
+            }
+        }
+    };
+
+    myResolveAdBreak = function (request, entryId, adBreakOrdinal, callback) {
+        ///<summary>Resolve the AdSource of one AdBreak of a VMAP AdResolverEntry: inline VASTData or AdTagURI, down to its InLine ads</summary>
+        ///<param name="callback" type="Function">function (ads) invoked with the array of resolved InLine ads, in document order</param>
+        var sourceList,
+            tagURIList,
+            uri,
+            vastEntryId;
+
+        try {
+            sourceList = myAdResolver.vmap.getAdSource({ entryId: entryId, adBreakOrdinal: adBreakOrdinal });
+        }
+        catch (ex) {
+            // an AdBreak without AdSource has no ads to resolve
+            sourceList = [];
+        }
+        if (sourceList.length === 0) {
+            callback([]);
+        } else if (sourceList[0].type === 'VASTData') {
+            vastEntryId = myAdResolver.vmap.createVASTEntryFromAdBreak({ entryId: entryId, adBreakOrdinal: adBreakOrdinal });
+            request.entryIds.push(vastEntryId);
+            // Note: an entry created from VASTData has no source text, so it could not be restored once evicted
+            myPinEntry(request, vastEntryId);
+            myResolveVASTEntry(request, vastEntryId, 0, [], callback);
+        } else if (sourceList[0].type === 'AdTagURI') {
+            tagURIList = myAdResolver.getElementListFromPath({ entryId: entryId, path: ['VMAP', 'AdBreak:' + adBreakOrdinal.toString(), 'AdSource'], nodeName: 'AdTagURI' });
+            uri = (tagURIList.length > 0 && typeof tagURIList[0].value === 'string') ? tagURIList[0].value.replace(/^\s+|\s+$/g, '') : '';
+            if (!uri) {
+                myAddError(request, ERROR_SCHEMA_VALIDATION, 'AdSource without AdTagURI', entryId, -1, adBreakOrdinal);
+                callback([]);
+                return;
+            }
+            myFetchAndResolveVAST(request, uri, 0, [], entryId, -1, adBreakOrdinal, callback);
+        } else {
+            // CustomAdData is left to the application
+            callback([]);
+        }
+    };
+
+    return {
+        resolveVAST: function (params) {
+            ///<summary>Start resolving the Wrapper chains of a VAST AdResolverEntry down to its InLine ads</summary>
+            ///<param name="params" type="Object">An object with "entryId" (result of vast.createEntry), optional "maxWrapperDepth" and optional "onComplete" function (result)</param>
+            ///<returns type="Number">The requestId to pass to getResult</returns>
+            var request;
+
+            myAdResolver.vast.getAdList({ entryId: params.entryId }); // throws AdResolverError now if the entry is invalid
+            request = myCreateRequest(params);
+            myPinEntry(request, params.entryId);
+            request.ads = null;
+            myResolveVASTEntry(request, params.entryId, 0, [], function (ads) {
+                request.ads = ads;
+                myCompleteRequest(request);
+            });
+            return request.requestId;
+        },
+
+        resolveVMAP: function (params) {
+            ///<summary>Start resolving all the AdBreaks of a VMAP AdResolverEntry: inline VASTData and AdTagURI sources, each down to its InLine ads</summary>
+            ///<param name="params" type="Object">An object with "entryId" (result of vmap.createEntry), optional "maxWrapperDepth" and optional "onComplete" function (result)</param>
+            ///<returns type="Number">The requestId to pass to getResult</returns>
+            var adBreakList = myAdResolver.vmap.getAdBreakList({ entryId: params.entryId }), // throws AdResolverError now if the entry is invalid
+                request = myCreateRequest(params),
+                pending = adBreakList.length,
+                resolveAdBreak = function (adBreakOrdinal) {
+                    var adBreak = { adBreakOrdinal: adBreakOrdinal, attrs: adBreakList[adBreakOrdinal].attrs || {}, ads: [] };
+
+                    request.adBreaks[adBreakOrdinal] = adBreak;
+                    myResolveAdBreak(request, params.entryId, adBreakOrdinal, function (ads) {
+                        adBreak.ads = ads;
+                        pending -= 1;
+                        if (pending === 0) {
+                            myCompleteRequest(request);
+                        }
+                    });
+                },
+                i;
+
+            myPinEntry(request, params.entryId);
+            request.adBreaks = [];
+            if (pending === 0) {
+                myCompleteRequest(request);
+            }
+            for (i = 0; i < adBreakList.length; i += 1) {
+                resolveAdBreak(i);
+            }
+            return request.requestId;
+        },
+
+        resolveAdBreak: function (params) {
+            ///<summary>Start resolving the AdSource of a single AdBreak of a VMAP AdResolverEntry down to its InLine ads</summary>
+            ///<param name="params" type="Object">An object with "entryId" (result of vmap.createEntry), "adBreakOrdinal" (index into AdBreakList), optional "maxWrapperDepth" and optional "onComplete" function (result)</param>
+            ///<returns type="Number">The requestId to pass to getResult</returns>
+            var adBreakOrdinal = params.adBreakOrdinal || 0,
+                request;
+
+            myAdResolver.vmap.getAdBreakList({ entryId: params.entryId }); // throws AdResolverError now if the entry is invalid
+            request = myCreateRequest(params);
+            myPinEntry(request, params.entryId);
+            request.ads = null;
+            myResolveAdBreak(request, params.entryId, adBreakOrdinal, function (ads) {
+                request.ads = ads;
+                myCompleteRequest(request);
+            });
+            return request.requestId;
+        },
+
+        getResult: function (params) {
+            ///<summary>Get the state of a resolve request. Once a complete result has been returned the request is forgotten.</summary>
+            ///<param name="params" type="Object">An object with "requestId" (result of resolveVAST or resolveVMAP)</param>
+            ///<returns type="Object">An object with properties: requestId, isComplete and when complete: ads (resolveVAST, resolveAdBreak) or adBreaks (resolveVMAP) of { entryId, adOrdinal, attrs, wrappers: [{ entryId, adOrdinal }] }, entryIds (created entries to release), errors of { errorCode, message, entryId, adOrdinal, adBreakOrdinal } and timings</returns>
+            var request = myRequests.hasOwnProperty(params.requestId) ? myRequests[params.requestId] : null;
+
+            if (!request) {
+                throw new PLAYER_SEQUENCER.AdResolverError('invalid chain.getResult requestId: ' + String(params.requestId));
+            }
+            if (!request.isComplete) {
+                return { requestId: request.requestId, isComplete: false };
+            }
+            delete myRequests[request.requestId];
+            myUnpinEntries(request);
+            return PLAYER_SEQUENCER.theAdResolver.chain.getResultFromRequest(request);
+        },
+
+        getResultFromRequest: function (request) {
+            ///<summary>For internal use: build the result object of a completed request</summary>
+            var result = {
+                requestId: request.requestId,
+                isComplete: true,
+                entryIds: request.entryIds,
+                errors: request.errors,
+                timings: {
+                    totalTime: request.totalTime,
+                    firstInlineTime: request.firstInlineTime,
+                    stages: request.stages
+                }
+            };
+
+            if (request.adBreaks) {
+                result.adBreaks = request.adBreaks;
+            } else {
+                result.ads = request.ads;
+            }
+            return result;
+        },
+
+        setFetchFunction: function (fetchFunction) {
+            ///<summary>Set the function used to fetch VAST documents, or null for the default XMLHttpRequest fetch</summary>
+            ///<param name="fetchFunction" type="Function">function (uri, callback) which must invoke callback(error, text) once</param>
+            myFetchFunction = (typeof fetchFunction === 'function') ? fetchFunction : null;
+        },
+
+        setCacheTTL: function (milliseconds) {
+            ///<summary>Set how long fetched responses are cached</summary>
+            ///<param name="params" type="Number">The time to live in milliseconds; 0 disables caching</param>
+            myCacheTTL = milliseconds;
+        },
+
+        setMaxWrapperDepth: function (depth) {
+            ///<summary>Set the default maximum number of Wrapper ads followed in a chain</summary>
+            ///<param name="params" type="Number">The maximum wrapper depth</param>
+            myMaxWrapperDepth = depth;
+        },
+
+        clearCache: function () {
+            ///<summary>Drop all cached responses</summary>
+            myResponseCache = {};
+        },
+
+        getStatistics: function () {
+            ///<summary>Get the fetch counters</summary>
+            ///<returns type="Object">An object with properties: fetchCount, cacheHitCount, coalescedCount, fetchErrorCount, inFlightCount, pendingRequestCount</returns>
+            var inFlightCount = 0,
+                pendingRequestCount = 0,
+                key;
+
+            for (key in myInFlight) {
+                if (myInFlight.hasOwnProperty(key)) {
+                    inFlightCount += 1;
+                }
+            }
+            for (key in myRequests) {
+                if (myRequests.hasOwnProperty(key) && !myRequests[key].isComplete) {
+                    pendingRequestCount += 1;
+                }
+            }
+            return {
+                fetchCount: myFetchCount,
+                cacheHitCount: myCacheHitCount,
+                coalescedCount: myCoalescedCount,
+                fetchErrorCount: myFetchErrorCount,
+                inFlightCount: inFlightCount,
+                pendingRequestCount: pendingRequestCount
+            };
+        }
+    };
+}());
+
+// -------------------------
+// The AdResolver lazy VMAP compiler
+// -------------------------
+// Note: The purpose of this object is to turn a VMAP AdResolverEntry into a schedule without resolving any ads up front.
+//       compile schedules one 'VAST' placeholder clip per AdBreak, taking no linear time and with a rendering range of
+//       PLACEHOLDER_RENDERING_DURATION (the smallest the scheduler accepts): 'Pre' for timeOffset "start", 'Post' for
+//       "end" and 'Mid' for a time or percentage offset. AdBreaks sharing a timeOffset follow each other as a pod in
+//       document order. advance is called with the playback position (for example from the periodic tick) and each
+//       AdBreak which comes within the lookahead window is resolved through the chain resolver; its InLine ads (the ad
+//       pod in sequence order, else the first stand-alone ad) are then scheduled after the placeholder, which is removed.
+//       An AdBreak which resolves to no ad clip because of errors is 'failed' and its placeholder is removed.
+//       A pending AdBreak which advance finds behind the playback position (passed by a forward seek, or before the
+//       compile linearPosition) is 'skipped' and its placeholder is removed: it is never resolved.
+//       A placeholder reached before it is expanded plays as an unresolved 'VAST' clip the application should skip.
+//       The VMAP AdResolverEntry is pinned against the memory budget from compile until release.
+//       It is reached through theAdResolver so runJSON can invoke it as "compiler.<method>".
+//
+PLAYER_SEQUENCER.theAdResolver.compiler = (function () {
+"use strict";
+
+    var PLACEHOLDER_RENDERING_DURATION = 1.0,  // the smallest rendering range the scheduler accepts
+        myAdResolver = PLAYER_SEQUENCER.theAdResolver,
+        myLookahead = 30,               // seconds
+        myCompilations = {},            // compileId -> compilation
+        myNextCompileId = 1,            // start with 1 so id is always truthy
+        myMediaFileSelector = null,
+        myCompiledBreakCount = 0,
+        myResolvedBreakCount = 0,
+        mySkippedBreakCount = 0,
+        myFailedBreakCount = 0,
+        myExpandedClipCount = 0,
+
+    // private methods
+    myToPlaylistTime = function (seconds) {
+        ///<summary>Convert seconds to the time representation of the sequential playlist</summary>
+        ///<returns type="Number">The time in seconds, or in whole ticks with an integer timescale</returns>
+        var timescale = PLAYER_SEQUENCER.sequentialPlaylist.access.getTimescale();
+
+        return (timescale > 0) ? Math.round(seconds * timescale) : seconds;
+    },
+
+    myParseClockTime = function (text) {
+        ///<summary>Parse a VAST/VMAP "HH:MM:SS" or "HH:MM:SS.mmm" time</summary>
+        ///<returns type="Number">The time in the sequential playlist representation (seconds or ticks), NaN if invalid</returns>
+        var match = /^\s*(\d+):(\d+):(\d+(\.\d*)?)\s*$/.exec(text || '');
+
+        if (!match) {
+            return NaN;
+        }
+        return myToPlaylistTime(Number(match[1]) * 3600 + Number(match[2]) * 60 + Number(match[3]));
+    },
+
+    myPositionFromTimeOffset = function (timeOffset, contentDuration) {
+        ///<summary>Map a VMAP AdBreak timeOffset to the scheduler roll type and linear position</summary>
+        ///<returns type="Object" mayBeNull="true">An object with eRollType and linearTime, null if the timeOffset is not supported</returns>
+        var linearTime,
+            match;
+
+        if (timeOffset === 'start') {
+            return { eRollType: 'Pre', linearTime: 0 };
+        }
+        if (timeOffset === 'end') {
+            return { eRollType: 'Post', linearTime: contentDuration };
+        }
+        match = /^\s*(\d+(\.\d*)?)%\s*$/.exec(timeOffset || '');
+        linearTime = match ? contentDuration * Number(match[1]) / 100 : myParseClockTime(timeOffset);
+        if (match && PLAYER_SEQUENCER.sequentialPlaylist.access.getTimescale() > 0) {
+            linearTime = Math.round(linearTime);
+        }
+        if (isNaN(linearTime)) {
+            // Note: positional ("#n") offsets are not supported
+            return null;
+        }
+        if (linearTime <= 0) {
+            return { eRollType: 'Pre', linearTime: 0 };
+        }
+        if (linearTime >= contentDuration) {
+            return { eRollType: 'Post', linearTime: contentDuration };
+        }
+        return { eRollType: 'Mid', linearTime: linearTime };
+    },
+
+    myGetCompilation = function (compileId, callerName) {
+        if (!myCompilations.hasOwnProperty(compileId)) {
+            throw new PLAYER_SEQUENCER.AdResolverError('invalid compiler.' + callerName + ' compileId: ' + String(compileId));
+        }
+        return myCompilations[compileId];
+    },
+
+    myIsScheduled = function (playlistEntryId) {
+        try {
+            PLAYER_SEQUENCER.sequentialPlaylist.access.getEntryFromId(playlistEntryId);
+            return true;
+        }
+        catch (ex) {
+            return false;
+        }
+    },
+
+    myReleaseEntries = function (adBreak) {
+        var i;
+
+        for (i = 0; i < adBreak.entryIds.length; i += 1) {
+            try {
+                myAdResolver.releaseEntry(adBreak.entryIds[i]);
+            }
+            catch (ex) {
+                // already released by the application
+            }
+        }
+        adBreak.entryIds = [];
+    },
+
+    mySelectMediaFile = function (mediaFileList) {
+        ///<summary>The default MediaFile selection: the first MediaFile with a URI</summary>
+        var i;
+
+        for (i = 0; i < mediaFileList.length; i += 1) {
+            if (typeof mediaFileList[i].value === 'string' && mediaFileList[i].value.replace(/^\s+|\s+$/g, '')) {
+                return mediaFileList[i];
+            }
+        }
+        return null;
+    },
+
+    mySelectAds = function (ads) {
+        ///<summary>Select the ads to play: the ad pod in sequence order if there is one, else the first stand-alone ad (VAST 3.0 spec: 2.3.2.2)</summary>
+        var pod = [],
+            i;
+
+        for (i = 0; i < ads.length; i += 1) {
+            if (ads[i].attrs.sequence !== undefined && !isNaN(Number(ads[i].attrs.sequence))) {
+                pod.push(ads[i]);
+            }
+        }
+        if (pod.length > 0) {
+            return pod.sort(function (a, b) {
+                return Number(a.attrs.sequence) - Number(b.attrs.sequence);
+            });
+        }
+        return ads.slice(0, 1);
+    },
+
+    myCreateClipParams = function (ad, deleteAfterPlay) {
+        ///<summary>Create the scheduleClip params for the Linear creative of a resolved InLine ad</summary>
+        ///<returns type="Object">The params for a 'Pod' clip; appendTo is filled in by the caller. Throws AdResolverError if the ad has no playable Linear creative.</returns>
+        var creativeList = myAdResolver.vast.getCreativeList({ entryId: ad.entryId, adOrdinal: ad.adOrdinal, adType: 'InLine' }),
+            creativeOrdinal,
+            mediaFile,
+            durationList,
+            duration,
+            params;
+
+        for (creativeOrdinal = 0; creativeOrdinal < creativeList.length; creativeOrdinal += 1) {
+            if (creativeList[creativeOrdinal].type === 'Linear') {
+                break;
+            }
+        }
+        if (creativeOrdinal === creativeList.length) {
+            throw new PLAYER_SEQUENCER.AdResolverError('no Linear creative');
+        }
+        mediaFile = (myMediaFileSelector || mySelectMediaFile)(myAdResolver.vast.getMediaFileList({ entryId: ad.entryId, adOrdinal: ad.adOrdinal, creativeOrdinal: creativeOrdinal }));
+        if (!mediaFile) {
+            throw new PLAYER_SEQUENCER.AdResolverError('no MediaFile selected');
+        }
+        durationList = myAdResolver.getElementListFromPath({
+            entryId: ad.entryId,
+            path: ['VAST', 'Ad:' + ad.adOrdinal.toString(), 'InLine', 'Creatives', 'Creative:' + creativeOrdinal.toString(), 'Linear'],
+            nodeName: 'Duration'
+        });
+        duration = (durationList.length > 0) ? myParseClockTime(durationList[0].value) : NaN;
+        if (isNaN(duration)) {
+            throw new PLAYER_SEQUENCER.AdResolverError('invalid Linear Duration');
+        }
+
+        params = PLAYER_SEQUENCER.scheduler.createScheduleClipParams();
+        params.clipURI = mediaFile.value.replace(/^\s+|\s+$/g, '');
+        params.eClipType = 'Media';
+        params.minManifestPosition = 0;
+        params.maxManifestPosition = duration;
+        params.deleteAfterPlay = deleteAfterPlay;
+        params.eRollType = 'Pod';
+        return params;
+    },
+
+    myExpandAdBreak = function (compilation, adBreak, result) {
+        ///<summary>Replace the placeholder of a resolved AdBreak with clips for its ads</summary>
+        var ads,
+            params,
+            appendTo = adBreak.placeholderId,
+            i;
+
+        adBreak.requestId = 0;
+        adBreak.entryIds = result.entryIds;
+        adBreak.errors = adBreak.errors.concat(result.errors);
+        if (!myCompilations.hasOwnProperty(compilation.compileId) || !myIsScheduled(adBreak.placeholderId)) {
+            // the compilation was released or the placeholder was played or removed while resolving
+            adBreak.state = 'skipped';
+            mySkippedBreakCount += 1;
+            myReleaseEntries(adBreak);
+            return;
+        }
+
+        ads = mySelectAds(result.ads);
+        for (i = 0; i < ads.length; i += 1) {
+            try {
+                params = myCreateClipParams(ads[i], compilation.deleteAfterPlay);
+                params.appendTo = appendTo;
+                appendTo = PLAYER_SEQUENCER.scheduler.scheduleClip(params).id;
+                adBreak.playlistEntryIds.push(appendTo);
+            }
+            catch (ex) {
+                adBreak.errors.push({ errorCode: 0, message: String((ex && ex.message) || ex), entryId: ads[i].entryId, adOrdinal: ads[i].adOrdinal, adBreakOrdinal: -1 });
+            }
+        }
+        PLAYER_SEQUENCER.scheduler.removeClip({ playlistEntryId: adBreak.placeholderId });
+        if (adBreak.playlistEntryIds.length === 0 && adBreak.errors.length > 0) {
+            // nothing to play: the fetch, the parse or every ad failed
+            adBreak.state = 'failed';
+            myFailedBreakCount += 1;
+            myReleaseEntries(adBreak);
+            return;
+        }
+        adBreak.state = 'expanded';
+        myResolvedBreakCount += 1;
+        myExpandedClipCount += adBreak.playlistEntryIds.length;
+    },
+
+    myResolveAdBreak = function (compilation, adBreak) {
+        var requestId = myAdResolver.chain.resolveAdBreak({
+                entryId: compilation.entryId,
+                adBreakOrdinal: adBreak.adBreakOrdinal,
+                onComplete: function (result) {
+                    myExpandAdBreak(compilation, adBreak, result);
+                }
+            });
+
+        if (adBreak.state === 'pending') {
+            // still resolving: onComplete was not invoked within resolveAdBreak (inline VASTData or a cached response)
+            adBreak.state = 'resolving';
+            adBreak.requestId = requestId;
+        }
+    },
+
+    myFailAdBreak = function (compilation, adBreak, ex) {
+        ///<summary>Mark an AdBreak whose resolution could not be started as failed, removing its placeholder</summary>
+        adBreak.errors.push({ errorCode: 0, message: String((ex && ex.message) || ex), entryId: compilation.entryId, adOrdinal: -1, adBreakOrdinal: adBreak.adBreakOrdinal });
+        adBreak.state = 'failed';
+        adBreak.requestId = 0;
+        myFailedBreakCount += 1;
+        if (myIsScheduled(adBreak.placeholderId)) {
+            PLAYER_SEQUENCER.scheduler.removeClip({ playlistEntryId: adBreak.placeholderId });
+        }
+        myReleaseEntries(adBreak);
+    },
+
+    myCopyAdBreak = function (adBreak) {
+        return {
+            adBreakOrdinal: adBreak.adBreakOrdinal,
+            breakId: adBreak.breakId,
+            timeOffset: adBreak.timeOffset,
+            eRollType: adBreak.eRollType,
+            linearTime: adBreak.linearTime,
+            state: adBreak.state,
+            placeholderId: adBreak.placeholderId,
+            playlistEntryIds: adBreak.playlistEntryIds.slice(0),
+            entryIds: adBreak.entryIds.slice(0),
+            errors: adBreak.errors.slice(0)
+        };
+    };
+
+    return {
+        compile: function (params) {
+            ///<summary>Schedule a placeholder clip for each AdBreak of a VMAP AdResolverEntry, then resolve those already within the lookahead window. The VMAP AdResolverEntry is pinned until release. Must not be called until main content has been scheduled.</summary>
+            ///<param name="params" type="Object">An object with "entryId" (result of vmap.createEntry), optional "linearPosition" (playback start position in linear time, default 0), optional "lookahead" (seconds, converted to ticks after scheduler.setTimescale; default setLookahead value) and optional "deleteAfterPlay" (for the ad clips, default true)</param>
+            ///<returns type="Object">An object with properties: compileId and adBreaks (as getStatus)</returns>
+            var adBreakList = myAdResolver.vmap.getAdBreakList({ entryId: params.entryId }), // throws AdResolverError now if the entry is invalid
+                contentDuration = PLAYER_SEQUENCER.sequentialPlaylist.access.getPlaylistLinearDuration(),
+                compilation = {
+                    compileId: myNextCompileId,
+                    entryId: params.entryId,
+                    lookahead: myToPlaylistTime((typeof params.lookahead === 'number') ? params.lookahead : myLookahead),
+                    deleteAfterPlay: params.deleteAfterPlay !== false,
+                    adBreaks: []
+                },
+                podTails = {},          // timeOffset position -> id of the last placeholder scheduled there
+                adBreak,
+                attrs,
+                position,
+                podKey,
+                clipParams,
+                i;
+
+            myNextCompileId += 1;
+            for (i = 0; i < adBreakList.length; i += 1) {
+                attrs = adBreakList[i].attrs || {};
+                adBreak = {
+                    adBreakOrdinal: i,
+                    breakId: attrs.breakId,
+                    timeOffset: attrs.timeOffset,
+                    eRollType: null,
+                    linearTime: -1,
+                    state: 'failed',
+                    placeholderId: -1,
+                    requestId: 0,
+                    playlistEntryIds: [],
+                    entryIds: [],
+                    errors: []
+                };
+                compilation.adBreaks.push(adBreak);
+
+                position = myPositionFromTimeOffset(attrs.timeOffset, contentDuration);
+                if (!position) {
+                    adBreak.errors.push({ errorCode: 0, message: 'unsupported timeOffset: ' + String(attrs.timeOffset), entryId: params.entryId, adOrdinal: -1, adBreakOrdinal: i });
+                    continue;
+                }
+                adBreak.eRollType = position.eRollType;
+                adBreak.linearTime = position.linearTime;
+
+                clipParams = PLAYER_SEQUENCER.scheduler.createScheduleClipParams();
+                clipParams.clipURI = '';
+                clipParams.eClipType = 'VAST';
+                clipParams.minManifestPosition = 0;
+                clipParams.maxManifestPosition = myToPlaylistTime(PLACEHOLDER_RENDERING_DURATION);
+                clipParams.deleteAfterPlay = true;
+                clipParams.startTime = position.linearTime;
+                podKey = position.eRollType + ':' + position.linearTime.toString();
+                if (podTails.hasOwnProperty(podKey)) {
+                    clipParams.eRollType = 'Pod';
+                    clipParams.appendTo = podTails[podKey];
+                } else {
+                    clipParams.eRollType = position.eRollType;
+                }
+                try {
+                    adBreak.placeholderId = PLAYER_SEQUENCER.scheduler.scheduleClip(clipParams).id;
+                }
+                catch (ex) {
+                    adBreak.errors.push({ errorCode: 0, message: String((ex && ex.message) || ex), entryId: params.entryId, adOrdinal: -1, adBreakOrdinal: i });
+                    continue;
+                }
+                podTails[podKey] = adBreak.placeholderId;
+                adBreak.state = 'pending';
+                myCompiledBreakCount += 1;
+            }
+
+            myCompilations[compilation.compileId] = compilation;
+            myAdResolver.pinEntry(compilation.entryId);
+            PLAYER_SEQUENCER.theAdResolver.compiler.advance({ linearPosition: params.linearPosition || 0 });
+            return PLAYER_SEQUENCER.theAdResolver.compiler.getStatus({ compileId: compilation.compileId });
+        },
+
+        advance: function (params) {
+            ///<summary>Start resolving every pending AdBreak whose position is within the lookahead window ahead of the playback position. Should be called as playback progresses and after seeks.
+            ///A pending AdBreak behind the playback position is skipped: its placeholder is removed and it is never resolved.
+            ///An AdBreak whose resolution cannot be started is failed, with the error recorded, and the other AdBreaks are still advanced.</summary>
+            ///<param name="params" type="Object">An object with "linearPosition" (the current playback position in linear time)</param>
+            ///<returns type="Number">The number of AdBreaks whose resolution was started</returns>
+            var compilation,
+                adBreak,
+                startedCount = 0,
+                compileId,
+                i;
+
+            for (compileId in myCompilations) {
+                if (myCompilations.hasOwnProperty(compileId)) {
+                    compilation = myCompilations[compileId];
+                    for (i = 0; i < compilation.adBreaks.length; i += 1) {
+                        adBreak = compilation.adBreaks[i];
+                        if (adBreak.state === 'pending' && adBreak.linearTime < params.linearPosition) {
+                            // passed without being resolved, by a forward seek or a start position beyond it
+                            adBreak.state = 'skipped';
+                            mySkippedBreakCount += 1;
+                            if (myIsScheduled(adBreak.placeholderId)) {
+                                PLAYER_SEQUENCER.scheduler.removeClip({ playlistEntryId: adBreak.placeholderId });
+                            }
+                        } else if (adBreak.state === 'pending' &&
+                            adBreak.linearTime >= params.linearPosition &&
+                            adBreak.linearTime <= params.linearPosition + compilation.lookahead) {
+                            try {
+                                myResolveAdBreak(compilation, adBreak);
+                                startedCount += 1;
+                            }
+                            catch (ex) {
+                                // one AdBreak failing, for example because the application released the VMAP entry, does not stop the others
+                                myFailAdBreak(compilation, adBreak, ex);
+                            }
+                        }
+                    }
+                }
+            }
+            return startedCount;
+        },
+
+        getStatus: function (params) {
+            ///<summary>Get the state of each AdBreak of a compilation</summary>
+            ///<param name="params" type="Object">An object with "compileId" (result of compile)</param>
+            ///<returns type="Object">An object with properties: compileId and adBreaks, an array in AdBreak order of { adBreakOrdinal, breakId, timeOffset, eRollType, linearTime, state ('pending', 'resolving', 'expanded', 'skipped' or 'failed'), placeholderId, playlistEntryIds (the ad clips scheduled), entryIds (AdResolverEntries held for the ads), errors }</returns>
+            var compilation = myGetCompilation(params.compileId, 'getStatus'),
+                adBreaks = [],
+                i;
+
+            for (i = 0; i < compilation.adBreaks.length; i += 1) {
+                adBreaks.push(myCopyAdBreak(compilation.adBreaks[i]));
+            }
+            return { compileId: compilation.compileId, adBreaks: adBreaks };
+        },
+
+        release: function (params) {
+            ///<summary>Forget a compilation: the placeholders not yet expanded are removed from the schedule, the VMAP AdResolverEntry is unpinned and the AdResolverEntries held for its ads are released. Scheduled ad clips are left in place.</summary>
+            ///<param name="params" type="Object">An object with "compileId" (result of compile)</param>
+            var compilation = myGetCompilation(params.compileId, 'release'),
+                adBreak,
+                i;
+
+            delete myCompilations[compilation.compileId];
+            try {
+                myAdResolver.unpinEntry(compilation.entryId);
+            }
+            catch (ex) {
+                // already released by the application
+            }
+            for (i = 0; i < compilation.adBreaks.length; i += 1) {
+                adBreak = compilation.adBreaks[i];
+                if ((adBreak.state === 'pending' || adBreak.state === 'resolving') && myIsScheduled(adBreak.placeholderId)) {
+                    PLAYER_SEQUENCER.scheduler.removeClip({ playlistEntryId: adBreak.placeholderId });
+                }
+                myReleaseEntries(adBreak);
+            }
+        },
+
+        setLookahead: function (seconds) {
+            ///<summary>Set the default lookahead window for compilations</summary>
+            ///<param name="seconds" type="Number">How far ahead of the playback position an AdBreak is resolved, in seconds even after scheduler.setTimescale (compile converts it to ticks)</param>
+            myLookahead = seconds;
+        },
+
+        setMediaFileSelector: function (selector) {
+            ///<summary>Set the function choosing the MediaFile of an ad, or null for the first MediaFile with a URI</summary>
+            ///<param name="selector" type="Function">function (mediaFileList) returning one of the getMediaFileList objects, or null if none is playable. The list is frozen; copy it to sort it.</param>
+            myMediaFileSelector = (typeof selector === 'function') ? selector : null;
+        },
+
+        getStatistics: function () {
+            ///<summary>Get the compiler counters</summary>
+            ///<returns type="Object">An object with properties: compilationCount, compiledBreakCount, resolvedBreakCount, skippedBreakCount, failedBreakCount, expandedClipCount</returns>
+            var compilationCount = 0,
+                key;
+
+            for (key in myCompilations) {
+                if (myCompilations.hasOwnProperty(key)) {
+                    compilationCount += 1;
+                }
+            }
+            return {
+                compilationCount: compilationCount,
+                compiledBreakCount: myCompiledBreakCount,
+                resolvedBreakCount: myResolvedBreakCount,
+                skippedBreakCount: mySkippedBreakCount,
+                failedBreakCount: myFailedBreakCount,
+                expandedClipCount: myExpandedClipCount
+            };
+        }
+    };
+}());
@@ -0,0 +1,244 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which checks the wrapper chain resolver of AdResolver.js
+// (theAdResolver.chain) against an in-memory ad server: a fetch function answering from a map of VAST documents
+// after a per-URI delay of a simulated clock, which is also the Date.now of the context:
+//     coalescing      Wrapper ads following the same URI share one fetch, and a later request is served from the cache
+//     stageTimings    the fetch time and depth of each stage, totalTime and firstInlineTime of a two-Wrapper chain,
+//                     polled through getResult
+//     wrapperLoop     Wrappers following each other end with error 302 at the wrapper limit
+//     depthLimit      the maxWrapperDepth of a request and the default of setMaxWrapperDepth
+//     cacheTTL        a cached response expires after the setCacheTTL time, and a TTL of 0 disables the cache
+//     fetchError      a failed fetch is error 301 at the Wrapper ad
+//
+// Usage: node AdResolverChainCheck.js
+//
+// The exit code is 1 if any check fails.
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    ERROR_WRAPPER_FETCH = 301,
+    ERROR_WRAPPER_LIMIT = 302,
+
+    createInline = function (id) {
+        return '<VAST version="3.0"><Ad id="' + id + '"><InLine><AdSystem>s</AdSystem><Creatives><Creative><Linear><Duration>00:00:15</Duration>' +
+            '<MediaFiles><MediaFile type="video/mp4"><![CDATA[http://example.com/' + id + '.mp4]]></MediaFile></MediaFiles></Linear></Creative></Creatives>' +
+            '</InLine></Ad></VAST>';
+    },
+
+    createWrapper = function (uris) {
+        ///<returns type="String">A VAST document with one Wrapper ad per URI</returns>
+        return '<VAST version="3.0">' + uris.map(function (uri, i) {
+            return '<Ad id="wrapper-' + i.toString() + '"><Wrapper><AdSystem>s</AdSystem><VASTAdTagURI><![CDATA[' + uri + ']]></VASTAdTagURI></Wrapper></Ad>';
+        }).join('') + '</VAST>';
+    },
+
+    createContext = function (documents) {
+        ///<summary>Load the core scripts into a fresh context with a simulated clock and set the chain fetch function to an in-memory ad server</summary>
+        ///<param name="documents" type="Object">uri -> { text, delay (milliseconds) }; other URIs fail with HTTP status 404</param>
+        ///<returns type="Object">An object with: adResolver, chain, fetchedURIs, clock ({ time } in milliseconds), advance (function (milliseconds) delivering the responses due)</returns>
+        var clock = { time: 0 },
+            pending = [],       // { dueTime, uri, callback }
+            context = {
+                clock: clock,
+                fetchedURIs: [],
+                adResolver: harness.loadScripts(harness.CORE_SCRIPTS, {
+                    hasDOMParser: true,
+                    globals: { Date: { now: function () { return clock.time; } } }
+                }).theAdResolver,
+                advance: function (milliseconds) {
+                    var stopTime = clock.time + milliseconds,
+                        response;
+
+                    pending.sort(function (a, b) { return a.dueTime - b.dueTime; });
+                    while (pending.length > 0 && pending[0].dueTime <= stopTime) {
+                        response = pending.shift();
+                        clock.time = response.dueTime;
+                        if (documents.hasOwnProperty(response.uri)) {
+                            response.callback(null, documents[response.uri].text);
+                        } else {
+                            response.callback('HTTP status 404');
+                        }
+                        // a response may start fetches due before stopTime
+                        pending.sort(function (a, b) { return a.dueTime - b.dueTime; });
+                    }
+                    clock.time = stopTime;
+                }
+            };
+
+        context.chain = context.adResolver.chain;
+        context.chain.setFetchFunction(function (uri, callback) {
+            context.fetchedURIs.push(uri);
+            pending.push({ dueTime: clock.time + (documents.hasOwnProperty(uri) ? documents[uri].delay : 10), uri: uri, callback: callback });
+        });
+        return context;
+    },
+
+    CHECKS = {
+        coalescing: function (expect) {
+            var context = createContext({ 'http://ads.example.com/inline': { text: createInline('shared'), delay: 100 } }),
+                rootText = createWrapper(['http://ads.example.com/inline', 'http://ads.example.com/inline', 'http://ads.example.com/inline']),
+                result = null,
+                statistics;
+
+            context.chain.resolveVAST({ entryId: context.adResolver.vast.createEntry(rootText), onComplete: function (r) { result = r; } });
+            statistics = context.chain.getStatistics();
+            expect(statistics.fetchCount === 1 && statistics.coalescedCount === 2 && statistics.inFlightCount === 1, 'three Wrappers, one fetch: ' + JSON.stringify(statistics));
+            expect(result === null && statistics.pendingRequestCount === 1, 'no result before the response');
+
+            context.advance(100);
+            expect(result !== null && result.ads.length === 3, 'the three Wrappers resolved to the shared InLine ad');
+            expect(result !== null && result.ads.every(function (ad) { return ad.wrappers.length === 1; }), 'each InLine ad has its Wrapper');
+            expect(result !== null && result.entryIds.length === 3, 'each stage parsed the shared response into an entry to release');
+            expect(result !== null && result.timings.stages.every(function (stage) { return !stage.isCached && stage.fetchTime === 100; }),
+                'every coalesced stage waited for the one response');
+
+            result = null;
+            context.chain.resolveVAST({ entryId: context.adResolver.vast.createEntry(rootText), onComplete: function (r) { result = r; } });
+            statistics = context.chain.getStatistics();
+            expect(statistics.fetchCount === 1 && statistics.cacheHitCount === 3, 'a second request is served from the cache: ' + JSON.stringify(statistics));
+            expect(result !== null && result.ads.length === 3 && result.timings.stages.every(function (stage) { return stage.isCached && stage.fetchTime === 0; }),
+                'a request served from the cache completes at once');
+        },
+
+        stageTimings: function (expect) {
+            var context = createContext({
+                    'http://ads.example.com/first': { text: createWrapper(['http://ads.example.com/second']), delay: 50 },
+                    'http://ads.example.com/second': { text: createInline('chained'), delay: 70 }
+                }),
+                requestId = context.chain.resolveVAST({ entryId: context.adResolver.vast.createEntry(createWrapper(['http://ads.example.com/first'])) }),
+                result;
+
+            context.advance(60);
+            result = context.chain.getResult({ requestId: requestId });
+            expect(!result.isComplete && context.chain.getStatistics().pendingRequestCount === 1, 'the request is pending during the second fetch');
+
+            context.advance(100);
+            result = context.chain.getResult({ requestId: requestId });
+            expect(result.isComplete && result.ads.length === 1 && result.ads[0].wrappers.length === 2, 'the InLine ad is reached through two Wrappers');
+            expect(result.errors.length === 0, 'no error');
+            expect(result.timings.stages.length === 2 &&
+                result.timings.stages[0].uri === 'http://ads.example.com/first' && result.timings.stages[0].depth === 1 && result.timings.stages[0].fetchTime === 50 &&
+                result.timings.stages[1].uri === 'http://ads.example.com/second' && result.timings.stages[1].depth === 2 && result.timings.stages[1].fetchTime === 70,
+                'the stages in chain order with their depth and fetch time: ' + JSON.stringify(result.timings.stages));
+            expect(result.timings.stages.every(function (stage) { return stage.parseTime === 0 && !stage.isCached && stage.error === undefined; }), 'the parse takes no simulated time');
+            expect(result.timings.totalTime === 120 && result.timings.firstInlineTime === 120, 'totalTime and firstInlineTime: ' + JSON.stringify(result.timings));
+            expect(harness.throwsError(function () { context.chain.getResult({ requestId: requestId }); }, 'PLAYER_SEQUENCER:AdResolverError'),
+                'the request is forgotten once its complete result is returned');
+        },
+
+        wrapperLoop: function (expect) {
+            var context = createContext({
+                    'http://ads.example.com/a': { text: createWrapper(['http://ads.example.com/b']), delay: 10 },
+                    'http://ads.example.com/b': { text: createWrapper(['http://ads.example.com/a']), delay: 10 }
+                }),
+                result = null,
+                statistics;
+
+            context.chain.resolveVAST({ entryId: context.adResolver.vast.createEntry(createWrapper(['http://ads.example.com/a'])), onComplete: function (r) { result = r; } });
+            context.advance(1000);
+            statistics = context.chain.getStatistics();
+            expect(result !== null && result.ads.length === 0, 'the loop resolves to no ad');
+            expect(result !== null && result.errors.length === 1 && result.errors[0].errorCode === ERROR_WRAPPER_LIMIT, 'error 302: ' + JSON.stringify(result && result.errors));
+            expect(result !== null && result.errors[0].entryId === result.entryIds[result.entryIds.length - 1] && result.errors[0].adOrdinal === 0,
+                'the error is at the Wrapper ad of the last stage');
+            expect(result !== null && result.timings.stages.length === 5, 'the default limit of 5 wrappers was followed');
+            expect(statistics.fetchCount === 2 && statistics.cacheHitCount === 3, 'the loop is fetched once and then served from the cache: ' + JSON.stringify(statistics));
+        },
+
+        depthLimit: function (expect) {
+            var context = createContext({
+                    'http://ads.example.com/1': { text: createWrapper(['http://ads.example.com/2']), delay: 10 },
+                    'http://ads.example.com/2': { text: createWrapper(['http://ads.example.com/3']), delay: 10 },
+                    'http://ads.example.com/3': { text: createInline('deep'), delay: 10 }
+                }),
+                rootText = createWrapper(['http://ads.example.com/1']),
+                resolve = function (params) {
+                    var result = null;
+
+                    params.entryId = context.adResolver.vast.createEntry(rootText);
+                    params.onComplete = function (r) { result = r; };
+                    context.chain.resolveVAST(params);
+                    context.advance(1000);
+                    return result;
+                },
+                result;
+
+            result = resolve({ maxWrapperDepth: 3 });
+            expect(result.ads.length === 1 && result.ads[0].wrappers.length === 3 && result.errors.length === 0, 'three Wrappers are followed with maxWrapperDepth 3');
+            result = resolve({ maxWrapperDepth: 2 });
+            expect(result.ads.length === 0 && result.errors.length === 1 && result.errors[0].errorCode === ERROR_WRAPPER_LIMIT && result.timings.stages.length === 2,
+                'maxWrapperDepth 2 stops at the third Wrapper: ' + JSON.stringify(result.errors));
+            result = resolve({ maxWrapperDepth: 0 });
+            expect(result.ads.length === 0 && result.errors[0].errorCode === ERROR_WRAPPER_LIMIT && result.timings.stages.length === 0, 'maxWrapperDepth 0 follows no Wrapper');
+
+            context.chain.setMaxWrapperDepth(1);
+            result = resolve({});
+            expect(result.errors.length === 1 && result.errors[0].errorCode === ERROR_WRAPPER_LIMIT && result.timings.stages.length === 1, 'setMaxWrapperDepth sets the default');
+            result = resolve({ maxWrapperDepth: 5 });
+            expect(result.ads.length === 1 && result.errors.length === 0, 'the maxWrapperDepth of a request overrides the default');
+        },
+
+        cacheTTL: function (expect) {
+            var context = createContext({ 'http://ads.example.com/inline': { text: createInline('cached'), delay: 20 } }),
+                rootText = createWrapper(['http://ads.example.com/inline']),
+                resolve = function () {
+                    var result = null;
+
+                    context.chain.resolveVAST({ entryId: context.adResolver.vast.createEntry(rootText), onComplete: function (r) { result = r; } });
+                    context.advance(20);
+                    return result;
+                };
+
+            context.chain.setCacheTTL(1000);
+            resolve();
+            context.advance(979);
+            expect(resolve().timings.stages[0].isCached && context.chain.getStatistics().fetchCount === 1, 'served from the cache before the TTL');
+            context.advance(1);
+            expect(!resolve().timings.stages[0].isCached && context.chain.getStatistics().fetchCount === 2, 'fetched again once the TTL is over');
+
+            context.chain.clearCache();
+            expect(!resolve().timings.stages[0].isCached && context.chain.getStatistics().fetchCount === 3, 'fetched again after clearCache');
+
+            context.chain.setCacheTTL(0);
+            context.chain.clearCache();
+            resolve();
+            expect(!resolve().timings.stages[0].isCached && context.chain.getStatistics().fetchCount === 5, 'a TTL of 0 disables the cache');
+            expect(context.fetchedURIs.length === 5, 'every fetch went through the fetch function');
+        },
+
+        fetchError: function (expect) {
+            var context = createContext({}),
+                rootEntryId = context.adResolver.vast.createEntry(createWrapper(['http://ads.example.com/missing'])),
+                requestId = context.chain.resolveVAST({ entryId: rootEntryId }),
+                result;
+
+            context.advance(10);
+            result = context.chain.getResult({ requestId: requestId });
+            expect(result.isComplete && result.ads.length === 0 && result.entryIds.length === 0, 'a failed fetch creates no entry');
+            expect(result.errors.length === 1 && result.errors[0].errorCode === ERROR_WRAPPER_FETCH && result.errors[0].entryId === rootEntryId && result.errors[0].adOrdinal === 0,
+                'error 301 at the Wrapper ad: ' + JSON.stringify(result.errors));
+            expect(result.timings.stages[0].error === 'HTTP status 404', 'the stage has the fetch error');
+            expect(context.chain.getStatistics().fetchErrorCount === 1, 'the fetch error is counted');
+        }
+    };
+
+harness.runChecks(CHECKS);
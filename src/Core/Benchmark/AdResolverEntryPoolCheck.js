@@ -0,0 +1,231 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which checks the memory budget of the AdResolver entry pool, with
+// a budget holding two parsed copies of the sample InlineVAST.xml:
+//     evictionOrder       the least recently used entry is evicted, a query making an entry most recently used
+//     pinnedEntries       a pinned entry is never evicted, and is evicted once unpinned if over the budget
+//     restoreEntry        restoreEntry re-parses an evicted entry keeping its id, and refuses one without source text
+//     transparentRestore  a query on an evicted entry restores it from its source text with the same result
+//     statistics          the entry, resident, byte, eviction and restore counters
+//     compilerPins        the lazy VMAP compiler pins a VMAP entry without source text from compile to release, and the
+//                         chain resolver pins the entries of an AdBreak until it is expanded, so entries created after
+//                         compile do not evict them; an AdBreak which fails to start resolving does not stop the others
+//
+// Usage: node AdResolverEntryPoolCheck.js
+//
+// The exit code is 1 if any check fails.
+//
+
+/*jslint node: true */
+"use strict";
+
+var fs = require('fs'),
+    path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    SAMPLE_TEXT = fs.readFileSync(path.join(__dirname, 'Samples', 'InlineVAST.xml'), 'utf8'),
+
+    createContext = function () {
+        ///<summary>Load the core scripts into a fresh context with a memory budget of two parsed sample documents</summary>
+        ///<returns type="Object">An object with: adResolver, pool (theAdResolverEntryPool), documentBytes (estimated size of one sample document)</returns>
+        var namespace = harness.loadScripts(harness.CORE_SCRIPTS, { hasDOMParser: true }),
+            adResolver = namespace.theAdResolver,
+            entryId = adResolver.vast.createEntry(SAMPLE_TEXT),
+            documentBytes = adResolver.getStatistics().residentBytes;
+
+        adResolver.releaseEntry(entryId);
+        adResolver.setMemoryBudget(2 * documentBytes);
+        return { namespace: namespace, adResolver: adResolver, pool: namespace.theAdResolverEntryPool, documentBytes: documentBytes };
+    },
+
+    MID_ROLL_POSITION = 600,
+
+    createVMAPDocument = function (namespace, mediaURI) {
+        ///<summary>Parse a VMAP document with one mid-roll AdBreak of inline VASTData into a document object, so its entry has no source text</summary>
+        return namespace.theCompactXMLParser.parseFromString('<VMAP version="1.0"><AdBreak timeOffset="00:10:00" breakId="mid"><AdSource><VASTData>' +
+            '<VAST version="3.0"><Ad id="mid"><InLine><AdSystem>s</AdSystem><Creatives><Creative><Linear><Duration>00:00:15</Duration><MediaFiles>' +
+            '<MediaFile type="video/mp4"><![CDATA[' + mediaURI + ']]></MediaFile></MediaFiles></Linear></Creative></Creatives></InLine></Ad></VAST>' +
+            '</VASTData></AdSource></AdBreak></VMAP>');
+    },
+
+    CHECKS = {
+        evictionOrder: function (expect) {
+            var context = createContext(),
+                adResolver = context.adResolver,
+                pool = context.pool,
+                first = adResolver.vast.createEntry(SAMPLE_TEXT),
+                second = adResolver.vast.createEntry(SAMPLE_TEXT),
+                third;
+
+            expect(pool.isEntryResident(first) && pool.isEntryResident(second), 'two documents fit the budget');
+            adResolver.vast.getAdList({ entryId: first });
+            third = adResolver.vast.createEntry(SAMPLE_TEXT);
+            expect(pool.isEntryResident(first), 'the entry queried last is kept');
+            expect(!pool.isEntryResident(second), 'the least recently used entry is evicted');
+            expect(pool.isEntryResident(third), 'the entry just created is resident');
+            expect(harness.throwsError(function () { pool.getEntryFromId(second); }, 'PLAYER_SEQUENCER:AdResolverError'), 'the pool refuses to return an evicted entry');
+        },
+
+        pinnedEntries: function (expect) {
+            var context = createContext(),
+                adResolver = context.adResolver,
+                pool = context.pool,
+                pinned = adResolver.vast.createEntry(SAMPLE_TEXT),
+                second = adResolver.vast.createEntry(SAMPLE_TEXT),
+                i;
+
+            adResolver.pinEntry(pinned);
+            adResolver.pinEntry(pinned);
+            for (i = 0; i < 3; i += 1) {
+                adResolver.vast.createEntry(SAMPLE_TEXT);
+            }
+            expect(pool.isEntryResident(pinned), 'the pinned least recently used entry is kept');
+            expect(!pool.isEntryResident(second), 'the unpinned entry after it is evicted');
+            expect(adResolver.getStatistics().residentBytes === 2 * context.documentBytes, 'the budget is kept with the pinned entry');
+
+            adResolver.unpinEntry(pinned);
+            expect(pool.isEntryResident(pinned), 'pins are counted: one pin is left');
+            adResolver.setMemoryBudget(context.documentBytes / 2);
+            expect(pool.isEntryResident(pinned), 'the pinned entry is kept over the budget');
+            adResolver.unpinEntry(pinned);
+            expect(!pool.isEntryResident(pinned), 'the entry is evicted once the last pin is undone');
+            expect(adResolver.getStatistics().residentBytes === 0, 'unpinning enforces the budget');
+        },
+
+        restoreEntry: function (expect) {
+            var context = createContext(),
+                adResolver = context.adResolver,
+                pool = context.pool,
+                evicted = adResolver.vast.createEntry(SAMPLE_TEXT),
+                domEntry,
+                i;
+
+            for (i = 0; i < 2; i += 1) {
+                adResolver.vast.createEntry(SAMPLE_TEXT);
+            }
+            expect(!pool.isEntryResident(evicted), 'the first entry is evicted');
+            expect(adResolver.restoreEntry(evicted) === evicted, 'restoreEntry keeps the id');
+            expect(pool.isEntryResident(evicted), 'the restored entry is resident');
+            expect(adResolver.restoreEntry(evicted) === evicted && adResolver.getStatistics().restoreCount === 1, 'restoring a resident entry does nothing');
+
+            domEntry = adResolver.vast.createEntry(pool.getEntryFromId(evicted).parsedDocument);
+            expect(pool.getSourceText(domEntry) === null, 'an entry created from a DOM object has no source text');
+            for (i = 0; i < 2; i += 1) {
+                adResolver.vast.createEntry(SAMPLE_TEXT);
+            }
+            expect(!pool.isEntryResident(domEntry), 'the DOM entry is evicted');
+            expect(harness.throwsError(function () { adResolver.restoreEntry(domEntry); }, 'PLAYER_SEQUENCER:AdResolverError'), 'restoreEntry refuses an entry without source text');
+            expect(harness.throwsError(function () { adResolver.vast.getAdList({ entryId: domEntry }); }, 'PLAYER_SEQUENCER:AdResolverError'), 'a query refuses an evicted entry without source text');
+        },
+
+        transparentRestore: function (expect) {
+            var context = createContext(),
+                adResolver = context.adResolver,
+                pool = context.pool,
+                evicted = adResolver.vast.createEntry(SAMPLE_TEXT),
+                adList = JSON.stringify(adResolver.vast.getAdList({ entryId: evicted })),
+                mediaFiles = JSON.stringify(adResolver.vast.getMediaFileList({ entryId: evicted, adOrdinal: 0, creativeOrdinal: 0 })),
+                i;
+
+            for (i = 0; i < 2; i += 1) {
+                adResolver.vast.createEntry(SAMPLE_TEXT);
+            }
+            expect(!pool.isEntryResident(evicted), 'the first entry is evicted');
+            expect(JSON.stringify(adResolver.vast.getAdList({ entryId: evicted })) === adList, 'the memoized query result is the same after the restore');
+            expect(pool.isEntryResident(evicted), 'the query restored the entry');
+            expect(JSON.stringify(adResolver.vast.getMediaFileList({ entryId: evicted, adOrdinal: 0, creativeOrdinal: 0 })) === mediaFiles,
+                'a second query on the restored entry has the same result');
+            expect(adResolver.getStatistics().restoreCount === 1, 'one restore');
+        },
+
+        statistics: function (expect) {
+            var context = createContext(),
+                adResolver = context.adResolver,
+                entryIds = [],
+                statistics,
+                i;
+
+            for (i = 0; i < 5; i += 1) {
+                entryIds.push(adResolver.vast.createEntry(SAMPLE_TEXT));
+            }
+            statistics = adResolver.getStatistics();
+            expect(statistics.entryCount === 5 && statistics.residentCount === 2, 'five entries, two resident: ' + JSON.stringify(statistics));
+            expect(statistics.residentBytes === 2 * context.documentBytes && statistics.memoryBudget === 2 * context.documentBytes, 'the resident bytes are within the budget');
+            expect(statistics.sourceBytes === 5 * 2 * SAMPLE_TEXT.length, 'the source text of every entry is counted');
+            expect(statistics.evictionCount === 3 && statistics.restoreCount === 0, 'three evictions');
+
+            adResolver.vast.getAdList({ entryId: entryIds[0] });
+            statistics = adResolver.getStatistics();
+            expect(statistics.restoreCount === 1 && statistics.evictionCount === 4 && statistics.residentCount === 2, 'the restore evicted another entry: ' + JSON.stringify(statistics));
+
+            adResolver.releaseEntry(entryIds[0]);
+            adResolver.releaseEntry(entryIds[1]);
+            statistics = adResolver.getStatistics();
+            expect(statistics.entryCount === 3 && statistics.residentCount === 1 && statistics.residentBytes === context.documentBytes,
+                'releasing a resident and an evicted entry: ' + JSON.stringify(statistics));
+            expect(statistics.sourceBytes === 3 * 2 * SAMPLE_TEXT.length, 'the source text of released entries is not counted');
+        },
+
+        compilerPins: function (expect) {
+            var context = createContext(),
+                adResolver = context.adResolver,
+                pool = context.pool,
+                scheduler = context.namespace.scheduler,
+                contentParams = scheduler.createContentClipParams(),
+                releasedEntryId,
+                vmapEntryId,
+                releasedCompileId,
+                compileId,
+                adBreak,
+                i;
+
+            contentParams.clipURI = 'http://example.com/main.m3u8';
+            contentParams.minManifestPosition = 0;
+            contentParams.maxManifestPosition = 3600;
+            scheduler.appendContentClip(contentParams);
+            releasedEntryId = adResolver.vmap.createEntry(createVMAPDocument(context.namespace, 'http://example.com/released.mp4'));
+            vmapEntryId = adResolver.vmap.createEntry(createVMAPDocument(context.namespace, 'http://example.com/mid.mp4'));
+            releasedCompileId = adResolver.compiler.compile({ entryId: releasedEntryId }).compileId;
+            compileId = adResolver.compiler.compile({ entryId: vmapEntryId }).compileId;
+            expect(pool.getSourceText(vmapEntryId) === null, 'the VMAP entry has no source text');
+
+            // no budget: every entry which is not pinned is evicted as soon as another is created
+            adResolver.setMemoryBudget(0);
+            for (i = 0; i < 3; i += 1) {
+                adResolver.vast.createEntry(SAMPLE_TEXT);
+            }
+            expect(pool.isEntryResident(vmapEntryId), 'the compiled VMAP entry is kept over the budget');
+            // the application releases an entry it compiled by mistake
+            adResolver.releaseEntry(releasedEntryId);
+
+            expect(!harness.throwsError(function () { adResolver.compiler.advance({ linearPosition: MID_ROLL_POSITION - 0.5 }); }), 'advance does not throw');
+            adBreak = adResolver.compiler.getStatus({ compileId: releasedCompileId }).adBreaks[0];
+            expect(adBreak.state === 'failed' && adBreak.errors.length === 1, 'the AdBreak of the released entry failed: ' + JSON.stringify(adBreak));
+            expect(adBreak.placeholderId > 0 && harness.throwsError(function () { context.namespace.sequentialPlaylist.access.getEntryFromId(adBreak.placeholderId); }),
+                'the placeholder of the failed AdBreak was removed');
+            adBreak = adResolver.compiler.getStatus({ compileId: compileId }).adBreaks[0];
+            expect(adBreak.state === 'expanded' && adBreak.playlistEntryIds.length === 1, 'the other AdBreak was expanded: ' + JSON.stringify(adBreak));
+            expect(context.namespace.sequentialPlaylist.access.getEntryFromId(adBreak.playlistEntryIds[0]).clipURI === 'http://example.com/mid.mp4', 'the ad clip was scheduled');
+            expect(JSON.parse(pool.testProbe_toJSON()).entries.every(function (entry) { return entry.idNumber === vmapEntryId ? entry.pinCount === 1 : entry.pinCount === 0; }),
+                'only the compiled VMAP entry is still pinned');
+
+            adResolver.compiler.release({ compileId: compileId });
+            adResolver.compiler.release({ compileId: releasedCompileId });
+            expect(!pool.isEntryResident(vmapEntryId), 'release unpins the VMAP entry, which is evicted over the budget');
+        }
+    };
+
+harness.runChecks(CHECKS);
@@ -0,0 +1,184 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which measures the compact XML parser of AdResolver.js and the
+// DOMParser (DOMParserStandIn.js) on large generated documents: VAST documents with many copies of the ads of the
+// sample InlineVAST.xml, and VMAP documents with as many AdBreaks each holding one of those ads as VASTData.
+// For each document and parser it reports:
+//     parse       the time of createEntry
+//     retained    the heap retained by each parsed entry, measured with RETAINED_ENTRY_COUNT entries held, after a
+//                 garbage collection when node is run with --expose-gc
+//     estimated   the entry size the memory budget of the AdResolver entry pool counts
+// The retained heap of the DOMParser is that of the stand-in, not of a web view DOM.
+//
+// Usage: node [--expose-gc] AdResolverParserBenchmark.js [--ads <count,...>] [--parses <count>]
+//     --ads           the ad counts of the generated documents (default 10,100,1000)
+//     --parses        parses of each document measured per parser, divided by the ad count (default 10000)
+//
+// The exit code is 1 if a parser does not find every ad or AdBreak of a document.
+//
+
+/*jslint node: true */
+"use strict";
+
+var fs = require('fs'),
+    path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    SAMPLE_TEXT = fs.readFileSync(path.join(__dirname, 'Samples', 'InlineVAST.xml'), 'utf8'),
+    SAMPLE_ADS = SAMPLE_TEXT.match(/<Ad\s[\s\S]*?<\/Ad>/g),
+    RETAINED_ENTRY_COUNT = 20,
+
+    parseArguments = function (argv) {
+        var options = { ads: [10, 100, 1000], parses: 10000 },
+            i;
+
+        for (i = 0; i < argv.length; i += 1) {
+            if (argv[i] === '--ads') {
+                i += 1;
+                options.ads = argv[i].split(',').map(function (count) { return parseInt(count, 10); });
+            } else if (argv[i] === '--parses') {
+                i += 1;
+                options.parses = parseInt(argv[i], 10);
+            } else {
+                throw new Error('usage: node [--expose-gc] AdResolverParserBenchmark.js [--ads <count,...>] [--parses <count>]');
+            }
+        }
+        return options;
+    },
+
+    createAd = function (index) {
+        ///<returns type="String">A copy of one of the sample ads with a unique id and sequence</returns>
+        return SAMPLE_ADS[index % SAMPLE_ADS.length]
+            .replace(/^<Ad\s[^>]*>/, '<Ad id="ad-' + index.toString() + '" sequence="' + (index + 1).toString() + '">');
+    },
+
+    createVAST = function (adCount) {
+        var ads = [],
+            i;
+
+        for (i = 0; i < adCount; i += 1) {
+            ads.push(createAd(i));
+        }
+        return '<?xml version="1.0" encoding="UTF-8"?>\n<VAST version="3.0">\n' + ads.join('\n') + '\n</VAST>\n';
+    },
+
+    createVMAP = function (adBreakCount) {
+        var adBreaks = [],
+            i;
+
+        for (i = 0; i < adBreakCount; i += 1) {
+            adBreaks.push('<vmap:AdBreak timeOffset="' + (i === 0 ? 'start' : '00:' + ('0' + Math.floor(i / 60) % 60).slice(-2) + ':' + ('0' + i % 60).slice(-2)) +
+                '" breakType="linear" breakId="break-' + i.toString() + '"><vmap:AdSource id="source-' + i.toString() + '"><vmap:VASTData><VAST version="3.0">' +
+                createAd(i) + '</VAST></vmap:VASTData></vmap:AdSource></vmap:AdBreak>');
+        }
+        return '<?xml version="1.0" encoding="UTF-8"?>\n<vmap:VMAP xmlns:vmap="http://www.iab.net/videosuite/vmap" version="1.0">\n' + adBreaks.join('\n') + '\n</vmap:VMAP>\n';
+    },
+
+    createAdResolver = function (isCompact) {
+        ///<summary>Load the core scripts into a fresh context with the DOMParser stand-in, select the parser and lift the memory budget</summary>
+        ///<returns type="Object">theAdResolver of the context</returns>
+        var adResolver = harness.loadScripts(harness.CORE_SCRIPTS, { hasDOMParser: true }).theAdResolver;
+
+        adResolver.setCompactParser(isCompact);
+        adResolver.setMemoryBudget(Number.MAX_VALUE);
+        return adResolver;
+    },
+
+    heapUsed = function () {
+        ///<returns type="Number">The heap used in bytes, after a garbage collection if node was run with --expose-gc</returns>
+        if (typeof global.gc === 'function') {
+            global.gc();
+        }
+        return process.memoryUsage().heapUsed;
+    },
+
+    countItems = function (adResolver, kind, entryId) {
+        ///<returns type="Number">The number of ads of a VAST entry or AdBreaks of a VMAP entry</returns>
+        return (kind === 'vast') ? adResolver.vast.getAdList({ entryId: entryId }).length : adResolver.vmap.getAdBreakList({ entryId: entryId }).length;
+    },
+
+    measure = function (adResolver, kind, text, parseCount) {
+        ///<returns type="Object">An object with properties: parseTime (microseconds per parse), retainedBytes and estimatedBytes (per entry), itemCount (ads or AdBreaks)</returns>
+        var entryIds = [],
+            baseHeap,
+            retainedHeap,
+            estimatedBytes,
+            itemCount,
+            parseTime,
+            i;
+
+        for (i = 0; i < Math.min(parseCount, 5); i += 1) {
+            adResolver.releaseEntry(adResolver[kind].createEntry(text));
+        }
+        parseTime = harness.now();
+        for (i = 0; i < parseCount; i += 1) {
+            adResolver.releaseEntry(adResolver[kind].createEntry(text));
+        }
+        parseTime = (harness.now() - parseTime) / 1000 / parseCount;
+
+        baseHeap = heapUsed();
+        for (i = 0; i < RETAINED_ENTRY_COUNT; i += 1) {
+            entryIds.push(adResolver[kind].createEntry(text));
+        }
+        retainedHeap = heapUsed() - baseHeap;
+        estimatedBytes = adResolver.getStatistics().residentBytes;
+        itemCount = countItems(adResolver, kind, entryIds[0]);
+        for (i = 0; i < entryIds.length; i += 1) {
+            adResolver.releaseEntry(entryIds[i]);
+        }
+        return {
+            parseTime: parseTime,
+            retainedBytes: retainedHeap / RETAINED_ENTRY_COUNT,
+            estimatedBytes: estimatedBytes / RETAINED_ENTRY_COUNT,
+            itemCount: itemCount
+        };
+    },
+
+    main = function () {
+        var options = parseArguments(process.argv.slice(2)),
+            parsers = [
+                { name: 'compact', adResolver: createAdResolver(true) },
+                { name: 'DOMParser', adResolver: createAdResolver(false) }
+            ],
+            documents = [],
+            mismatchCount = 0,
+            results,
+            i,
+            p;
+
+        for (i = 0; i < options.ads.length; i += 1) {
+            documents.push({ name: 'VAST ' + options.ads[i] + ' ads', kind: 'vast', adCount: options.ads[i], text: createVAST(options.ads[i]) });
+            documents.push({ name: 'VMAP ' + options.ads[i] + ' AdBreaks', kind: 'vmap', adCount: options.ads[i], text: createVMAP(options.ads[i]) });
+        }
+
+        console.log('retained heap ' + ((typeof global.gc === 'function') ? 'after garbage collection' : 'without garbage collection: run node --expose-gc'));
+        console.log('document\tbytes\tparser\tus/parse\tretained bytes\testimated bytes');
+        for (i = 0; i < documents.length; i += 1) {
+            results = [];
+            for (p = 0; p < parsers.length; p += 1) {
+                results.push(measure(parsers[p].adResolver, documents[i].kind, documents[i].text, Math.max(1, Math.floor(options.parses / documents[i].adCount))));
+                console.log([documents[i].name, documents[i].text.length, parsers[p].name, results[p].parseTime.toFixed(1),
+                    results[p].retainedBytes.toFixed(0), results[p].estimatedBytes.toFixed(0)].join('\t'));
+            }
+            if (results[0].itemCount !== documents[i].adCount || results[1].itemCount !== documents[i].adCount) {
+                mismatchCount += 1;
+                console.log('MISMATCH ' + documents[i].name + ': compact ' + results[0].itemCount + ', DOMParser ' + results[1].itemCount);
+            }
+        }
+        process.exitCode = (mismatchCount > 0) ? 1 : 0;
+    };
+
+main();
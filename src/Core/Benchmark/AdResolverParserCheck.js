@@ -0,0 +1,237 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which checks the compact XML parser of AdResolver.js against the
+// DOMParser (DOMParserStandIn.js). The sample VAST and VMAP documents, and a few small documents with entities,
+// comments, split character data and namespaces, are parsed in two contexts, one with each parser, and every
+// query of theAdResolver is run through runJSON on both: the vast and vmap queries for every ad, creative and
+// ad break, the VAST entry of every VMAP VASTData ad source, and getElementListFromPath. The results must be
+// equal, and a document which is not well formed must be rejected by both.
+// It also measures the parse time (createEntry) of each sample document with each parser.
+//
+// Usage: node AdResolverParserCheck.js [--parses <count>]
+//     --parses        parses of each sample document measured per parser (default 500)
+//
+// The exit code is 1 if any query result differs.
+//
+
+/*jslint node: true */
+"use strict";
+
+var fs = require('fs'),
+    path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    SAMPLES_DIRECTORY = path.join(__dirname, 'Samples'),
+    SAMPLES = [
+        { name: 'InlineVAST.xml', kind: 'vast' },
+        { name: 'WrapperVAST.xml', kind: 'vast' },
+        { name: 'PlaylistVMAP.xml', kind: 'vmap' }
+    ],
+    EDGE_CASES = [
+        { name: 'entities', kind: 'vast', text: '<VAST version="3.0"><Ad id="a&amp;b &#x41;&#66; &quot;q&quot; &apos;s&apos;"><InLine><AdTitle>x &lt;y&gt; &#x1F600;</AdTitle>' +
+            '<Creatives><Creative id=\'single\' sequence = "1"><Linear><MediaFiles><MediaFile type="video/mp4">http://example.com/a.mp4?x=1&amp;y=2</MediaFile>' +
+            '</MediaFiles></Linear></Creative></Creatives></InLine></Ad></VAST>' },
+        { name: 'comments', kind: 'vast', text: '<?xml version="1.0"?>\n<!-- leading -->\n<VAST version="3.0"><!-- before the ad --><Ad><InLine><Creatives><Creative>' +
+            '<!-- a comment before the linear --><Linear><TrackingEvents><!-- none yet --><Tracking event="start"><!-- c --><![CDATA[http://t/start]]></Tracking>' +
+            '</TrackingEvents></Linear></Creative></Creatives></InLine></Ad></VAST>\n<!-- trailing -->\n' },
+        { name: 'splitText', kind: 'vast', text: '<VAST version="3.0"><Ad><InLine><AdSystem>one<![CDATA[two]]>three</AdSystem><Creatives><Creative><Linear>' +
+            '<VideoClicks><ClickThrough>\n<![CDATA[http://click/1]]>\n</ClickThrough><ClickTracking>plain text</ClickTracking><CustomClick/></VideoClicks>' +
+            '</Linear></Creative></Creatives></InLine></Ad></VAST>' },
+        { name: 'namespaces', kind: 'vmap', text: '<v:VMAP xmlns:v="http://www.iab.net/videosuite/vmap" version="1.0"><v:AdBreak timeOffset="start" breakType="linear">' +
+            '<v:AdSource id="s"><v:VASTData><VAST version="3.0"><Ad id="n"><InLine><Creatives><Creative><Linear><MediaFiles>' +
+            '<MediaFile xml:lang="en" type="video/mp4"><![CDATA[http://m/n.mp4]]></MediaFile></MediaFiles></Linear></Creative></Creatives></InLine></Ad></VAST>' +
+            '</v:VASTData></v:AdSource></v:AdBreak></v:VMAP>' }
+    ],
+    MALFORMED = [
+        '<VAST version="3.0"><Ad><InLine></Ad></VAST>',
+        '<VAST version="3.0"><Ad>',
+        '<VAST version=3.0><Ad/></VAST>',
+        '<VAST version="3.0"><Ad><![CDATA[x</Ad></VAST>',
+        'not xml at all'
+    ],
+    VAST_QUERIES = ['getLinearTrackingEventsList', 'getVideoClicksList', 'getIconsList', 'getMediaFileList', 'getCompanionAdsList', 'getNonLinearAdsList'],
+
+    parseArguments = function (argv) {
+        var options = { parses: 500 },
+            i;
+
+        for (i = 0; i < argv.length; i += 1) {
+            if (argv[i] === '--parses') {
+                i += 1;
+                options.parses = parseInt(argv[i], 10);
+            } else {
+                throw new Error('usage: node AdResolverParserCheck.js [--parses <count>]');
+            }
+        }
+        return options;
+    },
+
+    createAdResolver = function (isCompact) {
+        ///<summary>Load the core scripts into a fresh context with the DOMParser stand-in and select the parser</summary>
+        ///<returns type="Object">theAdResolver of the context</returns>
+        var adResolver = harness.loadScripts(harness.CORE_SCRIPTS, { hasDOMParser: true }).theAdResolver;
+
+        adResolver.setCompactParser(isCompact);
+        return adResolver;
+    },
+
+    now = harness.now,
+
+    createQueryRunner = function (adResolver) {
+        ///<summary>Run queries through runJSON, recording each result with the exception stack removed</summary>
+        var results = [],
+
+            call = function (func, params) {
+                var result = JSON.parse(adResolver.runJSON(JSON.stringify({ func: func, params: params })));
+
+                if (result && result.EXCEPTION) {
+                    delete result.EXCEPTION.stack;
+                }
+                results.push(func + ' ' + JSON.stringify(params) + ' -> ' + JSON.stringify(result));
+                return result;
+            },
+
+            runVAST = function (entryId) {
+                var adList = call('vast.getAdList', { entryId: entryId }),
+                    creativeList,
+                    adTypes = ['InLine', 'Wrapper'],
+                    i,
+                    j,
+                    k;
+
+                for (i = 0; adList && !adList.EXCEPTION && i <= adList.length; i += 1) {
+                    creativeList = [];
+                    for (j = 0; j < adTypes.length; j += 1) {
+                        creativeList = call('vast.getCreativeList', { entryId: entryId, adOrdinal: i, adType: adTypes[j] });
+                    }
+                    for (j = 0; j <= 2; j += 1) {
+                        for (k = 0; k < VAST_QUERIES.length; k += 1) {
+                            call('vast.' + VAST_QUERIES[k], { entryId: entryId, adOrdinal: i, creativeOrdinal: j });
+                        }
+                    }
+                    call('getElementListFromPath', { entryId: entryId, path: ['VAST', 'Ad:' + i.toString()] });
+                    call('getElementListFromPath', { entryId: entryId, path: ['VAST', 'Ad:' + i.toString(), '*'] });
+                    call('getElementListFromPath', { entryId: entryId, path: ['VAST', 'Ad:' + i.toString(), '*'], nodeName: 'Impression' });
+                    call('getElementListFromPath', { entryId: entryId, path: ['VAST', 'Ad:' + i.toString(), '*', 'Extensions'], nodeName: 'Extension' });
+                }
+            },
+
+            runVMAP = function (entryId) {
+                var adBreakList = call('vmap.getAdBreakList', { entryId: entryId }),
+                    vastEntryId,
+                    i;
+
+                for (i = 0; adBreakList && !adBreakList.EXCEPTION && i <= adBreakList.length; i += 1) {
+                    call('vmap.getAdSource', { entryId: entryId, adBreakOrdinal: i });
+                    call('vmap.getTrackingEventsList', { entryId: entryId, adBreakOrdinal: i });
+                    call('vmap.getExtensionsList', { entryId: entryId, adBreakOrdinal: i });
+                    call('getElementListFromPath', { entryId: entryId, path: ['VMAP', 'AdBreak:' + i.toString(), 'AdSource'] });
+                    vastEntryId = call('vmap.createVASTEntryFromAdBreak', { entryId: entryId, adBreakOrdinal: i });
+                    if (typeof vastEntryId === 'number') {
+                        runVAST(vastEntryId);
+                        adResolver.releaseEntry(vastEntryId);
+                    }
+                }
+            };
+
+        return {
+            results: results,
+
+            run: function (kind, text) {
+                var entryId = call(kind + '.createEntry', text);
+
+                if (typeof entryId === 'number') {
+                    if (kind === 'vast') {
+                        runVAST(entryId);
+                    } else {
+                        runVMAP(entryId);
+                    }
+                    adResolver.releaseEntry(entryId);
+                }
+                return entryId;
+            }
+        };
+    },
+
+    measureParse = function (adResolver, kind, text, parseCount) {
+        ///<returns type="Number">microseconds per parse</returns>
+        var startTime,
+            i;
+
+        for (i = 0; i < 20; i += 1) {
+            adResolver.releaseEntry(adResolver[kind].createEntry(text));
+        }
+        startTime = now();
+        for (i = 0; i < parseCount; i += 1) {
+            adResolver.releaseEntry(adResolver[kind].createEntry(text));
+        }
+        return (now() - startTime) / 1000 / parseCount;
+    },
+
+    main = function () {
+        var options = parseArguments(process.argv.slice(2)),
+            compact = createAdResolver(true),
+            dom = createAdResolver(false),
+            documents = SAMPLES.map(function (sample) {
+                return { name: sample.name, kind: sample.kind, text: fs.readFileSync(path.join(SAMPLES_DIRECTORY, sample.name), 'utf8') };
+            }).concat(EDGE_CASES),
+            mismatchCount = 0,
+            queryCount = 0,
+            compactRunner,
+            domRunner,
+            compactId,
+            domId,
+            i,
+            j;
+
+        for (i = 0; i < documents.length; i += 1) {
+            compactRunner = createQueryRunner(compact);
+            domRunner = createQueryRunner(dom);
+            compactRunner.run(documents[i].kind, documents[i].text);
+            domRunner.run(documents[i].kind, documents[i].text);
+            queryCount += compactRunner.results.length;
+            if (compactRunner.results.length !== domRunner.results.length) {
+                mismatchCount += 1;
+                console.log('MISMATCH ' + documents[i].name + ': ' + compactRunner.results.length + ' compact results, ' + domRunner.results.length + ' DOMParser results');
+            }
+            for (j = 0; j < Math.min(compactRunner.results.length, domRunner.results.length); j += 1) {
+                if (compactRunner.results[j] !== domRunner.results[j]) {
+                    mismatchCount += 1;
+                    console.log('MISMATCH ' + documents[i].name + '\n    compact:   ' + compactRunner.results[j] + '\n    DOMParser: ' + domRunner.results[j]);
+                }
+            }
+        }
+
+        for (i = 0; i < MALFORMED.length; i += 1) {
+            compactId = createQueryRunner(compact).run('vast', MALFORMED[i]);
+            domId = createQueryRunner(dom).run('vast', MALFORMED[i]);
+            if (!compactId.EXCEPTION || !domId.EXCEPTION) {
+                mismatchCount += 1;
+                console.log('MISMATCH malformed document accepted (compact ' + JSON.stringify(compactId) + ', DOMParser ' + JSON.stringify(domId) + '): ' + MALFORMED[i]);
+            }
+        }
+
+        console.log(documents.length + ' documents, ' + queryCount + ' queries, ' + MALFORMED.length + ' malformed documents, mismatches: ' + mismatchCount);
+        console.log('document\tbytes\tcompact us/parse\tDOMParser us/parse');
+        for (i = 0; i < SAMPLES.length; i += 1) {
+            console.log([documents[i].name, documents[i].text.length,
+                measureParse(compact, documents[i].kind, documents[i].text, options.parses).toFixed(1),
+                measureParse(dom, documents[i].kind, documents[i].text, options.parses).toFixed(1)].join('\t'));
+        }
+        process.exitCode = (mismatchCount > 0) ? 1 : 0;
+    };
+
+main();
@@ -0,0 +1,245 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which round-trips every runCompact command against runJSON.
+//
+// Two identical contexts play a schedule with pre-roll, mid-roll (one with ',' in its clipURI) and post-roll
+// ads, with an ad scheduled into the playing content so its clip changes. Every call is made through runCompact
+// on one context and through runJSON on the other, and the compact tuple, decoded by the field names of
+// PLAYER_SEQUENCER.compactCommands, must equal the runJSON result field for field. An exception must be the
+// same EXCEPTION (name and message) on both paths.
+//
+// Usage: node CompactCommandCheck.js
+//
+// The exit code is 1 if any call differs, or if a compact command was not checked.
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    CONTENT_CLIP_DURATION = 600,
+
+    createSequencer = function () {
+        ///<summary>Load the Scheduler and Sequencer into a fresh context and schedule content with pre-, mid- and post-roll ads</summary>
+        ///<returns type="Object">The PLAYER_SEQUENCER namespace of the context</returns>
+        var namespace = harness.loadScripts([harness.SCHEDULER_SCRIPT, harness.SEQUENCER_SCRIPT]),
+            schedule = function (eRollType, startTime, clipURI) {
+                namespace.scheduler.runJSON(JSON.stringify({ func: 'scheduleClip', params: { clipURI: clipURI, eClipType: 'Media', eRollType: eRollType,
+                    minManifestPosition: 0, maxManifestPosition: 15, linearDuration: 0, startTime: startTime, deleteAfterPlay: true } }));
+            },
+            i;
+
+        for (i = 0; i < 2; i += 1) {
+            namespace.scheduler.runJSON(JSON.stringify({ func: 'appendContentClip', params: {
+                clipURI: 'http://example.com/content' + i.toString() + '.m3u8', minManifestPosition: 0, maxManifestPosition: CONTENT_CLIP_DURATION } }));
+        }
+        schedule('Pre', 0, 'http://example.com/preroll.m3u8');
+        schedule('Mid', 300, 'http://example.com/ad.m3u8?cue=300,break=1,slot=2');
+        schedule('Post', 0, 'http://example.com/postroll.m3u8');
+        return namespace;
+    },
+
+    decodeField = function (field, expected) {
+        ///<summary>Decode a tuple field as the type of the runJSON value, following the runCompact encoding</summary>
+        if (typeof expected === 'boolean') {
+            return field === '1' ? true : (field === '0' ? false : field);
+        }
+        if (typeof expected === 'number') {
+            return field === '' ? field : Number(field);
+        }
+        if (expected === null || expected === undefined) {
+            return field === '' ? expected : field;
+        }
+        return field;
+    },
+
+    fieldValue = function (value, fieldName) {
+        var names = fieldName.split('.'),
+            i;
+
+        for (i = 0; i < names.length && value !== null && value !== undefined; i += 1) {
+            value = value[names[i]];
+        }
+        return value;
+    },
+
+    compareResults = function (command, compact, json) {
+        ///<returns type="String" mayBeNull="true">What differs, or null</returns>
+        var result = JSON.parse(json),
+            fields,
+            i;
+
+        if (result && result.EXCEPTION) {
+            compact = JSON.parse(compact);
+            return (compact.EXCEPTION && compact.EXCEPTION.name === result.EXCEPTION.name && compact.EXCEPTION.message === result.EXCEPTION.message) ?
+                    null : 'exception';
+        }
+        if (!command.fields) {
+            return Number(compact) === result ? null : 'value';
+        }
+        if (result === null) {
+            return compact === 'null' ? null : 'null segment';
+        }
+        fields = compact.split(',');
+        if (fields.length > command.fields.length) {
+            // Note: only the last field may contain the ',' separator
+            fields.push(fields.splice(command.fields.length - 1).join(','));
+        }
+        if (fields.length !== command.fields.length) {
+            return 'field count ' + fields.length;
+        }
+        for (i = 0; i < fields.length; i += 1) {
+            if (decodeField(fields[i], fieldValue(result, command.fields[i])) !== fieldValue(result, command.fields[i])) {
+                return command.fields[i];
+            }
+        }
+        return null;
+    },
+
+    createChecker = function () {
+        ///<summary>Two identical contexts, the first called through runCompact and the second through runJSON</summary>
+        var compactNamespace = createSequencer(),
+            jsonNamespace = createSequencer(),
+            report = { callCount: 0, mismatchCount: 0, mismatches: [], checked: {} };
+
+        return {
+            report: report,
+
+            check: function (func, params) {
+                ///<summary>Make the same call on both paths and compare the results</summary>
+                ///<returns type="Object">The runJSON result</returns>
+                var command = compactNamespace.compactCommands[func],
+                    args = [func],
+                    jsonParams = {},
+                    compact,
+                    json,
+                    difference,
+                    i;
+
+                for (i = 0; i < command.params.length; i += 1) {
+                    args.push(params[command.params[i]]);
+                    if (params[command.params[i]] !== undefined) {
+                        jsonParams[command.params[i]] = params[command.params[i]];
+                    }
+                }
+                compact = compactNamespace.sequencerPluginChain.runCompact.apply(null, args);
+                json = jsonNamespace.sequencerPluginChain.runJSON(JSON.stringify({ func: func, params: jsonParams }));
+
+                report.callCount += 1;
+                report.checked[func] = true;
+                difference = compareResults(command, compact, json);
+                if (difference) {
+                    report.mismatchCount += 1;
+                    if (report.mismatches.length < 10) {
+                        report.mismatches.push({ func: func, params: jsonParams, difference: difference, compact: compact, json: json });
+                    }
+                }
+                return JSON.parse(json);
+            },
+
+            both: function (target, func, params) {
+                ///<summary>Make a call which has no compact command through runJSON on both contexts</summary>
+                var results = [compactNamespace, jsonNamespace].map(function (namespace) {
+                        return namespace[target].runJSON(JSON.stringify({ func: func, params: params }));
+                    });
+
+                if (results[0] !== results[1]) {
+                    throw new Error('contexts diverged on ' + func + ': ' + results[0] + ' / ' + results[1]);
+                }
+                if (JSON.parse(results[0]) && JSON.parse(results[0]).EXCEPTION) {
+                    throw new Error(func + ' failed: ' + JSON.parse(results[0]).EXCEPTION.message);
+                }
+                return JSON.parse(results[0]);
+            },
+
+            commands: compactNamespace.compactCommands
+        };
+    },
+
+    checkSegment = function (checker, segment) {
+        ///<summary>Check the per-segment commands at a few positions of the segment</summary>
+        var minPosition = segment.clip.minRenderingTime,
+            maxPosition = segment.clip.maxRenderingTime,
+            positions = [minPosition, (minPosition + maxPosition) / 2, maxPosition - 0.5, maxPosition + 0.25],
+            scrubId,
+            buffered,
+            i;
+
+        for (i = 0; i < positions.length; i += 1) {
+            checker.check('tick', { currentSegmentId: segment.segmentId, playbackRate: 1, currentPlaybackPosition: positions[i], preloadThreshold: (i % 2 === 0) ? 2 : undefined });
+            checker.check('tick', { currentSegmentId: segment.segmentId, playbackRate: -2, currentPlaybackPosition: positions[i] });
+            checker.check('manifestToSeekbarTime', { currentSegmentId: segment.segmentId, playbackRate: 1, currentPlaybackPosition: positions[i] });
+            checker.check('manifestToLinearTime', { currentSegmentId: segment.segmentId, currentPlaybackPosition: positions[i] });
+        }
+
+        buffered = checker.check('onEndOfBuffering', { currentSegmentId: segment.segmentId, currentPlaybackPosition: maxPosition, currentPlaybackRate: 1 });
+        if (buffered) {
+            checker.both('sequencerPluginChain', 'releasePlaybackSegment', { currentSegmentId: buffered.segmentId });
+        }
+
+        scrubId = checker.both('sequencerPluginChain', 'beginScrub', { currentSegmentId: segment.segmentId, currentPlaybackPosition: minPosition });
+        checker.check('submitScrubPosition', { scrubId: scrubId, seekbarSeekPosition: 10 });
+        checker.check('submitScrubPosition', { scrubId: scrubId, seekbarSeekPosition: 20.5 });
+        checker.both('sequencerPluginChain', 'cancelScrub', { scrubId: scrubId });
+    },
+
+    main = function () {
+        var checker = createChecker(),
+            report = checker.report,
+            segment = checker.both('sequencerPluginChain', 'seekFromLinearPosition', { linearSeekPosition: 0 }),
+            hasSplit = false,
+            func,
+            i;
+
+        while (segment) {
+            checkSegment(checker, segment);
+            if (!segment.clip.isAdvertisement) {
+                // Note: the seek replaces the current segment
+                segment = checker.check('seekFromSeekbarPosition', { currentSegmentId: segment.segmentId, seekbarSeekPosition: segment.clip.linearStartTime + 1 });
+                if (!hasSplit) {
+                    // an ad in the playing content clip, so the next tick reports the clip changed
+                    hasSplit = true;
+                    checker.both('scheduler', 'scheduleClip', { clipURI: 'http://example.com/split.m3u8', eClipType: 'Media', eRollType: 'Mid',
+                        minManifestPosition: 0, maxManifestPosition: 15, linearDuration: 0, startTime: segment.clip.linearStartTime + 100, deleteAfterPlay: true });
+                    checker.check('tick', { currentSegmentId: segment.segmentId, playbackRate: 1, currentPlaybackPosition: segment.clip.minRenderingTime + 50 });
+                    segment = checker.both('sequencerPluginChain', 'seekFromLinearPosition', { currentSegmentId: segment.segmentId, linearSeekPosition: segment.clip.linearStartTime + 50 });
+                    checkSegment(checker, segment);
+                }
+            }
+            segment = checker.check('onEndOfMedia', { currentSegmentId: segment.segmentId, currentPlaybackPosition: segment.clip.maxRenderingTime, currentPlaybackRate: 1 });
+        }
+
+        // exceptions: a released segment, an unknown scrub
+        checker.check('tick', { currentSegmentId: 12345, playbackRate: 1, currentPlaybackPosition: 0 });
+        checker.check('onEndOfMedia', { currentSegmentId: 12345, currentPlaybackPosition: 0, currentPlaybackRate: 1 });
+        checker.check('submitScrubPosition', { scrubId: 12345, seekbarSeekPosition: 0 });
+
+        console.log(report.callCount + ' calls, mismatches: ' + report.mismatchCount);
+        for (i = 0; i < report.mismatches.length; i += 1) {
+            console.log('MISMATCH ' + JSON.stringify(report.mismatches[i]));
+        }
+        for (func in checker.commands) {
+            if (checker.commands.hasOwnProperty(func) && !report.checked[func]) {
+                console.log('NOT CHECKED ' + func);
+                report.mismatchCount += 1;
+            }
+        }
+        process.exitCode = (report.mismatchCount > 0) ? 1 : 0;
+    };
+
+main();
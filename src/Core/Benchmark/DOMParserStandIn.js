@@ -0,0 +1,186 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js module with a stand-in for the web view DOMParser, so AdResolver.js can parse into a
+// DOM-like document in the Node.js tools. It is a separate implementation from theCompactXMLParser (a token
+// pattern instead of a character scan, and node objects with a prototype) so the two can be checked against
+// each other. Like a web view, a document which is not well formed parses into a <parsererror> document
+// instead of throwing.
+//
+// Usage: require('./DOMParserStandIn.js').install(context) before running AdResolver.js in the vm context.
+//
+
+/*jslint node: true */
+"use strict";
+
+var ELEMENT_NODE = 1,
+    ATTRIBUTE_NODE = 2,
+    TEXT_NODE = 3,
+    CDATA_SECTION_NODE = 4,
+    PROCESSING_INSTRUCTION_NODE = 7,
+    COMMENT_NODE = 8,
+    DOCUMENT_NODE = 9,
+
+    // CDATA, comment, processing instruction, declaration, end tag, start tag (name, attributes, empty) or text
+    TOKEN_PATTERN = /<!\[CDATA\[([\s\S]*?)\]\]>|<!--([\s\S]*?)-->|<\?([^\s?]+)[\s\S]*?\?>|<!(?!--|\[CDATA\[)[^>]*>|<\/([^\s>]+)\s*>|<([^\s<>\/!?]+)((?:\s+[^\s=<>\/]+\s*=\s*(?:"[^"<]*"|'[^'<]*'))*)\s*(\/?)>|([^<]+)/y,
+    ATTRIBUTE_PATTERN = /([^\s=]+)\s*=\s*(?:"([^"]*)"|'([^']*)')/g,
+    ENTITIES = { amp: '&', lt: '<', gt: '>', quot: '"', apos: "'" },
+
+    decodeEntities = function (text) {
+        return text.replace(/&(?:#x([0-9a-fA-F]+)|#([0-9]+)|([a-z]+));/g, function (match, hex, decimal, name) {
+            if (name) {
+                if (!ENTITIES.hasOwnProperty(name)) {
+                    throw new Error('undefined entity ' + match);
+                }
+                return ENTITIES[name];
+            }
+            return String.fromCodePoint(hex ? parseInt(hex, 16) : parseInt(decimal, 10));
+        });
+    },
+
+    DOMNode = function (nodeType, nodeName, nodeValue) {
+        this.nodeType = nodeType;
+        this.nodeName = nodeName;
+        this.nodeValue = (nodeValue === undefined) ? null : nodeValue;
+        this.parentNode = null;
+        this.childNodes = [];
+    },
+
+    appendChild = function (parentNode, node) {
+        node.parentNode = parentNode;
+        parentNode.childNodes.push(node);
+        return node;
+    },
+
+    createElement = function (qualifiedName, attributeText) {
+        var element = new DOMNode(ELEMENT_NODE, qualifiedName),
+            match,
+            attr;
+
+        element.prefix = (qualifiedName.indexOf(':') < 0) ? null : qualifiedName.split(':')[0];
+        element.localName = qualifiedName.split(':').pop();
+        element.attributes = [];
+        ATTRIBUTE_PATTERN.lastIndex = 0;
+        while ((match = ATTRIBUTE_PATTERN.exec(attributeText || '')) !== null) {
+            attr = new DOMNode(ATTRIBUTE_NODE, match[1], decodeEntities(match[2] !== undefined ? match[2] : match[3]));
+            attr.name = attr.nodeName;
+            attr.value = attr.nodeValue;
+            attr.localName = attr.nodeName.split(':').pop();
+            element.attributes.push(attr);
+        }
+        return element;
+    },
+
+    parse = function (xmlText) {
+        ///<returns type="Object">The document node. Throws if the XML is not well formed.</returns>
+        var documentNode = new DOMNode(DOCUMENT_NODE, '#document'),
+            currentNode = documentNode,
+            position = 0,
+            element,
+            match;
+
+        while (position < xmlText.length) {
+            TOKEN_PATTERN.lastIndex = position;
+            match = TOKEN_PATTERN.exec(xmlText);
+            if (match === null) {
+                throw new Error('not well-formed at ' + position.toString());
+            }
+            position = TOKEN_PATTERN.lastIndex;
+            if (match[1] !== undefined) {
+                appendChild(currentNode, new DOMNode(CDATA_SECTION_NODE, '#cdata-section', match[1]));
+            } else if (match[2] !== undefined) {
+                appendChild(currentNode, new DOMNode(COMMENT_NODE, '#comment', match[2]));
+            } else if (match[3] !== undefined) {
+                // Note: the XML declaration is not a node
+                if (match[3] !== 'xml') {
+                    appendChild(currentNode, new DOMNode(PROCESSING_INSTRUCTION_NODE, match[3], ''));
+                }
+            } else if (match[4] !== undefined) {
+                if (currentNode === documentNode || match[4] !== currentNode.nodeName) {
+                    throw new Error('mismatched end tag </' + match[4] + '>');
+                }
+                currentNode = currentNode.parentNode;
+            } else if (match[5] !== undefined) {
+                if (currentNode === documentNode && documentNode.documentElement) {
+                    throw new Error('more than one document element');
+                }
+                element = appendChild(currentNode, createElement(match[5], match[6]));
+                if (currentNode === documentNode) {
+                    documentNode.documentElement = element;
+                }
+                if (match[7] !== '/') {
+                    currentNode = element;
+                }
+            } else if (match[8] !== undefined && currentNode !== documentNode) {
+                // Note: only white space may be outside the document element, and it is not a node
+                appendChild(currentNode, new DOMNode(TEXT_NODE, '#text', decodeEntities(match[8])));
+            } else if (match[8] !== undefined && /\S/.test(match[8])) {
+                throw new Error('text outside the document element');
+            }
+        }
+        if (currentNode !== documentNode || !documentNode.documentElement) {
+            throw new Error('no complete document element');
+        }
+        return documentNode;
+    },
+
+    DOMParser = function () {
+        return;
+    };
+
+Object.defineProperty(DOMNode.prototype, 'firstChild', { get: function () { return this.childNodes[0] || null; } });
+Object.defineProperty(DOMNode.prototype, 'textContent', {
+    get: function () {
+        return (this.nodeType === ELEMENT_NODE || this.nodeType === DOCUMENT_NODE) ?
+                this.childNodes.map(function (node) { return (node.nodeType === COMMENT_NODE || node.nodeType === PROCESSING_INSTRUCTION_NODE) ? '' : node.textContent; }).join('') :
+                this.nodeValue;
+    }
+});
+DOMNode.prototype.getAttribute = function (name) {
+    var i;
+
+    for (i = 0; this.attributes && i < this.attributes.length; i += 1) {
+        if (this.attributes[i].nodeName === name) {
+            return this.attributes[i].nodeValue;
+        }
+    }
+    return null;
+};
+
+DOMParser.count = 0;        // documents parsed, so a tool can tell which parser AdResolver used
+DOMParser.prototype.parseFromString = function (xmlText, mimeType) {
+    var documentNode;
+
+    DOMParser.count += 1;
+    try {
+        return parse(String(xmlText));
+    }
+    catch (ex) {
+        documentNode = new DOMNode(DOCUMENT_NODE, '#document');
+        documentNode.documentElement = appendChild(documentNode, createElement('parsererror', ''));
+        appendChild(documentNode.documentElement, new DOMNode(TEXT_NODE, '#text', (mimeType || 'XML') + ' parse error: ' + ex.message));
+        return documentNode;
+    }
+};
+
+module.exports = {
+    DOMParser: DOMParser,
+
+    install: function (context) {
+        ///<summary>Make the stand-in the DOMParser of a vm context</summary>
+        context.DOMParser = DOMParser;
+        return context;
+    }
+};
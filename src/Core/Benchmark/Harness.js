@@ -0,0 +1,155 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is the Node.js module shared by the benchmark, check and trace replay tools. It loads the core
+// scripts into a fresh vm context as the native Sequencer loads them into the web view, calls them as the native
+// bridge does, and runs the checks of a CHECKS object:
+//     CHECKS = { name: function (expect) { expect(condition, description); ... }, ... }
+// printing each failed expectation and "N checks, M failed", with the exit code 1 if any failed.
+//
+// Usage: var harness = require(path.join(__dirname, 'Harness.js'));
+//
+
+/*jslint node: true */
+"use strict";
+
+var fs = require('fs'),
+    path = require('path'),
+    vm = require('vm'),
+    domParserStandIn = require(path.join(__dirname, 'DOMParserStandIn.js')),
+
+    SCHEDULER_SCRIPT = path.join(__dirname, '..', 'Scheduler', 'Scheduler.js'),
+    SEQUENCER_SCRIPT = path.join(__dirname, '..', 'Sequencer', 'Sequencer.js'),
+    AD_RESOLVER_SCRIPT = path.join(__dirname, '..', 'AdResolver', 'AdResolver.js'),
+
+    loadScripts = function (scripts, options) {
+        ///<summary>Load scripts, in order, into a fresh context</summary>
+        ///<param name="scripts" type="Array">The script file names</param>
+        ///<param name="options" type="Object" optional="true">An object with optional properties: hasDOMParser (install DOMParserStandIn.js), globals (more properties of the context global)</param>
+        ///<returns type="Object">The PLAYER_SEQUENCER namespace of the context</returns>
+        var globals = { console: console },
+            context,
+            name,
+            i;
+
+        options = options || {};
+        for (name in options.globals) {
+            if (options.globals.hasOwnProperty(name)) {
+                globals[name] = options.globals[name];
+            }
+        }
+        context = vm.createContext(globals);
+        if (options.hasDOMParser) {
+            domParserStandIn.install(context);
+        }
+        for (i = 0; i < scripts.length; i += 1) {
+            vm.runInContext(fs.readFileSync(scripts[i], 'utf8'), context, { filename: scripts[i] });
+        }
+        return context.PLAYER_SEQUENCER;
+    },
+
+    callJSON = function (target, func, params) {
+        ///<summary>Call a runJSON method as the native bridge does, throwing on an EXCEPTION result</summary>
+        ///<returns type="Object">The parsed result, undefined for a method without result</returns>
+        var resultJSON = target.runJSON(JSON.stringify({ func: func, params: params })),
+            result = (resultJSON === undefined) ? undefined : JSON.parse(resultJSON);
+
+        if (result && result.EXCEPTION) {
+            throw new Error(func + ' failed: ' + result.EXCEPTION.message);
+        }
+        return result;
+    },
+
+    callCompact = function (chain, args) {
+        ///<summary>Call runCompact, throwing on an EXCEPTION result</summary>
+        ///<returns type="String">The compact tuple</returns>
+        var result = chain.runCompact.apply(chain, args);
+
+        if (result.charAt(0) === '{') {
+            throw new Error(args[0] + ' failed: ' + JSON.parse(result).EXCEPTION.message);
+        }
+        return result;
+    },
+
+    throwsError = function (call, name) {
+        ///<returns type="Boolean">true if the call throws an exception with the given name (any exception if name is not given)</returns>
+        try {
+            call();
+        }
+        catch (ex) {
+            return !name || (ex && ex.name === name);
+        }
+        return false;
+    },
+
+    createRandom = function (seed) {
+        ///<summary>A deterministic pseudo-random generator, so every run does the same work</summary>
+        var state = seed;
+
+        return function () {
+            state = (state * 1103515245 + 12345) % 2147483648;
+            return state / 2147483648;
+        };
+    },
+
+    now = function () {
+        ///<returns type="Number">A monotonic time in nanoseconds</returns>
+        var time = process.hrtime();
+        return time[0] * 1e9 + time[1];
+    },
+
+    runChecks = function (checks) {
+        ///<summary>Run every check of a CHECKS object, print the failures and the counts, and set the exit code</summary>
+        ///<returns type="Number">The number of failed expectations</returns>
+        var failureCount = 0,
+            checkCount = 0,
+            name,
+            expect = function (condition, description) {
+                checkCount += 1;
+                if (!condition) {
+                    failureCount += 1;
+                    console.log('FAIL ' + name + ': ' + description);
+                }
+            };
+
+        for (name in checks) {
+            if (checks.hasOwnProperty(name)) {
+                try {
+                    checks[name](expect);
+                }
+                catch (ex) {
+                    expect(false, 'unexpected exception ' + (ex && ex.message));
+                }
+            }
+        }
+        console.log(checkCount + ' checks, ' + failureCount + ' failed');
+        process.exitCode = (failureCount > 0) ? 1 : 0;
+        return failureCount;
+    };
+
+module.exports = {
+    SCHEDULER_SCRIPT: SCHEDULER_SCRIPT,
+    SEQUENCER_SCRIPT: SEQUENCER_SCRIPT,
+    AD_RESOLVER_SCRIPT: AD_RESOLVER_SCRIPT,
+    CORE_SCRIPTS: [SCHEDULER_SCRIPT, SEQUENCER_SCRIPT, AD_RESOLVER_SCRIPT],
+    PLUGIN_SCRIPT: path.join(__dirname, '..', '..', 'iOS', 'HLSClient', 'SequencerPlugin.js'),
+    loadScripts: loadScripts,
+    callJSON: callJSON,
+    callCompact: callCompact,
+    throwsError: throwsError,
+    createRandom: createRandom,
+    now: now,
+    runChecks: runChecks
+};
@@ -0,0 +1,223 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which checks the live window mode (setLiveWindow) of the Scheduler
+// and Sequencer when the playing entry slides out of the window as live chunks are appended:
+//     insideWindow        playback inside the window goes on to the next entry as in VOD mode
+//     playingContent      a content entry slid out of the window (and evicted): tick reports playbackRangeExceeded,
+//                         and onEndOfMedia and onEndOfBuffering continue at the window start
+//     playingAd           a deleteAfterPlay ad slid out of the window is evicted, not removed as played, and
+//                         playback continues at the window start
+//     playingBackward     playing backward from an entry behind the window ends the sequence
+//     windowInTicks       after setTimescale the window duration is in ticks, and a window set before is rescaled
+//     snapshotWindow      restoreSnapshot keeps the window, and refuses window properties which are not numbers
+//
+// Usage: node LiveWindowCheck.js
+//
+// The exit code is 1 if any check fails.
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    WINDOW_DURATION = 200,
+    CHUNK_DURATION = 60,
+
+    createLive = function () {
+        ///<summary>Load the Scheduler and Sequencer into a fresh context in live mode</summary>
+        ///<returns type="Object">An object with: namespace, appendChunks (count), scheduler and sequencer runJSON calls throwing on an EXCEPTION</returns>
+        var chunkCount = 0,
+            live;
+
+        live = {
+            namespace: harness.loadScripts([harness.SCHEDULER_SCRIPT, harness.SEQUENCER_SCRIPT]),
+            scheduler: function (func, params) {
+                return harness.callJSON(live.namespace.scheduler, func, params);
+            },
+            sequencer: function (func, params) {
+                return harness.callJSON(live.namespace.sequencerPluginChain, func, params);
+            },
+            appendChunks: function (count) {
+                var j;
+
+                for (j = 0; j < count; j += 1) {
+                    live.scheduler('appendContentClip', { clipURI: 'http://example.com/chunk' + chunkCount.toString() + '.ts',
+                        minManifestPosition: 0, maxManifestPosition: CHUNK_DURATION });
+                    chunkCount += 1;
+                }
+            },
+            tick: function (segment, position, playbackRate) {
+                return live.sequencer('tick', { currentSegmentId: segment.segmentId, playbackRate: playbackRate || 1, currentPlaybackPosition: position });
+            },
+            windowStart: function () {
+                return live.namespace.sequentialPlaylist.access.getWindowStart();
+            },
+            liveSegmentCount: function () {
+                return live.namespace.playbackSegmentPool.getStatistics().liveCount;
+            }
+        };
+        live.scheduler('setLiveWindow', { windowDuration: WINDOW_DURATION });
+        return live;
+    },
+
+    seekbarPosition = function (live, segment) {
+        return live.tick(segment, segment.initialPlaybackStartTime).currentSeekbarPosition;
+    },
+
+    TIMESCALE = 90000,
+
+    CHECKS = {
+        insideWindow: function (expect) {
+            var live = createLive(),
+                segment,
+                next,
+                result;
+
+            live.appendChunks(5);
+            // the last chunk stays in the window as the next one is appended
+            segment = live.sequencer('seekFromLinearPosition', { linearSeekPosition: 4 * CHUNK_DURATION });
+            live.appendChunks(1);
+            result = live.tick(segment, CHUNK_DURATION - 1);
+            expect(!result.playbackRangeExceeded, 'no range exceeded while the playing entry is in the window: ' + JSON.stringify(result));
+            next = live.sequencer('onEndOfMedia', { currentSegmentId: segment.segmentId, currentPlaybackPosition: CHUNK_DURATION, currentPlaybackRate: 1 });
+            expect(next.clip.linearStartTime === segment.clip.linearStartTime + CHUNK_DURATION && next.initialPlaybackStartTime === 0,
+                'the next chunk plays from its start: ' + next.clip.linearStartTime + ' at ' + next.initialPlaybackStartTime);
+            expect(live.liveSegmentCount() === 1, 'only the next segment is live');
+        },
+
+        playingContent: function (expect) {
+            var live = createLive(),
+                segment,
+                buffered,
+                next,
+                result;
+
+            live.appendChunks(5);
+            segment = live.sequencer('seekFromLinearPosition', { linearSeekPosition: 0 });
+            live.appendChunks(15);
+            expect(live.namespace.sequentialPlaylist.access.isEntryBeforeWindow(segment.clip), 'the playing entry is behind the window start ' + live.windowStart());
+            expect(live.namespace.sequentialPlaylist.access.getStatistics().evictedCount > 0, 'entries were evicted');
+
+            result = live.tick(segment, CHUNK_DURATION / 2);
+            expect(result.playbackRangeExceeded, 'tick reports the range exceeded: ' + JSON.stringify(result));
+            expect(result.minSeekbarPosition === live.windowStart(), 'the minimum seekbar position is the window start');
+
+            buffered = live.sequencer('onEndOfBuffering', { currentSegmentId: segment.segmentId, currentPlaybackPosition: CHUNK_DURATION, currentPlaybackRate: 1 });
+            expect(buffered && seekbarPosition(live, buffered) === live.windowStart(), 'onEndOfBuffering buffers from the window start');
+            live.sequencer('releasePlaybackSegment', { currentSegmentId: buffered.segmentId });
+
+            next = live.sequencer('onEndOfMedia', { currentSegmentId: segment.segmentId, currentPlaybackPosition: CHUNK_DURATION, currentPlaybackRate: 1 });
+            expect(next && seekbarPosition(live, next) === live.windowStart(), 'onEndOfMedia continues at the window start ' + live.windowStart() +
+                ': ' + (next && seekbarPosition(live, next)));
+            expect(!live.tick(next, next.initialPlaybackStartTime + 1).playbackRangeExceeded, 'playback at the window start is in range');
+            expect(live.liveSegmentCount() === 1, 'the segment behind the window was released');
+
+            next = live.sequencer('onEndOfMedia', { currentSegmentId: next.segmentId, currentPlaybackPosition: next.clip.maxRenderingTime, currentPlaybackRate: 1 });
+            expect(next && next.clip.linearStartTime === 1020 && next.initialPlaybackStartTime === 0, 'playback goes on to the following chunk');
+        },
+
+        playingAd: function (expect) {
+            var live = createLive(),
+                access,
+                segment,
+                next,
+                version,
+                changes;
+
+            live.appendChunks(5);
+            live.scheduler('scheduleClip', { clipURI: 'http://example.com/ad.m3u8', eClipType: 'Media', eRollType: 'Mid',
+                minManifestPosition: 0, maxManifestPosition: 15, linearDuration: 0, startTime: 150, deleteAfterPlay: true });
+            segment = live.sequencer('seekFromLinearPosition', { linearSeekPosition: 150 });
+            expect(segment.clip.isAdvertisement, 'the ad plays');
+            access = live.namespace.sequentialPlaylist.access;
+            version = access.getVersion();
+            live.appendChunks(15);
+
+            expect(live.tick(segment, 5).playbackRangeExceeded, 'tick reports the range exceeded for the ad behind the window');
+            next = live.sequencer('onEndOfMedia', { currentSegmentId: segment.segmentId, currentPlaybackPosition: 15, currentPlaybackRate: 1 });
+            expect(next && !next.clip.isAdvertisement && seekbarPosition(live, next) === live.windowStart(), 'content plays on from the window start');
+            changes = access.getChangesSince(version).changes;
+            expect(changes.some(function (delta) { return delta.change === 'evict' && delta.id === segment.clip.id; }), 'the ad was evicted');
+            expect(!changes.some(function (delta) { return delta.change === 'remove'; }), 'the evicted ad was not removed as played');
+        },
+
+        playingBackward: function (expect) {
+            var live = createLive(),
+                segment,
+                next;
+
+            live.appendChunks(5);
+            segment = live.sequencer('seekFromLinearPosition', { linearSeekPosition: 0 });
+            live.appendChunks(15);
+            expect(live.tick(segment, 10, -1).playbackRangeExceeded, 'tick reports the range exceeded playing backward');
+            next = live.sequencer('onEndOfMedia', { currentSegmentId: segment.segmentId, currentPlaybackPosition: 0, currentPlaybackRate: -1 });
+            expect(next === null, 'playing backward from behind the window ends the sequence');
+            expect(live.liveSegmentCount() === 0, 'the segment was released');
+        },
+
+        windowInTicks: function (expect) {
+            var live = createLive(),
+                i;
+
+            // the window of createLive, set in seconds before the timescale
+            live.scheduler('setTimescale', { timescale: TIMESCALE });
+            for (i = 0; i < 10; i += 1) {
+                live.scheduler('appendContentClip', { clipURI: 'http://example.com/tick' + i.toString() + '.ts',
+                    minManifestPosition: 0, maxManifestPosition: CHUNK_DURATION * TIMESCALE });
+            }
+            expect(live.windowStart() === (10 * CHUNK_DURATION - WINDOW_DURATION) * TIMESCALE, 'the window duration was rescaled to ticks: ' + live.windowStart());
+
+            live.scheduler('setLiveWindow', { windowDuration: WINDOW_DURATION / 2 * TIMESCALE });
+            live.scheduler('appendContentClip', { clipURI: 'http://example.com/tick10.ts', minManifestPosition: 0, maxManifestPosition: CHUNK_DURATION * TIMESCALE });
+            expect(live.windowStart() === (11 * CHUNK_DURATION - WINDOW_DURATION / 2) * TIMESCALE, 'the window duration is in ticks: ' + live.windowStart());
+            expect(live.namespace.sequentialPlaylist.access.getSnapshot().windowDuration === WINDOW_DURATION / 2 * TIMESCALE, 'the snapshot window duration is in ticks');
+
+            expect(/invalid duration/.test(live.namespace.scheduler.runJSON(JSON.stringify({ func: 'setLiveWindow', params: { windowDuration: 1.5 } }))),
+                'a window duration which is not whole ticks is refused');
+
+            live.scheduler('reset', {});
+            live.scheduler('setTimescale', { timescale: 0 });
+            expect(live.namespace.sequentialPlaylist.access.getSnapshot().windowDuration === WINDOW_DURATION / 2, 'the window duration was rescaled back to seconds');
+        },
+
+        snapshotWindow: function (expect) {
+            var live = createLive(),
+                restored = createLive(),
+                snapshot,
+                isRefused = function (name, value) {
+                    var invalid = JSON.parse(JSON.stringify(snapshot));
+
+                    invalid[name] = value;
+                    return /invalid windowDuration or windowStart/.test(restored.namespace.scheduler.runJSON(JSON.stringify({ func: 'restoreSnapshot', params: { snapshot: invalid } })));
+                };
+
+            live.appendChunks(6);
+            snapshot = live.scheduler('getSnapshot', {});
+            restored.scheduler('setLiveWindow', { windowDuration: 0 });
+            restored.scheduler('restoreSnapshot', { snapshot: snapshot });
+            expect(restored.windowStart() === live.windowStart() && restored.windowStart() === 6 * CHUNK_DURATION - WINDOW_DURATION, 'the window is restored: ' + restored.windowStart());
+            expect(isRefused('windowDuration', String(WINDOW_DURATION)), 'a windowDuration string is refused');
+            expect(isRefused('windowDuration', null), 'a null windowDuration is refused');
+            expect(isRefused('windowDuration', true), 'a boolean windowDuration is refused');
+            expect(isRefused('windowDuration', -1), 'a negative windowDuration is refused');
+            expect(isRefused('windowStart', String(live.windowStart())), 'a windowStart string is refused');
+            expect(restored.windowStart() === live.windowStart(), 'a refused snapshot leaves the schedule unchanged');
+        }
+    };
+
+harness.runChecks(CHECKS);
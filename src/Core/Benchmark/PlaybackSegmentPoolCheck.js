@@ -0,0 +1,161 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which checks the playback segment pool of Sequencer.js
+// (PLAYER_SEQUENCER.createPlaybackSegmentPool), where a segmentId is generation * 65536 + slot:
+//     slotReuse           a released slot is reused with the next generation
+//     staleId             a released or stale segmentId, or one which was never created, is rejected
+//     capacity            creating a segment beyond the capacity throws until one is released
+//     generationWrap      the generation wraps back to 1 after 32767 reuses of a slot, keeping every segmentId
+//                         a positive signed 32 bit int, and the segmentId before the wrap is rejected
+//     reset               testProbe_reset releases every live segment
+//
+// Usage: node PlaybackSegmentPoolCheck.js
+//
+// The exit code is 1 if any check fails.
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    SLOT_LIMIT = 65536,
+    GENERATION_LIMIT = Math.floor(0x7FFFFFFF / SLOT_LIMIT),
+
+    createPool = function () {
+        ///<summary>Load the Scheduler and Sequencer into a fresh context and create a pool</summary>
+        ///<returns type="Object">A new playback segment pool</returns>
+        return harness.loadScripts([harness.SCHEDULER_SCRIPT, harness.SEQUENCER_SCRIPT]).createPlaybackSegmentPool();
+    },
+
+    createClip = function () {
+        return { splitCount: 0 };
+    },
+
+    throwsSequencerError = function (call) {
+        return harness.throwsError(call, 'PLAYER_SEQUENCER:SequencerError');
+    },
+
+    CHECKS = {
+        slotReuse: function (expect) {
+            var pool = createPool(),
+                first = pool.createPlaybackSegment(createClip(), 0, 1),
+                second = pool.createPlaybackSegment(createClip(), 0, 1),
+                firstId = first.segmentId,
+                reused;
+
+            expect(firstId === 1 * SLOT_LIMIT + 0, 'first segmentId is generation 1 slot 0: ' + firstId);
+            expect(second.segmentId === 1 * SLOT_LIMIT + 1, 'second segmentId is generation 1 slot 1: ' + second.segmentId);
+            pool.releasePlaybackSegment(firstId);
+            reused = pool.createPlaybackSegment(createClip(), 5, 2);
+            expect(reused.segmentId === 2 * SLOT_LIMIT + 0, 'released slot 0 is reused with generation 2: ' + reused.segmentId);
+            expect(pool.getPlaybackSegment(reused.segmentId) === reused, 'reused segment is found by its segmentId');
+            expect(pool.getPlaybackSegment(second.segmentId) === second, 'other live segment is unaffected');
+            expect(pool.getStatistics().liveCount === 2 && pool.getStatistics().createCount === 3 && pool.getStatistics().releaseCount === 1,
+                'statistics count 3 created, 1 released, 2 live: ' + JSON.stringify(pool.getStatistics()));
+        },
+
+        staleId: function (expect) {
+            var pool = createPool(),
+                segment = pool.createPlaybackSegment(createClip(), 0, 1),
+                staleId = segment.segmentId;
+
+            pool.releasePlaybackSegment(staleId);
+            expect(throwsSequencerError(function () { pool.getPlaybackSegment(staleId); }), 'get of a released segmentId throws');
+            expect(throwsSequencerError(function () { pool.releasePlaybackSegment(staleId); }), 'second release of a segmentId throws');
+
+            // the slot is reused: the old segmentId must not alias the new segment
+            segment = pool.createPlaybackSegment(createClip(), 0, 1);
+            expect(segment.segmentId % SLOT_LIMIT === staleId % SLOT_LIMIT, 'the slot of the stale segmentId is reused');
+            expect(throwsSequencerError(function () { pool.getPlaybackSegment(staleId); }), 'get of a stale segmentId of a reused slot throws');
+            expect(throwsSequencerError(function () { pool.releasePlaybackSegment(staleId); }), 'release of a stale segmentId of a reused slot throws');
+            expect(pool.getPlaybackSegment(segment.segmentId) === segment, 'the new segment is still live after the stale release');
+
+            [undefined, null, '65536', 0, -1, SLOT_LIMIT - 1, segment.segmentId + 1, segment.segmentId + SLOT_LIMIT].forEach(function (badId) {
+                expect(throwsSequencerError(function () { pool.getPlaybackSegment(badId); }), 'get of segmentId ' + String(badId) + ' throws');
+            });
+        },
+
+        capacity: function (expect) {
+            var pool = createPool(),
+                segments = [],
+                i;
+
+            pool.setCapacity(3);
+            for (i = 0; i < 3; i += 1) {
+                segments.push(pool.createPlaybackSegment(createClip(), 0, 1));
+            }
+            expect(throwsSequencerError(function () { pool.createPlaybackSegment(createClip(), 0, 1); }), 'create beyond the capacity of 3 throws');
+            expect(pool.getStatistics().liveCount === 3 && pool.getStatistics().createCount === 3, 'a failed create changes no counter');
+            pool.releasePlaybackSegment(segments[1].segmentId);
+            segments[1] = pool.createPlaybackSegment(createClip(), 0, 1);
+            expect(segments[1].segmentId === 2 * SLOT_LIMIT + 1, 'create after a release reuses the released slot: ' + segments[1].segmentId);
+            expect(pool.getStatistics().highWaterMark === 3 && pool.getStatistics().capacity === 3, 'high water mark and capacity are 3');
+
+            [0, SLOT_LIMIT + 1, '10', undefined].forEach(function (badCapacity) {
+                expect(throwsSequencerError(function () { pool.setCapacity(badCapacity); }), 'setCapacity(' + String(badCapacity) + ') throws');
+            });
+            expect(pool.getStatistics().capacity === 3, 'an invalid setCapacity keeps the capacity');
+        },
+
+        generationWrap: function (expect) {
+            var pool = createPool(),
+                firstId,
+                lastId = 0,
+                segment,
+                maxId = 0,
+                i;
+
+            pool.setCapacity(1);
+            for (i = 0; i < GENERATION_LIMIT; i += 1) {
+                segment = pool.createPlaybackSegment(createClip(), 0, 1);
+                if (i === 0) {
+                    firstId = segment.segmentId;
+                }
+                if (segment.segmentId <= lastId && i > 0) {
+                    expect(false, 'segmentIds increase before the wrap: ' + lastId + ' then ' + segment.segmentId);
+                }
+                lastId = segment.segmentId;
+                maxId = Math.max(maxId, lastId);
+                pool.releasePlaybackSegment(lastId);
+            }
+            expect(lastId === GENERATION_LIMIT * SLOT_LIMIT, 'last segmentId before the wrap is generation ' + GENERATION_LIMIT + ': ' + lastId);
+            expect(maxId <= 0x7FFFFFFF, 'every segmentId is a signed 32 bit int: ' + maxId);
+
+            segment = pool.createPlaybackSegment(createClip(), 0, 1);
+            expect(segment.segmentId === firstId, 'the generation wraps back to 1: ' + segment.segmentId);
+            expect(segment.segmentId > 0, 'the wrapped segmentId is positive');
+            expect(throwsSequencerError(function () { pool.getPlaybackSegment(lastId); }), 'the segmentId before the wrap is rejected');
+            expect(pool.getPlaybackSegment(firstId) === segment, 'the wrapped segmentId finds the new segment');
+        },
+
+        reset: function (expect) {
+            var pool = createPool(),
+                ids = [],
+                i;
+
+            for (i = 0; i < 5; i += 1) {
+                ids.push(pool.createPlaybackSegment(createClip(), 0, 1).segmentId);
+            }
+            pool.testProbe_reset();
+            expect(pool.getStatistics().liveCount === 0, 'no live segment after a reset');
+            expect(ids.every(function (id) { return throwsSequencerError(function () { pool.getPlaybackSegment(id); }); }), 'every segmentId is rejected after a reset');
+            expect(pool.createPlaybackSegment(createClip(), 0, 1).segmentId >= 2 * SLOT_LIMIT, 'a slot freed by the reset is reused with a new generation');
+        }
+    };
+
+harness.runChecks(CHECKS);
@@ -0,0 +1,225 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which soaks the playback segment pool with 24 hours of simulated
+// ad-stitched playback: a 24-hour timeline with a pod of deleteAfterPlay ads every AD_BREAK_INTERVAL, played through
+// runJSON the way SequencerAVPlayerFramework drives the Sequencer:
+//     end of media    onEndOfBuffering preloads the next segment PRELOAD_LEAD before the end, onEndOfMedia returns the
+//                     segment to play, and the preloaded one is kept (the duplicate released) or released
+//     seek            seekFromLinearPosition replaces the current segment, before or after the preload, and the
+//                     preloaded segment is released (playSegmentAfterSeek:)
+//     preload drop    a preloaded segment which fails to load is released and playback goes on at the end of media
+// The Date.now of the context is a simulated clock, so oldestLiveAge is in simulated time. Every simulated hour it
+// reports the pool liveCount, highWaterMark and oldestLiveAge.
+//
+// Usage: node PlaybackSegmentSoak.js [--hours <count>] [--leak-preload-on-seek]
+//     --hours                  simulated hours of playback (default 24)
+//     --leak-preload-on-seek   drop the preloaded segment on a seek without releasing it, as playSegmentAfterSeek:
+//                              used to, to show the leak this soak detects
+//
+// The exit code is 1 if more than 2 segments (playing and preloaded) are live between calls, a segment lives
+// longer than MAX_SEGMENT_AGE, or any segment is still live once playback is stopped.
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    CONTENT_CLIP_COUNT = 24,
+    CONTENT_CLIP_DURATION = 3600,   // seconds
+    AD_BREAK_INTERVAL = 600,        // seconds
+    AD_DURATION = 30,               // seconds
+    ADS_PER_BREAK = 2,
+    PRELOAD_LEAD = 10,              // seconds before the end of a segment
+    EARLY_SEEK_PROBABILITY = 0.05,  // per segment, a seek before the preload
+    LATE_SEEK_PROBABILITY = 0.1,    // per segment, a seek after the preload
+    PRELOAD_DROP_PROBABILITY = 0.05,
+    MAX_LIVE_COUNT = 2,
+    MAX_SEGMENT_AGE = 2 * CONTENT_CLIP_DURATION * 1000, // milliseconds
+
+    parseArguments = function (argv) {
+        var options = { hours: 24, isPreloadLeakedOnSeek: false },
+            i;
+
+        for (i = 0; i < argv.length; i += 1) {
+            if (argv[i] === '--hours') {
+                i += 1;
+                options.hours = parseFloat(argv[i]);
+            } else if (argv[i] === '--leak-preload-on-seek') {
+                options.isPreloadLeakedOnSeek = true;
+            } else {
+                throw new Error('usage: node PlaybackSegmentSoak.js [--hours <count>] [--leak-preload-on-seek]');
+            }
+        }
+        return options;
+    },
+
+    createSession = function () {
+        ///<summary>Load the Scheduler and Sequencer into a fresh context with a simulated clock and schedule the ad-stitched timeline</summary>
+        ///<returns type="Object">An object with: namespace, clock ({ time } in milliseconds), scheduler and sequencer runJSON calls throwing on an EXCEPTION</returns>
+        var clock = { time: 0 },
+            session = {
+                clock: clock,
+                namespace: harness.loadScripts([harness.SCHEDULER_SCRIPT, harness.SEQUENCER_SCRIPT], {
+                    globals: { Date: { now: function () { return clock.time; } } }
+                }),
+                scheduler: function (func, params) {
+                    return harness.callJSON(session.namespace.scheduler, func, params);
+                },
+                sequencer: function (func, params) {
+                    return harness.callJSON(session.namespace.sequencerPluginChain, func, params);
+                }
+            },
+            startTime,
+            i;
+
+        for (i = 0; i < CONTENT_CLIP_COUNT; i += 1) {
+            session.scheduler('appendContentClip', { clipURI: 'http://example.com/content' + i.toString() + '.m3u8',
+                minManifestPosition: 0, maxManifestPosition: CONTENT_CLIP_DURATION });
+        }
+        for (startTime = AD_BREAK_INTERVAL; startTime < CONTENT_CLIP_COUNT * CONTENT_CLIP_DURATION; startTime += AD_BREAK_INTERVAL) {
+            for (i = 0; i < ADS_PER_BREAK; i += 1) {
+                session.scheduler('scheduleClip', { clipURI: 'http://example.com/ad' + i.toString() + '.mp4', eClipType: 'Media', eRollType: 'Mid',
+                    minManifestPosition: 0, maxManifestPosition: AD_DURATION, linearDuration: 0, startTime: startTime, deleteAfterPlay: true });
+            }
+        }
+        return session;
+    },
+
+    soak = function (options) {
+        ///<summary>Play the simulated hours, sampling the pool statistics every simulated hour</summary>
+        ///<returns type="Object">An object with properties: samples (array of { hour, liveCount, highWaterMark, oldestLiveAge }), counts ({ endOfMedia, seek, preloadDrop, restart }), finalLiveCount, failures (array of strings)</returns>
+        var session = createSession(),
+            pool = session.namespace.playbackSegmentPool,
+            random = harness.createRandom(104729),
+            endTime = options.hours * 3600 * 1000,
+            nextSampleTime = 3600 * 1000,
+            counts = { endOfMedia: 0, seek: 0, preloadDrop: 0, restart: 0 },
+            samples = [],
+            failures = [],
+            current,
+            preloaded = null,
+            next,
+            remaining,
+            statistics,
+
+            play = function (seconds) {
+                // advance the simulated clock, sampling the pool at each hour boundary crossed
+                var stopTime = session.clock.time + Math.max(0, seconds) * 1000;
+
+                while (nextSampleTime <= stopTime && nextSampleTime <= endTime) {
+                    session.clock.time = nextSampleTime;
+                    statistics = pool.getStatistics();
+                    samples.push({ hour: nextSampleTime / 3600000, liveCount: statistics.liveCount, highWaterMark: statistics.highWaterMark, oldestLiveAge: statistics.oldestLiveAge });
+                    nextSampleTime += 3600 * 1000;
+                }
+                session.clock.time = stopTime;
+            },
+
+            release = function (segment) {
+                if (segment) {
+                    session.sequencer('releasePlaybackSegment', { currentSegmentId: segment.segmentId });
+                }
+                return null;
+            },
+
+            check = function () {
+                statistics = pool.getStatistics();
+                if (statistics.liveCount > MAX_LIVE_COUNT) {
+                    failures.push('liveCount ' + statistics.liveCount + ' at ' + (session.clock.time / 1000).toFixed(0) + ' s');
+                }
+                if (statistics.oldestLiveAge > MAX_SEGMENT_AGE) {
+                    failures.push('oldestLiveAge ' + statistics.oldestLiveAge + ' ms at ' + (session.clock.time / 1000).toFixed(0) + ' s');
+                }
+            },
+
+            seek = function () {
+                // the whole timeline, so the seeks go backward as often as forward
+                current = session.sequencer('seekFromLinearPosition', { currentSegmentId: current.segmentId,
+                    linearSeekPosition: Math.floor(random() * CONTENT_CLIP_COUNT * CONTENT_CLIP_DURATION) });
+                counts.seek += 1;
+                preloaded = options.isPreloadLeakedOnSeek ? null : release(preloaded);
+            };
+
+        current = session.sequencer('seekFromLinearPosition', { linearSeekPosition: 0 });
+        while (session.clock.time < endTime && failures.length < 10) {
+            remaining = current.clip.maxRenderingTime - current.initialPlaybackStartTime;
+            if (random() < EARLY_SEEK_PROBABILITY) {
+                play(random() * remaining);
+                seek();
+            } else {
+                play(remaining - PRELOAD_LEAD);
+                preloaded = session.sequencer('onEndOfBuffering', { currentSegmentId: current.segmentId,
+                    currentPlaybackPosition: current.clip.maxRenderingTime - PRELOAD_LEAD, currentPlaybackRate: 1 });
+                if (preloaded && random() < PRELOAD_DROP_PROBABILITY) {
+                    preloaded = release(preloaded);
+                    counts.preloadDrop += 1;
+                }
+                check();
+                if (random() < LATE_SEEK_PROBABILITY) {
+                    play(random() * Math.min(PRELOAD_LEAD, remaining));
+                    seek();
+                } else {
+                    play(Math.min(PRELOAD_LEAD, remaining));
+                    next = session.sequencer('onEndOfMedia', { currentSegmentId: current.segmentId,
+                        currentPlaybackPosition: current.clip.maxRenderingTime, currentPlaybackRate: 1 });
+                    counts.endOfMedia += 1;
+                    if (preloaded && next && preloaded.clip.id === next.clip.id) {
+                        // keep the preloaded segment and release the duplicate one
+                        release(next);
+                        next = preloaded;
+                    } else {
+                        release(preloaded);
+                    }
+                    preloaded = null;
+                    current = next;
+                    if (!current) {
+                        // end of the timeline: play it again from the start
+                        current = session.sequencer('seekFromLinearPosition', { linearSeekPosition: 0 });
+                        counts.restart += 1;
+                    }
+                }
+            }
+            check();
+        }
+
+        release(preloaded);
+        release(current);
+        return { samples: samples, counts: counts, finalLiveCount: pool.getStatistics().liveCount, failures: failures };
+    },
+
+    main = function () {
+        var options = parseArguments(process.argv.slice(2)),
+            startTime = harness.now(),
+            result = soak(options),
+            i;
+
+        console.log(options.hours + ' simulated hours, ' + (CONTENT_CLIP_COUNT * CONTENT_CLIP_DURATION / AD_BREAK_INTERVAL - 1) + ' ad breaks of ' + ADS_PER_BREAK +
+            ' ads' + (options.isPreloadLeakedOnSeek ? ', leaking the preloaded segment on seeks' : ''));
+        console.log('hour\tliveCount\thighWaterMark\toldestLiveAge s');
+        for (i = 0; i < result.samples.length; i += 1) {
+            console.log([result.samples[i].hour, result.samples[i].liveCount, result.samples[i].highWaterMark, (result.samples[i].oldestLiveAge / 1000).toFixed(0)].join('\t'));
+        }
+        console.log('end of media ' + result.counts.endOfMedia + ', seeks ' + result.counts.seek + ', preload drops ' + result.counts.preloadDrop +
+            ', restarts ' + result.counts.restart + ', live after stop ' + result.finalLiveCount + ', ' + ((harness.now() - startTime) / 1e6).toFixed(0) + ' ms');
+        for (i = 0; i < result.failures.length; i += 1) {
+            console.log('FAIL ' + result.failures[i]);
+        }
+        process.exitCode = (result.failures.length > 0 || result.finalLiveCount > 0) ? 1 : 0;
+    };
+
+main();
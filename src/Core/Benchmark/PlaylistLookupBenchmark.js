@@ -0,0 +1,262 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which checks the indexed sequential playlist lookups (getEntryAtTime
+// by binary search, getEntryFromId by the id index) against the linear scans they replaced, on a large playlist
+// which is changed between the rounds of queries so the index is invalidated and rebuilt, and measures both.
+// It sweeps several playlist sizes in one run and prints the cost per query at each size, so the logarithmic
+// growth of the indexed lookups can be told from the linear growth of the scans.
+//
+// Usage: node PlaylistLookupBenchmark.js [--entries <count,...>] [--queries <count>]
+//     --entries       approximate playlist sizes (default 10,100,1000,10000)
+//     --queries       time and id queries per round (default 2000)
+//
+// The exit code is 1 if any indexed result differs from the linear scan.
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    CONTENT_CLIP_DURATION = 600,
+    ROUND_COUNT = 5,
+
+    parseArguments = function (argv) {
+        var options = { entries: [10, 100, 1000, 10000], queries: 2000 },
+            i;
+
+        for (i = 0; i < argv.length; i += 1) {
+            if (argv[i] === '--entries') {
+                i += 1;
+                options.entries = argv[i].split(',').map(function (count) { return parseInt(count, 10); });
+            } else if (argv[i] === '--queries') {
+                i += 1;
+                options.queries = parseInt(argv[i], 10);
+            } else {
+                throw new Error('usage: node PlaylistLookupBenchmark.js [--entries <count,...>] [--queries <count>]');
+            }
+        }
+        return options;
+    },
+
+    createScheduler = function () {
+        ///<summary>Load the Scheduler into a fresh context</summary>
+        ///<returns type="Object">The PLAYER_SEQUENCER namespace of the context</returns>
+        return harness.loadScripts([harness.SCHEDULER_SCRIPT]);
+    },
+
+    createRandom = harness.createRandom,
+
+    // ---------------------------------
+    // the linear scans replaced by the index (the baseline Scheduler.js code)
+    // ---------------------------------
+    linearIndexAtTime = function (entries, timeToFind) {
+        var i,
+            startTime;
+
+        for (i = 0; i < entries.length; i += 1) {
+            startTime = entries[i].linearStartTime;
+            if (Math.abs(startTime - timeToFind) < 0.001 ||
+                (startTime <= timeToFind && timeToFind < (startTime + entries[i].linearDuration))) {
+                break;
+            }
+        }
+        return i;
+    },
+
+    linearIndexFromId = function (entries, idToFind) {
+        var i;
+
+        for (i = 0; i < entries.length; i += 1) {
+            if (entries[i].id === idToFind) {
+                return i;
+            }
+        }
+        return -1;
+    },
+
+    buildPlaylist = function (namespace, entryCount, random) {
+        ///<summary>Append content clips and scatter mid-roll ads (some as pods sharing a start time) over them</summary>
+        ///<returns type="Array">The ids of the ads, which the rounds remove and replace</returns>
+        var scheduler = namespace.scheduler,
+            contentCount = Math.max(1, Math.floor(entryCount / 10)),
+            adIds = [],
+            params,
+            i;
+
+        for (i = 0; i < contentCount; i += 1) {
+            params = scheduler.createContentClipParams();
+            params.clipURI = 'http://example.com/content' + i.toString() + '.m3u8';
+            params.maxManifestPosition = CONTENT_CLIP_DURATION;
+            scheduler.appendContentClip(params);
+        }
+        while (namespace.sequentialPlaylist.access.getStatistics().entryCount < entryCount) {
+            adIds.push(scheduleAd(namespace, random, adIds));
+        }
+        return adIds;
+    },
+
+    scheduleAd = function (namespace, random, adIds) {
+        var scheduler = namespace.scheduler,
+            params = scheduler.createScheduleClipParams(),
+            duration = namespace.sequentialPlaylist.access.getPlaylistLinearDuration();
+
+        params.clipURI = 'http://example.com/ad.m3u8';
+        params.eClipType = 'Media';
+        params.maxManifestPosition = 30;
+        params.deleteAfterPlay = true;
+        if (adIds.length > 0 && random() < 0.2) {
+            // a pod: zero-duration entries sharing a start time
+            params.eRollType = 'Pod';
+            params.appendTo = adIds[Math.floor(random() * adIds.length)];
+        } else {
+            params.eRollType = 'Mid';
+            params.startTime = 1 + random() * (duration - 2);
+        }
+        return scheduler.scheduleClip(params).id;
+    },
+
+    createQueries = function (entries, count, random) {
+        ///<summary>Times inside entries, exactly at and within the tolerance of entry start times, and out of range; ids present and absent</summary>
+        var duration = entries.length > 0 ? entries[entries.length - 1].linearStartTime + entries[entries.length - 1].linearDuration : 0,
+            times = [-1, 0, duration, duration + 1],
+            ids = [0, -1],
+            entry,
+            i;
+
+        for (i = 0; i < count; i += 1) {
+            entry = entries[Math.floor(random() * entries.length)];
+            switch (i % 4) {
+                case 0:
+                    times.push(random() * duration);
+                    break;
+                case 1:
+                    times.push(entry.linearStartTime);
+                    break;
+                case 2:
+                    times.push(entry.linearStartTime + (random() - 0.5) * 0.0019);
+                    break;
+                default:
+                    times.push(entry.linearStartTime + entry.linearDuration);
+                    break;
+            }
+            ids.push((i % 10 === 0) ? entry.id + 1000000 : entry.id);
+        }
+        return { times: times, ids: ids };
+    },
+
+    now = function () {
+        // milliseconds
+        return harness.now() / 1e6;
+    },
+
+    runRound = function (namespace, queries, report) {
+        ///<summary>Run the queries through both implementations, counting mismatches and adding up their times</summary>
+        var access = namespace.sequentialPlaylist.access,
+            entries = JSON.parse(namespace.sequentialPlaylist.testProbe_toJSON()),
+            indexedIds = [],
+            linearIds = [],
+            startTime,
+            entry,
+            i;
+
+        startTime = now();
+        for (i = 0; i < queries.times.length; i += 1) {
+            entry = access.getEntryAtTime(queries.times[i]);
+            indexedIds.push(entry ? entry.id : null);
+        }
+        for (i = 0; i < queries.ids.length; i += 1) {
+            try {
+                indexedIds.push(access.getEntryFromId(queries.ids[i]).id);
+            }
+            catch (ex) {
+                indexedIds.push(null);
+            }
+        }
+        report.indexedMs += now() - startTime;
+
+        startTime = now();
+        for (i = 0; i < queries.times.length; i += 1) {
+            entry = entries[linearIndexAtTime(entries, queries.times[i])];
+            linearIds.push(entry ? entry.id : null);
+        }
+        for (i = 0; i < queries.ids.length; i += 1) {
+            entry = entries[linearIndexFromId(entries, queries.ids[i])];
+            linearIds.push(entry ? entry.id : null);
+        }
+        report.linearMs += now() - startTime;
+
+        report.queryCount += indexedIds.length;
+        for (i = 0; i < indexedIds.length; i += 1) {
+            if (indexedIds[i] !== linearIds[i]) {
+                report.mismatchCount += 1;
+                if (report.mismatches.length < 10) {
+                    report.mismatches.push({ query: (i < queries.times.length) ? 'time ' + queries.times[i] : 'id ' + queries.ids[i - queries.times.length],
+                        indexed: indexedIds[i], linear: linearIds[i] });
+                }
+            }
+        }
+        return entries.length;
+    },
+
+    measureSize = function (entryCount, queryCount, random) {
+        ///<summary>Run the rounds of queries on a fresh playlist of about entryCount entries</summary>
+        ///<returns type="Object">The report: entryCount, queryCount, mismatchCount, mismatches, indexedMs, linearMs</returns>
+        var namespace = createScheduler(),
+            adIds = buildPlaylist(namespace, entryCount, random),
+            report = { entryCount: 0, queryCount: 0, mismatchCount: 0, mismatches: [], indexedMs: 0, linearMs: 0 },
+            round,
+            i;
+
+        for (round = 0; round < ROUND_COUNT; round += 1) {
+            report.entryCount = runRound(namespace, createQueries(JSON.parse(namespace.sequentialPlaylist.testProbe_toJSON()), queryCount, random), report);
+
+            // change the playlist so the next round runs against a re-indexed list: remove and add back 5% of the ads
+            for (i = 0; i < adIds.length / 20; i += 1) {
+                namespace.scheduler.removeClip({ playlistEntryId: adIds.splice(Math.floor(random() * adIds.length), 1)[0] });
+            }
+            while (namespace.sequentialPlaylist.access.getStatistics().entryCount < entryCount) {
+                adIds.push(scheduleAd(namespace, random, adIds));
+            }
+        }
+        return report;
+    },
+
+    main = function () {
+        var options = parseArguments(process.argv.slice(2)),
+            random = createRandom(7919),
+            mismatchCount = 0,
+            report,
+            i,
+            j;
+
+        console.log(ROUND_COUNT + ' rounds of ' + options.queries + ' time and id queries per size');
+        console.log('entries	queries	indexed us/query	linear us/query	speedup');
+        for (i = 0; i < options.entries.length; i += 1) {
+            report = measureSize(options.entries[i], options.queries, random);
+            console.log([report.entryCount, report.queryCount, (1000 * report.indexedMs / report.queryCount).toFixed(3),
+                (1000 * report.linearMs / report.queryCount).toFixed(3), (report.linearMs / report.indexedMs).toFixed(1)].join('\t'));
+            mismatchCount += report.mismatchCount;
+            for (j = 0; j < report.mismatches.length; j += 1) {
+                console.log('MISMATCH ' + report.entryCount + ' entries ' + JSON.stringify(report.mismatches[j]));
+            }
+        }
+        console.log('mismatches: ' + mismatchCount);
+        process.exitCode = (mismatchCount > 0) ? 1 : 0;
+    };
+
+main();
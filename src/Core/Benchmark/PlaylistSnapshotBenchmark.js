@@ -0,0 +1,139 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which measures rebuilding a 500 entry sequential playlist by
+// replaying the appendContentClip and scheduleClip runJSON calls which built it, against restoring it from
+// the getSnapshot JSON with a single restoreSnapshot runJSON call (the native bridge path in both cases).
+//
+// Usage: node PlaylistSnapshotBenchmark.js [--iterations <count>]
+//     --iterations    rebuilds measured per case (default 500)
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    CONTENT_CLIP_COUNT = 10,
+    CONTENT_CLIP_DURATION = 600,
+    MIDROLL_COUNT = 245,            // each splits a content clip, for 10 + 2 * 245 = 500 entries
+    WARMUP_ITERATIONS = 50,
+
+    parseArguments = function (argv) {
+        var options = { iterations: 500 },
+            i;
+
+        for (i = 0; i < argv.length; i += 1) {
+            if (argv[i] === '--iterations') {
+                i += 1;
+                options.iterations = parseInt(argv[i], 10);
+            } else {
+                throw new Error('usage: node PlaylistSnapshotBenchmark.js [--iterations <count>]');
+            }
+        }
+        return options;
+    },
+
+    createScheduler = function () {
+        ///<summary>Load the Scheduler into a fresh context</summary>
+        ///<returns type="Object">The PLAYER_SEQUENCER namespace of the context</returns>
+        return harness.loadScripts([harness.SCHEDULER_SCRIPT]);
+    },
+
+    createScheduleCalls = function () {
+        ///<returns type="Array">The runJSON strings which build the schedule, in call order</returns>
+        var calls = [],
+            totalDuration = CONTENT_CLIP_COUNT * CONTENT_CLIP_DURATION,
+            i;
+
+        for (i = 0; i < CONTENT_CLIP_COUNT; i += 1) {
+            calls.push(JSON.stringify({ func: 'appendContentClip', params: {
+                clipURI: 'http://example.com/content' + i.toString() + '.m3u8', minManifestPosition: 0, maxManifestPosition: CONTENT_CLIP_DURATION } }));
+        }
+        for (i = 0; i < MIDROLL_COUNT; i += 1) {
+            // spread the start times over the content in a scattered order, as an ad server response would be
+            calls.push(JSON.stringify({ func: 'scheduleClip', params: {
+                clipURI: 'http://example.com/ad' + i.toString() + '.m3u8', eClipType: 'Media', minManifestPosition: 0, maxManifestPosition: 30,
+                linearDuration: 0, startTime: 1 + ((i * 7919) % MIDROLL_COUNT) * ((totalDuration - 2) / MIDROLL_COUNT),
+                deleteAfterPlay: (i % 2) === 0, eRollType: 'Mid', playbackPolicyObj: { allowSeek: false } } }));
+        }
+        return calls;
+    },
+
+    checkResult = function (resultJSON) {
+        if (resultJSON.indexOf('{"EXCEPTION":') === 0) {
+            throw new Error(resultJSON);
+        }
+    },
+
+    measure = function (iterations, rebuild) {
+        ///<returns type="Number">microseconds per rebuild</returns>
+        var startTime,
+            duration,
+            i;
+
+        for (i = 0; i < WARMUP_ITERATIONS; i += 1) {
+            rebuild();
+        }
+        startTime = process.hrtime();
+        for (i = 0; i < iterations; i += 1) {
+            rebuild();
+        }
+        duration = process.hrtime(startTime);
+        return (duration[0] * 1e6 + duration[1] / 1e3) / iterations;
+    },
+
+    main = function () {
+        var options = parseArguments(process.argv.slice(2)),
+            calls = createScheduleCalls(),
+            source = createScheduler(),
+            replayTarget = createScheduler(),
+            restoreTarget = createScheduler(),
+            snapshotJSON,
+            restoreJSON,
+            replayTime,
+            restoreTime,
+            i;
+
+        for (i = 0; i < calls.length; i += 1) {
+            checkResult(source.scheduler.runJSON(calls[i]));
+        }
+        snapshotJSON = source.scheduler.runJSON('{"func":"getSnapshot"}');
+        restoreJSON = '{"func":"restoreSnapshot","params":{"snapshot":' + snapshotJSON + '}}';
+
+        replayTime = measure(options.iterations, function () {
+            var j;
+
+            replayTarget.scheduler.reset();
+            for (j = 0; j < calls.length; j += 1) {
+                checkResult(replayTarget.scheduler.runJSON(calls[j]));
+            }
+        });
+        restoreTime = measure(options.iterations, function () {
+            checkResult(restoreTarget.scheduler.runJSON(restoreJSON));
+        });
+
+        if (restoreTarget.sequentialPlaylist.testProbe_toJSON() !== source.sequentialPlaylist.testProbe_toJSON()) {
+            throw new Error('the restored playlist differs from the original one');
+        }
+
+        console.log(source.sequentialPlaylist.access.getStatistics().entryCount + ' entries, ' + calls.length + ' calls, ' +
+            snapshotJSON.length + ' snapshot JSON characters, ' + options.iterations + ' rebuilds per case');
+        console.log('replay calls us\trestoreSnapshot us\tspeedup');
+        console.log([replayTime.toFixed(0), restoreTime.toFixed(0), (replayTime / restoreTime).toFixed(1)].join('\t'));
+    };
+
+main();
@@ -0,0 +1,115 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which measures the cost of invoking the sequencer plugin chain
+// with 1, 5 and 20 pass-through plugins in front of the default plugin, through runCompact (the native
+// bridge path), runJSON and a direct getFirstSequencer() call.
+//
+// Usage: node PluginChainBenchmark.js [--iterations <count>] [--sequencer <Sequencer.js>]
+//     --iterations    calls measured per case (default 200000)
+//     --sequencer     another version of Sequencer.js to measure instead, such as one checked out before a change
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    PLUGIN_COUNTS = [1, 5, 20],
+    WARMUP_ITERATIONS = 20000,
+
+    parseArguments = function (argv) {
+        var options = {
+                iterations: 200000,
+                sequencerScript: harness.SEQUENCER_SCRIPT
+            },
+            i;
+
+        for (i = 0; i < argv.length; i += 1) {
+            if (argv[i] === '--iterations') {
+                i += 1;
+                options.iterations = parseInt(argv[i], 10);
+            } else if (argv[i] === '--sequencer') {
+                i += 1;
+                options.sequencerScript = path.resolve(argv[i]);
+            } else {
+                throw new Error('usage: node PluginChainBenchmark.js [--iterations <count>] [--sequencer <Sequencer.js>]');
+            }
+        }
+        return options;
+    },
+
+    createChain = function (options, pluginCount) {
+        ///<summary>Load the Scheduler and Sequencer into a fresh context and add pluginCount pass-through plugins</summary>
+        ///<returns type="Object">An object with properties: chain (the sequencer plugin chain) and segmentId (a segment to tick)</returns>
+        var namespace = harness.loadScripts([harness.SCHEDULER_SCRIPT, options.sequencerScript]),
+            segment,
+            i;
+
+        for (i = 0; i < pluginCount; i += 1) {
+            namespace.sequencerPluginChain.createSequencerPlugin('passThrough' + i.toString());
+        }
+        namespace.scheduler.runJSON(JSON.stringify({ func: 'appendContentClip', params: { clipURI: 'http://example.com/content.m3u8', minManifestPosition: 0, maxManifestPosition: 600 } }));
+        segment = JSON.parse(namespace.sequencerPluginChain.runJSON(JSON.stringify({ func: 'seekFromLinearPosition', params: { linearSeekPosition: 0 } })));
+        return { chain: namespace.sequencerPluginChain, segmentId: segment.segmentId };
+    },
+
+    measure = function (iterations, call) {
+        ///<returns type="Number">nanoseconds per call</returns>
+        var startTime,
+            duration,
+            i;
+
+        for (i = 0; i < WARMUP_ITERATIONS; i += 1) {
+            call(i);
+        }
+        startTime = process.hrtime();
+        for (i = 0; i < iterations; i += 1) {
+            call(i);
+        }
+        duration = process.hrtime(startTime);
+        return (duration[0] * 1e9 + duration[1]) / iterations;
+    },
+
+    main = function () {
+        var options = parseArguments(process.argv.slice(2)),
+            setup,
+            cases,
+            results,
+            i;
+
+        console.log(path.relative(process.cwd(), options.sequencerScript) + ', ' + options.iterations + ' calls per case');
+        console.log('plugins\trunCompact tick ns\trunJSON tick ns\tdirect tick ns');
+        for (i = 0; i < PLUGIN_COUNTS.length; i += 1) {
+            setup = createChain(options, PLUGIN_COUNTS[i]);
+            cases = [
+                function (n) {
+                    setup.chain.runCompact('tick', setup.segmentId, 1, (n % 500) + 1, 0, 600, 5);
+                },
+                function (n) {
+                    setup.chain.runJSON('{"func":"tick","params":{"currentSegmentId":' + setup.segmentId +
+                        ',"playbackRate":1,"currentPlaybackPosition":' + ((n % 500) + 1) + '}}');
+                },
+                function (n) {
+                    setup.chain.getFirstSequencer().tick({ currentSegmentId: setup.segmentId, playbackRate: 1, currentPlaybackPosition: (n % 500) + 1 });
+                }
+            ];
+            results = cases.map(function (call) { return measure(options.iterations, call).toFixed(0); });
+            console.log([PLUGIN_COUNTS[i]].concat(results).join('\t'));
+        }
+    };
+
+main();
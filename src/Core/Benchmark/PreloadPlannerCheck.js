@@ -0,0 +1,207 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which checks the preload planner (createPreloadPlanner of Sequencer.js)
+// with an injected clock and synthetic latency traces. The percentile estimates are expected between the latency of
+// the trace at that percentile and 10% above it (the log-scale histogram rounds up to a bucket bound):
+//     injectedClock       beginLoad and endLoad measure the latency on the injected clock; cancelLoad and unknown loads
+//     percentiles         p50, p90 and p99 of a uniform trace without decay
+//     leadTime            the lead time is the (1 - targetStallProbability) percentile plus the safety margin, clamped
+//                         to [minLeadTime, maxLeadTime], and defaultLeadTime until minSamples
+//     perHost             a fast CDN and a slow ad server trace get their own lead times, and an unknown host of the
+//                         same clip type the estimate of the clip type
+//     decay               with decay the estimate follows a server which got faster
+//     invalidOptions      out of range options and latencies throw SequencerError
+//
+// Usage: node PreloadPlannerCheck.js
+//
+// The exit code is 1 if any check fails.
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    FAST_URI = 'http://cdn.example.com/content.m3u8',
+    SLOW_URI = 'http://ads.example.com/ad.mp4',
+    QUANTIZATION = 1.1,     // the bucket growth of the planner histogram
+
+    namespace = harness.loadScripts([harness.SCHEDULER_SCRIPT, harness.SEQUENCER_SCRIPT]),
+
+    createPlanner = function (options) {
+        ///<summary>Create a preload planner with an injected clock</summary>
+        ///<returns type="Object">An object with: planner, clock ({ time } in milliseconds)</returns>
+        var clock = { time: 0 };
+
+        options.clock = function () { return clock.time; };
+        return { planner: namespace.createPreloadPlanner(options), clock: clock };
+    },
+
+    createTrace = function (count, minLatency, maxLatency, seed) {
+        ///<returns type="Array">count latencies in seconds, skewed toward minLatency</returns>
+        var random = harness.createRandom(seed),
+            trace = [],
+            i;
+
+        for (i = 0; i < count; i += 1) {
+            trace.push(minLatency + Math.pow(random(), 2) * (maxLatency - minLatency));
+        }
+        return trace;
+    },
+
+    getTracePercentile = function (trace, fraction) {
+        ///<returns type="Number">The latency of the trace at the percentile, as the planner ranks samples</returns>
+        var sorted = trace.slice(0).sort(function (a, b) { return a - b; });
+
+        return sorted[Math.max(1, Math.ceil(fraction * sorted.length)) - 1];
+    },
+
+    isEstimate = function (estimate, expected) {
+        return estimate >= expected && estimate <= expected * QUANTIZATION * (1 + 1e-9);
+    },
+
+    recordTrace = function (planner, trace, clipURI) {
+        var i;
+
+        for (i = 0; i < trace.length; i += 1) {
+            planner.recordLatency({ clipURI: clipURI, eClipType: 'Media', latency: trace[i] });
+        }
+    },
+
+    CHECKS = {
+        injectedClock: function (expect) {
+            var context = createPlanner({}),
+                planner = context.planner,
+                loadId = planner.beginLoad({ clipURI: SLOW_URI, eClipType: 'Media' }),
+                cancelledId = planner.beginLoad({ clipURI: SLOW_URI, eClipType: 'Media', loadId: 42 });
+
+            expect(cancelledId === '42' && planner.getStatistics().pendingLoadCount === 2, 'two pending loads, the given loadId as a string');
+            context.clock.time += 1250;
+            expect(planner.endLoad({ loadId: loadId }) === 1.25, 'endLoad returns the latency on the injected clock');
+            expect(planner.endLoad({ loadId: loadId }) === null, 'a load ends once');
+            expect(planner.cancelLoad({ loadId: 42 }) && !planner.cancelLoad({ loadId: 42 }), 'cancelLoad drops a pending load once');
+            expect(planner.endLoad({ loadId: cancelledId }) === null, 'a cancelled load records nothing');
+            expect(planner.getStatistics().pendingLoadCount === 0 && planner.getStatistics().estimators['|'].count === 1, 'one latency recorded');
+
+            planner.beginLoad({ clipURI: SLOW_URI, loadId: 'restarted' });
+            context.clock.time += 5000;
+            planner.beginLoad({ clipURI: SLOW_URI, loadId: 'restarted' });
+            context.clock.time += 500;
+            expect(planner.endLoad({ loadId: 'restarted' }) === 0.5, 'beginning a load again restarts its measurement');
+        },
+
+        percentiles: function (expect) {
+            var planner = createPlanner({ decay: 1 }).planner,
+                trace = [],
+                estimator,
+                i;
+
+            for (i = 1; i <= 100; i += 1) {
+                trace.push(i / 10);
+            }
+            recordTrace(planner, trace, SLOW_URI);
+            estimator = planner.getStatistics().estimators['Media|ads.example.com'];
+            expect(estimator.count === 100, '100 samples');
+            expect(isEstimate(estimator.p50, getTracePercentile(trace, 0.5)), 'p50 ' + estimator.p50 + ' of ' + getTracePercentile(trace, 0.5));
+            expect(isEstimate(estimator.p90, getTracePercentile(trace, 0.9)), 'p90 ' + estimator.p90 + ' of ' + getTracePercentile(trace, 0.9));
+            expect(isEstimate(estimator.p99, getTracePercentile(trace, 0.99)), 'p99 ' + estimator.p99 + ' of ' + getTracePercentile(trace, 0.99));
+            expect(estimator.p50 <= estimator.p90 && estimator.p90 <= estimator.p99, 'the percentiles are ordered');
+        },
+
+        leadTime: function (expect) {
+            var planner = createPlanner({ decay: 1, defaultLeadTime: 7, minSamples: 10, safetyMargin: 0.5, minLeadTime: 1, maxLeadTime: 30 }).planner,
+                trace = createTrace(200, 2, 8, 7),
+                leadTime;
+
+            recordTrace(planner, trace.slice(0, 9), SLOW_URI);
+            expect(planner.getLeadTime({ clipURI: SLOW_URI, eClipType: 'Media' }) === 7, 'defaultLeadTime until minSamples');
+            recordTrace(planner, trace.slice(9), SLOW_URI);
+            leadTime = planner.getLeadTime({ clipURI: SLOW_URI, eClipType: 'Media' });
+            expect(isEstimate(leadTime - 0.5, getTracePercentile(trace, 0.95)), 'the p95 latency plus the safety margin: ' + leadTime + ' for ' + getTracePercentile(trace, 0.95));
+            expect(planner.shouldStartLoad({ remainingTime: leadTime, clipURI: SLOW_URI, eClipType: 'Media' }) &&
+                !planner.shouldStartLoad({ remainingTime: leadTime + 0.1, clipURI: SLOW_URI, eClipType: 'Media' }), 'shouldStartLoad within the lead time');
+
+            planner.setTargetStallProbability({ targetStallProbability: 0.5 });
+            leadTime = planner.getLeadTime({ clipURI: SLOW_URI, eClipType: 'Media' });
+            expect(isEstimate(leadTime - 0.5, getTracePercentile(trace, 0.5)), 'a stall probability of 0.5 uses the median: ' + leadTime);
+
+            planner = createPlanner({ decay: 1, minSamples: 1, minLeadTime: 1, maxLeadTime: 30 }).planner;
+            planner.recordLatency({ clipURI: FAST_URI, eClipType: 'Media', latency: 0.01 });
+            planner.recordLatency({ clipURI: SLOW_URI, eClipType: 'Media', latency: 100 });
+            expect(planner.getLeadTime({ clipURI: FAST_URI, eClipType: 'Media' }) === 1, 'clamped to minLeadTime');
+            expect(planner.getLeadTime({ clipURI: SLOW_URI, eClipType: 'Media' }) === 30, 'clamped to maxLeadTime');
+        },
+
+        perHost: function (expect) {
+            var context = createPlanner({ decay: 1, minLeadTime: 0, safetyMargin: 0 }),
+                planner = context.planner,
+                fastTrace = createTrace(400, 0.2, 0.4, 11),
+                slowTrace = createTrace(400, 1, 4, 13),
+                statistics,
+                loadId,
+                i;
+
+            // drive the fast trace through beginLoad and endLoad on the clock, the slow one through recordLatency
+            for (i = 0; i < fastTrace.length; i += 1) {
+                loadId = planner.beginLoad({ clipURI: FAST_URI, eClipType: 'Media' });
+                context.clock.time += fastTrace[i] * 1000;
+                planner.endLoad({ loadId: loadId });
+            }
+            recordTrace(planner, slowTrace, SLOW_URI);
+            statistics = planner.getStatistics().estimators;
+            expect(isEstimate(statistics['Media|cdn.example.com'].p90, getTracePercentile(fastTrace, 0.9)), 'fast p90 ' + statistics['Media|cdn.example.com'].p90);
+            expect(isEstimate(statistics['Media|ads.example.com'].p90, getTracePercentile(slowTrace, 0.9)), 'slow p90 ' + statistics['Media|ads.example.com'].p90);
+            expect(isEstimate(planner.getLeadTime({ clipURI: FAST_URI, eClipType: 'Media' }), getTracePercentile(fastTrace, 0.95)), 'the fast host lead time');
+            expect(isEstimate(planner.getLeadTime({ clipURI: 'HTTP://ADS.EXAMPLE.COM/other.mp4', eClipType: 'Media' }), getTracePercentile(slowTrace, 0.95)),
+                'the slow host lead time, whatever the case of the host');
+            expect(isEstimate(planner.getLeadTime({ clipURI: 'http://other.example.com/clip.mp4', eClipType: 'Media' }), getTracePercentile(fastTrace.concat(slowTrace), 0.95)),
+                'an unknown host gets the estimate of its clip type');
+            expect(planner.getLeadTime({ clipURI: FAST_URI, eClipType: 'Static' }) === planner.getLeadTime({}), 'an unknown clip type gets the overall estimate');
+        },
+
+        decay: function (expect) {
+            var decayed = createPlanner({ decay: 0.9, safetyMargin: 0, minLeadTime: 0 }).planner,
+                kept = createPlanner({ decay: 1, safetyMargin: 0, minLeadTime: 0 }).planner,
+                slowTrace = createTrace(200, 2, 4, 17),
+                fastTrace = createTrace(100, 0.3, 0.5, 19);
+
+            recordTrace(decayed, slowTrace, SLOW_URI);
+            recordTrace(kept, slowTrace, SLOW_URI);
+            recordTrace(decayed, fastTrace, SLOW_URI);
+            recordTrace(kept, fastTrace, SLOW_URI);
+            expect(isEstimate(decayed.getLeadTime({ clipURI: SLOW_URI, eClipType: 'Media' }), getTracePercentile(fastTrace, 0.95)),
+                'with decay the lead time follows the faster server: ' + decayed.getLeadTime({ clipURI: SLOW_URI, eClipType: 'Media' }));
+            expect(kept.getLeadTime({ clipURI: SLOW_URI, eClipType: 'Media' }) >= 2, 'without decay the slow samples are kept');
+        },
+
+        invalidOptions: function (expect) {
+            var planner = createPlanner({}).planner,
+                isSequencerError = function (call) {
+                    return harness.throwsError(call, 'PLAYER_SEQUENCER:SequencerError');
+                };
+
+            expect(isSequencerError(function () { createPlanner({ targetStallProbability: 1.5 }); }), 'targetStallProbability above 1');
+            expect(isSequencerError(function () { createPlanner({ minLeadTime: 10, maxLeadTime: 5 }); }), 'maxLeadTime below minLeadTime');
+            expect(isSequencerError(function () { createPlanner({ decay: 0.1 }); }), 'decay below 0.5');
+            expect(isSequencerError(function () { planner.recordLatency({ latency: -1 }); }), 'a negative latency');
+            expect(isSequencerError(function () { planner.recordLatency({ latency: NaN }); }), 'a NaN latency');
+            expect(JSON.parse(planner.runJSON('{"func":"setTargetStallProbability","params":{"targetStallProbability":"high"}}')).EXCEPTION !== undefined,
+                'runJSON returns the exception');
+        }
+    };
+
+harness.runChecks(CHECKS);
@@ -0,0 +1,393 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which runs the headless benchmark and regression suite of the core:
+// Scheduler.js, Sequencer.js, AdResolver.js and the sequencer plugin loaded into a vm context as the native
+// Sequencer loads them into the web view, with DOMParserStandIn.js as the DOMParser. Each case is called through
+// runJSON and runCompact as the native bridge calls it:
+//     scheduleBuildUp     content clips appended and mid-roll ads scheduled at scattered times
+//     tick                the playback timer tick on a content segment
+//     seekStorm           random seeks over a playlist with ads, each releasing the segment it seeks from
+//     endOfMediaChain     playing a playlist through, each deleteAfterPlay ad welding its content back
+//     vastParseQuery      parsing the sample VAST documents and running every query on them, with the compact
+//     vmapParseQuery      parser and the DOMParser, and the same for the sample VMAP document
+// Every case is run --repeat times in a fresh context and its best time is kept. Each case also checks its
+// results (the playlist welded back, no playback segment left live, both parsers answering alike).
+//
+// The metrics and checks are written as JSON (to --out, or to stdout with --json):
+//     { "suite", "node", "options", "metrics": { <name>: <value> }, "checks": { <name>: <true|false> }, "failures": [] }
+// The run fails (exit code 1) if a check fails, or if a metric is over its "max" in the thresholds file, or
+// more than "maxRegression" (a fraction, per metric or for all) over its value in the --baseline results.
+//
+// Usage: node RegressionSuite.js [--out <results.json>] [--json] [--baseline <results.json>] [--thresholds <thresholds.json>]
+//                                [--repeat <count>] [--scale <factor>] [--plugin <plugin script>]
+//     --out           write the JSON results to a file
+//     --json          write the JSON results to stdout instead of the table
+//     --baseline      the JSON results of an earlier run to check for regressions against
+//     --thresholds    the metric thresholds (default RegressionThresholds.json next to this file)
+//     --repeat        runs of each case, the best is kept (default 3)
+//     --scale         multiplies the size of every case (default 1)
+//     --plugin        the sequencer plugin script loaded last (default src/iOS/HLSClient/SequencerPlugin.js)
+//
+
+/*jslint node: true */
+"use strict";
+
+var fs = require('fs'),
+    path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    SAMPLES_DIRECTORY = path.join(__dirname, 'Samples'),
+    CONTENT_CLIP_DURATION = 600,
+    AD_DURATION = 15,
+
+    parseArguments = function (argv) {
+        var options = {
+                out: null,
+                json: false,
+                baseline: null,
+                thresholds: path.join(__dirname, 'RegressionThresholds.json'),
+                repeat: 3,
+                scale: 1,
+                pluginScript: harness.PLUGIN_SCRIPT
+            },
+            i;
+
+        for (i = 0; i < argv.length; i += 1) {
+            if (argv[i] === '--out') {
+                i += 1;
+                options.out = path.resolve(argv[i]);
+            } else if (argv[i] === '--json') {
+                options.json = true;
+            } else if (argv[i] === '--baseline') {
+                i += 1;
+                options.baseline = path.resolve(argv[i]);
+            } else if (argv[i] === '--thresholds') {
+                i += 1;
+                options.thresholds = path.resolve(argv[i]);
+            } else if (argv[i] === '--repeat') {
+                i += 1;
+                options.repeat = parseInt(argv[i], 10);
+            } else if (argv[i] === '--scale') {
+                i += 1;
+                options.scale = parseFloat(argv[i]);
+            } else if (argv[i] === '--plugin') {
+                i += 1;
+                options.pluginScript = path.resolve(argv[i]);
+            } else {
+                throw new Error('usage: node RegressionSuite.js [--out <results.json>] [--json] [--baseline <results.json>] [--thresholds <thresholds.json>]' +
+                    ' [--repeat <count>] [--scale <factor>] [--plugin <plugin script>]');
+            }
+        }
+        return options;
+    },
+
+    createCore = function (options) {
+        ///<summary>Load the core scripts and the plugin into a fresh context with the DOMParser stand-in</summary>
+        ///<returns type="Object">The PLAYER_SEQUENCER namespace of the context</returns>
+        return harness.loadScripts(harness.CORE_SCRIPTS.concat([options.pluginScript]), { hasDOMParser: true });
+    },
+
+    createRandom = harness.createRandom,
+    now = harness.now,
+    callJSON = harness.callJSON,
+    callCompact = harness.callCompact,
+
+    buildPlaylist = function (namespace, contentCount, adCount, random) {
+        ///<summary>Append content clips and schedule deleteAfterPlay mid-roll ads at scattered times</summary>
+        var i;
+
+        for (i = 0; i < contentCount; i += 1) {
+            callJSON(namespace.scheduler, 'appendContentClip', { clipURI: 'http://example.com/content' + i.toString() + '.m3u8',
+                minManifestPosition: 0, maxManifestPosition: CONTENT_CLIP_DURATION });
+        }
+        for (i = 0; i < adCount; i += 1) {
+            callJSON(namespace.scheduler, 'scheduleClip', { clipURI: 'http://example.com/ad' + i.toString() + '.m3u8', eClipType: 'Media', eRollType: 'Mid',
+                minManifestPosition: 0, maxManifestPosition: AD_DURATION, linearDuration: 0, deleteAfterPlay: true,
+                startTime: 1 + random() * (contentCount * CONTENT_CLIP_DURATION - 2) });
+        }
+    },
+
+    // ---------------------------------
+    // the cases: each returns { metrics: { name: value }, checks: { name: boolean } } for one run
+    // ---------------------------------
+    CASES = {
+        scheduleBuildUp: function (options) {
+            var namespace = createCore(options),
+                contentCount = Math.round(100 * options.scale),
+                adCount = Math.round(2000 * options.scale),
+                startTime = now();
+
+            buildPlaylist(namespace, contentCount, adCount, createRandom(7919));
+            return {
+                metrics: { 'scheduleBuildUp.usPerClip': (now() - startTime) / 1000 / (contentCount + adCount) },
+                checks: { 'scheduleBuildUp.entryCount': namespace.sequentialPlaylist.access.getStatistics().entryCount >= contentCount + adCount }
+            };
+        },
+
+        tick: function (options) {
+            var namespace = createCore(options),
+                chain = namespace.sequencerPluginChain,
+                callCount = Math.round(200000 * options.scale),
+                segmentId,
+                fields,
+                startTime,
+                i;
+
+            buildPlaylist(namespace, 1, 0, createRandom(7919));
+            segmentId = callJSON(chain, 'seekFromLinearPosition', { linearSeekPosition: 0 }).segmentId;
+            startTime = now();
+            for (i = 0; i < callCount; i += 1) {
+                fields = callCompact(chain, ['tick', segmentId, 1, (i % 500) + 0.5, 0, CONTENT_CLIP_DURATION, 5]);
+            }
+            return {
+                metrics: { 'tick.nsPerCall': (now() - startTime) / callCount },
+                checks: { 'tick.lastSeekbarPosition': Number(fields.split(',')[0]) === ((callCount - 1) % 500) + 0.5 }
+            };
+        },
+
+        seekStorm: function (options) {
+            var namespace = createCore(options),
+                chain = namespace.sequencerPluginChain,
+                random = createRandom(7919),
+                contentCount = Math.round(100 * options.scale),
+                seekCount = Math.round(5000 * options.scale),
+                duration,
+                segment,
+                startTime,
+                i;
+
+            buildPlaylist(namespace, contentCount, Math.round(1000 * options.scale), random);
+            duration = namespace.sequentialPlaylist.access.getPlaylistLinearDuration();
+            segment = callJSON(chain, 'seekFromLinearPosition', { linearSeekPosition: 0 });
+            startTime = now();
+            for (i = 0; i < seekCount; i += 1) {
+                if (segment.clip.isAdvertisement) {
+                    // Note: the seekbar of an ad is the ad itself, so leave it by a linear seek
+                    segment = callJSON(chain, 'seekFromLinearPosition', { currentSegmentId: segment.segmentId, linearSeekPosition: random() * duration });
+                } else {
+                    segment = { segmentId: Number(callCompact(chain, ['seekFromSeekbarPosition', random() * duration, segment.segmentId]).split(',')[0]) };
+                    segment.clip = namespace.playbackSegmentPool.getPlaybackSegment(segment.segmentId).clip;
+                }
+            }
+            return {
+                metrics: { 'seekStorm.usPerSeek': (now() - startTime) / 1000 / seekCount },
+                checks: { 'seekStorm.segmentsReleased': namespace.playbackSegmentPool.getStatistics().liveCount === 1 }
+            };
+        },
+
+        endOfMediaChain: function (options) {
+            var namespace = createCore(options),
+                chain = namespace.sequencerPluginChain,
+                contentCount = Math.round(50 * options.scale),
+                segmentCount = 0,
+                tuple,
+                fields,
+                startTime;
+
+            buildPlaylist(namespace, contentCount, Math.round(500 * options.scale), createRandom(7919));
+            tuple = callCompact(chain, ['seekFromSeekbarPosition', 0, callJSON(chain, 'seekFromLinearPosition', { linearSeekPosition: 0 }).segmentId]);
+            startTime = now();
+            while (tuple !== 'null') {
+                fields = tuple.split(',');
+                // segmentId, ..., maxRenderingTime (see PLAYER_SEQUENCER.compactCommands)
+                tuple = callCompact(chain, ['onEndOfMedia', Number(fields[0]), Number(fields[7]), 1, false, false]);
+                segmentCount += 1;
+            }
+            return {
+                metrics: { 'endOfMediaChain.usPerSegment': (now() - startTime) / 1000 / segmentCount },
+                checks: {
+                    'endOfMediaChain.contentWelded': namespace.sequentialPlaylist.access.getStatistics().entryCount === contentCount,
+                    'endOfMediaChain.segmentsReleased': namespace.playbackSegmentPool.getStatistics().liveCount === 0
+                }
+            };
+        },
+
+        vastParseQuery: function (options) {
+            return parseQueryCase(options, 'vastParseQuery', ['InlineVAST.xml', 'WrapperVAST.xml'], 'vast');
+        },
+
+        vmapParseQuery: function (options) {
+            return parseQueryCase(options, 'vmapParseQuery', ['PlaylistVMAP.xml'], 'vmap');
+        }
+    },
+
+    runQueries = function (adResolver, kind, entryId) {
+        ///<summary>Run every query of a VAST or VMAP entry through runJSON, as the native AdResolver does</summary>
+        ///<returns type="Array">The result strings</returns>
+        var results = [],
+            call = function (func, params) {
+                results.push(adResolver.runJSON(JSON.stringify({ func: func, params: params })).replace(/"stack":\[[^\]]*\]/, ''));
+            },
+            adList,
+            adBreakList,
+            i,
+            j;
+
+        if (kind === 'vast') {
+            adList = adResolver.vast.getAdList({ entryId: entryId });
+            call('vast.getAdList', { entryId: entryId });
+            for (i = 0; i < adList.length; i += 1) {
+                call('vast.getCreativeList', { entryId: entryId, adOrdinal: i, adType: adList[i].type });
+                for (j = 0; j < 2; j += 1) {
+                    call('vast.getLinearTrackingEventsList', { entryId: entryId, adOrdinal: i, creativeOrdinal: j });
+                    call('vast.getVideoClicksList', { entryId: entryId, adOrdinal: i, creativeOrdinal: j });
+                    call('vast.getIconsList', { entryId: entryId, adOrdinal: i, creativeOrdinal: j });
+                    call('vast.getMediaFileList', { entryId: entryId, adOrdinal: i, creativeOrdinal: j });
+                    call('vast.getCompanionAdsList', { entryId: entryId, adOrdinal: i, creativeOrdinal: j });
+                    call('vast.getNonLinearAdsList', { entryId: entryId, adOrdinal: i, creativeOrdinal: j });
+                }
+            }
+        } else {
+            adBreakList = adResolver.vmap.getAdBreakList({ entryId: entryId });
+            call('vmap.getAdBreakList', { entryId: entryId });
+            for (i = 0; i < adBreakList.length; i += 1) {
+                call('vmap.getAdSource', { entryId: entryId, adBreakOrdinal: i });
+                call('vmap.getTrackingEventsList', { entryId: entryId, adBreakOrdinal: i });
+                call('vmap.getExtensionsList', { entryId: entryId, adBreakOrdinal: i });
+            }
+        }
+        return results;
+    },
+
+    parseQueryCase = function (options, caseName, sampleNames, kind) {
+        var namespace = createCore(options),
+            adResolver = namespace.theAdResolver,
+            documentCount = Math.round(200 * options.scale),
+            samples = sampleNames.map(function (name) { return fs.readFileSync(path.join(SAMPLES_DIRECTORY, name), 'utf8'); }),
+            parsers = [{ name: 'compact', isCompact: true }, { name: 'domParser', isCompact: false }],
+            run = { metrics: {}, checks: {} },
+            answers = [],
+            queryResults,
+            entryId,
+            startTime,
+            p,
+            i;
+
+        for (p = 0; p < parsers.length; p += 1) {
+            adResolver.setCompactParser(parsers[p].isCompact);
+            answers[p] = [];
+            startTime = now();
+            for (i = 0; i < documentCount; i += 1) {
+                entryId = JSON.parse(adResolver.runJSON(JSON.stringify({ func: kind + '.createEntry', params: samples[i % samples.length] })));
+                queryResults = runQueries(adResolver, kind, entryId);
+                if (i < samples.length) {
+                    answers[p] = answers[p].concat(queryResults);
+                }
+                adResolver.releaseEntry(entryId);
+            }
+            run.metrics[caseName + '.' + parsers[p].name + '.usPerDocument'] = (now() - startTime) / 1000 / documentCount;
+        }
+        run.checks[caseName + '.parsersAgree'] = JSON.stringify(answers[0]) === JSON.stringify(answers[1]);
+        return run;
+    },
+
+    // ---------------------------------
+    // the thresholds
+    // ---------------------------------
+    checkThresholds = function (results, thresholds, baseline) {
+        ///<returns type="Array">The failure messages</returns>
+        var failures = [],
+            name,
+            threshold,
+            maxRegression;
+
+        for (name in results.checks) {
+            if (results.checks.hasOwnProperty(name) && !results.checks[name]) {
+                failures.push('check failed: ' + name);
+            }
+        }
+        for (name in thresholds.metrics) {
+            if (thresholds.metrics.hasOwnProperty(name)) {
+                threshold = thresholds.metrics[name];
+                if (!results.metrics.hasOwnProperty(name)) {
+                    failures.push('metric missing: ' + name);
+                } else if (typeof threshold.max === 'number' && results.metrics[name] > threshold.max) {
+                    failures.push(name + ' ' + results.metrics[name].toFixed(3) + ' over the max ' + threshold.max);
+                } else if (baseline && baseline.metrics.hasOwnProperty(name)) {
+                    maxRegression = (typeof threshold.maxRegression === 'number') ? threshold.maxRegression : thresholds.maxRegression;
+                    if (results.metrics[name] > baseline.metrics[name] * (1 + maxRegression)) {
+                        failures.push(name + ' ' + results.metrics[name].toFixed(3) + ' regressed more than ' + (100 * maxRegression).toFixed(0) +
+                            '% from the baseline ' + baseline.metrics[name].toFixed(3));
+                    }
+                }
+            }
+        }
+        return failures;
+    },
+
+    main = function () {
+        var options = parseArguments(process.argv.slice(2)),
+            thresholds = JSON.parse(fs.readFileSync(options.thresholds, 'utf8')),
+            baseline = options.baseline ? JSON.parse(fs.readFileSync(options.baseline, 'utf8')) : null,
+            results = {
+                suite: 'RegressionSuite',
+                node: process.version,
+                options: { repeat: options.repeat, scale: options.scale, plugin: path.basename(options.pluginScript) },
+                metrics: {},
+                checks: {},
+                failures: []
+            },
+            caseName,
+            run,
+            name,
+            r;
+
+        for (caseName in CASES) {
+            if (CASES.hasOwnProperty(caseName)) {
+                for (r = 0; r < options.repeat; r += 1) {
+                    run = CASES[caseName](options);
+                    for (name in run.metrics) {
+                        if (run.metrics.hasOwnProperty(name)) {
+                            results.metrics[name] = results.metrics.hasOwnProperty(name) ? Math.min(results.metrics[name], run.metrics[name]) : run.metrics[name];
+                        }
+                    }
+                    for (name in run.checks) {
+                        if (run.checks.hasOwnProperty(name)) {
+                            results.checks[name] = (results.checks[name] !== false) && run.checks[name];
+                        }
+                    }
+                }
+            }
+        }
+        results.failures = checkThresholds(results, thresholds, baseline);
+
+        if (options.out) {
+            fs.writeFileSync(options.out, JSON.stringify(results, null, 2) + '\n');
+        }
+        if (options.json) {
+            console.log(JSON.stringify(results, null, 2));
+        } else {
+            console.log('metric\tvalue\tmax\tbaseline');
+            for (name in results.metrics) {
+                if (results.metrics.hasOwnProperty(name)) {
+                    console.log([name, results.metrics[name].toFixed(3),
+                        (thresholds.metrics[name] && typeof thresholds.metrics[name].max === 'number') ? thresholds.metrics[name].max : '-',
+                        (baseline && baseline.metrics.hasOwnProperty(name)) ? baseline.metrics[name].toFixed(3) : '-'].join('\t'));
+                }
+            }
+            for (name in results.checks) {
+                if (results.checks.hasOwnProperty(name)) {
+                    console.log((results.checks[name] ? 'PASS ' : 'FAIL ') + name);
+                }
+            }
+            for (r = 0; r < results.failures.length; r += 1) {
+                console.log('FAILURE ' + results.failures[r]);
+            }
+        }
+        process.exitCode = (results.failures.length > 0) ? 1 : 0;
+    };
+
+main();
@@ -0,0 +1,181 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which replays headless scrub traces (seekbar drags) through
+// beginScrub, submitScrubPosition (runCompact, as the native seekbar submits them) and commitScrub, on a content
+// clip with a pod of two mid-roll ads and two single mid-roll ads. A whole drag must create exactly one playback
+// segment, the one of its last position:
+//     forwardDrag         a drag over the whole timeline ending after the ads creates one segment, the same as a
+//                         seek to the last position, and crosses the ads in play order
+//     backwardDrag        a drag back to the start crosses the ads in reverse order
+//     dragWithinContent   a drag between two ads crosses none
+//     emptyAndCancelled   a commit without position and a cancelled drag create no segment
+//     repeatedDrags       a seeded random trace of drags keeps the live segment count and creates one segment per drag
+//
+// Usage: node ScrubTraceCheck.js
+//
+// The exit code is 1 if any check fails.
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    CONTENT_DURATION = 600,
+    AD_DURATION = 15,
+    AD_TIMES = [100, 100, 300, 450],    // a pod of two ads at 100
+
+    createPlayer = function () {
+        ///<summary>Load the Scheduler and Sequencer into a fresh context, schedule the timeline and start playback at 50</summary>
+        ///<returns type="Object">An object with: namespace, pool, chain, adIds (in play order), segment (the current one), sequencer (runJSON call throwing on an EXCEPTION)</returns>
+        var player = { namespace: harness.loadScripts([harness.SCHEDULER_SCRIPT, harness.SEQUENCER_SCRIPT]), adIds: [] },
+            access = player.namespace.sequentialPlaylist.access,
+            entry,
+            i;
+
+        player.pool = player.namespace.playbackSegmentPool;
+        player.chain = player.namespace.sequencerPluginChain;
+        player.sequencer = function (func, params) {
+            return harness.callJSON(player.chain, func, params);
+        };
+        harness.callJSON(player.namespace.scheduler, 'appendContentClip', { clipURI: 'http://example.com/content.m3u8',
+            minManifestPosition: 0, maxManifestPosition: CONTENT_DURATION });
+        for (i = 0; i < AD_TIMES.length; i += 1) {
+            harness.callJSON(player.namespace.scheduler, 'scheduleClip', { clipURI: 'http://example.com/ad' + i.toString() + '.mp4',
+                eClipType: 'Media', eRollType: 'Mid', minManifestPosition: 0, maxManifestPosition: AD_DURATION, linearDuration: 0, startTime: AD_TIMES[i] });
+        }
+        for (entry = access.getEntryAtTime(0); entry; entry = access.getEntryAfterId(entry.id)) {
+            if (entry.isAdvertisement) {
+                player.adIds.push(entry.id);
+            }
+        }
+        player.segment = player.sequencer('seekFromLinearPosition', { linearSeekPosition: 50 });
+        return player;
+    },
+
+    drag = function (player, positions) {
+        ///<summary>Scrub through the seekbar positions and commit</summary>
+        ///<returns type="Object">An object with: result (of commitScrub), createdCount (segments created by the whole drag)</returns>
+        var createCount = player.pool.getStatistics().createCount,
+            scrubId = player.sequencer('beginScrub', { currentSegmentId: player.segment.segmentId, currentPlaybackPosition: player.segment.initialPlaybackStartTime }),
+            result,
+            i;
+
+        for (i = 0; i < positions.length; i += 1) {
+            harness.callCompact(player.chain, ['submitScrubPosition', scrubId, positions[i]]);
+        }
+        result = player.sequencer('commitScrub', { scrubId: scrubId });
+        if (result.segment) {
+            player.segment = result.segment;
+        }
+        return { result: result, createdCount: player.pool.getStatistics().createCount - createCount };
+    },
+
+    sweep = function (from, to, count) {
+        ///<returns type="Array">count seekbar positions from from to to, jittering back and forth as a finger does</returns>
+        var positions = [],
+            i;
+
+        for (i = 0; i < count; i += 1) {
+            positions.push(Math.min(CONTENT_DURATION, Math.max(0, from + (to - from) * (i / (count - 1)) + ((i % 7) - 3))));
+        }
+        positions[count - 1] = to;
+        return positions;
+    },
+
+    CHECKS = {
+        forwardDrag: function (expect) {
+            var player = createPlayer(),
+                reference = createPlayer(),
+                positions = sweep(0, CONTENT_DURATION, 120).concat(sweep(CONTENT_DURATION, 400, 40)),
+                seek,
+                trace;
+
+            trace = drag(player, positions);
+            seek = reference.sequencer('seekFromSeekbarPosition', { currentSegmentId: reference.segment.segmentId, seekbarSeekPosition: 400 });
+            expect(trace.createdCount === 1, 'one segment for the whole drag: ' + trace.createdCount);
+            expect(trace.result.submittedCount === positions.length, 'every position was submitted');
+            expect(trace.result.segment.clip.id === seek.clip.id && trace.result.segment.initialPlaybackStartTime === seek.initialPlaybackStartTime,
+                'the segment of a seek to the last position');
+            expect(JSON.stringify(trace.result.crossedAdEntryIds) === JSON.stringify(player.adIds.slice(0, 3)),
+                'the pod and the ad at 300 are crossed in play order: ' + JSON.stringify(trace.result.crossedAdEntryIds));
+        },
+
+        backwardDrag: function (expect) {
+            var player = createPlayer(),
+                trace;
+
+            drag(player, [500]);
+            trace = drag(player, sweep(500, 20, 60));
+            expect(trace.createdCount === 1, 'one segment for the whole drag: ' + trace.createdCount);
+            expect(JSON.stringify(trace.result.crossedAdEntryIds) === JSON.stringify(player.adIds.slice(0).reverse()),
+                'the ads are crossed in reverse order: ' + JSON.stringify(trace.result.crossedAdEntryIds));
+        },
+
+        dragWithinContent: function (expect) {
+            var player = createPlayer(),
+                trace;
+
+            drag(player, [150]);
+            trace = drag(player, sweep(150, 250, 30).concat(sweep(250, 200, 10)));
+            expect(trace.createdCount === 1 && trace.result.crossedAdEntryIds.length === 0, 'no ad crossed: ' + JSON.stringify(trace.result.crossedAdEntryIds));
+        },
+
+        emptyAndCancelled: function (expect) {
+            var player = createPlayer(),
+                createCount = player.pool.getStatistics().createCount,
+                trace = drag(player, []),
+                scrubId;
+
+            expect(trace.createdCount === 0 && trace.result.segment === null && trace.result.submittedCount === 0, 'a commit without position does not seek');
+
+            scrubId = player.sequencer('beginScrub', { currentSegmentId: player.segment.segmentId });
+            harness.callCompact(player.chain, ['submitScrubPosition', scrubId, 300]);
+            expect(player.sequencer('cancelScrub', { scrubId: scrubId }), 'the scrub is cancelled');
+            expect(harness.throwsError(function () { player.sequencer('commitScrub', { scrubId: scrubId }); }), 'a cancelled scrub cannot be committed');
+            expect(player.pool.getStatistics().createCount === createCount, 'no segment created');
+        },
+
+        repeatedDrags: function (expect) {
+            var player = createPlayer(),
+                random = harness.createRandom(31337),
+                liveCount = player.pool.getStatistics().liveCount,
+                badCount = 0,
+                positions,
+                trace,
+                i,
+                j;
+
+            for (i = 0; i < 200; i += 1) {
+                positions = [];
+                for (j = Math.floor(random() * 40); j >= 0; j -= 1) {
+                    positions.push(random() * CONTENT_DURATION);
+                }
+                trace = drag(player, positions);
+                if (trace.createdCount !== 1 || player.pool.getStatistics().liveCount !== liveCount) {
+                    badCount += 1;
+                }
+                if (player.segment.clip.isAdvertisement) {
+                    // the drag landed on an ad: play it through
+                    player.segment = player.sequencer('onEndOfMedia', { currentSegmentId: player.segment.segmentId, currentPlaybackPosition: AD_DURATION, currentPlaybackRate: 1 });
+                }
+            }
+            expect(badCount === 0, badCount + ' drags did not create exactly one segment or changed the live count');
+        }
+    };
+
+harness.runChecks(CHECKS);
@@ -0,0 +1,171 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which measures the sessions of PLAYER_SEQUENCER.sessionManager
+// (Sequencer.js) at scale, through sessionManager.runJSON and runCompact as the native bridge calls them:
+//     create      createSession, then a content clip and a mid-roll ad scheduled in it
+//     run         a seek, ticks, and onEndOfMedia into the ad, through it and back to the content
+//     destroy     destroySession
+// It reports the time per session of each phase, and per session: the heap retained while the sessions are live,
+// the sessionManager estimatedBytes, and the heap still retained once they are destroyed. The heap is measured
+// after a garbage collection when node is run with --expose-gc.
+//
+// Usage: node [--expose-gc] SessionBenchmark.js [--sessions <count>] [--ticks <count>]
+//     --sessions      sessions created, run and destroyed (default 10000)
+//     --ticks         ticks per session in the run phase (default 20)
+//
+// The exit code is 1 if a session does not play its ad, a playback segment is left live after the run, or a
+// session is left once they are destroyed.
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    CONTENT_DURATION = 600,
+    AD_TIME = 300,
+    AD_DURATION = 15,
+
+    parseArguments = function (argv) {
+        var options = { sessions: 10000, ticks: 20 },
+            i;
+
+        for (i = 0; i < argv.length; i += 1) {
+            if (argv[i] === '--sessions') {
+                i += 1;
+                options.sessions = parseInt(argv[i], 10);
+            } else if (argv[i] === '--ticks') {
+                i += 1;
+                options.ticks = parseInt(argv[i], 10);
+            } else {
+                throw new Error('usage: node [--expose-gc] SessionBenchmark.js [--sessions <count>] [--ticks <count>]');
+            }
+        }
+        return options;
+    },
+
+    heapUsed = function () {
+        ///<returns type="Number">The heap used in bytes, after a garbage collection if node was run with --expose-gc</returns>
+        if (typeof global.gc === 'function') {
+            global.gc();
+        }
+        return process.memoryUsage().heapUsed;
+    },
+
+    run = function (sessionManager, sessionId, target, func, params) {
+        ///<summary>Call a session through sessionManager.runJSON, throwing on an EXCEPTION result</summary>
+        var resultJSON = sessionManager.runJSON(sessionId, target, JSON.stringify({ func: func, params: params })),
+            result = (resultJSON === undefined) ? undefined : JSON.parse(resultJSON);      // undefined for a method without result
+
+        if (result && result.EXCEPTION) {
+            throw new Error(sessionId + ' ' + func + ' failed: ' + result.EXCEPTION.message);
+        }
+        return result;
+    },
+
+    createSession = function (sessionManager) {
+        var sessionId = sessionManager.createSession();
+
+        run(sessionManager, sessionId, 'scheduler', 'appendContentClip', { clipURI: 'http://example.com/' + sessionId + '.m3u8',
+            minManifestPosition: 0, maxManifestPosition: CONTENT_DURATION });
+        run(sessionManager, sessionId, 'scheduler', 'scheduleClip', { clipURI: 'http://example.com/' + sessionId + '-ad.m3u8', eClipType: 'Media',
+            eRollType: 'Mid', minManifestPosition: 0, maxManifestPosition: AD_DURATION, linearDuration: 0, startTime: AD_TIME, deleteAfterPlay: true });
+        return sessionId;
+    },
+
+    runSession = function (sessionManager, sessionId, tickCount) {
+        ///<summary>Play a session from before its ad, through the ad and back into the content</summary>
+        ///<returns type="Boolean">true if the ad played between the two content segments</returns>
+        var segment = run(sessionManager, sessionId, 'sequencer', 'seekFromLinearPosition', { linearSeekPosition: AD_TIME - tickCount }),
+            ad,
+            content,
+            i;
+
+        for (i = 0; i < tickCount; i += 1) {
+            if (sessionManager.runCompact(sessionId, 'tick', segment.segmentId, 1, segment.initialPlaybackStartTime + i, 0, AD_TIME, 5).charAt(0) === '{') {
+                throw new Error(sessionId + ' tick failed');
+            }
+        }
+        ad = run(sessionManager, sessionId, 'sequencer', 'onEndOfMedia', { currentSegmentId: segment.segmentId, currentPlaybackPosition: AD_TIME, currentPlaybackRate: 1 });
+        content = run(sessionManager, sessionId, 'sequencer', 'onEndOfMedia', { currentSegmentId: ad.segmentId, currentPlaybackPosition: AD_DURATION, currentPlaybackRate: 1 });
+        run(sessionManager, sessionId, 'sequencer', 'releasePlaybackSegment', { currentSegmentId: content.segmentId });
+        return ad.clip.isAdvertisement && !content.clip.isAdvertisement;
+    },
+
+    main = function () {
+        var options = parseArguments(process.argv.slice(2)),
+            sessionManager = harness.loadScripts([harness.SCHEDULER_SCRIPT, harness.SEQUENCER_SCRIPT]).sessionManager,
+            sessionIds = [],
+            failedCount = 0,
+            liveSegmentCount = 0,
+            baseHeap,
+            liveHeap,
+            destroyedHeap,
+            estimatedBytes,
+            createTime,
+            runTime,
+            destroyTime,
+            startTime,
+            statistics,
+            perSession = function (value) {
+                return value / options.sessions;
+            },
+            i;
+
+        baseHeap = heapUsed();
+        startTime = harness.now();
+        for (i = 0; i < options.sessions; i += 1) {
+            sessionIds.push(createSession(sessionManager));
+        }
+        createTime = harness.now() - startTime;
+
+        startTime = harness.now();
+        for (i = 0; i < options.sessions; i += 1) {
+            if (!runSession(sessionManager, sessionIds[i], options.ticks)) {
+                failedCount += 1;
+            }
+        }
+        runTime = harness.now() - startTime;
+        for (i = 0; i < options.sessions; i += 1) {
+            liveSegmentCount += sessionManager.getSessionStatistics(sessionIds[i]).liveSegmentCount;
+        }
+        estimatedBytes = sessionManager.getStatistics().estimatedBytes - sessionManager.getSessionStatistics('default').estimatedBytes;
+        liveHeap = heapUsed();
+
+        startTime = harness.now();
+        for (i = 0; i < options.sessions; i += 1) {
+            sessionManager.destroySession(sessionIds[i]);
+        }
+        destroyTime = harness.now() - startTime;
+        sessionIds = null;
+        destroyedHeap = heapUsed();
+        statistics = sessionManager.getStatistics();
+
+        console.log(options.sessions + ' sessions, ' + options.ticks + ' ticks each' + ((typeof global.gc === 'function') ? '' : ' (heap without garbage collection: run node --expose-gc)'));
+        console.log('phase\tus/session');
+        console.log('create\t' + (perSession(createTime) / 1000).toFixed(1));
+        console.log('run\t' + (perSession(runTime) / 1000).toFixed(1));
+        console.log('destroy\t' + (perSession(destroyTime) / 1000).toFixed(1));
+        console.log('memory\tbytes/session');
+        console.log('live heap\t' + perSession(liveHeap - baseHeap).toFixed(0));
+        console.log('estimated\t' + perSession(estimatedBytes).toFixed(0));
+        console.log('after destroy\t' + perSession(destroyedHeap - baseHeap).toFixed(0));
+        console.log('sessions without their ad ' + failedCount + ', live segments after the run ' + liveSegmentCount + ', sessions left ' + (statistics.sessionCount - 1));
+        process.exitCode = (failedCount > 0 || liveSegmentCount > 0 || statistics.sessionCount !== 1) ? 1 : 0;
+    };
+
+main();
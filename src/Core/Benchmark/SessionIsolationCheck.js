@@ -0,0 +1,227 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which checks that the sessions of PLAYER_SEQUENCER.sessionManager
+// (Sequencer.js) are isolated from each other and from the "default" session:
+//     playlists           clips scheduled in one session are not in another
+//     journals            the playlist version and change journal of a session only record its own changes
+//     pools               a segmentId of one session is rejected by another, and capacity, create and release
+//                         of one session's playback segment pool do not affect another
+//     routing             sessionManager.runJSON and runCompact reach the session named, and fail for an unknown one
+//     destroy             destroying a session releases its live playback segments, and leaves the others playing
+//
+// Usage: node SessionIsolationCheck.js
+//
+// The exit code is 1 if any check fails.
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    createNamespace = function () {
+        ///<summary>Load the Scheduler and Sequencer into a fresh context</summary>
+        ///<returns type="Object">The PLAYER_SEQUENCER namespace of the context</returns>
+        return harness.loadScripts([harness.SCHEDULER_SCRIPT, harness.SEQUENCER_SCRIPT]);
+    },
+
+    run = function (sessionManager, sessionId, target, func, params) {
+        ///<summary>Call a session through sessionManager.runJSON, throwing on an EXCEPTION result</summary>
+        var resultJSON = sessionManager.runJSON(sessionId, target, JSON.stringify({ func: func, params: params })),
+            result = (resultJSON === undefined) ? undefined : JSON.parse(resultJSON);      // undefined for a method without result
+
+        if (result && result.EXCEPTION) {
+            throw new Error(sessionId + ' ' + func + ' failed: ' + result.EXCEPTION.message);
+        }
+        return result;
+    },
+
+    isException = function (resultJSON) {
+        var result = JSON.parse(resultJSON);
+        return !!(result && result.EXCEPTION);
+    },
+
+    schedule = function (sessionManager, sessionId, contentDuration, adTime) {
+        ///<summary>Schedule content and, if adTime is a number, a mid-roll ad in a session</summary>
+        run(sessionManager, sessionId, 'scheduler', 'appendContentClip', { clipURI: 'http://example.com/' + sessionId + '.m3u8',
+            minManifestPosition: 0, maxManifestPosition: contentDuration });
+        if (typeof adTime === 'number') {
+            run(sessionManager, sessionId, 'scheduler', 'scheduleClip', { clipURI: 'http://example.com/' + sessionId + '-ad.m3u8', eClipType: 'Media',
+                eRollType: 'Mid', minManifestPosition: 0, maxManifestPosition: 15, linearDuration: 0, startTime: adTime, deleteAfterPlay: true });
+        }
+    },
+
+    playlistURIs = function (session) {
+        var access = session.sequentialPlaylist.access,
+            entry = access.getEntryAtTime(0),
+            uris = [];
+
+        while (entry) {
+            uris.push(entry.clipURI);
+            entry = access.getEntryAfterId(entry.id);
+        }
+        return uris;
+    },
+
+    CHECKS = {
+        playlists: function (expect) {
+            var namespace = createNamespace(),
+                sessionManager = namespace.sessionManager,
+                a = sessionManager.createSession(),
+                b = sessionManager.createSession({ sessionId: 'viewer-b' });
+
+            schedule(sessionManager, a, 600, 300);
+            schedule(sessionManager, b, 1200);
+            expect(playlistURIs(sessionManager.getSession(a)).join(' ') === 'http://example.com/' + a + '.m3u8 http://example.com/' + a + '-ad.m3u8 http://example.com/' + a + '.m3u8',
+                'session ' + a + ' holds its content split by its ad: ' + playlistURIs(sessionManager.getSession(a)).join(' '));
+            expect(playlistURIs(sessionManager.getSession(b)).join(' ') === 'http://example.com/viewer-b.m3u8',
+                'session viewer-b holds only its content: ' + playlistURIs(sessionManager.getSession(b)).join(' '));
+            expect(sessionManager.getSession(a).sequentialPlaylist.access.getPlaylistLinearDuration() === 600 &&
+                sessionManager.getSession(b).sequentialPlaylist.access.getPlaylistLinearDuration() === 1200, 'each session has its own linear duration');
+            expect(playlistURIs(sessionManager.getSession('default')).length === 0 && namespace.sequentialPlaylist.access.getPlaylistLinearDuration() === 0,
+                'the default session is empty');
+            expect(sessionManager.getSessionStatistics(a).entryCount === 3 && sessionManager.getSessionStatistics(b).entryCount === 1,
+                'session statistics count each session\'s entries');
+
+            run(sessionManager, b, 'scheduler', 'reset', {});
+            expect(playlistURIs(sessionManager.getSession(b)).length === 0 && playlistURIs(sessionManager.getSession(a)).length === 3,
+                'a reset of viewer-b leaves ' + a + ' unchanged');
+        },
+
+        journals: function (expect) {
+            var sessionManager = createNamespace().sessionManager,
+                a = sessionManager.createSession(),
+                b = sessionManager.createSession(),
+                accessA = sessionManager.getSession(a).sequentialPlaylist.access,
+                accessB = sessionManager.getSession(b).sequentialPlaylist.access,
+                versionA,
+                changes;
+
+            schedule(sessionManager, a, 600);
+            versionA = accessA.getVersion();
+            schedule(sessionManager, b, 600, 100);
+            schedule(sessionManager, b, 600, 900);
+            expect(accessA.getVersion() === versionA, 'changes to ' + b + ' do not advance the version of ' + a);
+            changes = accessA.getChangesSince(0);
+            expect(!changes.isTruncated && changes.changes.length === 1 && changes.changes[0].change === 'insert',
+                'the journal of ' + a + ' holds only its own insert: ' + JSON.stringify(changes.changes));
+            changes = accessB.getChangesSince(0);
+            expect(!changes.isTruncated && changes.changes.length === accessB.getVersion() && changes.changes[0].version === 1,
+                'the journal of ' + b + ' holds its own ' + accessB.getVersion() + ' changes from version 1: ' + JSON.stringify(changes.changes));
+            run(sessionManager, a, 'scheduler', 'reset', {});
+            expect(accessB.getChangesSince(changes.version).changes.length === 0, 'a reset of ' + a + ' is not in the journal of ' + b);
+        },
+
+        pools: function (expect) {
+            var sessionManager = createNamespace().sessionManager,
+                a = sessionManager.createSession({ segmentCapacity: 2 }),
+                b = sessionManager.createSession(),
+                poolA = sessionManager.getSession(a).playbackSegmentPool,
+                poolB = sessionManager.getSession(b).playbackSegmentPool,
+                segmentsA = [],
+                segmentB,
+                i;
+
+            schedule(sessionManager, a, 600);
+            schedule(sessionManager, b, 600);
+            for (i = 0; i < 2; i += 1) {
+                segmentsA.push(run(sessionManager, a, 'sequencer', 'seekFromLinearPosition', { linearSeekPosition: i * 10 }));
+            }
+            expect(isException(sessionManager.runJSON(a, 'sequencer', JSON.stringify({ func: 'seekFromLinearPosition', params: { linearSeekPosition: 20 } }))),
+                'a seek beyond the capacity of 2 of ' + a + ' fails');
+            expect(poolB.getStatistics().liveCount === 0, a + ' at capacity leaves the pool of ' + b + ' empty');
+            expect(isException(sessionManager.runJSON(b, 'sequencer', JSON.stringify({ func: 'tick', params: { currentSegmentId: segmentsA[1].segmentId, playbackRate: 1, currentPlaybackPosition: 0 } }))),
+                'a segmentId of ' + a + ' is rejected by ' + b);
+
+            segmentB = run(sessionManager, b, 'sequencer', 'seekFromLinearPosition', { linearSeekPosition: 0 });
+            expect(segmentB.clip.clipURI === 'http://example.com/' + b + '.m3u8', b + ' plays its own content');
+            expect(poolA.getStatistics().liveCount === 2 && poolB.getStatistics().liveCount === 1, 'each pool counts only its own live segments');
+            run(sessionManager, b, 'sequencer', 'releasePlaybackSegment', { currentSegmentId: segmentB.segmentId });
+            expect(poolA.getPlaybackSegment(segmentsA[0].segmentId).clip.clipURI === 'http://example.com/' + a + '.m3u8',
+                'releasing a segment of ' + b + ' with the same segmentId leaves the segment of ' + a + ' live');
+            expect(poolA.getStatistics().releaseCount === 0 && poolB.getStatistics().releaseCount === 1, 'each pool counts only its own releases');
+        },
+
+        routing: function (expect) {
+            var namespace = createNamespace(),
+                sessionManager = namespace.sessionManager,
+                a = sessionManager.createSession(),
+                segment,
+                tuple;
+
+            schedule(sessionManager, a, 600);
+            schedule(sessionManager, 'default', 900);
+            segment = run(sessionManager, a, 'sequencer', 'seekFromLinearPosition', { linearSeekPosition: 5 });
+            expect(segment.clip.clipURI === 'http://example.com/' + a + '.m3u8', 'runJSON reaches the sequencer of ' + a);
+            tuple = sessionManager.runCompact(a, 'tick', segment.segmentId, 1, 10).split(',');
+            expect(tuple[2] === '600', 'runCompact tick reaches ' + a + ': ' + tuple.join(','));
+            expect(namespace.sequentialPlaylist.access.getPlaylistLinearDuration() === 900, 'runJSON with "default" reaches the singletons');
+            expect(isException(sessionManager.runJSON('missing', 'scheduler', JSON.stringify({ func: 'getPlaylistLinearDuration', params: {} }))) &&
+                isException(sessionManager.runCompact('missing', 'tick', segment.segmentId, 1, 10)), 'an unknown sessionId fails');
+            expect(isException(sessionManager.runJSON(a, 'playlist', '{}')), 'an unknown target fails');
+        },
+
+        destroy: function (expect) {
+            var sessionManager = createNamespace().sessionManager,
+                a = sessionManager.createSession(),
+                b = sessionManager.createSession(),
+                poolA = sessionManager.getSession(a).playbackSegmentPool,
+                segmentsA = [],
+                segmentB,
+                i;
+
+            schedule(sessionManager, a, 600, 300);
+            schedule(sessionManager, b, 600, 300);
+            for (i = 0; i < 3; i += 1) {
+                segmentsA.push(run(sessionManager, a, 'sequencer', 'seekFromLinearPosition', { linearSeekPosition: i * 200 }));
+            }
+            segmentB = run(sessionManager, b, 'sequencer', 'seekFromLinearPosition', { linearSeekPosition: 0 });
+            expect(poolA.getStatistics().liveCount === 3, a + ' has 3 live segments before it is destroyed');
+
+            sessionManager.destroySession(a);
+            expect(!sessionManager.hasSession(a), a + ' is gone');
+            expect(poolA.getStatistics().liveCount === 0 && poolA.getStatistics().releaseCount === 3,
+                'destroying ' + a + ' released its segments: ' + JSON.stringify(poolA.getStatistics()));
+            expect(segmentsA.every(function (segment) {
+                try {
+                    poolA.getPlaybackSegment(segment.segmentId);
+                    return false;
+                }
+                catch (ex) {
+                    return true;
+                }
+            }), 'every segmentId of the destroyed session is rejected');
+            expect(isException(sessionManager.runJSON(a, 'sequencer', JSON.stringify({ func: 'tick', params: { currentSegmentId: segmentsA[0].segmentId, playbackRate: 1, currentPlaybackPosition: 0 } }))),
+                'runJSON for the destroyed session fails');
+
+            segmentB = run(sessionManager, b, 'sequencer', 'onEndOfMedia', { currentSegmentId: segmentB.segmentId, currentPlaybackPosition: 300, currentPlaybackRate: 1 });
+            expect(segmentB.clip.clipURI === 'http://example.com/' + b + '-ad.m3u8', b + ' plays on to its ad after ' + a + ' is destroyed');
+            expect(sessionManager.getSessionStatistics(b).liveSegmentCount === 1, b + ' keeps its own live segment');
+            expect(sessionManager.getStatistics().sessionCount === 2 && sessionManager.getStatistics().destroyCount === 1,
+                'the manager counts the default session and ' + b + ', and one destroy');
+
+            try {
+                sessionManager.destroySession('default');
+                expect(false, 'destroying the default session throws');
+            }
+            catch (ex) {
+                expect(sessionManager.hasSession('default'), 'the default session cannot be destroyed');
+            }
+        }
+    };
+
+harness.runChecks(CHECKS);
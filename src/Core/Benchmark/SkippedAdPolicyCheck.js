@@ -0,0 +1,216 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which checks the eSkippedAdPolicy of seekSkippingAds and commitScrub
+// (mySeekSkippingAds of Sequencer.js) for a forward seek from 50 to 450 across the breaks of one content clip: a pod
+// of two deleteAfterPlay ads at 100, an ad without deleteAfterPlay at 200, and deleteAfterPlay ads at 300 and 400:
+//     markPlayed          every crossed ad is marked played; the deleteAfterPlay ones are removed by a single
+//                         onPlayedEntries pass, the same list and changes as removing them one by one, and the split
+//                         content is welded back so the seek lands on the welded entry
+//     playLast            the last break is played before resuming at the seek position, the others are marked played
+//     playAll             every crossed ad is played in order, each removed as played, then playback resumes
+//     commitScrub         a scrub committed with eSkippedAdPolicy does the same as seekSkippingAds
+//     backwardSeek        a backward seek leaves the ads it crosses as they are
+//
+// Usage: node SkippedAdPolicyCheck.js
+//
+// The exit code is 1 if any check fails.
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    CONTENT_DURATION = 600,
+    AD_DURATION = 10,
+    SEEK_FROM = 50,
+    SEEK_TO = 450,
+
+    createPlayer = function () {
+        ///<summary>Load the Scheduler and Sequencer into a fresh context, schedule the timeline and start playback at SEEK_FROM</summary>
+        ///<returns type="Object">An object with: namespace, ads (entry ids by name: podA, podB, kept, ad300, ad400), adIds (in play order), segment (the current one), sequencer (runJSON call throwing on an EXCEPTION)</returns>
+        var player = { namespace: harness.loadScripts([harness.SCHEDULER_SCRIPT, harness.SEQUENCER_SCRIPT]), ads: {} },
+            scheduleAd = function (name, params) {
+                params.clipURI = 'http://example.com/' + name + '.mp4';
+                params.eClipType = 'Media';
+                params.minManifestPosition = 0;
+                params.maxManifestPosition = AD_DURATION;
+                params.linearDuration = 0;
+                player.ads[name] = harness.callJSON(player.namespace.scheduler, 'scheduleClip', params).id;
+            };
+
+        player.sequencer = function (func, params) {
+            return harness.callJSON(player.namespace.sequencerPluginChain, func, params);
+        };
+        harness.callJSON(player.namespace.scheduler, 'appendContentClip', { clipURI: 'http://example.com/content.m3u8',
+            minManifestPosition: 0, maxManifestPosition: CONTENT_DURATION });
+        scheduleAd('podA', { eRollType: 'Mid', startTime: 100, deleteAfterPlay: true });
+        scheduleAd('podB', { eRollType: 'Pod', appendTo: player.ads.podA, deleteAfterPlay: true });
+        scheduleAd('kept', { eRollType: 'Mid', startTime: 200, deleteAfterPlay: false });
+        scheduleAd('ad300', { eRollType: 'Mid', startTime: 300, deleteAfterPlay: true });
+        scheduleAd('ad400', { eRollType: 'Mid', startTime: 400, deleteAfterPlay: true });
+        player.adIds = [player.ads.podA, player.ads.podB, player.ads.kept, player.ads.ad300, player.ads.ad400];
+        player.segment = player.sequencer('seekFromLinearPosition', { linearSeekPosition: SEEK_FROM });
+        return player;
+    },
+
+    listEntries = function (player) {
+        ///<returns type="String">The playlist as "clip@linearStartTime+linearDuration" in list order</returns>
+        var access = player.namespace.sequentialPlaylist.access,
+            entries = [],
+            entry;
+
+        for (entry = access.getEntryAtTime(0); entry; entry = access.getEntryAfterId(entry.id)) {
+            entries.push(entry.clipURI.replace('http://example.com/', '') + '@' + entry.linearStartTime + '+' + entry.linearDuration);
+        }
+        return entries.join(' ');
+    },
+
+    // the playlist once every deleteAfterPlay ad is gone: the content split at 200 by the kept ad only
+    PLAYED_PLAYLIST = 'content.m3u8@0+200 kept.mp4@200+0 content.m3u8@200+400',
+
+    seekSkippingAds = function (player, eSkippedAdPolicy) {
+        var result = player.sequencer('seekSkippingAds', { currentSegmentId: player.segment.segmentId, currentPlaybackPosition: SEEK_FROM,
+            seekbarSeekPosition: SEEK_TO, eSkippedAdPolicy: eSkippedAdPolicy });
+
+        player.segment = result.segment;
+        return result;
+    },
+
+    playToEnd = function (player) {
+        ///<summary>Play the current segment to its end</summary>
+        player.segment = player.sequencer('onEndOfMedia', { currentSegmentId: player.segment.segmentId,
+            currentPlaybackPosition: player.segment.clip.maxRenderingTime, currentPlaybackRate: 1 });
+        return player.segment;
+    },
+
+    isContentAt = function (segment, linearStartTime, initialPlaybackStartTime) {
+        return !!segment && !segment.clip.isAdvertisement && segment.clip.linearStartTime === linearStartTime && segment.initialPlaybackStartTime === initialPlaybackStartTime;
+    },
+
+    CHECKS = {
+        markPlayed: function (expect) {
+            var player = createPlayer(),
+                reference = createPlayer(),
+                change = player.namespace.sequentialPlaylist.change,
+                removeEntries = change.removeEntries,
+                remove = change.remove,
+                calls = { removeEntries: 0, remove: 0 },
+                version = player.namespace.sequentialPlaylist.access.getVersion(),
+                result;
+
+            change.removeEntries = function (ids) {
+                calls.removeEntries += 1;
+                return removeEntries.call(change, ids);
+            };
+            change.remove = function (id) {
+                calls.remove += 1;
+                return remove.call(change, id);
+            };
+            result = seekSkippingAds(player, 'MarkPlayed');
+            change.removeEntries = removeEntries;
+            change.remove = remove;
+
+            expect(JSON.stringify(result.crossedAdEntryIds) === JSON.stringify(player.adIds), 'every ad is crossed in play order: ' + JSON.stringify(result.crossedAdEntryIds));
+            expect(result.queuedAdEntryIds.length === 0 && JSON.stringify(result.markedPlayedAdEntryIds) === JSON.stringify(player.adIds), 'every crossed ad is marked played');
+            expect(calls.removeEntries === 1 && calls.remove === 0, 'the ads are removed in a single pass: ' + JSON.stringify(calls));
+            expect(result.removedEntryIds.length === 7 && [player.ads.podA, player.ads.podB, player.ads.ad300, player.ads.ad400].every(function (id) {
+                return result.removedEntryIds.indexOf(id) >= 0;
+            }) && result.removedEntryIds.indexOf(player.ads.kept) < 0, 'the four deleteAfterPlay ads and three welded content tails are removed: ' + JSON.stringify(result.removedEntryIds));
+            expect(listEntries(player) === PLAYED_PLAYLIST, 'the content is welded back around the kept ad: ' + listEntries(player));
+            expect(isContentAt(result.segment, 200, SEEK_TO) && result.segment.clip.linearDuration === 400, 'the seek lands on the welded content entry');
+
+            [player.ads.podA, player.ads.podB, player.ads.ad300, player.ads.ad400].forEach(function (id) {
+                reference.namespace.sequentialPlaylist.change.remove(id);
+            });
+            expect(player.namespace.sequentialPlaylist.testProbe_toJSON() === reference.namespace.sequentialPlaylist.testProbe_toJSON(),
+                'the same playlist as removing the ads one by one');
+            expect(JSON.stringify(player.namespace.sequentialPlaylist.access.getChangesSince(version)) ===
+                JSON.stringify(reference.namespace.sequentialPlaylist.access.getChangesSince(version)), 'the same changes as removing the ads one by one');
+            expect(player.namespace.playbackSegmentPool.getStatistics().liveCount === 1, 'one live segment');
+        },
+
+        playLast: function (expect) {
+            var player = createPlayer(),
+                result = seekSkippingAds(player, 'PlayLast');
+
+            expect(JSON.stringify(result.queuedAdEntryIds) === JSON.stringify([player.ads.ad400]), 'the last break is queued');
+            expect(JSON.stringify(result.markedPlayedAdEntryIds) === JSON.stringify(player.adIds.slice(0, 4)), 'the breaks before it are marked played');
+            expect(result.removedEntryIds.length === 5 && result.removedEntryIds.indexOf(player.ads.ad400) < 0, 'three ads and two content tails are removed: ' + JSON.stringify(result.removedEntryIds));
+            expect(result.segment.clip.id === player.ads.ad400 && result.segment.initialPlaybackStartTime === 0, 'the last break plays first');
+
+            playToEnd(player);
+            expect(isContentAt(player.segment, 200, SEEK_TO), 'playback resumes at the seek position on the welded content');
+            expect(listEntries(player) === PLAYED_PLAYLIST, 'the played ad was removed: ' + listEntries(player));
+            expect(player.namespace.playbackSegmentPool.getStatistics().liveCount === 1, 'one live segment');
+        },
+
+        playAll: function (expect) {
+            var player = createPlayer(),
+                result = seekSkippingAds(player, 'PlayAll'),
+                played = [player.segment.clip.id],
+                i;
+
+            expect(JSON.stringify(result.queuedAdEntryIds) === JSON.stringify(player.adIds) && result.markedPlayedAdEntryIds.length === 0 &&
+                result.removedEntryIds.length === 0, 'every crossed ad is queued and none removed');
+            for (i = 1; i < player.adIds.length; i += 1) {
+                played.push(playToEnd(player).clip.id);
+            }
+            expect(JSON.stringify(played) === JSON.stringify(player.adIds), 'the ads are played in order: ' + JSON.stringify(played));
+            playToEnd(player);
+            expect(isContentAt(player.segment, 200, SEEK_TO), 'playback resumes at the seek position on the welded content');
+            expect(listEntries(player) === PLAYED_PLAYLIST, 'each deleteAfterPlay ad was removed as played: ' + listEntries(player));
+            expect(player.namespace.playbackSegmentPool.getStatistics().liveCount === 1, 'one live segment');
+        },
+
+        commitScrub: function (expect) {
+            var player = createPlayer(),
+                reference = createPlayer(),
+                scrubId = player.sequencer('beginScrub', { currentSegmentId: player.segment.segmentId, currentPlaybackPosition: SEEK_FROM }),
+                expected = seekSkippingAds(reference, 'PlayLast'),
+                result;
+
+            harness.callCompact(player.namespace.sequencerPluginChain, ['submitScrubPosition', scrubId, 250]);
+            harness.callCompact(player.namespace.sequencerPluginChain, ['submitScrubPosition', scrubId, SEEK_TO]);
+            result = player.sequencer('commitScrub', { scrubId: scrubId, eSkippedAdPolicy: 'PlayLast' });
+            expect(result.submittedCount === 2, 'two positions submitted');
+            expect(['crossedAdEntryIds', 'queuedAdEntryIds', 'markedPlayedAdEntryIds', 'removedEntryIds'].every(function (name) {
+                return JSON.stringify(result[name]) === JSON.stringify(expected[name]);
+            }), 'the same ads as seekSkippingAds: ' + JSON.stringify(result));
+            expect(result.segment.clip.id === expected.segment.clip.id, 'the same segment as seekSkippingAds');
+            expect(listEntries(player) === listEntries(reference), 'the same playlist as seekSkippingAds');
+            player.segment = result.segment;
+            scrubId = player.sequencer('beginScrub', { currentSegmentId: player.segment.segmentId });
+            expect(harness.throwsError(function () { player.sequencer('commitScrub', { scrubId: scrubId, eSkippedAdPolicy: 'Skip' }); }), 'an invalid policy is refused');
+        },
+
+        backwardSeek: function (expect) {
+            var player = createPlayer(),
+                playlist,
+                result;
+
+            player.segment = player.sequencer('seekFromLinearPosition', { linearSeekPosition: SEEK_TO });
+            playlist = listEntries(player);
+            result = player.sequencer('seekSkippingAds', { currentSegmentId: player.segment.segmentId, currentPlaybackPosition: SEEK_TO,
+                seekbarSeekPosition: SEEK_FROM, eSkippedAdPolicy: 'MarkPlayed' });
+            expect(JSON.stringify(result.crossedAdEntryIds) === JSON.stringify(player.adIds.slice(0).reverse()), 'the ads are crossed in reverse order');
+            expect(result.markedPlayedAdEntryIds.length === 0 && result.queuedAdEntryIds.length === 0 && result.removedEntryIds.length === 0, 'no ad is marked or queued');
+            expect(listEntries(player) === playlist && isContentAt(result.segment, 0, SEEK_FROM), 'the playlist is unchanged');
+        }
+    };
+
+harness.runChecks(CHECKS);
@@ -0,0 +1,179 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which measures the cold start time, from loading the scripts to the
+// result of the first scheduleClip, of:
+//     separate    the four scripts loaded one by one, with the host polling the scheduler every 50 ms as the
+//                 SequencerAVPlayerFramework used to do
+//     bundle      the single-bundle build of src/Core/Build/BuildBundle.js, with the host told it is ready by the
+//                 readiness signal (the iframe load of the ready URL, emulated by a minimal document)
+//
+// Usage: node StartupBenchmark.js [--runs <count>] [--plugin <plugin script>]
+//     --runs      cold starts measured per case, each in a fresh context (default 20)
+//     --plugin    the sequencer plugin script loaded last (default src/iOS/HLSClient/SequencerPlugin.js)
+//
+
+/*jslint node: true */
+"use strict";
+
+var fs = require('fs'),
+    path = require('path'),
+    vm = require('vm'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+    buildBundle = require(path.join(__dirname, '..', 'Build', 'BuildBundle.js')).buildBundle,
+
+    POLLING_INTERVAL_MS = 50,
+    READY_URL = 'playersequencer://ready',
+    CONTENT_CLIP_JSON = JSON.stringify({ func: 'appendContentClip', params: { clipURI: 'http://example.com/content.m3u8', minManifestPosition: 0, maxManifestPosition: 600 } }),
+    SCHEDULE_CLIP_JSON = JSON.stringify({ func: 'scheduleClip', params: { clipURI: 'http://example.com/ad.m3u8', eClipType: 'Media',
+        minManifestPosition: 0, maxManifestPosition: 30, linearDuration: 0, startTime: 60, deleteAfterPlay: true, eRollType: 'Mid' } }),
+
+    parseArguments = function (argv) {
+        var options = { runs: 20, pluginScript: harness.PLUGIN_SCRIPT },
+            i;
+
+        for (i = 0; i < argv.length; i += 1) {
+            if (argv[i] === '--runs') {
+                i += 1;
+                options.runs = parseInt(argv[i], 10);
+            } else if (argv[i] === '--plugin') {
+                i += 1;
+                options.pluginScript = path.resolve(argv[i]);
+            } else {
+                throw new Error('usage: node StartupBenchmark.js [--runs <count>] [--plugin <plugin script>]');
+            }
+        }
+        return options;
+    },
+
+    now = function () {
+        // milliseconds
+        return harness.now() / 1e6;
+    },
+
+    scheduleFirstClip = function (context) {
+        ///<summary>Make the first scheduling calls the host makes once the scripts are ready</summary>
+        var result = vm.runInContext('PLAYER_SEQUENCER.scheduler.runJSON(' + JSON.stringify(CONTENT_CLIP_JSON) + ') && ' +
+            'PLAYER_SEQUENCER.scheduler.runJSON(' + JSON.stringify(SCHEDULE_CLIP_JSON) + ')', context);
+
+        if (result.indexOf('{"EXCEPTION":') === 0) {
+            throw new Error(result);
+        }
+    },
+
+    startSeparate = function (scripts, done) {
+        ///<summary>Load the separate scripts and poll for readiness as the framework loadTimer did</summary>
+        var context = vm.createContext({ console: console }),
+            startTime = now(),
+            i,
+
+        poll = function () {
+            // Note: the isReady check of the native Scheduler wrapper
+            if (vm.runInContext('typeof PLAYER_SEQUENCER !== "undefined" && !!PLAYER_SEQUENCER.scheduler', context)) {
+                scheduleFirstClip(context);
+                done(now() - startTime);
+            } else {
+                setTimeout(poll, POLLING_INTERVAL_MS);
+            }
+        };
+
+        // Note: the web view loads the scripts after the framework init returns, which starts the first poll timer
+        setTimeout(poll, POLLING_INTERVAL_MS);
+        setImmediate(function () {
+            for (i = 0; i < scripts.length; i += 1) {
+                vm.runInContext(scripts[i].source, context, { filename: scripts[i].fileName });
+            }
+        });
+    },
+
+    startBundle = function (bundle, done) {
+        ///<summary>Load the bundle and wait for its readiness signal</summary>
+        var startTime = now(),
+            context,
+            documentElement = {
+                appendChild: function (element) {
+                    if (element.src === READY_URL) {
+                        // Note: the web view calls its delegate for the iframe load asynchronously
+                        setImmediate(function () {
+                            scheduleFirstClip(context);
+                            done(now() - startTime);
+                        });
+                    }
+                },
+                removeChild: function () {
+                    return undefined;
+                }
+            };
+
+        context = vm.createContext({
+            console: console,
+            document: {
+                documentElement: documentElement,
+                createElement: function () {
+                    return { style: {} };
+                }
+            }
+        });
+        setImmediate(function () {
+            vm.runInContext(bundle, context, { filename: 'PlayerSequencer.js' });
+        });
+    },
+
+    summarize = function (samples) {
+        var sorted = samples.slice(0).sort(function (a, b) { return a - b; }),
+            total = 0,
+            i;
+
+        for (i = 0; i < sorted.length; i += 1) {
+            total += sorted[i];
+        }
+        return [(total / sorted.length).toFixed(2), sorted[Math.floor(sorted.length / 2)].toFixed(2), sorted[sorted.length - 1].toFixed(2)];
+    },
+
+    runCase = function (runs, start, done) {
+        var samples = [],
+
+        next = function (elapsed) {
+            if (elapsed !== undefined) {
+                samples.push(elapsed);
+            }
+            if (samples.length < runs) {
+                start(next);
+            } else {
+                done(samples);
+            }
+        };
+
+        next();
+    },
+
+    main = function () {
+        var options = parseArguments(process.argv.slice(2)),
+            scripts = harness.CORE_SCRIPTS.concat([options.pluginScript]).map(function (fileName) {
+                return { fileName: fileName, source: fs.readFileSync(fileName, 'utf8') };
+            }),
+            bundle = buildBundle({ scripts: [options.pluginScript], isMinified: true });
+
+        console.log(options.runs + ' cold starts per case, bundle ' + bundle.length + ' characters');
+        console.log('case\tmean ms\tp50 ms\tmax ms');
+        runCase(options.runs, function (done) { startSeparate(scripts, done); }, function (separateSamples) {
+            console.log(['separate+poll'].concat(summarize(separateSamples)).join('\t'));
+            runCase(options.runs, function (done) { startBundle(bundle, done); }, function (bundleSamples) {
+                console.log(['bundle+push'].concat(summarize(bundleSamples)).join('\t'));
+            });
+        });
+    };
+
+main();
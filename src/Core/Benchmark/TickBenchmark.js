@@ -0,0 +1,254 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+// This file is a Node.js command line tool which checks the combined sequencer tick against the calls it
+// replaced on the native playback timer, and measures the cost of both for each frame.
+//
+// Two identical contexts play the same schedule frame by frame, with mid-roll ads scheduled ahead of the
+// playback position and some removed again, so the playing content clip is split and welded under it:
+//     tick        one runCompact('tick', ...) call, as the native bridge makes it
+//     separate    the isClipChanged of the playback segment, runJSON manifestToSeekbarTime and, when the clip
+//                 changed, its minRenderingTime and maxRenderingTime (the rendering range is kept from the last
+//                 change otherwise, as the native side did)
+// Every frame the seekbar times, playbackRangeExceeded, isClipChanged and the rendering range must be equal.
+//
+// Usage: node TickBenchmark.js [--clips <count>] [--step <seconds>] [--iterations <count>]
+//     --clips         600 second content clips played (default 4)
+//     --step          playback position advance per frame (default 0.25)
+//     --iterations    calls measured per case for the steady-state cost (default 200000)
+//
+// The exit code is 1 if any frame differs.
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    CONTENT_CLIP_DURATION = 600,
+    AD_DURATION = 15,
+    SCHEDULE_INTERVAL = 150,        // frames between mid-roll ads scheduled ahead of the playback position
+    REMOVE_INTERVAL = 400,          // frames between removals of the last scheduled ad (welding the content back)
+    WARMUP_ITERATIONS = 20000,
+
+    parseArguments = function (argv) {
+        var options = { clips: 4, step: 0.25, iterations: 200000 },
+            i;
+
+        for (i = 0; i < argv.length; i += 1) {
+            if (argv[i] === '--clips') {
+                i += 1;
+                options.clips = parseInt(argv[i], 10);
+            } else if (argv[i] === '--step') {
+                i += 1;
+                options.step = parseFloat(argv[i]);
+            } else if (argv[i] === '--iterations') {
+                i += 1;
+                options.iterations = parseInt(argv[i], 10);
+            } else {
+                throw new Error('usage: node TickBenchmark.js [--clips <count>] [--step <seconds>] [--iterations <count>]');
+            }
+        }
+        return options;
+    },
+
+    createSequencer = function (clipCount) {
+        ///<summary>Load the Scheduler and Sequencer into a fresh context and append the content clips</summary>
+        ///<returns type="Object">The PLAYER_SEQUENCER namespace of the context</returns>
+        var namespace = harness.loadScripts([harness.SCHEDULER_SCRIPT, harness.SEQUENCER_SCRIPT]),
+            i;
+
+        for (i = 0; i < clipCount; i += 1) {
+            namespace.scheduler.runJSON(JSON.stringify({ func: 'appendContentClip', params: {
+                clipURI: 'http://example.com/content' + i.toString() + '.m3u8', minManifestPosition: 0, maxManifestPosition: CONTENT_CLIP_DURATION } }));
+        }
+        return namespace;
+    },
+
+    createRandom = harness.createRandom,
+
+    now = harness.now,
+
+    parseSegment = function (json) {
+        var segment = JSON.parse(json);
+
+        if (segment && segment.EXCEPTION) {
+            throw new Error(segment.EXCEPTION.message);
+        }
+        return segment;
+    },
+
+    // ---------------------------------
+    // one frame through each path, as the native playback timer makes it
+    // ---------------------------------
+    tickFrame = function (namespace, segmentId, position) {
+        var fields = namespace.sequencerPluginChain.runCompact('tick', segmentId, 1, position, undefined, undefined, undefined).split(',');
+
+        if (fields.length !== 9) {
+            throw new Error('tick failed: ' + fields.join(','));
+        }
+        return {
+            currentSeekbarPosition: Number(fields[0]),
+            minSeekbarPosition: Number(fields[1]),
+            maxSeekbarPosition: Number(fields[2]),
+            playbackRangeExceeded: fields[3] === '1',
+            isClipChanged: fields[4] === '1',
+            minRenderingTime: Number(fields[5]),
+            maxRenderingTime: Number(fields[6])
+        };
+    },
+
+    separateFrame = function (namespace, segmentId, position, renderingRange) {
+        var isClipChanged = namespace.playbackSegmentPool.getPlaybackSegment(segmentId).isClipChanged,
+            result = parseSegment(namespace.sequencerPluginChain.runJSON('{"func":"manifestToSeekbarTime","params":{"currentSegmentId":' + segmentId +
+                ',"playbackRate":1,"currentPlaybackPosition":' + position + '}}'));
+
+        if (isClipChanged) {
+            renderingRange.minRenderingTime = namespace.playbackSegmentPool.getPlaybackSegment(segmentId).clip.minRenderingTime;
+            renderingRange.maxRenderingTime = namespace.playbackSegmentPool.getPlaybackSegment(segmentId).clip.maxRenderingTime;
+        }
+        return {
+            currentSeekbarPosition: result.currentSeekbarPosition,
+            minSeekbarPosition: result.minSeekbarPosition,
+            maxSeekbarPosition: result.maxSeekbarPosition,
+            playbackRangeExceeded: result.playbackRangeExceeded,
+            isClipChanged: isClipChanged,
+            minRenderingTime: renderingRange.minRenderingTime,
+            maxRenderingTime: renderingRange.maxRenderingTime
+        };
+    },
+
+    compareFrames = function (tickResult, separateResult) {
+        ///<returns type="String" mayBeNull="true">The first differing field, or null</returns>
+        var field;
+
+        for (field in separateResult) {
+            if (separateResult.hasOwnProperty(field) && tickResult[field] !== separateResult[field]) {
+                return field;
+            }
+        }
+        return null;
+    },
+
+    // ---------------------------------
+    // the same schedule change or segment change on both contexts
+    // ---------------------------------
+    runBoth = function (namespaces, target, json) {
+        var results = namespaces.map(function (namespace) { return namespace[target].runJSON(json); });
+
+        if (results[0] !== results[1]) {
+            throw new Error('contexts diverged on ' + json + ': ' + results[0] + ' / ' + results[1]);
+        }
+        return results[0];
+    },
+
+    play = function (options) {
+        ///<summary>Play the whole schedule through both paths, comparing every frame</summary>
+        ///<returns type="Object">An object with properties: frameCount, clipChangeCount, segmentCount, mismatchCount, mismatches, tickNs, separateNs</returns>
+        var namespaces = [createSequencer(options.clips), createSequencer(options.clips)],
+            random = createRandom(7919),
+            report = { frameCount: 0, clipChangeCount: 0, segmentCount: 1, mismatchCount: 0, mismatches: [], tickNs: 0, separateNs: 0 },
+            segment = parseSegment(runBoth(namespaces, 'sequencerPluginChain', JSON.stringify({ func: 'seekFromLinearPosition', params: { linearSeekPosition: 0 } }))),
+            renderingRange = { minRenderingTime: segment.clip.minRenderingTime, maxRenderingTime: segment.clip.maxRenderingTime },
+            position = segment.initialPlaybackStartTime,
+            lastAdId = null,
+            tickResult,
+            separateResult,
+            startTime,
+            field;
+
+        while (segment) {
+            startTime = now();
+            tickResult = tickFrame(namespaces[0], segment.segmentId, position);
+            report.tickNs += now() - startTime;
+            startTime = now();
+            separateResult = separateFrame(namespaces[1], segment.segmentId, position, renderingRange);
+            report.separateNs += now() - startTime;
+
+            report.frameCount += 1;
+            report.clipChangeCount += separateResult.isClipChanged ? 1 : 0;
+            field = compareFrames(tickResult, separateResult);
+            if (field) {
+                report.mismatchCount += 1;
+                if (report.mismatches.length < 10) {
+                    report.mismatches.push({ frame: report.frameCount, segmentId: segment.segmentId, position: position, field: field, tick: tickResult, separate: separateResult });
+                }
+            }
+
+            if (separateResult.playbackRangeExceeded) {
+                segment = parseSegment(runBoth(namespaces, 'sequencerPluginChain', JSON.stringify({ func: 'onEndOfMedia', params: {
+                    currentSegmentId: segment.segmentId, currentPlaybackPosition: position, currentPlaybackRate: 1 } })));
+                if (segment) {
+                    report.segmentCount += 1;
+                    renderingRange.minRenderingTime = segment.clip.minRenderingTime;
+                    renderingRange.maxRenderingTime = segment.clip.maxRenderingTime;
+                    position = segment.initialPlaybackStartTime;
+                }
+            } else {
+                position += options.step;
+                if (!segment.clip.isAdvertisement && report.frameCount % SCHEDULE_INTERVAL === 0 &&
+                        separateResult.currentSeekbarPosition + 120 < separateResult.maxSeekbarPosition) {
+                    // an ad ahead of the playback position, often in the playing content clip so it is split under it
+                    lastAdId = parseSegment(runBoth(namespaces, 'scheduler', JSON.stringify({ func: 'scheduleClip', params: {
+                        clipURI: 'http://example.com/ad.m3u8', eClipType: 'Media', eRollType: 'Mid', minManifestPosition: 0, maxManifestPosition: AD_DURATION, linearDuration: 0,
+                        deleteAfterPlay: true, startTime: separateResult.currentSeekbarPosition + 5 + random() * 100 } }))).id;
+                }
+                if (lastAdId !== null && !segment.clip.isAdvertisement && report.frameCount % REMOVE_INTERVAL === 0) {
+                    // Note: the ad may have played and been deleted already, which both contexts report alike
+                    runBoth(namespaces, 'scheduler', JSON.stringify({ func: 'removeClip', params: { playlistEntryId: lastAdId } }));
+                    lastAdId = null;
+                }
+            }
+        }
+        return report;
+    },
+
+    measure = function (iterations, call) {
+        ///<returns type="Number">nanoseconds per call</returns>
+        var startTime,
+            i;
+
+        for (i = 0; i < WARMUP_ITERATIONS; i += 1) {
+            call(i);
+        }
+        startTime = now();
+        for (i = 0; i < iterations; i += 1) {
+            call(i);
+        }
+        return (now() - startTime) / iterations;
+    },
+
+    main = function () {
+        var options = parseArguments(process.argv.slice(2)),
+            report = play(options),
+            namespace = createSequencer(1),
+            segmentId = parseSegment(namespace.sequencerPluginChain.runJSON(JSON.stringify({ func: 'seekFromLinearPosition', params: { linearSeekPosition: 0 } }))).segmentId,
+            renderingRange = { minRenderingTime: 0, maxRenderingTime: CONTENT_CLIP_DURATION },
+            i;
+
+        console.log(report.frameCount + ' frames over ' + report.segmentCount + ' playback segments, ' + report.clipChangeCount + ' clip changes');
+        console.log('path\tplayed ns per frame\tsteady-state ns per frame');
+        console.log(['tick', (report.tickNs / report.frameCount).toFixed(0),
+            measure(options.iterations, function (n) { tickFrame(namespace, segmentId, (n % 500) + 1); }).toFixed(0)].join('\t'));
+        console.log(['separate', (report.separateNs / report.frameCount).toFixed(0),
+            measure(options.iterations, function (n) { separateFrame(namespace, segmentId, (n % 500) + 1, renderingRange); }).toFixed(0)].join('\t'));
+        console.log('mismatches: ' + report.mismatchCount);
+        for (i = 0; i < report.mismatches.length; i += 1) {
+            console.log('MISMATCH ' + JSON.stringify(report.mismatches[i]));
+        }
+        process.exitCode = (report.mismatchCount > 0) ? 1 : 0;
+    };
+
+main();
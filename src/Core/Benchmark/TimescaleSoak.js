@@ -0,0 +1,152 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which soaks a 24-hour sequential playlist with split/weld cycles
+// (mid-roll ads scheduled at scattered times, then removed so the content is welded back) and reports, with the
+// times in floating point seconds and in integer ticks (scheduler.setTimescale):
+//     placement   the largest distance between the requested start time of an ad and the one it was given
+//     drift       the largest distance of a content entry time, once welded back, from its exact value
+// It also reports the error the 32-bit float narrowing of the native bridge used to add to a time near the end
+// of the timeline.
+//
+// Usage: node TimescaleSoak.js [--cycles <count>] [--timescale <ticks per second>]
+//     --cycles        split/weld cycles per case, each of BATCH_SIZE ads (default 5000)
+//     --timescale     the ticks per second of the integer case (default 90000)
+//
+// The exit code is 1 if the integer case has any placement error or drift.
+//
+
+/*jslint node: true */
+"use strict";
+
+var path = require('path'),
+    harness = require(path.join(__dirname, 'Harness.js')),
+
+    CONTENT_CLIP_COUNT = 24,
+    CONTENT_CLIP_FRAMES = 107892,   // at 29.97 (30000 / 1001) fps, for a 24-hour timeline
+    CONTENT_CLIP_DURATION = CONTENT_CLIP_FRAMES * 1001 / 30000,
+    BATCH_SIZE = 4,                 // ads scheduled per cycle, so a content entry may be split several times before the welds
+
+    parseArguments = function (argv) {
+        var options = { cycles: 5000, timescale: 90000 },
+            i;
+
+        for (i = 0; i < argv.length; i += 1) {
+            if (argv[i] === '--cycles') {
+                i += 1;
+                options.cycles = parseInt(argv[i], 10);
+            } else if (argv[i] === '--timescale') {
+                i += 1;
+                options.timescale = parseInt(argv[i], 10);
+            } else {
+                throw new Error('usage: node TimescaleSoak.js [--cycles <count>] [--timescale <ticks per second>]');
+            }
+        }
+        return options;
+    },
+
+    createScheduler = function () {
+        ///<summary>Load the Scheduler into a fresh context</summary>
+        ///<returns type="Object">The PLAYER_SEQUENCER namespace of the context</returns>
+        return harness.loadScripts([harness.SCHEDULER_SCRIPT]);
+    },
+
+    createRandom = harness.createRandom,
+
+    soak = function (cycles, timescale) {
+        ///<summary>Run the split/weld cycles on a fresh schedule with the given timescale (0 for seconds)</summary>
+        ///<returns type="Object">An object with properties: maxPlacementError, maxDrift (seconds), entryCount, playlistDuration (seconds)</returns>
+        var namespace = createScheduler(),
+            scheduler = namespace.scheduler,
+            access = namespace.sequentialPlaylist.access,
+            unit = timescale || 1,
+            clipDuration = (timescale > 0) ? Math.round(CONTENT_CLIP_DURATION * timescale) : CONTENT_CLIP_DURATION,
+            totalDuration = CONTENT_CLIP_COUNT * clipDuration,
+            random = createRandom(7919),
+            exactTime = function (frames) {
+                // Note: a single rounding of the exact value, where the playlist adds the clip durations
+                return (timescale > 0) ? frames * 1001 * timescale / 30000 : frames * 1001 / 30000;
+            },
+            contentIds = [],
+            ids,
+            params,
+            entry,
+            maxPlacementError = 0,
+            maxDrift = 0,
+            cycle,
+            i;
+
+        scheduler.setTimescale({ timescale: timescale });
+        for (i = 0; i < CONTENT_CLIP_COUNT; i += 1) {
+            params = scheduler.createContentClipParams();
+            params.clipURI = 'http://example.com/content' + i.toString() + '.m3u8';
+            params.maxManifestPosition = clipDuration;
+            contentIds.push(scheduler.appendContentClip(params).id);
+        }
+
+        for (cycle = 0; cycle < cycles; cycle += 1) {
+            ids = [];
+            for (i = 0; i < BATCH_SIZE; i += 1) {
+                params = scheduler.createScheduleClipParams();
+                params.clipURI = 'http://example.com/ad.m3u8';
+                params.eClipType = 'Media';
+                params.maxManifestPosition = 30 * unit;
+                params.eRollType = 'Mid';
+                // Note: a scattered start time with a fractional part, as from a manifest cue (whole ticks in the integer case)
+                params.startTime = 1 + random() * (totalDuration - 2);
+                if (timescale > 0) {
+                    params.startTime = Math.round(params.startTime);
+                }
+                entry = scheduler.scheduleClip(params);
+                maxPlacementError = Math.max(maxPlacementError, Math.abs(entry.linearStartTime - params.startTime) / unit);
+                ids.push(entry.id);
+            }
+            for (i = 0; i < ids.length; i += 1) {
+                scheduler.removeClip({ playlistEntryId: ids[i] });
+            }
+        }
+
+        // every content entry is welded back, so it must have its exact times
+        for (i = 0; i < contentIds.length; i += 1) {
+            entry = access.getEntryFromId(contentIds[i]);
+            maxDrift = Math.max(maxDrift,
+                Math.abs(entry.linearStartTime - exactTime(i * CONTENT_CLIP_FRAMES)) / unit,
+                Math.abs(entry.linearDuration - clipDuration) / unit,
+                Math.abs(entry.minRenderingTime) / unit,
+                Math.abs(entry.maxRenderingTime - clipDuration) / unit);
+        }
+        return {
+            maxPlacementError: maxPlacementError,
+            maxDrift: maxDrift,
+            entryCount: access.getStatistics().entryCount,
+            playlistDuration: access.getPlaylistLinearDuration() / unit
+        };
+    },
+
+    main = function () {
+        var options = parseArguments(process.argv.slice(2)),
+            seconds = soak(options.cycles, 0),
+            ticks = soak(options.cycles, options.timescale),
+            lastMillisecond = Math.floor(CONTENT_CLIP_COUNT * CONTENT_CLIP_DURATION) - 0.001;
+
+        console.log(options.cycles + ' cycles of ' + BATCH_SIZE + ' splits and welds on a ' + (CONTENT_CLIP_COUNT * CONTENT_CLIP_DURATION / 3600).toFixed(3) + '-hour timeline');
+        console.log('case\tentries\tduration s\tplacement s\tdrift s');
+        console.log(['seconds', seconds.entryCount, seconds.playlistDuration, seconds.maxPlacementError.toExponential(3), seconds.maxDrift.toExponential(3)].join('\t'));
+        console.log(['ticks/' + options.timescale, ticks.entryCount, ticks.playlistDuration, ticks.maxPlacementError.toExponential(3), ticks.maxDrift.toExponential(3)].join('\t'));
+        console.log('32-bit float error at ' + lastMillisecond.toString() + ' s: ' + Math.abs(Math.fround(lastMillisecond) - lastMillisecond).toExponential(3) + ' s');
+        process.exitCode = (ticks.maxPlacementError > 0 || ticks.maxDrift > 0) ? 1 : 0;
+    };
+
+main();
@@ -0,0 +1,252 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which builds the single-bundle script of the Core modules: Scheduler.js,
+// Sequencer.js and AdResolver.js followed by the app sequencer plugin scripts, minified into one file whose last
+// line calls PLAYER_SEQUENCER.readiness.signalReady(). A web view then loads one script instead of four and the
+// host is told when it is ready instead of polling for it.
+//
+// Usage: node BuildBundle.js --out <bundle file> [--plugin <plugin script>]... [--no-minify]
+//     --out           the bundle file to write, such as PlayerSequencer.js in the app resources
+//     --plugin        a sequencer plugin script to add after the Core modules, such as SequencerPlugin.js
+//     --no-minify     keep the comments and white space, such as to debug the bundle
+//
+// Note: The minifier only removes comments and white space, and keeps the line breaks so automatic semicolon
+//       insertion is unchanged. It relies on the ES5 subset used by the Core modules (no template literals).
+
+/*jslint node: true */
+"use strict";
+
+var fs = require('fs'),
+    path = require('path'),
+
+    CORE_SCRIPTS = [
+        path.join(__dirname, '..', 'Scheduler', 'Scheduler.js'),
+        path.join(__dirname, '..', 'Sequencer', 'Sequencer.js'),
+        path.join(__dirname, '..', 'AdResolver', 'AdResolver.js')
+    ],
+    LICENSE_HEADER_LINE_COUNT = 14,
+    READY_CALL = 'PLAYER_SEQUENCER.readiness.signalReady();',
+    // Note: a '/' after one of these words starts a regular expression, not a division
+    REGEXP_PREFIX_WORDS = { 'return': true, 'typeof': true, 'instanceof': true, 'in': true, 'new': true, 'delete': true,
+        'void': true, 'throw': true, 'case': true, 'do': true, 'else': true },
+
+    parseArguments = function (argv) {
+        var options = { outFile: null, scripts: [], isMinified: true },
+            i;
+
+        for (i = 0; i < argv.length; i += 1) {
+            if (argv[i] === '--out') {
+                i += 1;
+                options.outFile = path.resolve(argv[i]);
+            } else if (argv[i] === '--plugin') {
+                i += 1;
+                options.scripts.push(path.resolve(argv[i]));
+            } else if (argv[i] === '--no-minify') {
+                options.isMinified = false;
+            } else {
+                options.outFile = null;
+                break;
+            }
+        }
+        if (!options.outFile) {
+            throw new Error('usage: node BuildBundle.js --out <bundle file> [--plugin <plugin script>]... [--no-minify]');
+        }
+        return options;
+    },
+
+    isWordCharacter = function (c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c === '_' || c === '$' || c === '\\';
+    },
+
+    tokenize = function (source, fileName) {
+        ///<summary>Split a script into tokens, dropping the comments</summary>
+        ///<returns type="Array">An array of { type: 'word' | 'punct' | 'string' | 'regexp' | 'space' | 'newline', text }</returns>
+        var tokens = [],
+            lastSignificant = null,     // the last token which is not white space
+            length = source.length,
+            i = 0,
+            start,
+            c,
+            isInClass,
+
+        push = function (type, text) {
+            var token = { type: type, text: text };
+
+            tokens.push(token);
+            if (type !== 'space' && type !== 'newline') {
+                lastSignificant = token;
+            }
+        },
+
+        isRegExpAllowed = function () {
+            if (!lastSignificant) {
+                return true;
+            }
+            if (lastSignificant.type === 'word') {
+                return REGEXP_PREFIX_WORDS.hasOwnProperty(lastSignificant.text);
+            }
+            return lastSignificant.type === 'punct' && ')]}'.indexOf(lastSignificant.text) < 0;
+        },
+
+        fail = function (message) {
+            throw new Error(fileName + ': ' + message + ' at offset ' + start.toString());
+        };
+
+        while (i < length) {
+            start = i;
+            c = source.charAt(i);
+
+            if (c === '\n') {
+                i += 1;
+                push('newline', '\n');
+            } else if (c === ' ' || c === '\t' || c === '\r') {
+                while (i < length && ' \t\r'.indexOf(source.charAt(i)) >= 0) {
+                    i += 1;
+                }
+                push('space', ' ');
+            } else if (c === '/' && source.charAt(i + 1) === '/') {
+                while (i < length && source.charAt(i) !== '\n') {
+                    i += 1;
+                }
+            } else if (c === '/' && source.charAt(i + 1) === '*') {
+                i = source.indexOf('*/', i + 2);
+                if (i < 0) {
+                    fail('unterminated comment');
+                }
+                i += 2;
+                // a comment spanning lines still separates statements
+                if (source.slice(start, i).indexOf('\n') >= 0) {
+                    push('newline', '\n');
+                } else {
+                    push('space', ' ');
+                }
+            } else if (c === '"' || c === "'") {
+                i += 1;
+                while (i < length && source.charAt(i) !== c) {
+                    if (source.charAt(i) === '\n') {
+                        fail('unterminated string');
+                    }
+                    i += (source.charAt(i) === '\\') ? 2 : 1;
+                }
+                i += 1;
+                push('string', source.slice(start, i));
+            } else if (c === '/' && isRegExpAllowed()) {
+                i += 1;
+                isInClass = false;
+                while (i < length && (isInClass || source.charAt(i) !== '/')) {
+                    if (source.charAt(i) === '\n') {
+                        fail('unterminated regular expression');
+                    }
+                    if (source.charAt(i) === '[') {
+                        isInClass = true;
+                    } else if (source.charAt(i) === ']') {
+                        isInClass = false;
+                    }
+                    i += (source.charAt(i) === '\\') ? 2 : 1;
+                }
+                i += 1;
+                while (i < length && isWordCharacter(source.charAt(i))) {
+                    i += 1;
+                }
+                push('regexp', source.slice(start, i));
+            } else if (isWordCharacter(c)) {
+                while (i < length && isWordCharacter(source.charAt(i))) {
+                    i += 1;
+                }
+                push('word', source.slice(start, i));
+            } else {
+                i += 1;
+                push('punct', c);
+            }
+        }
+        return tokens;
+    },
+
+    minify = function (source, fileName) {
+        ///<summary>Remove the comments and white space of a script, keeping one line break where there was any</summary>
+        var tokens = tokenize(source, fileName),
+            output = [],
+            previous = null,            // the last token written
+            separator = null,           // null, ' ' or '\n': the white space seen since the previous token
+            token,
+            i,
+
+        isSpaceNeeded = function (left, right) {
+            var leftCharacter = left.text.charAt(left.text.length - 1),
+                rightCharacter = right.text.charAt(0);
+
+            // keep identifiers and numbers apart, and 'a + +b', 'a - -b' and 'a / /re/' unambiguous
+            return (isWordCharacter(leftCharacter) && isWordCharacter(rightCharacter)) ||
+                (leftCharacter === '+' && rightCharacter === '+') ||
+                (leftCharacter === '-' && rightCharacter === '-') ||
+                (leftCharacter === '/' && rightCharacter === '/');
+        };
+
+        for (i = 0; i < tokens.length; i += 1) {
+            token = tokens[i];
+            if (token.type === 'newline') {
+                separator = '\n';
+            } else if (token.type === 'space') {
+                separator = separator || ' ';
+            } else {
+                if (previous && separator === '\n') {
+                    output.push('\n');
+                } else if (previous && separator === ' ' && isSpaceNeeded(previous, token)) {
+                    output.push(' ');
+                }
+                output.push(token.text);
+                previous = token;
+                separator = null;
+            }
+        }
+        return output.join('') + '\n';
+    },
+
+    buildBundle = function (options) {
+        ///<summary>Build the bundle script</summary>
+        ///<param name="options" type="Object">An object with properties: scripts (the plugin scripts to add after the Core modules), isMinified</param>
+        ///<returns type="String">The bundle script</returns>
+        var allScripts = CORE_SCRIPTS.concat(options.scripts || []),
+            header = fs.readFileSync(CORE_SCRIPTS[0], 'utf8').split('\n').slice(0, LICENSE_HEADER_LINE_COUNT).join('\n'),
+            parts = [header.replace(/\r/g, '') + '\n'],
+            source,
+            i;
+
+        for (i = 0; i < allScripts.length; i += 1) {
+            source = fs.readFileSync(allScripts[i], 'utf8');
+            if (options.isMinified) {
+                parts.push(minify(source, allScripts[i]));
+            } else {
+                parts.push('// ' + path.basename(allScripts[i]) + '\n' + source.replace(/\r/g, '') + '\n');
+            }
+        }
+        parts.push(READY_CALL + '\n');
+        return parts.join('');
+    },
+
+    main = function () {
+        var options = parseArguments(process.argv.slice(2)),
+            bundle = buildBundle(options);
+
+        fs.writeFileSync(options.outFile, bundle);
+        console.log(options.outFile + ': ' + bundle.length + ' characters from ' + (CORE_SCRIPTS.length + options.scripts.length) + ' scripts');
+    };
+
+module.exports = { buildBundle: buildBundle, minify: minify };
+
+if (require.main === module) {
+    main();
+}
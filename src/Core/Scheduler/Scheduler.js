@@ -1,629 +1,1569 @@
-// ----------------------------------------------------------------------------
-// Copyright (c) Microsoft Corporation. All rights reserved.
-// ----------------------------------------------------------------------------
-//
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-// http://www.apache.org/licenses/LICENSE-2.0
-//
-// THIS CODE IS PROVIDED *AS IS* BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
-// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
-// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
-//
-
-// This is the public API for the Scheduler component
-// All the position variables are floating point seconds
-
-//
-// The namespace object
-//
-var PLAYER_SEQUENCER = PLAYER_SEQUENCER || {};
-
-// custom Scheduler Error derivation:
-PLAYER_SEQUENCER.SchedulerError = function (message) {
-"use strict";
-    if (this === PLAYER_SEQUENCER) {
-        throw new PLAYER_SEQUENCER.SchedulerError("SchedulerError constructor called without new operator!");
-    }
-    this.name = "PLAYER_SEQUENCER:SchedulerError";
-    this.message = message || "[no message]";
-    // For V8 capture the stack trace:
-    if (Error.captureStackTrace) {
-        Error.captureStackTrace(this, PLAYER_SEQUENCER.SchedulerError);    
-    }
-};
-PLAYER_SEQUENCER.SchedulerError.prototype = new Error();
-PLAYER_SEQUENCER.SchedulerError.prototype.constructor = PLAYER_SEQUENCER.SchedulerError;
-
-PLAYER_SEQUENCER.createSequentialPlaylist = function () {
-"use strict";
-
-    // ---------------------------------
-    // private variables
-    // ---------------------------------
-    var playlist = [],
-        nextId = 1, // start with 1 so nextId is never false
-        privateMethodKey = Math.random(),
-        playlistDuration = 0,
-
-    // ---------------------------------
-    // private methods
-    // ---------------------------------
-    throwSetterInhibited = function ( value ) {
-        throw new PLAYER_SEQUENCER.SchedulerError('setter not allowed. value: ' + value.toString());
-    },
-
-    validatePrivateMethodAccess = function ( passKey ) { 
-        if (passKey !== privateMethodKey) {
-            throw new PLAYER_SEQUENCER.SchedulerError('incorrect private method passKey: ' + passKey.toString());
-        }
-    },
-
-    indexFromId = function ( idToFind, callerName ) {
-        var i;
-        for (i = 0; i < playlist.length; i += 1) {
-            if (playlist[i].id === idToFind) {
-                return i;
-            }
-        }
-        throw new PLAYER_SEQUENCER.SchedulerError( (callerName || "[unnamed]") + ' called indexFromId with invalid id ' + idToFind.toString());
-    },
-
-    isNearZero = function (value, tolerance) {
-        // default to 1 millisecond to accommodate number roundoff errors
-        return Math.abs( value ) < (tolerance || 0.001);
-    },
-
-    findEntryIndexAtTime = function (timeToFind) {
-        var i,
-            startTime;
-
-        // Search the list to find the entry containing the time point with the closest start time.
-        // Note: the list is searched forward so the first of multiple entries with the same start time is found.
-        for (i = 0; i < playlist.length; i += 1) {
-            startTime = playlist[i].linearStartTime;
-            // Note: Object is found if start time is close to timeToFind
-            if (isNearZero(startTime - timeToFind) ||
-                (startTime <= timeToFind && timeToFind < (startTime + playlist[i].linearDuration)) ) {
-                break;
-            }
-        }
-        return i;
-    },
-
-    // ---------------------------------
-    // public sequentialPlaylist methods
-    // ---------------------------------
-    newSeqPlaylist = {
-
-        // methods that change the sequentialPlaylist state:
-        change: {
-            createEntry: function (idSplitFrom, splitOffsetTime) {
-                ///<summary>Create a new null sequentialPlaylistEntry.</summary>
-                ///<param name="idSplitFrom" type="number">optional id of playlistEntry to split to generate new entry from the tail of the split.</param>
-                ///<param name="splitOffsetTime" type="number">when idSplitFrom given, required time offset of the split point.</param>
-                ///<returns type="Object">A playlistEntry object to be filled in before insertEntry is called using it.</returns>
-                var playlistEntry,
-                    myId = nextId,
-                    myIdSplitFrom = nextId,
-                    mySplitCount = 0,
-                    indexToSplitFrom,
-                    splitTimeDelta;
-                nextId += 1;
-                
-                if (idSplitFrom) {
-                    indexToSplitFrom = indexFromId(idSplitFrom, "createEntry");
-                    if (playlist[indexToSplitFrom].linearDuration === 0) {
-                        throw new PLAYER_SEQUENCER.SchedulerError( 'createEntry idToSplitFrom ' + idSplitFrom.toString() + ' cannot be split');
-                    }
-                    myIdSplitFrom = playlist[indexToSplitFrom].idSplitFrom;
-                }
-                // DEFINITION of playlistEntry
-                playlistEntry = {
-                //  -----------------------------------------------------------------------
-                    clipURI: null,              // string
-                    eClipType: null,            // string - 'Media', 'Static', 'VAST', 'SeekToStart', 'ProgramContent'
-                    linearStartTime: 0,         // number
-                    linearDuration: 0,          // number - zero for pause timeline true
-                    minRenderingTime: 0,        // number - clip begin
-                    maxRenderingTime: 0,        // number - clip end
-                    isAdvertisement: true,      // boolean
-                    playbackPolicyObj: {},      // opaque - playback policy object
-                    deleteAfterPlay: false,     // boolean
-                    get id () { return myId; },
-                    set id (value) { throwSetterInhibited(value); },
-                    get idSplitFrom () { return myIdSplitFrom; },
-                    set idSplitFrom (value) { throwSetterInhibited(value); },
-                    get splitCount () { return mySplitCount; },
-                    set splitCount (value) { throwSetterInhibited(value); },
-                    incrementSplitCount: function ( passKey ) { 
-                        validatePrivateMethodAccess(passKey);
-                        mySplitCount += 1; 
-                    }
-                //  -----------------------------------------------------------------------
-                };
-
-                if (idSplitFrom) {
-                    // copy the properties (with times adjusted for the split offset)
-                    splitTimeDelta = Number(splitOffsetTime);
-
-                    playlistEntry.clipURI = playlist[indexToSplitFrom].clipURI;
-                    playlistEntry.eClipType = playlist[indexToSplitFrom].eClipType;
-                    playlistEntry.linearStartTime = playlist[indexToSplitFrom].linearStartTime + splitTimeDelta;
-                    playlistEntry.linearDuration = playlist[indexToSplitFrom].linearDuration - splitTimeDelta;
-                    playlistEntry.minRenderingTime = playlist[indexToSplitFrom].minRenderingTime + splitTimeDelta;
-                    playlistEntry.maxRenderingTime = playlist[indexToSplitFrom].maxRenderingTime;
-                    playlistEntry.isAdvertisement = playlist[indexToSplitFrom].isAdvertisement;
-                    playlistEntry.playbackPolicyObj = playlist[indexToSplitFrom].playbackPolicyObj;
-                    playlistEntry.deleteAfterPlay = playlist[indexToSplitFrom].deleteAfterPlay;
-                }
-                return playlistEntry;
-            },
-            
-            insertEntry: function (playlistEntry) {
-                ///<summary>Insert the provided entry at a list position based on the values.</summary>
-                ///<param name="playlistEntry" type="Object">The playlistEntry to be inserted in the sequentialPlayList.</param>
-                var entryFound, entrySplit, splitOffsetTime, indexFound;
-
-                if (!playlistEntry.isAdvertisement) {
-                    throw new PLAYER_SEQUENCER.SchedulerError('insertEntry of non-advertisement');
-                }
-
-                // TODO: remove this when overlay ads are implemented:
-                if (playlistEntry.linearDuration !== 0) {
-                    throw new PLAYER_SEQUENCER.SchedulerError('insertEntry of overlay ad is currently not supported');
-                }
-
-                indexFound = findEntryIndexAtTime(playlistEntry.linearStartTime);
-                if (indexFound === playlist.length) {
-                    throw new PLAYER_SEQUENCER.SchedulerError('insertEntry linearStartTime ' + playlistEntry.linearStartTime.toString() + ' outside playlist range');
-                }
-                entryFound = playlist[indexFound];
-
-                splitOffsetTime = playlistEntry.linearStartTime - entryFound.linearStartTime;
-                // if new entry start time close to an existing entry start
-                if (isNearZero( splitOffsetTime )) {
-                    // insert before entry found
-                    // prevent retrograde start times in the list
-                    if (playlistEntry.linearStartTime > entryFound.linearStartTime) {
-                        playlistEntry.linearStartTime = entryFound.linearStartTime;
-                    }
-                    playlist.splice(indexFound, 0, playlistEntry);
-                }
-                else {
-                    // split the existing entry
-                    if (entryFound.isAdvertisement) {
-                        throw new PLAYER_SEQUENCER.SchedulerError('insertEntry splitting ad');
-                    }
-                    entrySplit = this.createEntry(entryFound.id, splitOffsetTime);
-
-                    entryFound.incrementSplitCount( privateMethodKey );
-                    entryFound.maxRenderingTime = entrySplit.minRenderingTime;
-                    entryFound.linearDuration = splitOffsetTime;
-
-                    playlistEntry.linearStartTime = entryFound.linearStartTime + entryFound.linearDuration;
-
-                    /* TODO: to support overlay ads, add the following:
-                    if ( playlistEntry.linearDuration > 0) {
-                        // Note: overlay ads are not allowed to span RCE clips or content split by other ads
-                        if ( playlistEntry.linearDuration > entrySplit.linearDuration) {
-                            throw new PLAYER_SEQUENCER.SchedulerError('insertEntry overlay beyond end of program content clip');
-                        }                        
-                        entrySplit.linearStartTime += playlistEntry.linearDuration;
-                        entrySplit.linearDuration -= playlistEntry.linearDuration;
-                    }
-                    */
-
-                    // insert new entry after the first part and the second part after that
-                    playlist.splice(indexFound + 1, 0, playlistEntry);
-                    indexFound = indexFromId( playlistEntry.id, "insertEntry split" );
-                    playlist.splice(indexFound + 1, 0, entrySplit);
-                }
-            },
-
-            insertEntryAfterEnd: function (playlistEntry) {
-                ///<summary>Insert the provided entry at the end of the playList.</summary>
-                ///<param name="playlistEntry" type="Object">The playlistEntry to be inserted after the end of the sequentialPlayList.</param>
-                var i = playlist.length;
-
-                if (playlistEntry.isAdvertisement && playlistEntry.linearDuration > 0) {
-                    throw new PLAYER_SEQUENCER.SchedulerError('insertEntryAfterEnd an overlay ad');
-                }
-                if (i > 0) {
-                    playlistEntry.linearStartTime = playlist[i-1].linearStartTime + playlist[i-1].linearDuration;
-                }
-                playlistDuration += playlistEntry.linearDuration;
-                playlist.push(playlistEntry);
-            },
-
-            insertEntryBeforeBeginning: function (playlistEntry) {
-                ///<summary>Insert the provided entry at the beginning of the playList.</summary>
-                ///<param name="playlistEntry" type="Object">The playlistEntry to be inserted at the beginning of the sequentialPlayList.</param>
-                if (playlistEntry.linearDuration > 0) {
-                    // TODO: handle overlay preroll ad case (adjust underlying main content linear and rendering times)
-                    throw new PLAYER_SEQUENCER.SchedulerError('insertEntryBeforeBeginning overlay ad not yet supported');
-                }
-                playlist.unshift(playlistEntry);
-            },
-
-            insertEntryAfterId: function (idToFind, playlistEntry) {
-                ///<summary>Insert the provided entry after an existing entry.</summary>
-                ///<param name="idToFind" type="number">id of playlistEntry after which the insertion is to take place.</param>
-                ///<param name="playlistEntry" type="Object">The playlistEntry to be inserted after the specified entry.</param>
-                var i = indexFromId( idToFind, "insertEntryAfterId" );
-
-                if (playlist[i].eClipType === "SeekToStart") {
-                    throw new PLAYER_SEQUENCER.SchedulerError('insertEntryAfterId ' + idToFind.toString() + ' cannot be inserted after SeekToStart');
-                }
-
-                if (playlistEntry.linearDuration === 0) {
-                    playlistEntry.linearStartTime = playlist[i].linearStartTime + playlist[i].linearDuration;
-                    playlist.splice(i + 1, 0, playlistEntry);
-                }
-                else {
-                    // TODO: handle overlay ad case (adjust underlying main content linear and rendering times)
-                    throw new PLAYER_SEQUENCER.SchedulerError('insertEntryAfterId overlay ad not yet supported');
-                }
-            },
-
-            insertSeekToStart: function (playlistEntry) {
-                ///<summary>Insert the provided entry before the first list item with non-zero linear duration.</summary>
-                ///<param name="playlistEntry" type="Object">The SeekToStart playlist entry to be inserted.</param>
-                ///<returns type="Object">The playlistEntry inserted or null if a SeekToStart entry is already in the sequentialPlaylist.</returns>
-                var i;
-
-                for (i = 0; i < playlist.length; i += 1) {
-                    if (playlist[i].eClipType === "SeekToStart") {
-                        return null;
-                    }
-                    if (playlist[i].linearDuration > 0) {
-                        playlistEntry.eClipType = "SeekToStart";
-                        playlist.splice(i, 0, playlistEntry);
-                        return playlistEntry;
-                    }
-                }
-                throw new PLAYER_SEQUENCER.SchedulerError('insertSeekToStart cannot be inserted inside playlist with no content');
-            },        
-            
-            remove: function (idToRemove) {
-                ///<summary>Insert the provided entry at a list position based on the values.</summary>
-                ///<param name="idToRemove" type="Object">The id of the playlistEntry to be removed from the sequentialPlayList.</param>
-                ///<returns type="Object">The playlistEntry that was removed.</returns>
-                var objRemoved = null,
-                    i = indexFromId( idToRemove, "remove" );
-                    
-                objRemoved = playlist[i];
-                if (!objRemoved.isAdvertisement) {
-                    throw new PLAYER_SEQUENCER.SchedulerError( 'remove main content currently not allowed' );
-                }
-                // remove the specified entry from the list:
-                playlist.splice(i,1);
-                if (i === playlist.length) {
-                    playlistDuration -= objRemoved.linearDuration;
-                }
-                // Note: the "splitCount" is being used as a "changed count" here:
-                objRemoved.incrementSplitCount( privateMethodKey );
-                // Clear the deleteAfterPlay flag so access.onPlayedEntry will not remove again
-                objRemoved.deleteAfterPlay = false;
-
-                // if entry after the one removed was spliced from the entry before the one removed,
-                if (i > 0 && i < playlist.length && playlist[i-1].idSplitFrom === playlist[i].idSplitFrom) {
-                    // weld the after entry onto the before entry and indicate it has changed:
-                    playlist[i-1].linearDuration += playlist[i].linearDuration + objRemoved.linearDuration;
-                    playlist[i-1].maxRenderingTime = playlist[i].maxRenderingTime;
-                    playlist[i-1].incrementSplitCount( privateMethodKey );
-                    // indicate the after entry has changed:
-                    playlist[i].incrementSplitCount( privateMethodKey );
-                    // remove the after entry from the list:
-                    playlist.splice(i,1);
-                }
-                // TODO: handle overlay ads by adjusting start times of any following ads and the
-                //       next overlaid main content item and the main content item duration.
-                return objRemoved;
-            },
-
-            removeAllEntries: function () {
-                ///<summary>Remove all entries from the playList.</summary>
-                playlist = [];
-                playlistDuration = 0;
-            }
-        }, // end of change methods
-
-        // Methods that only access the playlist:
-        access: {
-            getEntryAtTime: function (timeToFind) {
-                /// <summary>Get the playlistEntry containing the given linear time point.</summary>
-                /// <param name="getEntryAtTime" type="number">The time point to find.</param>
-                /// <returns type="Object">The playlistEntry found (the first if multiple zero-duration entrys start at the same time)</returns>
-                return playlist[findEntryIndexAtTime(timeToFind)];
-            },
-            
-            // Fetch the entry that follows the one with the idToFind
-            // returns: playlistEntry; falsy if idToFind at end of list
-            // throws: SchedulerError if no list item with idToFind
-            getEntryAfterId: function (idToFind) {
-                /// <summary>Get the playlistEntry that follows the one with the given id.</summary>
-                /// <param name="idToFind" type="number">The id of the playlistEntry to find.</param>
-                /// <returns type="Object">The playlistEntry found; falsy if idToFind is at the end of the sequentialPlaylist</returns>
-                var objFound = null,
-                    i = indexFromId( idToFind, "fetchNext" );
-                    
-                if (i < (playlist.length - 1)) {
-                    objFound = playlist[i + 1];
-                }
-                return objFound;
-            },
-            
-            getEntryBeforeId: function (idToFind) {
-                /// <summary>Get the playlistEntry that preceeds the one with the given id.</summary>
-                /// <param name="idToFind" type="number">The id of the playlistEntry to find.</param>
-                /// <returns type="Object">The playlistEntry found; falsy if idToFind is at the end of the sequentialPlaylist</returns>
-                var objFound = null,
-                    i = indexFromId( idToFind, "fetchPrev" );
-                    
-                if (i > 0) {
-                    objFound = playlist[i - 1];
-                }
-                return objFound;
-            },
-            
-            getPlaylistLinearDuration: function () {
-                /// <summary>Get the total linear duration of the entire sequentialPlaylist.</summary>
-                /// <returns type="number">The duration in seconds.</returns>
-                return playlistDuration;
-            },
-
-            onPlayedEntry: function (playlistEntry) {
-                ///<summary>Notify that a given playlistEntry has been played.</summary>
-                ///<param name="playlistEntry" type="Object">The playlist entry that has been played. This entry will be removed from the sequentialPlaylist if the deleteAfterPlay flag is set.</param>
-                if (playlistEntry.deleteAfterPlay) {
-                    newSeqPlaylist.change.remove(playlistEntry.id);
-                }
-            }
-        }, // end of access methods
-
-        // Test methods
-        testProbe_toJSON: function () {
-            ///<summary>Return a JSON string of the entire sequentialPlaylist.</summary>
-            return JSON.stringify(playlist);
-        }
-    };
-    return newSeqPlaylist;
-};
-        
-
-// The Scheduler for VOD content
-PLAYER_SEQUENCER.createScheduler = function (sequentialPlaylist) {
-"use strict";
-    // ---------------------------------
-    // private variables
-    // ---------------------------------
-    var mySequentialPlaylist = sequentialPlaylist.change,
-
-    // ---------------------------------
-    // private methods
-    // ---------------------------------
-        isDurationTooSmall = function (duration) {
-        return duration < 1.0; // this value is replicated in the createContentClipParams comment below
-    },
-
-    // ---------------------------------
-    // public methods
-    // ---------------------------------
-
-    myScheduler = {
-        createContentClipParams: function () {
-            ///<summary>Create a null parameters object for scheduling a content clip.</summary>
-            ///<returns type="Object">The parameters object to be filled in before calling appendContentClip.</returns>
-            return {
-                clipURI: null,              // string: the Media URI
-                minManifestPosition: 0,     // number: the minimum manifest time for the clip
-                maxManifestPosition: 0      // number: the maximum manifest time for the clip
-                                            // Note: duration is (max - min) and must be > 1.0
-            };
-        },
-
-        createScheduleClipParams: function () {
-            ///<summary>Create a null parameters object for scheduling an advertisement clip.</summary>
-            ///<returns type="Object">The parameters object to be filled in before calling scheduleClip.</returns>
-            return {
-                clipURI: null,              // string: the clip URL
-                eClipType: null,            // string: the the clip type: 'Media', 'Static', or 'VAST'
-                minManifestPosition: 0,     // number: the minimum manifest time for the clip
-                maxManifestPosition: 0,     // number: the maximum manifest time the clip will play to (duration of the clip)
-                startTime: 0,               // number: the clip start time in the linear time; only used for eTypeMidroll
-                linearDuration: 0,          // number: 0 for pauseTimeline true ad, and duration for pauseTimeline false ad
-                playbackPolicyObj: {},      // Object: the opaque playback policy object for the clip (sequencer implementation dependent)
-                deleteAfterPlay: false,     // boolean: if the ad should be deleted after playback
-                eRollType: null,            // string: the "roll" type: 'Pre', 'Post', 'Mid', 'Now', or 'Pod'
-                appendTo: -1                // number: the id of the playlistEntry to append to in an ad pod, otherwise leave default of -1
-            };
-        },
-
-        reset: function () {
-            ///<summary>Reset the schedule to be completely empty.</summary>
-            mySequentialPlaylist.removeAllEntries();
-        },
-
-        removeClip: function (params) {
-            ///<summary>Remove a clip.</summary>
-            ///<param name="params" type="Object">An object with property: playlistEntryId (id entry to be removed).</param>
-            ///<returns type="Object">The playlistEntry that was removed.</returns>
-            return mySequentialPlaylist.remove(params.playlistEntryId);
-        },
-
-        appendContentClip: function (params) {
-            ///<summary>Append a content (non-ad media) clip to the sequential playlist to build up the main content. Must be called one or more times before scheduleClip.</summary>
-            ///<param name="params" type="Object">An object obtained with createContentClipParams and then filled in with specific values.</param>
-            ///<returns type="Object">The playlistEntry created for the clip.</returns>
-            var playlistEntry;
-
-            playlistEntry = mySequentialPlaylist.createEntry();
-
-            playlistEntry.clipURI = params.clipURI;
-            // Note: eClipType is ignored:
-            playlistEntry.eClipType = 'ProgramContent';
-
-            if (typeof params.minManifestPosition !== 'number') {
-                throw new PLAYER_SEQUENCER.SchedulerError('appendContentClip minManifestPosition not a number');
-            }
-            playlistEntry.minRenderingTime = params.minManifestPosition;
-
-            if (typeof params.maxManifestPosition !== 'number') {
-                throw new PLAYER_SEQUENCER.SchedulerError('appendContentClip maxManifestPosition not a number');
-            }
-            playlistEntry.maxRenderingTime = params.maxManifestPosition;
-
-            playlistEntry.linearDuration = playlistEntry.maxRenderingTime - playlistEntry.minRenderingTime;
-
-            if (isDurationTooSmall(playlistEntry.linearDuration)) {
-                throw new PLAYER_SEQUENCER.SchedulerError('appendContentClip duration too small: ' + playlistEntry.linearDuration.toString());
-            }
-            playlistEntry.isAdvertisement = false;
-
-            mySequentialPlaylist.insertEntryAfterEnd(playlistEntry);
-
-            return playlistEntry;
-        },
-
-        scheduleClip: function (params) {
-            ///<summary>Schedule an ad clip. Must not be called until main content that contains the clip has been scheduled.</summary>
-            ///<param name="params" type="Object">An object obtained with createScheduleClipParams and then filled in with specific values.</param>
-            ///<returns type="Object">The playlistEntry created for the clip.</returns>
-            var playlistEntry, renderingDuration;
-
-            playlistEntry = mySequentialPlaylist.createEntry();
-
-            playlistEntry.clipURI = params.clipURI;
-            playlistEntry.eClipType = params.eClipType;
-            playlistEntry.linearDuration = params.linearDuration;
-
-            if (params.minManifestPosition !== undefined) {
-                playlistEntry.minRenderingTime = params.minManifestPosition;
-            }
-            if (params.maxManifestPosition !== undefined) {
-                renderingDuration = params.maxManifestPosition - playlistEntry.minRenderingTime;
-                if (isDurationTooSmall(renderingDuration)) {
-                    throw new PLAYER_SEQUENCER.SchedulerError('scheduleClip maxManifestPosition too small. Delta: ' + renderingDuration.toString());
-                }
-                playlistEntry.maxRenderingTime = params.maxManifestPosition;
-            }
-            else if (playlistEntry.linearDuration === 0) {
-                throw new PLAYER_SEQUENCER.SchedulerError('scheduleClip cannot determine maxRenderingTime given missing maxManifestPosition and zero linearDuration');
-            }
-            else {
-                playlistEntry.maxRenderingTime = playlistEntry.minRenderingTime + playlistEntry.linearDuration;
-            }
-
-            playlistEntry.isAdvertisement = true;
-            // NOTE: For now do not allow overlay ads
-            // TODO: preroll ads should always be pause-timeline-true (zero linear duration)
-            if (playlistEntry.linearDuration > 0) {
-                throw new PLAYER_SEQUENCER.SchedulerError('scheduleClip overlay currently not supported');
-            }
-
-            if (params.playbackPolicyObj !== undefined) {
-                playlistEntry.playbackPolicyObj = params.playbackPolicyObj;
-            }
-            if (params.deleteAfterPlay !== undefined) {
-                playlistEntry.deleteAfterPlay = params.deleteAfterPlay;
-            }
-
-            switch (params.eRollType) {
-                case 'Pre':
-                    mySequentialPlaylist.insertEntryBeforeBeginning(playlistEntry);
-                    break;
-
-                case 'Post':
-                    mySequentialPlaylist.insertEntryAfterEnd(playlistEntry);
-                    break;
-
-                case 'Pod':
-                    mySequentialPlaylist.insertEntryAfterId(params.appendTo, playlistEntry);
-                    break;
-
-                case 'Mid':
-                    playlistEntry.linearStartTime = params.startTime;
-                    mySequentialPlaylist.insertEntry(playlistEntry);
-                    break;
-
-                default:
-                    throw new PLAYER_SEQUENCER.SchedulerError('scheduleClip invalid eRollType: ' + params.eRollType.toString());
-            }
-
-            return playlistEntry;
-        },
-
-        setSeekToStart: function (params) {
-            ///<summary>Set seek-to-start marker. Must not be called until main content has been scheduled.</summary>
-            ///<param name="params" type="Object">An optional object with a clipURI property (indicates live content).</param>
-            ///<returns type="Object">The playlistEntry created for the clip.</returns>
-            var playlistEntry;
-
-            playlistEntry = mySequentialPlaylist.createEntry();
-
-            if (params && params.clipURI) {
-                playlistEntry.clipURI = params.clipURI;
-            }
-            playlistEntry.eClipType = 'SeekToStart';
-            playlistEntry.maxRenderingTime = -1; // flag unbounded
-            playlistEntry.deleteAfterPlay = true;
-            playlistEntry.isAdvertisement = true;
-
-            return mySequentialPlaylist.insertSeekToStart(playlistEntry);
-        },
-        
-        runJSON: function (paramsJSON) {
-            ///<summary>Invoke a scheduler method using a JSON string and returning the result as a JSON string.</summary>
-            ///<param name="paramsJSON" type="String">The method name and params expressed in a JSON string. There must be a top level property "func" string with the name of the method to invoke. Method params can either be all top level or within a containing "params" object.</param>
-            ///<returns type="String">The method results expressed is a JSON string. If an exception was thrown, a top level object "EXCEPTION" will contain standard Error fields.</returns>
-
-            var params, result, stackArray, stackAsJSON, i;
-
-            try {
-                params = JSON.parse(paramsJSON);
-
-                if (!params || (typeof params.func !== 'string')) {
-                    throw new PLAYER_SEQUENCER.SchedulerError('runJSON func property missing or not a string');
-                }
-
-                if (params.params) {
-                    result = myScheduler[params.func](params.params);
-                }
-                else {
-                    result = myScheduler[params.func](params);
-                }
-            }
-            catch (ex) {
-                // JSON.stringify() does not appear to work for exceptions, so generate explicitly:
-                if (ex.stack) {
-                    stackArray = ex.stack.split('\n');
-                    stackAsJSON = "";
-                    for (i = 0; i < stackArray.length; i += 1)
-                    {
-                        if (i > 0) {
-                            stackAsJSON += ',';
-                        }
-                        stackAsJSON += '"' + stackArray[i] + '"';
-                    }
-                    return '{"EXCEPTION":{"name":"' + ex.name + '","message":"' + ex.message + '","stack":[' + stackAsJSON + ']}}';
-                }
-                return '{"EXCEPTION":{"name":"' + ex.name + '","message":"' + ex.message + '"}}';
-            }
-            return JSON.stringify(result);
-        }
-    };
-    return myScheduler;
-};
-
-// ------------------------------------------------------------------------------------------------
-// Singletons for the sequential playlist and the scheduler
-// Note: These are declared here for simplicity in the initial single-instance implementation.
-//       For multiple instance implementations, these would be moved to an instance manager.
-// ------------------------------------------------------------------------------------------------
-
-PLAYER_SEQUENCER.sequentialPlaylist = PLAYER_SEQUENCER.createSequentialPlaylist();
-
-PLAYER_SEQUENCER.scheduler = PLAYER_SEQUENCER.createScheduler(PLAYER_SEQUENCER.sequentialPlaylist);
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This is the public API for the Scheduler component
+// All the position variables are floating point seconds, or integer ticks after setTimescale
+
+//
+// The namespace object
+//
+var PLAYER_SEQUENCER = PLAYER_SEQUENCER || {};
+
+// custom Scheduler Error derivation:
+PLAYER_SEQUENCER.SchedulerError = function (message) {
+"use strict";
+    if (this === PLAYER_SEQUENCER) {
+        throw new PLAYER_SEQUENCER.SchedulerError("SchedulerError constructor called without new operator!");
+    }
+    this.name = "PLAYER_SEQUENCER:SchedulerError";
+    this.message = message || "[no message]";
+    // For V8 capture the stack trace:
+    if (Error.captureStackTrace) {
+        Error.captureStackTrace(this, PLAYER_SEQUENCER.SchedulerError);    
+    }
+};
+PLAYER_SEQUENCER.SchedulerError.prototype = new Error();
+PLAYER_SEQUENCER.SchedulerError.prototype.constructor = PLAYER_SEQUENCER.SchedulerError;
+
+// ------------------------------------------------------------------------------------------------
+// JSON helpers shared by the runJSON entry points of all the components
+// ------------------------------------------------------------------------------------------------
+
+PLAYER_SEQUENCER.exceptionToJSON = function (ex) {
+    ///<summary>Generate the runJSON result for an exception.</summary>
+    ///<param name="ex" type="Object">The exception caught, normally an Error.</param>
+    ///<returns type="String">A compact JSON string with a top level object "EXCEPTION" with properties: name and message (always strings) and stack (an array of lines, when available).</returns>
+"use strict";
+    // Note: JSON.stringify(ex) gives {} since name, message and stack are not own enumerable properties of an Error
+    var isObject = (ex !== null && typeof ex === 'object');
+
+    return JSON.stringify({
+        EXCEPTION: {
+            // Note: the native bridge requires both strings, also for a thrown non-Error value
+            name: String((isObject && ex.name) || 'Error'),
+            message: String((isObject && ex.message !== undefined) ? ex.message : ex),
+            stack: (isObject && typeof ex.stack === 'string') ? ex.stack.split('\n') : undefined
+        }
+    });
+};
+
+PLAYER_SEQUENCER.projectFields = (function () {
+"use strict";
+    var pathNames = {},         // field path -> array of its names, since callers reuse the same few paths
+
+    project = function (value, fields) {
+        var projection,
+            source,
+            target,
+            names,
+            i,
+            j;
+
+        if (value === null || typeof value !== 'object') {
+            return value;
+        }
+        if (Array.isArray(value)) {
+            projection = [];
+            for (i = 0; i < value.length; i += 1) {
+                projection.push(project(value[i], fields));
+            }
+            return projection;
+        }
+        projection = {};
+        for (i = 0; i < fields.length; i += 1) {
+            if (!pathNames.hasOwnProperty(fields[i])) {
+                pathNames[fields[i]] = String(fields[i]).split('.');
+            }
+            names = pathNames[fields[i]];
+            source = value;
+            for (j = 0; j < names.length && source !== null && source !== undefined; j += 1) {
+                source = source[names[j]];
+            }
+            if (source !== undefined) {
+                target = projection;
+                for (j = 0; j < names.length - 1; j += 1) {
+                    if (target[names[j]] === null || typeof target[names[j]] !== 'object') {
+                        target[names[j]] = {};
+                    }
+                    target = target[names[j]];
+                }
+                target[names[names.length - 1]] = source;
+            }
+        }
+        return projection;
+    };
+
+    return function (value, fields) {
+        ///<summary>Copy only the given fields of a result (of each element for an array), so a caller decodes only what it uses.</summary>
+        ///<param name="value" type="Object">The result to project.</param>
+        ///<param name="fields" type="Array">The field paths to keep, with nested fields as dotted paths such as "clip.id".</param>
+        ///<returns type="Object">A new object with only the given fields, or value itself if it is not an object.</returns>
+        return project(value, fields);
+    };
+}());
+
+PLAYER_SEQUENCER.stringifyResult = (function () {
+"use strict";
+    var quotedKeys = {},        // key -> JSON.stringify(key), since results reuse a few property names
+
+    stringify = function (item) {
+        // Note: the same output as JSON.stringify, except the JSON of playlist entries is the cached one
+        var json,
+            key,
+            value,
+            valueJSON,
+            isFirst = true,
+            i;
+
+        if (item === null || typeof item !== 'object' || typeof item.toJSON === 'function') {
+            return JSON.stringify(item);
+        }
+        if (typeof item.toCachedJSON === 'function') {
+            return item.toCachedJSON();
+        }
+        if (Array.isArray(item)) {
+            json = '[';
+            for (i = 0; i < item.length; i += 1) {
+                valueJSON = stringify(item[i]);
+                json += ((i > 0) ? ',' : '') + ((valueJSON === undefined) ? 'null' : valueJSON);
+            }
+            return json + ']';
+        }
+        json = '{';
+        for (key in item) {
+            if (Object.prototype.hasOwnProperty.call(item, key)) {
+                value = item[key];
+                switch (typeof value) {
+                    case 'number':
+                        valueJSON = isFinite(value) ? String(value) : 'null';
+                        break;
+                    case 'boolean':
+                        valueJSON = value ? 'true' : 'false';
+                        break;
+                    case 'string':
+                        valueJSON = JSON.stringify(value);
+                        break;
+                    case 'object':
+                        valueJSON = stringify(value);
+                        break;
+                    default:
+                        // functions and undefined values are left out
+                        valueJSON = undefined;
+                        break;
+                }
+                if (valueJSON !== undefined) {
+                    if (!quotedKeys.hasOwnProperty(key)) {
+                        quotedKeys[key] = JSON.stringify(key);
+                    }
+                    json += (isFirst ? '' : ',') + quotedKeys[key] + ':' + valueJSON;
+                    isFirst = false;
+                }
+            }
+        }
+        return json + '}';
+    };
+
+    return function (value, fields) {
+        ///<summary>Generate the runJSON result string, the same as JSON.stringify(value) but reusing the cached JSON of the playlist entries.</summary>
+        ///<param name="value" type="Object">The result of the method invoked.</param>
+        ///<param name="fields" type="Array" optional="true">The field paths to keep (see projectFields), all fields if not given.</param>
+        ///<returns type="String">The JSON string (undefined for an undefined result, as for JSON.stringify).</returns>
+        return stringify(fields ? PLAYER_SEQUENCER.projectFields(value, fields) : value);
+    };
+}());
+
+PLAYER_SEQUENCER.createSequentialPlaylist = function (journalCapacity) {
+"use strict";
+
+    // ---------------------------------
+    // private variables
+    // ---------------------------------
+    var playlist = [],
+        nextId = 1, // start with 1 so nextId is never false
+        privateMethodKey = Math.random(),
+        playlistDuration = 0,
+
+    // change journal:
+    // version is incremented for every change and the latest changes are kept in journal (oldest first),
+    // so journal[i] has version (version - journal.length + 1 + i). The journal is trimmed back to
+    // maxJournalLength only once it has doubled to keep the trimming cost constant per change.
+    version = 0,
+    journal = [],
+    maxJournalLength = journalCapacity || 256,
+
+    // snapshot format:
+    // SNAPSHOT_FORMAT_VERSION is incremented for any change to SNAPSHOT_FIELDS or their meaning. Each snapshot
+    // entry is an array of the SNAPSHOT_FIELDS values of a playlistEntry, in sequentialPlaylist order.
+    SNAPSHOT_FORMAT_VERSION = 1,
+    SNAPSHOT_FIELDS = ['id', 'idSplitFrom', 'splitCount', 'clipURI', 'eClipType', 'linearStartTime', 'linearDuration',
+        'minRenderingTime', 'maxRenderingTime', 'isAdvertisement', 'playbackPolicyObj', 'deleteAfterPlay'],
+
+    // live window:
+    // In live mode (windowDuration > 0) the window start follows the live edge (the end of the last entry) and
+    // never moves back. The evictableCount leading entries are known to be entirely before the window start.
+    // They are only removed once they are at least half of the playlist, so the cost of removing them and of
+    // re-indexing the rest is constant per evicted entry and the playlist holds at most twice the window entries.
+    windowDuration = 0,
+    windowStart = 0,
+    evictableCount = 0,
+    evictedCount = 0,
+
+    // time representation:
+    // With timescale 0 all times are floating point seconds and compared with a 1 millisecond tolerance to
+    // accommodate the roundoff of splits and welds. With an integer timescale (such as 90000) all times are
+    // integer ticks of 1/timescale seconds, which add, subtract and compare exactly (up to 2^53 ticks, over
+    // 3000 years at 90 kHz), so timeTolerance is one tick and no drift accumulates. It can only be changed
+    // while the playList is empty. The windowDuration is in the same units; a change of timescale rescales it.
+    timescale = 0,
+    timeTolerance = 0.001,
+
+    // ---------------------------------
+    // private methods
+    // ---------------------------------
+    throwSetterInhibited = function ( value ) {
+        throw new PLAYER_SEQUENCER.SchedulerError('setter not allowed. value: ' + value.toString());
+    },
+
+    validatePrivateMethodAccess = function ( passKey ) { 
+        if (passKey !== privateMethodKey) {
+            throw new PLAYER_SEQUENCER.SchedulerError('incorrect private method passKey: ' + passKey.toString());
+        }
+    },
+
+    // id to playlist index cache:
+    // indexById[id] is valid for all indices below indexDirtyFrom. Any splice into the playlist
+    // lowers indexDirtyFrom to the splice point and the tail is re-indexed on the next lookup.
+    indexById = {},
+    indexDirtyFrom = 0,
+
+    invalidateIndexFrom = function ( index ) {
+        if (index < indexDirtyFrom) {
+            indexDirtyFrom = index;
+        }
+    },
+
+    reindexTail = function () {
+        var i;
+        for (i = indexDirtyFrom; i < playlist.length; i += 1) {
+            indexById[playlist[i].id] = i;
+        }
+        indexDirtyFrom = playlist.length;
+    },
+
+    indexFromId = function ( idToFind, callerName ) {
+        var i = indexById[idToFind];
+
+        if (i === undefined || i >= indexDirtyFrom) {
+            reindexTail();
+            i = indexById[idToFind];
+        }
+        if (i === undefined) {
+            throw new PLAYER_SEQUENCER.SchedulerError( (callerName || "[unnamed]") + ' called indexFromId with invalid id ' + idToFind.toString());
+        }
+        return i;
+    },
+
+    spliceIn = function ( index, playlistEntry ) {
+        playlist.splice(index, 0, playlistEntry);
+        invalidateIndexFrom(index);
+        // Note: an entry inserted before an evictable entry cannot start after it, so it is evictable too
+        if (index < evictableCount) {
+            evictableCount += 1;
+        }
+    },
+
+    spliceOut = function ( index ) {
+        delete indexById[playlist[index].id];
+        playlist.splice(index, 1);
+        invalidateIndexFrom(index);
+        if (index < evictableCount) {
+            evictableCount -= 1;
+        }
+    },
+
+    recordChange = function ( change, playlistEntry, otherEntry ) {
+        var delta = { version: version + 1, change: change, id: playlistEntry ? playlistEntry.id : 0 };
+
+        if (otherEntry) {
+            // split: the id of the new tail entry, weld: the id of the tail entry welded back on
+            delta.otherId = otherEntry.id;
+        }
+        version += 1;
+        journal.push(delta);
+        if (journal.length >= 2 * maxJournalLength) {
+            journal.splice(0, journal.length - maxJournalLength);
+        }
+    },
+
+    isNearZero = function (value, tolerance) {
+        // default to 1 millisecond (or exact in ticks) to accommodate number roundoff errors
+        return Math.abs( value ) < (tolerance || timeTolerance);
+    },
+
+    isValidTimescale = function (value) {
+        return typeof value === 'number' && value >= 0 && value % 1 === 0;
+    },
+
+    setTimescaleValue = function (value) {
+        timescale = value;
+        timeTolerance = (timescale > 0) ? 1 : 0.001;
+    },
+
+    isBeforeWindow = function (playlistEntry) {
+        // Note: a zero-duration entry at the window start is still in the window
+        return playlistEntry.linearStartTime - windowStart <= -timeTolerance &&
+            playlistEntry.linearStartTime + playlistEntry.linearDuration - windowStart < timeTolerance;
+    },
+
+    advanceWindow = function () {
+        var i = playlist.length - 1,
+            liveEdge;
+
+        if (i < 0) {
+            return;
+        }
+        liveEdge = playlist[i].linearStartTime + playlist[i].linearDuration;
+        if (liveEdge - windowDuration > windowStart) {
+            windowStart = liveEdge - windowDuration;
+        }
+
+        // Note: the last entry, at the live edge, is never evicted
+        while (evictableCount < i && isBeforeWindow(playlist[evictableCount])) {
+            evictableCount += 1;
+        }
+        if (evictableCount > 0 && 2 * evictableCount >= playlist.length) {
+            for (i = 0; i < evictableCount; i += 1) {
+                delete indexById[playlist[i].id];
+                recordChange('evict', playlist[i]);
+            }
+            playlist.splice(0, evictableCount);
+            evictedCount += evictableCount;
+            evictableCount = 0;
+            invalidateIndexFrom(0);
+        }
+    },
+
+    findEntryIndexAtTime = function (timeToFind) {
+        var low = 0,
+            high = playlist.length,
+            mid,
+            entry;
+
+        // The list is ordered by non-decreasing start time and the non-zero-duration entries tile the linear
+        // timeline, so binary search for the first entry whose start time is not before timeToFind (within tolerance).
+        while (low < high) {
+            mid = (low + high) >>> 1;
+            if (playlist[mid].linearStartTime - timeToFind <= -timeTolerance) {
+                low = mid + 1;
+            }
+            else {
+                high = mid;
+            }
+        }
+
+        // Note: the entry just before that one is the only one that can contain the time point and
+        //       it precedes any entry with a start time close to timeToFind, so it is checked first.
+        if (low > 0) {
+            entry = playlist[low - 1];
+            if (entry.linearStartTime <= timeToFind && timeToFind < (entry.linearStartTime + entry.linearDuration)) {
+                return low - 1;
+            }
+        }
+        // Note: Object is found if start time is close to timeToFind
+        if (low < playlist.length && isNearZero(playlist[low].linearStartTime - timeToFind)) {
+            return low;
+        }
+        return playlist.length;
+    },
+
+    newPlaylistEntry = function (entryToSplitFrom, splitOffsetTime, snapshotEntry) {
+        var playlistEntry,
+            myId = nextId,
+            myIdSplitFrom = nextId,
+            mySplitCount = 0,
+            myCachedJSON = null,
+            myCachedJSONSplitCount = -1,
+            splitTimeDelta;
+
+        if (snapshotEntry) {
+            // restore the ids of the entry (restoreSnapshot sets nextId)
+            myId = snapshotEntry[0];
+            myIdSplitFrom = snapshotEntry[1];
+            mySplitCount = snapshotEntry[2];
+        } else {
+            nextId += 1;
+        }
+        
+        if (entryToSplitFrom) {
+            myIdSplitFrom = entryToSplitFrom.idSplitFrom;
+        }
+        // DEFINITION of playlistEntry
+        playlistEntry = {
+        //  -----------------------------------------------------------------------
+            clipURI: null,              // string
+            eClipType: null,            // string - 'Media', 'Static', 'VAST', 'SeekToStart', 'ProgramContent'
+            linearStartTime: 0,         // number
+            linearDuration: 0,          // number - zero for pause timeline true
+            minRenderingTime: 0,        // number - clip begin
+            maxRenderingTime: 0,        // number - clip end
+            isAdvertisement: true,      // boolean
+            playbackPolicyObj: {},      // opaque - playback policy object
+            deleteAfterPlay: false,     // boolean
+            get id () { return myId; },
+            set id (value) { throwSetterInhibited(value); },
+            get idSplitFrom () { return myIdSplitFrom; },
+            set idSplitFrom (value) { throwSetterInhibited(value); },
+            get splitCount () { return mySplitCount; },
+            set splitCount (value) { throwSetterInhibited(value); },
+            incrementSplitCount: function ( passKey ) { 
+                validatePrivateMethodAccess(passKey);
+                mySplitCount += 1; 
+            },
+            toCachedJSON: function () {
+                // Note: every change to an entry in the sequentialPlaylist increments its splitCount, which invalidates the
+                //       cached JSON. The opaque playbackPolicyObj is assumed not to be modified once scheduled.
+                if (myCachedJSONSplitCount !== mySplitCount) {
+                    myCachedJSON = JSON.stringify(playlistEntry);
+                    myCachedJSONSplitCount = mySplitCount;
+                }
+                return myCachedJSON;
+            }
+        //  -----------------------------------------------------------------------
+        };
+
+        if (entryToSplitFrom) {
+            // copy the properties (with times adjusted for the split offset)
+            splitTimeDelta = Number(splitOffsetTime);
+
+            playlistEntry.clipURI = entryToSplitFrom.clipURI;
+            playlistEntry.eClipType = entryToSplitFrom.eClipType;
+            playlistEntry.linearStartTime = entryToSplitFrom.linearStartTime + splitTimeDelta;
+            playlistEntry.linearDuration = entryToSplitFrom.linearDuration - splitTimeDelta;
+            playlistEntry.minRenderingTime = entryToSplitFrom.minRenderingTime + splitTimeDelta;
+            playlistEntry.maxRenderingTime = entryToSplitFrom.maxRenderingTime;
+            playlistEntry.isAdvertisement = entryToSplitFrom.isAdvertisement;
+            playlistEntry.playbackPolicyObj = entryToSplitFrom.playbackPolicyObj;
+            playlistEntry.deleteAfterPlay = entryToSplitFrom.deleteAfterPlay;
+        }
+        else if (snapshotEntry) {
+            // Note: in SNAPSHOT_FIELDS order
+            playlistEntry.clipURI = snapshotEntry[3];
+            playlistEntry.eClipType = snapshotEntry[4];
+            playlistEntry.linearStartTime = snapshotEntry[5];
+            playlistEntry.linearDuration = snapshotEntry[6];
+            playlistEntry.minRenderingTime = snapshotEntry[7];
+            playlistEntry.maxRenderingTime = snapshotEntry[8];
+            playlistEntry.isAdvertisement = snapshotEntry[9];
+            playlistEntry.playbackPolicyObj = snapshotEntry[10];
+            playlistEntry.deleteAfterPlay = snapshotEntry[11];
+        }
+        return playlistEntry;
+    },
+
+    validateSnapshotEntry = function (snapshotEntry, previousEntry, snapshotNextId) {
+        var message = null;
+
+        if (!Array.isArray(snapshotEntry) || snapshotEntry.length !== SNAPSHOT_FIELDS.length) {
+            message = 'entry is not an array of ' + SNAPSHOT_FIELDS.length.toString() + ' values';
+        }
+        else if (typeof snapshotEntry[0] !== 'number' || snapshotEntry[0] < 1 || snapshotEntry[0] >= snapshotNextId ||
+                typeof snapshotEntry[1] !== 'number' || snapshotEntry[1] < 1 || snapshotEntry[1] > snapshotEntry[0] ||
+                typeof snapshotEntry[2] !== 'number') {
+            message = 'entry ids out of range';
+        }
+        else if (typeof snapshotEntry[5] !== 'number' || typeof snapshotEntry[6] !== 'number' ||
+                typeof snapshotEntry[7] !== 'number' || typeof snapshotEntry[8] !== 'number') {
+            message = 'entry times not numbers';
+        }
+        else if (timescale > 0 && (snapshotEntry[5] % 1 !== 0 || snapshotEntry[6] % 1 !== 0 ||
+                snapshotEntry[7] % 1 !== 0 || snapshotEntry[8] % 1 !== 0)) {
+            message = 'entry times not integer ticks';
+        }
+        else if (previousEntry && snapshotEntry[5] - previousEntry.linearStartTime <= -timeTolerance) {
+            message = 'entry linearStartTime before the previous entry';
+        }
+        if (message) {
+            throw new PLAYER_SEQUENCER.SchedulerError('restoreSnapshot ' + message + ': ' + JSON.stringify(snapshotEntry));
+        }
+    },
+
+    // ---------------------------------
+    // public sequentialPlaylist methods
+    // ---------------------------------
+    newSeqPlaylist = {
+
+        // methods that change the sequentialPlaylist state:
+        change: {
+            createEntry: function (idSplitFrom, splitOffsetTime) {
+                ///<summary>Create a new null sequentialPlaylistEntry.</summary>
+                ///<param name="idSplitFrom" type="number">optional id of playlistEntry to split to generate new entry from the tail of the split.</param>
+                ///<param name="splitOffsetTime" type="number">when idSplitFrom given, required time offset of the split point.</param>
+                ///<returns type="Object">A playlistEntry object to be filled in before insertEntry is called using it.</returns>
+                var indexToSplitFrom;
+
+                if (idSplitFrom) {
+                    indexToSplitFrom = indexFromId(idSplitFrom, "createEntry");
+                    if (playlist[indexToSplitFrom].linearDuration === 0) {
+                        throw new PLAYER_SEQUENCER.SchedulerError( 'createEntry idToSplitFrom ' + idSplitFrom.toString() + ' cannot be split');
+                    }
+                    return newPlaylistEntry(playlist[indexToSplitFrom], splitOffsetTime);
+                }
+                return newPlaylistEntry();
+            },
+            
+            insertEntry: function (playlistEntry) {
+                ///<summary>Insert the provided entry at a list position based on the values.</summary>
+                ///<param name="playlistEntry" type="Object">The playlistEntry to be inserted in the sequentialPlayList.</param>
+                var entryFound, entrySplit, splitOffsetTime, indexFound;
+
+                if (!playlistEntry.isAdvertisement) {
+                    throw new PLAYER_SEQUENCER.SchedulerError('insertEntry of non-advertisement');
+                }
+
+                // TODO: remove this when overlay ads are implemented:
+                if (playlistEntry.linearDuration !== 0) {
+                    throw new PLAYER_SEQUENCER.SchedulerError('insertEntry of overlay ad is currently not supported');
+                }
+
+                indexFound = findEntryIndexAtTime(playlistEntry.linearStartTime);
+                if (indexFound === playlist.length) {
+                    throw new PLAYER_SEQUENCER.SchedulerError('insertEntry linearStartTime ' + playlistEntry.linearStartTime.toString() + ' outside playlist range');
+                }
+                entryFound = playlist[indexFound];
+
+                splitOffsetTime = playlistEntry.linearStartTime - entryFound.linearStartTime;
+                // if new entry start time close to an existing entry start
+                if (isNearZero( splitOffsetTime )) {
+                    // insert before entry found
+                    // prevent retrograde start times in the list
+                    if (playlistEntry.linearStartTime > entryFound.linearStartTime) {
+                        playlistEntry.linearStartTime = entryFound.linearStartTime;
+                    }
+                    spliceIn(indexFound, playlistEntry);
+                    recordChange('insert', playlistEntry);
+                }
+                else {
+                    // split the existing entry
+                    if (entryFound.isAdvertisement) {
+                        throw new PLAYER_SEQUENCER.SchedulerError('insertEntry splitting ad');
+                    }
+                    entrySplit = this.createEntry(entryFound.id, splitOffsetTime);
+
+                    entryFound.incrementSplitCount( privateMethodKey );
+                    entryFound.maxRenderingTime = entrySplit.minRenderingTime;
+                    entryFound.linearDuration = splitOffsetTime;
+
+                    playlistEntry.linearStartTime = entryFound.linearStartTime + entryFound.linearDuration;
+
+                    /* TODO: to support overlay ads, add the following:
+                    if ( playlistEntry.linearDuration > 0) {
+                        // Note: overlay ads are not allowed to span RCE clips or content split by other ads
+                        if ( playlistEntry.linearDuration > entrySplit.linearDuration) {
+                            throw new PLAYER_SEQUENCER.SchedulerError('insertEntry overlay beyond end of program content clip');
+                        }                        
+                        entrySplit.linearStartTime += playlistEntry.linearDuration;
+                        entrySplit.linearDuration -= playlistEntry.linearDuration;
+                    }
+                    */
+
+                    // insert new entry after the first part and the second part after that
+                    spliceIn(indexFound + 1, playlistEntry);
+                    spliceIn(indexFound + 2, entrySplit);
+                    recordChange('split', entryFound, entrySplit);
+                    recordChange('insert', playlistEntry);
+                }
+            },
+
+            insertEntries: function (playlistEntries) {
+                ///<summary>Insert several entries at list positions based on their values in a single merge pass over the list.</summary>
+                ///<param name="playlistEntries" type="Array">The playlistEntry objects to be inserted in the sequentialPlayList.</param>
+                ///<remarks>The result is the same as calling insertEntry for each entry in linearStartTime order (ties in array order).</remarks>
+                var sorted = [],
+                    merged = [],
+                    pending = [],       // entries (last is first) logically ahead of playlist[sourceIndex]
+                    sourceIndex = 0,
+                    playlistEntry,
+                    entryFound,
+                    entrySplit,
+                    splitOffsetTime,
+                    timeToFind,
+                    error = null,
+                    i,
+
+                peekEntry = function () {
+                    return pending.length > 0 ? pending[pending.length - 1] : playlist[sourceIndex];
+                },
+
+                takeEntry = function () {
+                    if (pending.length > 0) {
+                        return pending.pop();
+                    }
+                    sourceIndex += 1;
+                    return playlist[sourceIndex - 1];
+                };
+
+                for (i = 0; i < playlistEntries.length; i += 1) {
+                    if (!playlistEntries[i].isAdvertisement) {
+                        throw new PLAYER_SEQUENCER.SchedulerError('insertEntries of non-advertisement');
+                    }
+                    // TODO: remove this when overlay ads are implemented:
+                    if (playlistEntries[i].linearDuration !== 0) {
+                        throw new PLAYER_SEQUENCER.SchedulerError('insertEntries of overlay ad is currently not supported');
+                    }
+                    sorted.push({ entry: playlistEntries[i], order: i });
+                }
+                sorted.sort(function (a, b) {
+                    return (a.entry.linearStartTime - b.entry.linearStartTime) || (a.order - b.order);
+                });
+
+                for (i = 0; i < sorted.length && !error; i += 1) {
+                    playlistEntry = sorted[i].entry;
+                    timeToFind = playlistEntry.linearStartTime;
+
+                    // Move entries ahead of the insertion point to the merged list.
+                    // Note: the start times are sorted, so an entry passed over here cannot be found by a later entry.
+                    for (entryFound = peekEntry(); entryFound; entryFound = peekEntry()) {
+                        if (isNearZero(entryFound.linearStartTime - timeToFind) ||
+                            (entryFound.linearStartTime <= timeToFind && timeToFind < (entryFound.linearStartTime + entryFound.linearDuration))) {
+                            break;
+                        }
+                        merged.push(takeEntry());
+                    }
+                    if (!entryFound) {
+                        error = new PLAYER_SEQUENCER.SchedulerError('insertEntries linearStartTime ' + timeToFind.toString() + ' outside playlist range');
+                        break;
+                    }
+
+                    splitOffsetTime = timeToFind - entryFound.linearStartTime;
+                    // if new entry start time close to an existing entry start
+                    if (isNearZero( splitOffsetTime )) {
+                        // insert before entry found
+                        // prevent retrograde start times in the list
+                        if (playlistEntry.linearStartTime > entryFound.linearStartTime) {
+                            playlistEntry.linearStartTime = entryFound.linearStartTime;
+                        }
+                        pending.push(playlistEntry);
+                        recordChange('insert', playlistEntry);
+                    }
+                    else if (entryFound.isAdvertisement) {
+                        error = new PLAYER_SEQUENCER.SchedulerError('insertEntries splitting ad');
+                    }
+                    else {
+                        // split the existing entry
+                        entrySplit = newPlaylistEntry(entryFound, splitOffsetTime);
+
+                        entryFound.incrementSplitCount( privateMethodKey );
+                        entryFound.maxRenderingTime = entrySplit.minRenderingTime;
+                        entryFound.linearDuration = splitOffsetTime;
+
+                        playlistEntry.linearStartTime = entryFound.linearStartTime + entryFound.linearDuration;
+
+                        // the first part is complete, the new entry and second part may still be found by later entries
+                        merged.push(takeEntry());
+                        pending.push(entrySplit);
+                        pending.push(playlistEntry);
+                        recordChange('split', entryFound, entrySplit);
+                        recordChange('insert', playlistEntry);
+                    }
+                }
+
+                // Rebuild the list even on error since entries split so far have already been changed.
+                while (pending.length > 0) {
+                    merged.push(pending.pop());
+                }
+                for (; sourceIndex < playlist.length; sourceIndex += 1) {
+                    merged.push(playlist[sourceIndex]);
+                }
+                playlist = merged;
+                invalidateIndexFrom(0);
+                // Note: the evictable entries are found again by the next advanceWindow
+                evictableCount = 0;
+
+                if (error) {
+                    throw error;
+                }
+            },
+
+            insertEntryAfterEnd: function (playlistEntry) {
+                ///<summary>Insert the provided entry at the end of the playList.</summary>
+                ///<param name="playlistEntry" type="Object">The playlistEntry to be inserted after the end of the sequentialPlayList.</param>
+                var i = playlist.length;
+
+                if (playlistEntry.isAdvertisement && playlistEntry.linearDuration > 0) {
+                    throw new PLAYER_SEQUENCER.SchedulerError('insertEntryAfterEnd an overlay ad');
+                }
+                if (i > 0) {
+                    playlistEntry.linearStartTime = playlist[i-1].linearStartTime + playlist[i-1].linearDuration;
+                }
+                playlistDuration += playlistEntry.linearDuration;
+                playlist.push(playlistEntry);
+                if (indexDirtyFrom === i) {
+                    indexById[playlistEntry.id] = i;
+                    indexDirtyFrom = playlist.length;
+                }
+                recordChange('insert', playlistEntry);
+                if (windowDuration > 0) {
+                    advanceWindow();
+                }
+            },
+
+            insertEntryBeforeBeginning: function (playlistEntry) {
+                ///<summary>Insert the provided entry at the beginning of the playList.</summary>
+                ///<param name="playlistEntry" type="Object">The playlistEntry to be inserted at the beginning of the sequentialPlayList.</param>
+                if (playlistEntry.linearDuration > 0) {
+                    // TODO: handle overlay preroll ad case (adjust underlying main content linear and rendering times)
+                    throw new PLAYER_SEQUENCER.SchedulerError('insertEntryBeforeBeginning overlay ad not yet supported');
+                }
+                spliceIn(0, playlistEntry);
+                recordChange('insert', playlistEntry);
+            },
+
+            insertEntryAfterId: function (idToFind, playlistEntry) {
+                ///<summary>Insert the provided entry after an existing entry.</summary>
+                ///<param name="idToFind" type="number">id of playlistEntry after which the insertion is to take place.</param>
+                ///<param name="playlistEntry" type="Object">The playlistEntry to be inserted after the specified entry.</param>
+                var i = indexFromId( idToFind, "insertEntryAfterId" );
+
+                if (playlist[i].eClipType === "SeekToStart") {
+                    throw new PLAYER_SEQUENCER.SchedulerError('insertEntryAfterId ' + idToFind.toString() + ' cannot be inserted after SeekToStart');
+                }
+
+                if (playlistEntry.linearDuration === 0) {
+                    playlistEntry.linearStartTime = playlist[i].linearStartTime + playlist[i].linearDuration;
+                    spliceIn(i + 1, playlistEntry);
+                    recordChange('insert', playlistEntry);
+                }
+                else {
+                    // TODO: handle overlay ad case (adjust underlying main content linear and rendering times)
+                    throw new PLAYER_SEQUENCER.SchedulerError('insertEntryAfterId overlay ad not yet supported');
+                }
+            },
+
+            insertSeekToStart: function (playlistEntry) {
+                ///<summary>Insert the provided entry before the first list item with non-zero linear duration.</summary>
+                ///<param name="playlistEntry" type="Object">The SeekToStart playlist entry to be inserted.</param>
+                ///<returns type="Object">The playlistEntry inserted or null if a SeekToStart entry is already in the sequentialPlaylist.</returns>
+                var i;
+
+                for (i = 0; i < playlist.length; i += 1) {
+                    if (playlist[i].eClipType === "SeekToStart") {
+                        return null;
+                    }
+                    if (playlist[i].linearDuration > 0) {
+                        playlistEntry.eClipType = "SeekToStart";
+                        spliceIn(i, playlistEntry);
+                        recordChange('insert', playlistEntry);
+                        return playlistEntry;
+                    }
+                }
+                throw new PLAYER_SEQUENCER.SchedulerError('insertSeekToStart cannot be inserted inside playlist with no content');
+            },        
+            
+            remove: function (idToRemove) {
+                ///<summary>Insert the provided entry at a list position based on the values.</summary>
+                ///<param name="idToRemove" type="Object">The id of the playlistEntry to be removed from the sequentialPlayList.</param>
+                ///<returns type="Object">The playlistEntry that was removed.</returns>
+                var objRemoved = null,
+                    i = indexFromId( idToRemove, "remove" );
+                    
+                objRemoved = playlist[i];
+                if (!objRemoved.isAdvertisement) {
+                    throw new PLAYER_SEQUENCER.SchedulerError( 'remove main content currently not allowed' );
+                }
+                // remove the specified entry from the list:
+                spliceOut(i);
+                if (i === playlist.length) {
+                    playlistDuration -= objRemoved.linearDuration;
+                }
+                // Note: the "splitCount" is being used as a "changed count" here:
+                objRemoved.incrementSplitCount( privateMethodKey );
+                // Clear the deleteAfterPlay flag so access.onPlayedEntry will not remove again
+                objRemoved.deleteAfterPlay = false;
+                recordChange('remove', objRemoved);
+
+                // if entry after the one removed was spliced from the entry before the one removed,
+                if (i > 0 && i < playlist.length && playlist[i-1].idSplitFrom === playlist[i].idSplitFrom) {
+                    // weld the after entry onto the before entry and indicate it has changed:
+                    playlist[i-1].linearDuration += playlist[i].linearDuration + objRemoved.linearDuration;
+                    playlist[i-1].maxRenderingTime = playlist[i].maxRenderingTime;
+                    playlist[i-1].incrementSplitCount( privateMethodKey );
+                    // indicate the after entry has changed:
+                    playlist[i].incrementSplitCount( privateMethodKey );
+                    recordChange('weld', playlist[i-1], playlist[i]);
+                    // remove the after entry from the list:
+                    spliceOut(i);
+                }
+                // TODO: handle overlay ads by adjusting start times of any following ads and the
+                //       next overlaid main content item and the main content item duration.
+                return objRemoved;
+            },
+
+            removeEntries: function (idsToRemove) {
+                ///<summary>Remove several entries in a single compaction pass over the list, welding back the content split by them.</summary>
+                ///<param name="idsToRemove" type="Array">The ids of the playlistEntries to be removed from the sequentialPlayList.</param>
+                ///<returns type="Array">The playlistEntries taken out of the list, in list order: the entries removed and the tail entries welded back onto the entry before them.</returns>
+                ///<remarks>The list and the changes recorded are the same as calling remove for each id in list order. Nothing is removed if any id is invalid or is main content.</remarks>
+                var toRemove = {},
+                    removed = [],
+                    firstIndex = playlist.length,
+                    writeIndex,
+                    keptEntry,                  // the last entry kept in the list
+                    removedDuration = 0,        // the linear duration removed since keptEntry
+                    isRemovedSinceKept = false,
+                    playlistEntry,
+                    i;
+
+                for (i = 0; i < idsToRemove.length; i += 1) {
+                    writeIndex = indexFromId( idsToRemove[i], "removeEntries" );
+                    if (!playlist[writeIndex].isAdvertisement) {
+                        throw new PLAYER_SEQUENCER.SchedulerError( 'removeEntries main content currently not allowed' );
+                    }
+                    toRemove[idsToRemove[i]] = true;
+                    firstIndex = Math.min(firstIndex, writeIndex);
+                }
+
+                keptEntry = firstIndex > 0 ? playlist[firstIndex - 1] : null;
+                writeIndex = firstIndex;
+                for (i = firstIndex; i < playlist.length; i += 1) {
+                    playlistEntry = playlist[i];
+                    if (toRemove.hasOwnProperty(playlistEntry.id)) {
+                        delete indexById[playlistEntry.id];
+                        // Note: as in remove, the "splitCount" is being used as a "changed count" here and the
+                        //       deleteAfterPlay flag is cleared so access.onPlayedEntry will not remove again
+                        playlistEntry.incrementSplitCount( privateMethodKey );
+                        playlistEntry.deleteAfterPlay = false;
+                        recordChange('remove', playlistEntry);
+                        removed.push(playlistEntry);
+                        removedDuration += playlistEntry.linearDuration;
+                        isRemovedSinceKept = true;
+                    }
+                    else if (isRemovedSinceKept && keptEntry && keptEntry.idSplitFrom === playlistEntry.idSplitFrom) {
+                        // weld this entry onto the kept entry before the removed ones and indicate both have changed:
+                        keptEntry.linearDuration += playlistEntry.linearDuration + removedDuration;
+                        keptEntry.maxRenderingTime = playlistEntry.maxRenderingTime;
+                        keptEntry.incrementSplitCount( privateMethodKey );
+                        playlistEntry.incrementSplitCount( privateMethodKey );
+                        recordChange('weld', keptEntry, playlistEntry);
+                        delete indexById[playlistEntry.id];
+                        removed.push(playlistEntry);
+                        removedDuration = 0;
+                        isRemovedSinceKept = false;
+                    }
+                    else {
+                        playlist[writeIndex] = playlistEntry;
+                        writeIndex += 1;
+                        keptEntry = playlistEntry;
+                        removedDuration = 0;
+                        isRemovedSinceKept = false;
+                    }
+                }
+                if (isRemovedSinceKept) {
+                    playlistDuration -= removedDuration;
+                }
+                playlist.length = writeIndex;
+                invalidateIndexFrom(firstIndex);
+                if (evictableCount > firstIndex) {
+                    evictableCount = firstIndex;
+                }
+                return removed;
+            },
+
+            removeAllEntries: function () {
+                ///<summary>Remove all entries from the playList.</summary>
+                playlist = [];
+                playlistDuration = 0;
+                indexById = {};
+                indexDirtyFrom = 0;
+                windowStart = 0;
+                evictableCount = 0;
+                recordChange('removeAll');
+            },
+
+            setTimescale: function (newTimescale) {
+                ///<summary>Set the time representation of all the times of the playList and its entries.</summary>
+                ///<param name="newTimescale" type="number">0 for floating point seconds, or the integer ticks per second (such as 90000) for integer times which add and compare exactly.</param>
+                ///<remarks>The playList must be empty, such as after removeAllEntries. The timescale is kept by removeAllEntries and set by restoreSnapshot.</remarks>
+                if (!isValidTimescale(newTimescale)) {
+                    throw new PLAYER_SEQUENCER.SchedulerError('setTimescale invalid timescale: ' + String(newTimescale));
+                }
+                if (playlist.length > 0) {
+                    throw new PLAYER_SEQUENCER.SchedulerError('setTimescale of a playList which is not empty');
+                }
+                // Note: a window duration set before the timescale keeps its duration in seconds
+                if (newTimescale !== timescale) {
+                    windowDuration = (timescale > 0) ? windowDuration / timescale : windowDuration;
+                    windowDuration = (newTimescale > 0) ? Math.round(windowDuration * newTimescale) : windowDuration;
+                }
+                setTimescaleValue(newTimescale);
+            },
+
+            setWindowDuration: function (duration) {
+                ///<summary>Set the live window duration. In live mode the entries entirely before the window start (the live edge minus the duration) are evicted as entries are appended.</summary>
+                ///<param name="duration" type="number">The window duration (the DVR depth) in seconds, or in integer ticks after setTimescale, or 0 for VOD mode where the playList only grows.</param>
+                ///<remarks>The window start never moves back, even if the duration is increased or set to 0. It is only reset by removeAllEntries and restoreSnapshot.</remarks>
+                if (typeof duration !== 'number' || !(duration >= 0) || (timescale > 0 && duration % 1 !== 0)) {
+                    throw new PLAYER_SEQUENCER.SchedulerError('setWindowDuration invalid duration: ' + String(duration));
+                }
+                windowDuration = duration;
+                if (windowDuration > 0) {
+                    advanceWindow();
+                }
+            },
+
+            restoreSnapshot: function (snapshot) {
+                ///<summary>Replace all the entries of the playList with those of a snapshot, in a single pass over the snapshot entries.</summary>
+                ///<param name="snapshot" type="Object">A snapshot object returned by access.getSnapshot, possibly of another sequentialPlaylist.</param>
+                ///<remarks>The playList is unchanged if the snapshot is invalid. The version is not restored, the restore is recorded as a single 'restore' change.</remarks>
+                var restoredPlaylist = [],
+                    restoredIndexById = {},
+                    playlistEntry = null,
+                    previousTimescale,
+                    i;
+
+                if (!snapshot || snapshot.formatVersion !== SNAPSHOT_FORMAT_VERSION) {
+                    throw new PLAYER_SEQUENCER.SchedulerError('restoreSnapshot unsupported formatVersion: ' + String(snapshot && snapshot.formatVersion));
+                }
+                if (typeof snapshot.nextId !== 'number' || typeof snapshot.playlistDuration !== 'number' || !Array.isArray(snapshot.entries)) {
+                    throw new PLAYER_SEQUENCER.SchedulerError('restoreSnapshot nextId, playlistDuration or entries missing');
+                }
+                // Note: snapshots taken before the live window was added have no window properties
+                if ((snapshot.windowDuration !== undefined && (typeof snapshot.windowDuration !== 'number' || !(snapshot.windowDuration >= 0))) ||
+                        (snapshot.windowStart !== undefined && typeof snapshot.windowStart !== 'number')) {
+                    throw new PLAYER_SEQUENCER.SchedulerError('restoreSnapshot invalid windowDuration or windowStart');
+                }
+                // Note: snapshots taken before the integer timescale was added have no timescale property (seconds)
+                if (snapshot.timescale !== undefined && !isValidTimescale(snapshot.timescale)) {
+                    throw new PLAYER_SEQUENCER.SchedulerError('restoreSnapshot invalid timescale: ' + String(snapshot.timescale));
+                }
+                // Note: the window times are in the units of the snapshot timescale, as its entry times
+                if (snapshot.timescale > 0 && ((snapshot.windowDuration || 0) % 1 !== 0 || (snapshot.windowStart || 0) % 1 !== 0)) {
+                    throw new PLAYER_SEQUENCER.SchedulerError('restoreSnapshot windowDuration or windowStart not integer ticks');
+                }
+                // Note: the entries are validated against the timescale of the snapshot
+                previousTimescale = timescale;
+                setTimescaleValue(snapshot.timescale || 0);
+
+                try {
+                    for (i = 0; i < snapshot.entries.length; i += 1) {
+                        validateSnapshotEntry(snapshot.entries[i], playlistEntry, snapshot.nextId);
+                        if (restoredIndexById.hasOwnProperty(snapshot.entries[i][0])) {
+                            throw new PLAYER_SEQUENCER.SchedulerError('restoreSnapshot duplicate entry id: ' + snapshot.entries[i][0].toString());
+                        }
+                        playlistEntry = newPlaylistEntry(null, 0, snapshot.entries[i]);
+                        restoredIndexById[playlistEntry.id] = i;
+                        restoredPlaylist.push(playlistEntry);
+                    }
+                }
+                catch (ex) {
+                    setTimescaleValue(previousTimescale);
+                    throw ex;
+                }
+
+                playlist = restoredPlaylist;
+                playlistDuration = snapshot.playlistDuration;
+                nextId = snapshot.nextId;
+                indexById = restoredIndexById;
+                indexDirtyFrom = playlist.length;
+                windowDuration = snapshot.windowDuration || 0;
+                windowStart = snapshot.windowStart || 0;
+                evictableCount = 0;
+                recordChange('restore');
+            }
+        }, // end of change methods
+
+        // Methods that only access the playlist:
+        access: {
+            getEntryAtTime: function (timeToFind) {
+                /// <summary>Get the playlistEntry containing the given linear time point.</summary>
+                /// <param name="getEntryAtTime" type="number">The time point to find.</param>
+                /// <returns type="Object">The playlistEntry found (the first if multiple zero-duration entrys start at the same time)</returns>
+                return playlist[findEntryIndexAtTime(timeToFind)];
+            },
+            
+            getEntryFromId: function (idToFind) {
+                /// <summary>Get the playlistEntry with the given id.</summary>
+                /// <param name="idToFind" type="number">The id of the playlistEntry to find.</param>
+                /// <returns type="Object">The playlistEntry found. Throws SchedulerError if there is no entry with idToFind</returns>
+                return playlist[indexFromId( idToFind, "getEntryFromId" )];
+            },
+
+            // Fetch the entry that follows the one with the idToFind
+            // returns: playlistEntry; falsy if idToFind at end of list
+            // throws: SchedulerError if no list item with idToFind
+            getEntryAfterId: function (idToFind) {
+                /// <summary>Get the playlistEntry that follows the one with the given id.</summary>
+                /// <param name="idToFind" type="number">The id of the playlistEntry to find.</param>
+                /// <returns type="Object">The playlistEntry found; falsy if idToFind is at the end of the sequentialPlaylist</returns>
+                var objFound = null,
+                    i = indexFromId( idToFind, "fetchNext" );
+                    
+                if (i < (playlist.length - 1)) {
+                    objFound = playlist[i + 1];
+                }
+                return objFound;
+            },
+            
+            getEntryBeforeId: function (idToFind) {
+                /// <summary>Get the playlistEntry that preceeds the one with the given id.</summary>
+                /// <param name="idToFind" type="number">The id of the playlistEntry to find.</param>
+                /// <returns type="Object">The playlistEntry found; falsy if idToFind is at the end of the sequentialPlaylist</returns>
+                var objFound = null,
+                    i = indexFromId( idToFind, "fetchPrev" );
+                    
+                if (i > 0) {
+                    objFound = playlist[i - 1];
+                }
+                return objFound;
+            },
+            
+            getPlaylistLinearDuration: function () {
+                /// <summary>Get the total linear duration of the entire sequentialPlaylist. In live mode this includes the evicted entries, so it is the linear time of the live edge.</summary>
+                /// <returns type="number">The duration in seconds, or in ticks after setTimescale.</returns>
+                return playlistDuration;
+            },
+
+            getWindowStart: function () {
+                /// <summary>Get the linear time of the live window start, which is the minimum seek position. Entries before it are being evicted.</summary>
+                /// <returns type="number">The window start in seconds, or in ticks after setTimescale (0 in VOD mode).</returns>
+                return windowStart;
+            },
+
+            isEntryBeforeWindow: function (playlistEntry) {
+                /// <summary>Check if a playlist entry is entirely before the live window start, so it is evicted or about to be. A playing entry can slide out of the window this way.</summary>
+                /// <param name="playlistEntry" type="Object">A playlist entry, which may have been evicted already.</param>
+                /// <returns type="Boolean">true if the entry is before the window start (never in VOD mode).</returns>
+                return windowDuration > 0 && isBeforeWindow(playlistEntry);
+            },
+
+            getTimescale: function () {
+                /// <summary>Get the time representation set by change.setTimescale.</summary>
+                /// <returns type="number">0 for floating point seconds, else the integer ticks per second of all the times.</returns>
+                return timescale;
+            },
+
+            isSameTime: function (time1, time2) {
+                /// <summary>Compare two times as the sequentialPlaylist does: within 1 millisecond in seconds, exactly in ticks.</summary>
+                /// <returns type="boolean">true if the times are the same.</returns>
+                return isNearZero(time1 - time2);
+            },
+
+            getSnapshot: function () {
+                /// <summary>Get the state of the sequentialPlaylist as a compact snapshot, to be restored later with change.restoreSnapshot instead of scheduling all the clips again.</summary>
+                /// <returns type="Object">An object with properties: formatVersion, fields (the names of the entry values), nextId, playlistDuration, windowDuration, windowStart, timescale and entries (an array of the values of each playlistEntry in fields order, in playlist order). It contains no functions, so it can be converted to JSON and back.</returns>
+                var entries = [],
+                    values,
+                    i,
+                    j;
+
+                for (i = 0; i < playlist.length; i += 1) {
+                    values = [];
+                    for (j = 0; j < SNAPSHOT_FIELDS.length; j += 1) {
+                        values.push(playlist[i][SNAPSHOT_FIELDS[j]]);
+                    }
+                    entries.push(values);
+                }
+                return {
+                    formatVersion: SNAPSHOT_FORMAT_VERSION,
+                    fields: SNAPSHOT_FIELDS.slice(0),
+                    nextId: nextId,
+                    playlistDuration: playlistDuration,
+                    windowDuration: windowDuration,
+                    windowStart: windowStart,
+                    timescale: timescale,
+                    entries: entries
+                };
+            },
+
+            getVersion: function () {
+                /// <summary>Get the sequentialPlaylist version, which is incremented for every change. An unchanged version means there is nothing to re-check.</summary>
+                /// <returns type="number">The current version (0 before the first change).</returns>
+                return version;
+            },
+
+            getStatistics: function () {
+                /// <summary>Get the sequentialPlaylist size counters, used for memory accounting.</summary>
+                /// <returns type="Object">An object with properties: entryCount, version, journalLength, evictedCount (the entries evicted from the live window so far).</returns>
+                return { entryCount: playlist.length, version: version, journalLength: journal.length, evictedCount: evictedCount };
+            },
+
+            getChangesSince: function (sinceVersion) {
+                /// <summary>Get the changes made after a given version.</summary>
+                /// <param name="sinceVersion" type="number">A version previously obtained from getVersion or getChangesSince.</param>
+                /// <returns type="Object">An object with properties: version (the current version), isTruncated (true if the journal no longer holds all the changes since sinceVersion, so the whole playlist must be re-read) and changes (an array of { version, change: 'insert' | 'split' | 'weld' | 'remove' | 'evict' | 'removeAll' | 'restore', id, otherId } oldest first; 'evict' is an entry dropped before the live window start; after 'removeAll' or 'restore' the whole playlist must be re-read; otherId is the new tail entry of a split or the tail entry removed by a weld).</returns>
+                var firstIndex = sinceVersion - (version - journal.length);
+
+                if (typeof sinceVersion !== 'number' || sinceVersion < 0 || sinceVersion > version) {
+                    throw new PLAYER_SEQUENCER.SchedulerError('getChangesSince invalid version: ' + String(sinceVersion));
+                }
+                if (firstIndex < 0) {
+                    return { version: version, isTruncated: true, changes: [] };
+                }
+                return { version: version, isTruncated: false, changes: journal.slice(firstIndex) };
+            },
+
+            onPlayedEntry: function (playlistEntry) {
+                ///<summary>Notify that a given playlistEntry has been played.</summary>
+                ///<param name="playlistEntry" type="Object">The playlist entry that has been played. This entry will be removed from the sequentialPlaylist if the deleteAfterPlay flag is set.</param>
+                if (playlistEntry.deleteAfterPlay) {
+                    newSeqPlaylist.change.remove(playlistEntry.id);
+                }
+            },
+
+            onPlayedEntries: function (playlistEntries) {
+                ///<summary>Notify that several playlistEntries have been played, or are to be treated as played, such as ads skipped over by a seek.</summary>
+                ///<param name="playlistEntries" type="Array">The playlist entries played. Those with the deleteAfterPlay flag set are removed from the sequentialPlaylist in a single pass.</param>
+                ///<returns type="Array">The playlistEntries taken out of the sequentialPlaylist, as for change.removeEntries.</returns>
+                var idsToRemove = [],
+                    i;
+
+                for (i = 0; i < playlistEntries.length; i += 1) {
+                    if (playlistEntries[i].deleteAfterPlay) {
+                        idsToRemove.push(playlistEntries[i].id);
+                    }
+                }
+                return idsToRemove.length > 0 ? newSeqPlaylist.change.removeEntries(idsToRemove) : [];
+            }
+        }, // end of access methods
+
+        // Test methods
+        testProbe_toJSON: function () {
+            ///<summary>Return a JSON string of the entire sequentialPlaylist.</summary>
+            return JSON.stringify(playlist);
+        }
+    };
+    return newSeqPlaylist;
+};
+        
+
+// The Scheduler for VOD and live content
+PLAYER_SEQUENCER.createScheduler = function (sequentialPlaylist) {
+"use strict";
+    // ---------------------------------
+    // private variables
+    // ---------------------------------
+    var mySequentialPlaylist = sequentialPlaylist.change,
+
+    // ---------------------------------
+    // private methods
+    // ---------------------------------
+        isDurationTooSmall = function (duration) {
+        // this value (1 second) is replicated in the createContentClipParams comment below
+        return duration < (sequentialPlaylist.access.getTimescale() || 1.0);
+    },
+
+    validateTimeParam = function (value, name, callerName) {
+        // Note: with an integer timescale, a time which is not a whole number of ticks would bring back the roundoff drift
+        if (value !== undefined && sequentialPlaylist.access.getTimescale() > 0 && (typeof value !== 'number' || value % 1 !== 0)) {
+            throw new PLAYER_SEQUENCER.SchedulerError(callerName + ' ' + name + ' not an integer number of ticks: ' + String(value));
+        }
+    },
+
+    validateContentClipParams = function (params) {
+        // Note: separate from createContentClipEntry so a batch can be validated before any playlist id is taken
+        var duration;
+
+        if (typeof params.minManifestPosition !== 'number') {
+            throw new PLAYER_SEQUENCER.SchedulerError('appendContentClip minManifestPosition not a number');
+        }
+        if (typeof params.maxManifestPosition !== 'number') {
+            throw new PLAYER_SEQUENCER.SchedulerError('appendContentClip maxManifestPosition not a number');
+        }
+        validateTimeParam(params.minManifestPosition, 'minManifestPosition', 'appendContentClip');
+        validateTimeParam(params.maxManifestPosition, 'maxManifestPosition', 'appendContentClip');
+
+        duration = params.maxManifestPosition - params.minManifestPosition;
+        if (isDurationTooSmall(duration)) {
+            throw new PLAYER_SEQUENCER.SchedulerError('appendContentClip duration too small: ' + duration.toString());
+        }
+    },
+
+    createContentClipEntry = function (params) {
+        var playlistEntry;
+
+        validateContentClipParams(params);
+        playlistEntry = mySequentialPlaylist.createEntry();
+
+        playlistEntry.clipURI = params.clipURI;
+        // Note: eClipType is ignored:
+        playlistEntry.eClipType = 'ProgramContent';
+        playlistEntry.minRenderingTime = params.minManifestPosition;
+        playlistEntry.maxRenderingTime = params.maxManifestPosition;
+        playlistEntry.linearDuration = playlistEntry.maxRenderingTime - playlistEntry.minRenderingTime;
+        playlistEntry.isAdvertisement = false;
+
+        return playlistEntry;
+    },
+
+    validateScheduleClipParams = function (params) {
+        // Note: separate from createScheduleClipEntry so a batch can be validated before any playlist id is taken
+        var renderingDuration;
+
+        validateTimeParam(params.minManifestPosition, 'minManifestPosition', 'scheduleClip');
+        validateTimeParam(params.maxManifestPosition, 'maxManifestPosition', 'scheduleClip');
+        validateTimeParam(params.linearDuration, 'linearDuration', 'scheduleClip');
+        if (params.eRollType === 'Mid') {
+            validateTimeParam(params.startTime, 'startTime', 'scheduleClip');
+        }
+
+        if (params.maxManifestPosition !== undefined) {
+            renderingDuration = params.maxManifestPosition - ((params.minManifestPosition !== undefined) ? params.minManifestPosition : 0);
+            if (isDurationTooSmall(renderingDuration)) {
+                throw new PLAYER_SEQUENCER.SchedulerError('scheduleClip maxManifestPosition too small. Delta: ' + renderingDuration.toString());
+            }
+        }
+        else if (params.linearDuration === 0) {
+            throw new PLAYER_SEQUENCER.SchedulerError('scheduleClip cannot determine maxRenderingTime given missing maxManifestPosition and zero linearDuration');
+        }
+
+        // NOTE: For now do not allow overlay ads
+        // TODO: preroll ads should always be pause-timeline-true (zero linear duration)
+        if (params.linearDuration > 0) {
+            throw new PLAYER_SEQUENCER.SchedulerError('scheduleClip overlay currently not supported');
+        }
+    },
+
+    createScheduleClipEntry = function (params) {
+        var playlistEntry;
+
+        validateScheduleClipParams(params);
+        playlistEntry = mySequentialPlaylist.createEntry();
+
+        playlistEntry.clipURI = params.clipURI;
+        playlistEntry.eClipType = params.eClipType;
+        playlistEntry.linearDuration = params.linearDuration;
+
+        if (params.minManifestPosition !== undefined) {
+            playlistEntry.minRenderingTime = params.minManifestPosition;
+        }
+        if (params.maxManifestPosition !== undefined) {
+            playlistEntry.maxRenderingTime = params.maxManifestPosition;
+        }
+        else {
+            playlistEntry.maxRenderingTime = playlistEntry.minRenderingTime + playlistEntry.linearDuration;
+        }
+        playlistEntry.isAdvertisement = true;
+
+        if (params.playbackPolicyObj !== undefined) {
+            playlistEntry.playbackPolicyObj = params.playbackPolicyObj;
+        }
+        if (params.deleteAfterPlay !== undefined) {
+            playlistEntry.deleteAfterPlay = params.deleteAfterPlay;
+        }
+
+        return playlistEntry;
+    },
+
+    validateClipParamsArray = function (paramsArray, callerName) {
+        if (!Array.isArray(paramsArray)) {
+            throw new PLAYER_SEQUENCER.SchedulerError(callerName + ' params is not an array');
+        }
+    },
+
+    createBatchError = function (index, ex) {
+        return { index: index, name: ex.name, message: ex.message };
+    },
+
+    // ---------------------------------
+    // public methods
+    // ---------------------------------
+
+    myScheduler = {
+        createContentClipParams: function () {
+            ///<summary>Create a null parameters object for scheduling a content clip.</summary>
+            ///<returns type="Object">The parameters object to be filled in before calling appendContentClip.</returns>
+            return {
+                clipURI: null,              // string: the Media URI
+                minManifestPosition: 0,     // number: the minimum manifest time for the clip
+                maxManifestPosition: 0      // number: the maximum manifest time for the clip
+                                            // Note: duration is (max - min) and must be > 1.0 second
+            };
+        },
+
+        createScheduleClipParams: function () {
+            ///<summary>Create a null parameters object for scheduling an advertisement clip.</summary>
+            ///<returns type="Object">The parameters object to be filled in before calling scheduleClip.</returns>
+            return {
+                clipURI: null,              // string: the clip URL
+                eClipType: null,            // string: the the clip type: 'Media', 'Static', or 'VAST'
+                minManifestPosition: 0,     // number: the minimum manifest time for the clip
+                maxManifestPosition: 0,     // number: the maximum manifest time the clip will play to (duration of the clip)
+                startTime: 0,               // number: the clip start time in the linear time; only used for eTypeMidroll
+                linearDuration: 0,          // number: 0 for pauseTimeline true ad, and duration for pauseTimeline false ad
+                playbackPolicyObj: {},      // Object: the opaque playback policy object for the clip (sequencer implementation dependent)
+                deleteAfterPlay: false,     // boolean: if the ad should be deleted after playback
+                eRollType: null,            // string: the "roll" type: 'Pre', 'Post', 'Mid', 'Now', or 'Pod'
+                appendTo: -1                // number: the id of the playlistEntry to append to in an ad pod, otherwise leave default of -1
+            };
+        },
+
+        reset: function () {
+            ///<summary>Reset the schedule to be completely empty.</summary>
+            mySequentialPlaylist.removeAllEntries();
+        },
+
+        removeClip: function (params) {
+            ///<summary>Remove a clip.</summary>
+            ///<param name="params" type="Object">An object with property: playlistEntryId (id entry to be removed).</param>
+            ///<returns type="Object">The playlistEntry that was removed.</returns>
+            return mySequentialPlaylist.remove(params.playlistEntryId);
+        },
+
+        appendContentClip: function (params) {
+            ///<summary>Append a content (non-ad media) clip to the sequential playlist to build up the main content. Must be called one or more times before scheduleClip.</summary>
+            ///<param name="params" type="Object">An object obtained with createContentClipParams and then filled in with specific values.</param>
+            ///<returns type="Object">The playlistEntry created for the clip.</returns>
+            var playlistEntry = createContentClipEntry(params);
+
+            mySequentialPlaylist.insertEntryAfterEnd(playlistEntry);
+
+            return playlistEntry;
+        },
+
+        appendContentClips: function (paramsArray) {
+            ///<summary>Append several content clips in one call. All clips are validated before any is appended.</summary>
+            ///<param name="paramsArray" type="Array">An array of objects obtained with createContentClipParams and then filled in with specific values.</param>
+            ///<returns type="Object">An object with properties: entries (the playlistEntry created for each clip in array order) and errors (an array of { index, name, message } for each invalid clip). Nothing is appended, and no playlist id is taken, if errors is not empty.</returns>
+            var entries = [],
+                errors = [],
+                i;
+
+            validateClipParamsArray(paramsArray, 'appendContentClips');
+
+            for (i = 0; i < paramsArray.length; i += 1) {
+                try {
+                    validateContentClipParams(paramsArray[i]);
+                }
+                catch (ex) {
+                    errors.push(createBatchError(i, ex));
+                }
+            }
+            if (errors.length > 0) {
+                return { entries: [], errors: errors };
+            }
+
+            for (i = 0; i < paramsArray.length; i += 1) {
+                entries.push(createContentClipEntry(paramsArray[i]));
+                mySequentialPlaylist.insertEntryAfterEnd(entries[i]);
+            }
+            return { entries: entries, errors: errors };
+        },
+
+        scheduleClip: function (params) {
+            ///<summary>Schedule an ad clip. Must not be called until main content that contains the clip has been scheduled.</summary>
+            ///<param name="params" type="Object">An object obtained with createScheduleClipParams and then filled in with specific values.</param>
+            ///<returns type="Object">The playlistEntry created for the clip.</returns>
+            var playlistEntry = createScheduleClipEntry(params);
+
+            switch (params.eRollType) {
+                case 'Pre':
+                    mySequentialPlaylist.insertEntryBeforeBeginning(playlistEntry);
+                    break;
+
+                case 'Post':
+                    mySequentialPlaylist.insertEntryAfterEnd(playlistEntry);
+                    break;
+
+                case 'Pod':
+                    mySequentialPlaylist.insertEntryAfterId(params.appendTo, playlistEntry);
+                    break;
+
+                case 'Mid':
+                    playlistEntry.linearStartTime = params.startTime;
+                    mySequentialPlaylist.insertEntry(playlistEntry);
+                    break;
+
+                default:
+                    throw new PLAYER_SEQUENCER.SchedulerError('scheduleClip invalid eRollType: ' + params.eRollType.toString());
+            }
+
+            return playlistEntry;
+        },
+
+        scheduleClips: function (paramsArray) {
+            ///<summary>Schedule several ad clips in one call. Must not be called until main content that contains the clips has been scheduled.</summary>
+            ///<param name="paramsArray" type="Array">An array of objects obtained with createScheduleClipParams and then filled in with specific values.</param>
+            ///<returns type="Object">An object with properties: entries (the playlistEntry created for each clip in array order) and errors (an array of { index, name, message } for each invalid clip). Nothing is scheduled, and no playlist id is taken, if errors is not empty.</returns>
+            ///<remarks>'Pre', 'Post' and 'Pod' clips are scheduled first in array order. 'Mid' clips are then inserted in a single pass in startTime order, which is the same as calling scheduleClip for them in that order. 'Pod' appendTo ids and 'Mid' start times are checked against the playlist as it was before the call.</remarks>
+            var entries = [],
+                midrollEntries = [],
+                errors = [],
+                playlistEntry,
+                i;
+
+            validateClipParamsArray(paramsArray, 'scheduleClips');
+
+            for (i = 0; i < paramsArray.length; i += 1) {
+                try {
+                    validateScheduleClipParams(paramsArray[i]);
+
+                    switch (paramsArray[i].eRollType) {
+                        case 'Pre':
+                        case 'Post':
+                            break;
+
+                        case 'Pod':
+                            // Note: getEntryFromId throws if there is no entry to append to
+                            if (sequentialPlaylist.access.getEntryFromId(paramsArray[i].appendTo).eClipType === 'SeekToStart') {
+                                throw new PLAYER_SEQUENCER.SchedulerError('scheduleClips cannot append to SeekToStart');
+                            }
+                            break;
+
+                        case 'Mid':
+                            if (typeof paramsArray[i].startTime !== 'number') {
+                                throw new PLAYER_SEQUENCER.SchedulerError('scheduleClips startTime not a number');
+                            }
+                            if (!sequentialPlaylist.access.getEntryAtTime(paramsArray[i].startTime)) {
+                                throw new PLAYER_SEQUENCER.SchedulerError('scheduleClips startTime ' + paramsArray[i].startTime.toString() + ' outside playlist range');
+                            }
+                            break;
+
+                        default:
+                            throw new PLAYER_SEQUENCER.SchedulerError('scheduleClips invalid eRollType: ' + String(paramsArray[i].eRollType));
+                    }
+                }
+                catch (ex) {
+                    errors.push(createBatchError(i, ex));
+                }
+            }
+            if (errors.length > 0) {
+                return { entries: [], errors: errors };
+            }
+
+            // Note: the entries (and their ids) are only created once the whole batch is valid
+            for (i = 0; i < paramsArray.length; i += 1) {
+                playlistEntry = createScheduleClipEntry(paramsArray[i]);
+                if (paramsArray[i].eRollType === 'Mid') {
+                    playlistEntry.linearStartTime = paramsArray[i].startTime;
+                    midrollEntries.push(playlistEntry);
+                }
+                entries.push(playlistEntry);
+            }
+
+            for (i = 0; i < entries.length; i += 1) {
+                switch (paramsArray[i].eRollType) {
+                    case 'Pre':
+                        mySequentialPlaylist.insertEntryBeforeBeginning(entries[i]);
+                        break;
+
+                    case 'Post':
+                        mySequentialPlaylist.insertEntryAfterEnd(entries[i]);
+                        break;
+
+                    case 'Pod':
+                        mySequentialPlaylist.insertEntryAfterId(paramsArray[i].appendTo, entries[i]);
+                        break;
+                }
+            }
+            if (midrollEntries.length > 0) {
+                mySequentialPlaylist.insertEntries(midrollEntries);
+            }
+            return { entries: entries, errors: errors };
+        },
+
+        getSnapshot: function () {
+            ///<summary>Get a snapshot of the sequential playlist, such as to save the schedule of a viewer session for a later resume.</summary>
+            ///<returns type="Object">The snapshot object documented for sequentialPlaylist.access.getSnapshot.</returns>
+            return sequentialPlaylist.access.getSnapshot();
+        },
+
+        restoreSnapshot: function (params) {
+            ///<summary>Replace the schedule with a snapshot obtained with getSnapshot, instead of scheduling all its clips again. No playback segment of the previous schedule may be used after this.</summary>
+            ///<param name="params" type="Object">An object with property: snapshot (the snapshot object).</param>
+            ///<returns type="Object">An object with properties: entryCount, version (the sequential playlist version after the restore).</returns>
+            mySequentialPlaylist.restoreSnapshot(params.snapshot);
+            return { entryCount: params.snapshot.entries.length, version: sequentialPlaylist.access.getVersion() };
+        },
+
+        getPlaylistChanges: function (params) {
+            ///<summary>Get the sequential playlist changes made after a given version, so a consumer can update its view of the schedule instead of re-reading it.</summary>
+            ///<param name="params" type="Object">An object with property: sinceVersion (0 or the version returned by the previous call).</param>
+            ///<returns type="Object">An object with properties: version, isTruncated and changes as documented for sequentialPlaylist.access.getChangesSince.</returns>
+            return sequentialPlaylist.access.getChangesSince(params.sinceVersion);
+        },
+
+        setLiveWindow: function (params) {
+            ///<summary>Switch to live mode with a sliding DVR window, or back to VOD mode. In live mode, content and ads entirely before the window start are evicted as content is appended at the live edge, and the minimum seekbar position follows the window start.</summary>
+            ///<param name="params" type="Object">An object with property: windowDuration (the DVR depth in seconds, or in integer ticks after setTimescale; 0 for VOD mode).</param>
+            ///<returns type="Object">An object with properties: windowDuration, windowStart (the linear time of the window start).</returns>
+            mySequentialPlaylist.setWindowDuration(params.windowDuration);
+            return { windowDuration: params.windowDuration, windowStart: sequentialPlaylist.access.getWindowStart() };
+        },
+
+        setTimescale: function (params) {
+            ///<summary>Set the time representation of the schedule: floating point seconds, or integer ticks such as of a 90 kHz clock. With ticks all the times passed to and returned by the scheduler and sequencer (positions, durations and the playlist entry times) are integers, so splits, welds and comparisons are exact and no drift accumulates over a long timeline. Must be called while the schedule is empty, such as before the first appendContentClip or after reset.</summary>
+            ///<param name="params" type="Object">An object with property: timescale (0 for seconds, else the ticks per second).</param>
+            ///<returns type="Object">An object with property: timescale.</returns>
+            mySequentialPlaylist.setTimescale(params.timescale);
+            return { timescale: sequentialPlaylist.access.getTimescale() };
+        },
+
+        setSeekToStart: function (params) {
+            ///<summary>Set seek-to-start marker. Must not be called until main content has been scheduled.</summary>
+            ///<param name="params" type="Object">An optional object with a clipURI property (indicates live content).</param>
+            ///<returns type="Object">The playlistEntry created for the clip.</returns>
+            var playlistEntry;
+
+            playlistEntry = mySequentialPlaylist.createEntry();
+
+            if (params && params.clipURI) {
+                playlistEntry.clipURI = params.clipURI;
+            }
+            playlistEntry.eClipType = 'SeekToStart';
+            playlistEntry.maxRenderingTime = -1; // flag unbounded
+            playlistEntry.deleteAfterPlay = true;
+            playlistEntry.isAdvertisement = true;
+
+            return mySequentialPlaylist.insertSeekToStart(playlistEntry);
+        },
+        
+        runJSON: function (paramsJSON) {
+            ///<summary>Invoke a scheduler method using a JSON string and returning the result as a JSON string.</summary>
+            ///<param name="paramsJSON" type="String">The method name and params expressed in a JSON string. There must be a top level property "func" string with the name of the method to invoke. Method params can either be all top level or within a containing "params" object. An optional top level "fields" array of dotted field paths limits the result to those fields.</param>
+            ///<returns type="String">The method results expressed is a JSON string. If an exception was thrown, a top level object "EXCEPTION" will contain standard Error fields.</returns>
+
+            var params, result;
+
+            try {
+                params = JSON.parse(paramsJSON);
+
+                if (!params || (typeof params.func !== 'string')) {
+                    throw new PLAYER_SEQUENCER.SchedulerError('runJSON func property missing or not a string');
+                }
+
+                if (params.params) {
+                    result = myScheduler[params.func](params.params);
+                }
+                else {
+                    result = myScheduler[params.func](params);
+                }
+            }
+            catch (ex) {
+                return PLAYER_SEQUENCER.exceptionToJSON(ex);
+            }
+            return PLAYER_SEQUENCER.stringifyResult(result, params.fields);
+        }
+    };
+    return myScheduler;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Singletons for the sequential playlist and the scheduler
+// Note: These are declared here for simplicity in the initial single-instance implementation.
+//       They are also the "default" session of PLAYER_SEQUENCER.sessionManager, which creates other instances.
+// ------------------------------------------------------------------------------------------------
+
+PLAYER_SEQUENCER.sequentialPlaylist = PLAYER_SEQUENCER.createSequentialPlaylist();
+
+PLAYER_SEQUENCER.scheduler = PLAYER_SEQUENCER.createScheduler(PLAYER_SEQUENCER.sequentialPlaylist);
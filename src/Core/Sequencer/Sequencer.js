@@ -1,551 +1,2312 @@
-// ----------------------------------------------------------------------------
-// Copyright (c) Microsoft Corporation. All rights reserved.
-// ----------------------------------------------------------------------------
-//
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-// http://www.apache.org/licenses/LICENSE-2.0
-//
-// THIS CODE IS PROVIDED *AS IS* BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
-// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
-// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
-//
-
-// This file contains the public methods for Sequencer Chain head access and the Sequencer plugin factory.
-// It also contains the hidden default (last) Sequencer implementation.
-// All the position variables are floating point seconds.
-
-//
-// The namespace object
-//
-var PLAYER_SEQUENCER = PLAYER_SEQUENCER || {};
-
-// custom Sequencer Error derivation:
-PLAYER_SEQUENCER.SequencerError = function (message) {
-    ///<summary>Constructor for the custom Sequencer Error derivation.</summary>
-    ///<param name="message" type="String">A human readable error message within the Sequencer Error context.</param>
-    ///<returns type="Object">A new Sequencer Error object instance.</returns>
-    "use strict";
-    if (this === PLAYER_SEQUENCER) {
-        throw new PLAYER_SEQUENCER.SequencerError("SequencerError constructor called without new operator!");
-    }
-    this.name = "PLAYER_SEQUENCER:SequencerError";
-    this.message = message || "[no message]";
-    // For V8 capture the stack trace:
-    if (Error.captureStackTrace) {
-        Error.captureStackTrace(this, PLAYER_SEQUENCER.SequencerError);    
-    }
-};
-PLAYER_SEQUENCER.SequencerError.prototype = new Error();
-PLAYER_SEQUENCER.SequencerError.prototype.constructor = PLAYER_SEQUENCER.SequencerError;
-
-// -------------------------
-// The playback segment pool
-// -------------------------
-// Note: The purpose of this pool is to provide a unique mapping of segment id numbers to 
-//       playback segment objects which allows referencing the objects through the JSON thunk.
-//       Therefore, the pool can be a Singleton regardless of the number of Sequencer instances used.
-//
-PLAYER_SEQUENCER.playbackSegmentPool = (function () {
-"use strict";
-
-    var nextSegmentId = 1,          // start with 1 so never false
-        poolBaseId = nextSegmentId, // the segmentId of the zeroth pool element
-        pool = [],
-    
-    // private methods
-    throwSetterInhibited = function ( value ) {
-        throw new PLAYER_SEQUENCER.SequencerError('setter not allowed. value: ' + value.toString());
-    };
-
-    return {
-        createPlaybackSegment: function (aClip, aStartTime, aPlaybackRate) {
-            ///<summary>Create a new playbackSegment object</summary>
-            ///<param name="aClip" type="Object">A reference to a Scheduler sequentialPlaylist object</param>
-            ///<param name="aStartTime" type="Number">manifest time of where to start playing in the new segment</param>
-            ///<param name="aPlaybackRate" type="Number">initial playback rate</param>
-            ///<returns type="Object">playbackSegment object that was created</returns>
-            var myId = nextSegmentId,
-                myClip = aClip,
-                myStartTime = aStartTime,
-                myPlaybackRate = aPlaybackRate,
-                mySplitCount = aClip.splitCount,
-                playbackSegment;
-
-            nextSegmentId += 1;
-
-            // DEFINITION of a playbackSegment:
-            playbackSegment = {
-                /// <field name="clip" type="Object" mayBeNull="true">reference to a Scheduler sequentialPlaylist object</field>
-                get clip() { return myClip; },
-                set clip(value) { myClip = value; mySplitCount = value.splitCount; },
-                /// <field name="initialPlaybackStartTime" type="Number">manifest time of where to start playing in the new segment</field>
-                get initialPlaybackStartTime() { return myStartTime; },
-                set initialPlaybackStartTime(value) { throwSetterInhibited(value); },
-                /// <field name="initialPlaybackRate" type="Number">initial playback rate</field>
-                get initialPlaybackRate() { return myPlaybackRate; },
-                set initialPlaybackRate(value) { throwSetterInhibited(value); },
-                /// <field name="segmentId" type="Number">unique id number of the playback segment</field>
-                get segmentId() { return myId; },
-                set segmentId(value) { throwSetterInhibited(value); },
-                /// <field name="isClipChanged" type="Boolean">true if clip has changed</field>
-                get isClipChanged() { return mySplitCount !== myClip.splitCount; },
-                set isClipChanged(value) { throwSetterInhibited(value); }
-            };
-            pool[myId - poolBaseId] = playbackSegment;
-            return playbackSegment;
-        },
-        releasePlaybackSegment: function (segmentId) {
-            ///<summary>Release the segment pool reference to the playback segment object so it can be GCed</summary>
-            ///<param name="segmentId" type="Number">The segmentId number of the playback segment to be released from the pool</param>
-            if (pool[segmentId - poolBaseId] === undefined) {
-                throw new PLAYER_SEQUENCER.SequencerError('invalid releasePlaybackSegment Id: ' + segmentId.toString());
-            }
-            if (segmentId === poolBaseId) {
-                do {
-                    // shift out all contiguous released items starting at the base Id
-                    pool.shift();
-                    poolBaseId += 1;
-                } while (pool.length > 0 && pool[0] === null); 
-            }
-            else {
-                // just release the Id and it will be shifted out when all before are released
-                pool[segmentId - poolBaseId] = null;
-            }
-        },
-        getPlaybackSegment: function (segmentId) {
-            ///<summary>Get a a reference to the playbackSegment object with the given segmentId</summary>
-            ///<param name="segmentId" type="Number">The segmentId number of the playback segment to be referenced</param>
-            ///<returns type="Object">playbackSegment object reference</returns>
-            var ps = pool[segmentId - poolBaseId], 
-                ex;
-            if (!ps) {
-                ex = new PLAYER_SEQUENCER.SequencerError('invalid getPlaybackSegment Id: ' + segmentId.toString());
-                throw ex;
-            }
-            return ps;
-        },
-        testProbe_toJSON: function () {
-            ///<summary>For testing purposes, return JSON string of the entire playbackSegment pool</summary>
-            ///<returns type="String">JSON of the entire playbackSegment pool</returns>
-            return '{' + JSON.stringify(pool) + ',"poolBaseId":' + poolBaseId.toString() + ',"nextSegmentId":' + nextSegmentId.toString() + '}';
-        },
-        testProbe_reset: function () {
-            ///<summary>For testing purposes, reset the entire playbackSegment pool</summary>
-            pool = [];
-            poolBaseId = nextSegmentId; // the segmentId of the zeroth pool element
-        }
-    };
-}());
-
-//
-// -------------------------
-// Sequencer plugin chain
-// -------------------------
-//
-PLAYER_SEQUENCER.createSequencerPluginChain = function ( sequentialPlaylistAccessContext ) {
-    ///<summary>Create a sequencer plugin chain object with all the methods for accessing the chain instance.</summary>
-    ///<param name="sequentialPlaylistAccessContext" type="Object">The object with methods for accessing the Scheduler sequentialPlaylist instance to be used by this plugin chain.</param>
-    ///<returns type="Object">A new sequencer plugin factory object with methods for creating new pass-through plugins and using the chain.</returns>
-    "use strict";
-
-    var sequentialPlaylistAccess = sequentialPlaylistAccessContext,
-        firstSequencer = null;
-    
-    return {
-        //
-        // Sequencer plugin factory object
-        // This factory creates a pass-through object which defines all the methods
-        //     a sequencer plugin must either override or allow to be passed through.
-        // This could be thought of as the "interface definition" for a sequencer plug-in implementation.
-        // Note that the prototype for the object created is simply that of Object.
-        //
-        
-        createSequencerPlugin: function () {
-            ///<summary>Create a pass-through plugin object which defines all the methods a sequencer plugin can override.</summary>
-            ///<returns type="Object">A new sequencer plugin pass-through object.</returns>
-            var nextSequencer = null,
-        
-            newSequencer = {
-                getNextSequencer: function () {
-                    ///<summary>Get the hidden nextSequencer value so method overrides can conditionally pass through to the next sequencer.</summary>
-                    ///<returns type="Object">A reference to the next sequencer in the plugin chain.</returns>
-                    return nextSequencer;
-                },
-
-                getSequentialPlaylistAccess: function () {
-                    ///<summary>Get the hidden sequentialPlaylistAccess value so method overrides can access the correct sequentialPlaylist.</summary>
-                    ///<returns type="Object">A reference to the sequentialPlaylist.access object for this plugin chain.</returns>
-                    return sequentialPlaylistAccess;
-                },
-
-                manifestToSeekbarTime: function ( params ) {
-                    ///<summary>Convert manifest time to seekbar time. Should be called several times per second to keep seekbar updated and catch playlist changes.</summary>
-                    ///<param name="params" type="Object">An object with properties: currentSegmentId, playbackRate, currentPlaybackPosition</param>
-                    ///<returns type="Object">An object with properties: currentSeekbarPosition, minSeekbarPosition, maxSeekbarPosition, playbackPolicy, playbackRangeExceeded</returns>
-                    return nextSequencer.manifestToSeekbarTime(params);
-                },
-        
-                manifestToLinearTime: function ( params ) {
-                    ///<summary>Convert manifest time to linear time. Used to determine where to resume from last played position.</summary>
-                    ///<param name="params" type="Object">An object with properties: currentSegmentId, currentPlaybackPosition (in manifest time)</param>
-                    ///<returns type="Object">An object with properties: linearPosition, isOnLinearTimeline</returns>
-                    return nextSequencer.manifestToLinearTime( params );
-                },
-        
-                seekFromLinearPosition: function ( params ) {
-                    ///<summary>Seek to linear time. Used to resume from last played position (no currentSegmentId given0 or to seek out of a zero-linear-duration currentSegmentId.</summary>
-                    ///<param name="params" type="Object">An object with properties: currentSegmentId (optional), linearSeekPosition</param>
-                    ///<returns type="Object">A playback segment object reference</returns>
-                    return nextSequencer.seekFromLinearPosition( params );
-                },
-        
-                seekFromSeekbarPosition: function ( params ) {
-                    ///<summary>Seek to a position relative to the current playback segment seekbar range.</summary>
-                    ///<param name="params" type="Object">An object with properties: currentSegmentId, seekbarSeekPosition</param>
-                    ///<returns type="Object">A playback segment object reference (may be same as that for currentSegmentId)</returns>
-                    return nextSequencer.seekFromSeekbarPosition( params );
-                },
-        
-                onEndOfMedia: function ( params ) {
-                    ///<summary>Notify end of playing the current playback segment to get a new playback segment object for the next segment in the sequence. The Scheduler is notified the playlist entry for the current playback segment has been played.</summary>
-                    ///<param name="params" type="Object">An object with properties: currentSegmentId, currentPlaybackPosition (in manifest time), currentPlaybackRate, isNotPlayed, isEndOfSequence</param>
-                    ///<returns type="Object" mayBeNull="true">The new playback segment object reference (null when at end of list)</returns>
-                    return nextSequencer.onEndOfMedia( params );
-                },
-        
-                onEndOfBuffering: function ( params ) {
-                    ///<summary>Notify end of buffering the playback segment to get a new playback segment object for the next segment in the sequence to buffer. The Scheduler is NOT notified the playlist entry for the current playback segment has been played.</summary>
-                    ///<param name="params" type="Object">An object with properties: currentSegmentId, currentPlaybackPosition (in manifest time), currentPlaybackRate</param>
-                    ///<returns type="Object" mayBeNull="true">The new playback segment object reference (null when at end of list)</returns>
-                    return nextSequencer.onEndOfBuffering( params );
-                },
-        
-                onError: function ( params ) {
-                    ///<summary>Notify playback error to get a new playback segment object for the next segment in the sequence to use after an error.</summary>
-                    ///<param name="params" type="Object">An object with properties: currentSegmentId, currentPlaybackPosition (in manifest time), currentPlaybackRate, isNotPlayed, isEndOfSequence, errorDescription</param>
-                    ///<returns type="Object" mayBeNull="true">The new playback segment object reference (null when sequence is terminated)</returns>
-                    return nextSequencer.onError( params );
-                },
-
-                testProbe: function ( params ) {
-                    ///<summary>For testing purposes: generic invocation of a test probe. This is a "tunneling" mechanism for a private contract between the caller and a specific sequencer plugin.</summary>
-                    ///<param name="params" type="Object">An object with properties dependent upon the specific probe to be performed.</param>
-                    ///<returns mayBeNull="true">An object of type and value dependent upon the specific probe that was performed.</returns>
-                    return nextSequencer.testProbe( params );
-                }
-            }; // end of newSequencer
-            
-            nextSequencer = firstSequencer;
-            firstSequencer = newSequencer;
-
-            return newSequencer;
-        },
-        
-        getFirstSequencer: function () {
-            ///<summary>Get a reference to the first sequencer in the plugin chain. This should always be used for all sequencer plugin method invocations.</summary>
-            ///<returns type="Object">A reference to the first sequencer in the plugin chain.</returns>
-            return firstSequencer;
-        },
-
-        runJSON: function ( paramsJSON ) {
-            ///<summary>Invoke a sequencer plugin method using a JSON string and returning the result as a JSON string.</summary>
-            ///<param name="paramsJSON" type="String">The method name and params expressed in a JSON string. There must be a top level property "func" string with the name of the method to invoke. Method params can either be all top level or within a containing "params" object.</param>
-            ///<returns type="String">The method results expressed is a JSON string. If an exception was thrown, a top level object "EXCEPTION" will contain standard Error fields.</returns>
-
-            var params, result, stackArray, stackAsJSON, i;
-
-            try {
-                params = JSON.parse(paramsJSON);
-
-                if (!params || (typeof params.func !== 'string')) {
-                    throw new PLAYER_SEQUENCER.SequencerError('runJSON func property missing or not a string');
-                }
-
-                if (params.params) {
-                    result = firstSequencer[params.func](params.params);
-                }
-                else {
-                    result = firstSequencer[params.func](params);
-                }
-            }
-            catch (ex) {
-                // JSON.stringify() does not appear to work for exceptions, so generate explicitly:
-                if (ex.stack) {
-                    stackArray = ex.stack.split('\n');
-                    stackAsJSON = "";
-                    for (i = 0; i < stackArray.length; i += 1)
-                    {
-                        if (i > 0) {
-                            stackAsJSON += ',';
-                        }
-                        stackAsJSON += '"' + stackArray[i] + '"';
-                    }
-                    return '{"EXCEPTION":{"name":"' + ex.name + '","message":"' + ex.message + '","stack":[' + stackAsJSON + ']}}';
-                }
-                return '{"EXCEPTION":{"name":"' + ex.name + '","message":"' + ex.message + '"}}';
-            }
-            return JSON.stringify(result);
-        }
-    };
-};
-
-// ------------------------------------------------------------------------------------------------
-// Default (last in chain) sequencer
-// ------------------------------------------------------------------------------------------------
-
-PLAYER_SEQUENCER.createDefaultSequencerPlugin = function (basePlugin) {
-"use strict";
-
-    // private variables and methods
-    var mySequentialPlaylist = basePlugin.getSequentialPlaylistAccess(),
-        myPlaybackSegmentPool = PLAYER_SEQUENCER.playbackSegmentPool,
-
-    myOnEnd = function ( params, isEndOfMedia ) {
-        /* params:
-        currentSegmentId            // number: the unique Id for the playback segment
-        currentPlaybackPosition     // number: the current playback position in manifest time
-        currentPlaybackRate         // number: the current playback rate
-        isNotPlayed                 // boolean: suppress any "is played" processing
-        isEndOfSequence             // boolean: do not create a new playbackSegment
-        */
-        var entry = myPlaybackSegmentPool.getPlaybackSegment(params.currentSegmentId).clip,
-            nextEntry,
-            newSegment = null,
-            isPlayForward = 0 <= params.currentPlaybackRate,
-            currentLinearPosition,
-            initialPlaybackStartTime;
-        
-        if (!isEndOfMedia || !params.isEndOfSequence) {
-            nextEntry = isPlayForward ? mySequentialPlaylist.getEntryAfterId(entry.id) : mySequentialPlaylist.getEntryBeforeId(entry.id);
-        }
-        // nextEntry is defined to be falsey when getEntryAfter/BeforeId runs off the end of the playlist
-        if (nextEntry) {
-            initialPlaybackStartTime = isPlayForward ? nextEntry.minRenderingTime : nextEntry.maxRenderingTime;
-            newSegment = myPlaybackSegmentPool.createPlaybackSegment(nextEntry, initialPlaybackStartTime, params.currentPlaybackRate);
-        }
-
-        if (isEndOfMedia) {
-            if (!params.isNotPlayed) {
-                mySequentialPlaylist.onPlayedEntry(entry);
-            }
-            myPlaybackSegmentPool.releasePlaybackSegment(params.currentSegmentId);
-
-            // if onPlayedEntry caused welding of nextEntry
-            if (nextEntry && newSegment.isClipChanged) {
-                // switch nextEntry to the playlist entry for the linear start time of the welded entry
-                currentLinearPosition = nextEntry.linearStartTime;
-                nextEntry = mySequentialPlaylist.getEntryAtTime(currentLinearPosition);
-                if (!nextEntry) {
-                    throw new PLAYER_SEQUENCER.SequencerError('myOnEnd failed to find anealed playlist entry at time ' + currentLinearPosition.toString());
-                }
-                // replace newSegment clip with the new playlist entry
-                newSegment.clip = nextEntry;
-            }
-        }
-
-        return newSegment;
-    };
-
-    // Replace the default pass-through methods
-    // NOTE: Any that are missed (or mis-spelled) will cause an exception when
-    //       the default pass-through uses its null 'nextSequencer' value.
-    
-    basePlugin.manifestToSeekbarTime = function ( params ) {
-        /* params:
-        currentSegmentId,           // number: the unique Id for the playback segment
-        playbackRate,               // number: the current playback rate
-        currentPlaybackPosition,    // number: the current position in manifest time
-        */
-        var currentSegment = myPlaybackSegmentPool.getPlaybackSegment(params.currentSegmentId),
-            entry = currentSegment.clip,
-            playbackRate = params.playbackRate,
-            currentPlaybackPosition = params.currentPlaybackPosition,
-            minManifestPosition = entry.minRenderingTime,
-            maxManifestPosition = entry.maxRenderingTime,
-            currentSeekbarPosition = currentPlaybackPosition - minManifestPosition,
-            minSeekbarPosition = 0,
-            maxSeekbarPosition = 0,
-            playbackPolicy = null,
-            playbackRangeExceeded = false,
-            updatedEntry;
-
-        if (currentSegment.clip.isAdvertisement) {
-            playbackPolicy = entry.playbackPolicyObj;
-            maxSeekbarPosition = maxManifestPosition - minManifestPosition;
-
-            // currentSegment.isClipChanged cannot happen for an ad
-            
-            // clamp currentSeekbarPosition within min/max
-            if (currentSeekbarPosition < minSeekbarPosition) {
-                currentSeekbarPosition = minSeekbarPosition;
-            }
-            else if (maxSeekbarPosition < currentSeekbarPosition) {
-                currentSeekbarPosition = maxSeekbarPosition;
-            }
-        }
-        else {
-            // for non-ad get the max seekbar position (min is always zero)
-            maxSeekbarPosition = mySequentialPlaylist.getPlaylistLinearDuration();
-            currentSeekbarPosition += entry.linearStartTime;
-
-            if (currentSegment.isClipChanged) {
-                updatedEntry = mySequentialPlaylist.getEntryAtTime(currentSeekbarPosition);
-                if (!updatedEntry) {
-                    throw new PLAYER_SEQUENCER.SequencerError(
-                        'manifestToSeekbarTime failed to find anealed playlist entry at time ' + currentSeekbarPosition.toString());
-                }
-                if (currentSegment.clip.idSplitFrom === updatedEntry.idSplitFrom) {
-                    // Replace currentSegment clip with the new welded/split playlist entry.
-                    currentSegment.clip = updatedEntry;
-                    // Note: the currentSeekbarPosition must be within range since the updatedEntry contains it.
-                } else {
-                    // currentPlaybackPosition changed to a different idSplitFrom clip
-                    playbackRangeExceeded = true;
-                }
-            }
-        }
-
-        if (!updatedEntry && 
-            ((playbackRate < 0 && currentPlaybackPosition < minManifestPosition) ||
-            (playbackRate >= 0 && maxManifestPosition < currentPlaybackPosition))) {
-            playbackRangeExceeded = true;
-        }
-
-        return {
-            currentSeekbarPosition: currentSeekbarPosition,
-            minSeekbarPosition: minSeekbarPosition,
-            maxSeekbarPosition: maxSeekbarPosition,
-            playbackPolicy: playbackPolicy,
-            playbackRangeExceeded: playbackRangeExceeded
-        };
-    };
-
-    basePlugin.manifestToLinearTime = function ( params ) {
-        /* params:
-        currentSegmentId,           // number: the unique Id for the playback segment
-        currentPlaybackPosition     // number: the current playback position in manifest time
-        */
-        var currentSegment = myPlaybackSegmentPool.getPlaybackSegment(params.currentSegmentId),
-            positionOffset = params.currentPlaybackPosition - currentSegment.clip.minRenderingTime,
-            result = currentSegment.clip.linearStartTime;
-
-        if (currentSegment.clip.linearDuration > 0 && positionOffset > 0) {
-            // NOTE: result is *not* clipped to maxRenderingTime
-            result += positionOffset;
-        }
-        return result;
-    };
-
-    basePlugin.seekFromLinearPosition = function ( params ) {
-        /* params:
-        currentSegmentId,           // number: optional unique Id for the currrent playback segment; 0 or undefined for no current segment
-        linearSeekPosition          // number: the linear position to seek to, used mainly for resuming from the previous session
-        */
-        var seekPlaylistEntry = mySequentialPlaylist.getEntryAtTime(params.linearSeekPosition),
-            currentSegment,
-            initialPlaybackRate = 1,
-            initialPlaybackStartTime;
-
-        if (params.currentSegmentId) {
-            currentSegment = myPlaybackSegmentPool.getPlaybackSegment(params.currentSegmentId);
-        }
-
-        if (!seekPlaylistEntry) {
-            if (currentSegment) {
-                myPlaybackSegmentPool.releasePlaybackSegment(currentSegment.segmentId);
-            }
-            throw new PLAYER_SEQUENCER.SequencerError('seekFromLinearPosition outside playlist range');
-        }
-
-        if (currentSegment) {
-            myPlaybackSegmentPool.releasePlaybackSegment(currentSegment.segmentId);
-            initialPlaybackRate = currentSegment.initialPlaybackRate;
-        }
-        initialPlaybackStartTime = seekPlaylistEntry.minRenderingTime + (params.linearSeekPosition - seekPlaylistEntry.linearStartTime);
-        currentSegment = myPlaybackSegmentPool.createPlaybackSegment(seekPlaylistEntry, initialPlaybackStartTime, initialPlaybackRate);
-
-        return currentSegment;
-    };
-
-    basePlugin.seekFromSeekbarPosition = function ( params ) {
-        /* params:
-        currentSegmentId,           // number: the unique Id for the playback segment
-        seekbarSeekPosition         // number: the seek position in seekbar time, used for user seek
-        */
-        var currentSegment = myPlaybackSegmentPool.getPlaybackSegment(params.currentSegmentId),
-            seekPlaylistEntry,
-            seekPlaybackSegment,
-            initialPlaybackRate,
-            initialPlaybackStartTime;
-
-        // Prevent seekbarSeekPosition from being non-negative
-        if (params.seekbarSeekPosition < 0) {
-            params.seekbarSeekPosition = 0;
-        }
-
-        if (currentSegment.clip.linearDuration > 0) {
-            // Note: For non-zero-duration clips, seekbar time is the same as linear time.
-            seekPlaylistEntry = mySequentialPlaylist.getEntryAtTime(params.seekbarSeekPosition);
-            if (!seekPlaylistEntry) {
-                throw new PLAYER_SEQUENCER.SequencerError('seekFromSeekbarPosition outside playlist range');
-            }
-            initialPlaybackRate = currentSegment.initialPlaybackRate;
-            initialPlaybackStartTime = seekPlaylistEntry.minRenderingTime;
-            // if new clip is not zero duration, offset initialPlaybackStartTime by the remaining seek distance
-            if (seekPlaylistEntry.linearDuration > 0) {
-                initialPlaybackStartTime += (params.seekbarSeekPosition - seekPlaylistEntry.linearStartTime);
-            }
-        }
-        else if (params.seekbarSeekPosition > currentSegment.clip.maxRenderingTime - currentSegment.clip.minRenderingTime) {
-            // for zero-duration clips seeking must be within the clip
-            throw new PLAYER_SEQUENCER.SequencerError('seekFromSeekbarPosition outside segment range');
-        }
-        else {
-            // use the same zero-duration clip to create the new segment
-            seekPlaylistEntry = currentSegment.clip;
-            initialPlaybackRate = currentSegment.initialPlaybackRate;
-            initialPlaybackStartTime = seekPlaylistEntry.minRenderingTime + params.seekbarSeekPosition;
-        }
-        seekPlaybackSegment = myPlaybackSegmentPool.createPlaybackSegment(seekPlaylistEntry, initialPlaybackStartTime, initialPlaybackRate);
-
-        // Only if there were no exceptions is the previous playbackSegment released.
-        myPlaybackSegmentPool.releasePlaybackSegment(currentSegment.segmentId);
-
-        return seekPlaybackSegment;
-    };
-
-    basePlugin.onEndOfMedia = function ( params ) {
-        return myOnEnd(params, true);
-    };
-
-    basePlugin.onEndOfBuffering = function ( params ) {
-        return myOnEnd(params, false);
-    };
-
-    basePlugin.onError = function ( params ) {
-        // NOTE: The default implementation treats onError the same as onEndOfMedia.
-        //       A sequencer plugin is required to take some other action.
-        return myOnEnd(params, true);
-    };
-
-    basePlugin.testProbe = function ( params ) {
-        // TODO: add testProbe functionallity based on 'params'
-        return "default sequencer";
-    };
-};
-
-// ------------------------------------------------------------------------------------------------
-// Singleton for the sequencer plugin chain and the creation of the base sequencer plugin.
-// Note: These are declared here for simplicity in the initial single-instance implementation.
-//       For multiple instance implementations, these would be moved to an instance manager.
-// ------------------------------------------------------------------------------------------------
-//
-// NOTE: The createSequencerPlugin (for the parameter to createDefaultSequencerPlugin) must be called 
-//       immediately after the createSequencerPluginChain to ensure the default plugin is the last in the chain.
-//
-PLAYER_SEQUENCER.sequencerPluginChain = PLAYER_SEQUENCER.createSequencerPluginChain(PLAYER_SEQUENCER.sequentialPlaylist.access);
-
-PLAYER_SEQUENCER.createDefaultSequencerPlugin(PLAYER_SEQUENCER.sequencerPluginChain.createSequencerPlugin());
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file contains the public methods for Sequencer Chain head access and the Sequencer plugin factory.
+// It also contains the hidden default (last) Sequencer implementation.
+// All the position variables are floating point seconds, or integer ticks after scheduler.setTimescale.
+
+//
+// The namespace object
+//
+var PLAYER_SEQUENCER = PLAYER_SEQUENCER || {};
+
+// custom Sequencer Error derivation:
+PLAYER_SEQUENCER.SequencerError = function (message) {
+    ///<summary>Constructor for the custom Sequencer Error derivation.</summary>
+    ///<param name="message" type="String">A human readable error message within the Sequencer Error context.</param>
+    ///<returns type="Object">A new Sequencer Error object instance.</returns>
+    "use strict";
+    if (this === PLAYER_SEQUENCER) {
+        throw new PLAYER_SEQUENCER.SequencerError("SequencerError constructor called without new operator!");
+    }
+    this.name = "PLAYER_SEQUENCER:SequencerError";
+    this.message = message || "[no message]";
+    // For V8 capture the stack trace:
+    if (Error.captureStackTrace) {
+        Error.captureStackTrace(this, PLAYER_SEQUENCER.SequencerError);    
+    }
+};
+PLAYER_SEQUENCER.SequencerError.prototype = new Error();
+PLAYER_SEQUENCER.SequencerError.prototype.constructor = PLAYER_SEQUENCER.SequencerError;
+
+// -------------------------
+// The playback segment pool
+// -------------------------
+// Note: The purpose of this pool is to provide a unique mapping of segment id numbers to 
+//       playback segment objects which allows referencing the objects through the JSON thunk.
+//       Each sequencer plugin chain uses one pool. The single-instance implementation uses the
+//       playbackSegmentPool singleton while the sessionManager creates a pool for each session
+//       so sessions cannot exhaust or release each other's segments.
+//
+PLAYER_SEQUENCER.createPlaybackSegmentPool = function () {
+"use strict";
+
+    // Note: segmentId = generation * SLOT_LIMIT + slot
+    //       Released slots are reused from a free list and the generation of a slot is bumped each time it is reused,
+    //       so create, get and release are O(1) and a stale segmentId is detected instead of aliasing a new segment.
+    var SLOT_LIMIT = 65536,
+        GENERATION_LIMIT = Math.floor(0x7FFFFFFF / SLOT_LIMIT), // keep segmentIds within a signed 32 bit int for the native bridge
+        capacity = 1024,            // maximum number of live segments
+        slots = [],                 // the playbackSegment for each slot, null when the slot is free
+        generations = [],           // the current generation of each slot
+        createTimes = [],           // the Date.now() creation time of the playbackSegment in each slot
+        freeSlots = [],             // stack of free slot numbers
+        liveCount = 0,
+        highWaterMark = 0,
+        createCount = 0,
+        releaseCount = 0,
+    
+    // private methods
+    throwSetterInhibited = function ( value ) {
+        throw new PLAYER_SEQUENCER.SequencerError('setter not allowed. value: ' + value.toString());
+    },
+
+    slotFromId = function ( segmentId ) {
+        ///<summary>Get the slot number of a live playback segment</summary>
+        ///<param name="segmentId" type="Number">The segmentId number of the playback segment</param>
+        ///<returns type="Number">The slot number or -1 when the segmentId is invalid, released or stale</returns>
+        var slot;
+
+        if (typeof segmentId !== 'number' || segmentId < SLOT_LIMIT) {
+            return -1;
+        }
+        slot = segmentId % SLOT_LIMIT;
+        if (!slots[slot] || generations[slot] !== Math.floor(segmentId / SLOT_LIMIT)) {
+            return -1;
+        }
+        return slot;
+    },
+
+    allocateSlot = function () {
+        ///<summary>Get a free slot from the free list or grow the slot arrays, and bump its generation</summary>
+        ///<returns type="Number">The slot number</returns>
+        var slot;
+
+        if (liveCount >= capacity) {
+            throw new PLAYER_SEQUENCER.SequencerError('playbackSegmentPool capacity exceeded: ' + capacity.toString());
+        }
+        if (freeSlots.length > 0) {
+            slot = freeSlots.pop();
+        }
+        else {
+            slot = slots.length;
+            slots.push(null);
+            generations.push(0);
+            createTimes.push(0);
+        }
+        // generation starts at 1 so a segmentId is never false
+        generations[slot] = (generations[slot] % GENERATION_LIMIT) + 1;
+        return slot;
+    },
+
+    freeSlot = function ( slot ) {
+        slots[slot] = null;
+        freeSlots.push(slot);
+        liveCount -= 1;
+        releaseCount += 1;
+    },
+
+    myPool = {
+        createPlaybackSegment: function (aClip, aStartTime, aPlaybackRate) {
+            ///<summary>Create a new playbackSegment object</summary>
+            ///<param name="aClip" type="Object">A reference to a Scheduler sequentialPlaylist object</param>
+            ///<param name="aStartTime" type="Number">manifest time of where to start playing in the new segment</param>
+            ///<param name="aPlaybackRate" type="Number">initial playback rate</param>
+            ///<returns type="Object">playbackSegment object that was created</returns>
+            var slot = allocateSlot(),
+                myId = generations[slot] * SLOT_LIMIT + slot,
+                myClip = aClip,
+                myStartTime = aStartTime,
+                myPlaybackRate = aPlaybackRate,
+                mySplitCount = aClip.splitCount,
+                playbackSegment;
+
+            // DEFINITION of a playbackSegment:
+            playbackSegment = {
+                /// <field name="clip" type="Object" mayBeNull="true">reference to a Scheduler sequentialPlaylist object</field>
+                get clip() { return myClip; },
+                set clip(value) { myClip = value; mySplitCount = value.splitCount; },
+                /// <field name="initialPlaybackStartTime" type="Number">manifest time of where to start playing in the new segment</field>
+                get initialPlaybackStartTime() { return myStartTime; },
+                set initialPlaybackStartTime(value) { throwSetterInhibited(value); },
+                /// <field name="initialPlaybackRate" type="Number">initial playback rate</field>
+                get initialPlaybackRate() { return myPlaybackRate; },
+                set initialPlaybackRate(value) { throwSetterInhibited(value); },
+                /// <field name="segmentId" type="Number">unique id number of the playback segment</field>
+                get segmentId() { return myId; },
+                set segmentId(value) { throwSetterInhibited(value); },
+                /// <field name="isClipChanged" type="Boolean">true if clip has changed</field>
+                get isClipChanged() { return mySplitCount !== myClip.splitCount; },
+                set isClipChanged(value) { throwSetterInhibited(value); }
+            };
+            slots[slot] = playbackSegment;
+            createTimes[slot] = Date.now();
+            liveCount += 1;
+            createCount += 1;
+            if (liveCount > highWaterMark) {
+                highWaterMark = liveCount;
+            }
+            return playbackSegment;
+        },
+        releasePlaybackSegment: function (segmentId) {
+            ///<summary>Release the segment pool reference to the playback segment object so it can be GCed</summary>
+            ///<param name="segmentId" type="Number">The segmentId number of the playback segment to be released from the pool</param>
+            var slot = slotFromId(segmentId);
+            if (slot < 0) {
+                throw new PLAYER_SEQUENCER.SequencerError('invalid releasePlaybackSegment Id: ' + String(segmentId));
+            }
+            freeSlot(slot);
+        },
+        releaseAll: function () {
+            ///<summary>Release every live playback segment, so their segmentIds are rejected from now on</summary>
+            ///<returns type="Number">The number of playback segments released</returns>
+            var count = 0,
+                i;
+            for (i = 0; i < slots.length; i += 1) {
+                if (slots[i]) {
+                    freeSlot(i);
+                    count += 1;
+                }
+            }
+            return count;
+        },
+        getPlaybackSegment: function (segmentId) {
+            ///<summary>Get a a reference to the playbackSegment object with the given segmentId</summary>
+            ///<param name="segmentId" type="Number">The segmentId number of the playback segment to be referenced</param>
+            ///<returns type="Object">playbackSegment object reference</returns>
+            var slot = slotFromId(segmentId);
+            if (slot < 0) {
+                throw new PLAYER_SEQUENCER.SequencerError('invalid getPlaybackSegment Id: ' + String(segmentId));
+            }
+            return slots[slot];
+        },
+        setCapacity: function (maxLiveSegments) {
+            ///<summary>Set the maximum number of live playback segments. Creating a segment beyond the capacity throws a SequencerError.</summary>
+            ///<param name="maxLiveSegments" type="Number">The maximum number of live segments, from 1 to 65536</param>
+            if (typeof maxLiveSegments !== 'number' || maxLiveSegments < 1 || maxLiveSegments > SLOT_LIMIT) {
+                throw new PLAYER_SEQUENCER.SequencerError('invalid playbackSegmentPool capacity: ' + String(maxLiveSegments));
+            }
+            capacity = Math.floor(maxLiveSegments);
+        },
+        getStatistics: function () {
+            ///<summary>Get the pool usage counters, used to detect playback segments that are never released</summary>
+            ///<returns type="Object">An object with properties: liveCount, highWaterMark, capacity, createCount, releaseCount, oldestLiveAge (milliseconds, 0 when no segment is live)</returns>
+            var now = Date.now(),
+                oldestLiveAge = 0,
+                i;
+
+            for (i = 0; i < slots.length; i += 1) {
+                if (slots[i] && now - createTimes[i] > oldestLiveAge) {
+                    oldestLiveAge = now - createTimes[i];
+                }
+            }
+            return {
+                liveCount: liveCount,
+                highWaterMark: highWaterMark,
+                capacity: capacity,
+                createCount: createCount,
+                releaseCount: releaseCount,
+                oldestLiveAge: oldestLiveAge
+            };
+        },
+        testProbe_toJSON: function () {
+            ///<summary>For testing purposes, return JSON string of the entire playbackSegment pool</summary>
+            ///<returns type="String">JSON of the entire playbackSegment pool</returns>
+            return JSON.stringify({ slots: slots, generations: generations, freeSlots: freeSlots, statistics: myPool.getStatistics() });
+        },
+        testProbe_reset: function () {
+            ///<summary>For testing purposes, reset the entire playbackSegment pool</summary>
+            myPool.releaseAll();
+            highWaterMark = 0;
+            createCount = 0;
+            releaseCount = 0;
+        }
+    };
+    return myPool;
+};
+
+PLAYER_SEQUENCER.playbackSegmentPool = PLAYER_SEQUENCER.createPlaybackSegmentPool();
+
+//
+// -------------------------
+// Compact command layouts
+// -------------------------
+// Note: The DEFINITION of the runCompact commands: the names of the positional arguments and of the fields of the
+//       comma separated result tuple, as dotted paths into the method result (null for a number result).
+//       Booleans are encoded as 1 or 0, a missing value as an empty field and a null playback segment as "null".
+//       The native side parses the tuples by position, so a field may only be appended, and the clipURI must
+//       stay last since it may contain the ',' separator.
+//
+PLAYER_SEQUENCER.compactCommands = (function () {
+"use strict";
+    var SEEKBAR_TIME_FIELDS = ['currentSeekbarPosition', 'minSeekbarPosition', 'maxSeekbarPosition', 'playbackRangeExceeded'],
+        PLAYBACK_SEGMENT_FIELDS = ['segmentId', 'initialPlaybackStartTime', 'initialPlaybackRate', 'clip.eClipType', 'clip.linearStartTime', 'clip.linearDuration',
+            'clip.minRenderingTime', 'clip.maxRenderingTime', 'clip.isAdvertisement', 'clip.deleteAfterPlay', 'clip.id', 'clip.idSplitFrom', 'clip.clipURI'];
+
+    return {
+        tick: {
+            params: ['currentSegmentId', 'playbackRate', 'currentPlaybackPosition', 'minManifestPosition', 'maxManifestPosition', 'preloadThreshold'],
+            fields: SEEKBAR_TIME_FIELDS.concat(['isClipChanged', 'minRenderingTime', 'maxRenderingTime', 'isPreloadThresholdReached', 'playlistVersion'])
+        },
+        manifestToSeekbarTime: {
+            params: ['currentSegmentId', 'playbackRate', 'currentPlaybackPosition', 'minManifestPosition', 'maxManifestPosition'],
+            fields: SEEKBAR_TIME_FIELDS
+        },
+        manifestToLinearTime: {
+            params: ['currentSegmentId', 'currentPlaybackPosition'],
+            fields: null
+        },
+        onEndOfMedia: {
+            params: ['currentSegmentId', 'currentPlaybackPosition', 'currentPlaybackRate', 'isNotPlayed', 'isEndOfSequence'],
+            fields: PLAYBACK_SEGMENT_FIELDS
+        },
+        onEndOfBuffering: {
+            params: ['currentSegmentId', 'currentPlaybackPosition', 'currentPlaybackRate'],
+            fields: PLAYBACK_SEGMENT_FIELDS
+        },
+        seekFromSeekbarPosition: {
+            params: ['seekbarSeekPosition', 'currentSegmentId'],
+            fields: PLAYBACK_SEGMENT_FIELDS
+        },
+        submitScrubPosition: {
+            params: ['scrubId', 'seekbarSeekPosition'],
+            fields: null
+        }
+    };
+}());
+
+//
+// -------------------------
+// Sequencer plugin chain
+// -------------------------
+//
+PLAYER_SEQUENCER.createSequencerPluginChain = function ( sequentialPlaylistAccessContext, playbackSegmentPoolContext ) {
+    ///<summary>Create a sequencer plugin chain object with all the methods for accessing the chain instance.</summary>
+    ///<param name="sequentialPlaylistAccessContext" type="Object">The object with methods for accessing the Scheduler sequentialPlaylist instance to be used by this plugin chain.</param>
+    ///<param name="playbackSegmentPoolContext" type="Object" optional="true">The playback segment pool to be used by this plugin chain (the playbackSegmentPool singleton if not given).</param>
+    ///<returns type="Object">A new sequencer plugin factory object with methods for creating new pass-through plugins and using the chain.</returns>
+    "use strict";
+
+    var sequentialPlaylistAccess = sequentialPlaylistAccessContext,
+        playbackSegmentPool = playbackSegmentPoolContext || PLAYER_SEQUENCER.playbackSegmentPool,
+        firstSequencer = null,
+        plugins = [],               // { name, plugin, passThroughs, resolved } for each plugin, first in chain first
+        dispatchTable = {},         // method -> the first plugin in the chain which overrides it
+        isDispatchTableValid = false,
+
+    // NOTE: The methods of the plugin "interface definition" below which pass through to the next sequencer.
+    //       A plugin overrides one of them when its method is no longer the pass-through it was created with.
+    PASS_THROUGH_METHODS = ['manifestToSeekbarTime', 'tick', 'manifestToLinearTime', 'seekFromLinearPosition', 'seekFromSeekbarPosition',
+        'onEndOfMedia', 'onEndOfBuffering', 'onError', 'getUpcomingSegments', 'releasePlaybackSegment',
+        'beginScrub', 'submitScrubPosition', 'commitScrub', 'cancelScrub', 'seekSkippingAds', 'testProbe'],
+
+    // private methods
+    buildDispatchTable = function () {
+        ///<summary>Resolve, for the chain and for each plugin, the first plugin (after it) which overrides each method, so a call
+        ///         reaches the overriding plugin in one hop instead of walking the pass-through closures of the plugins in between.</summary>
+        var nearest = {},
+            entry,
+            method,
+            i,
+            j;
+
+        for (i = plugins.length - 1; i >= 0; i -= 1) {
+            entry = plugins[i];
+            entry.resolved = {};
+            for (j = 0; j < PASS_THROUGH_METHODS.length; j += 1) {
+                method = PASS_THROUGH_METHODS[j];
+                if (nearest.hasOwnProperty(method)) {
+                    entry.resolved[method] = nearest[method];
+                }
+                if (entry.plugin[method] !== entry.passThroughs[method]) {
+                    nearest[method] = entry.plugin;
+                }
+            }
+        }
+        dispatchTable = nearest;
+        isDispatchTableValid = true;
+    },
+
+    dispatch = function ( method ) {
+        ///<summary>Get the plugin to invoke a method of the chain on: the first which overrides it, or the first in the chain for any other method</summary>
+        if (!isDispatchTableValid) {
+            buildDispatchTable();
+        }
+        return dispatchTable.hasOwnProperty(method) ? dispatchTable[method] : firstSequencer;
+    },
+
+    compactCommands = (function () {
+        // the runCompact commands with the names of their result fields resolved to property paths once
+        var commands = {},
+            func,
+            i;
+
+        for (func in PLAYER_SEQUENCER.compactCommands) {
+            if (PLAYER_SEQUENCER.compactCommands.hasOwnProperty(func)) {
+                commands[func] = { params: PLAYER_SEQUENCER.compactCommands[func].params, paths: null };
+                if (PLAYER_SEQUENCER.compactCommands[func].fields) {
+                    commands[func].paths = [];
+                    for (i = 0; i < PLAYER_SEQUENCER.compactCommands[func].fields.length; i += 1) {
+                        commands[func].paths.push(PLAYER_SEQUENCER.compactCommands[func].fields[i].split('.'));
+                    }
+                }
+            }
+        }
+        return commands;
+    }()),
+
+    encodeCompactResult = function ( command, result ) {
+        ///<summary>Encode a result as the comma separated tuple of the result fields of its compact command</summary>
+        var tuple = '',
+            value,
+            i,
+            j;
+
+        if (!command.paths) {
+            return String(result);
+        }
+        if (result === null || result === undefined) {
+            return 'null';
+        }
+        for (i = 0; i < command.paths.length; i += 1) {
+            value = result;
+            for (j = 0; j < command.paths[i].length && value !== null && value !== undefined; j += 1) {
+                value = value[command.paths[i][j]];
+            }
+            if (i > 0) {
+                tuple += ',';
+            }
+            if (typeof value === 'boolean') {
+                tuple += value ? '1' : '0';
+            }
+            else if (typeof value === 'number' || typeof value === 'string') {
+                tuple += value;
+            }
+        }
+        return tuple;
+    };
+    
+    return {
+        //
+        // Sequencer plugin factory object
+        // This factory creates a pass-through object which defines all the methods
+        //     a sequencer plugin must either override or allow to be passed through.
+        // This could be thought of as the "interface definition" for a sequencer plug-in implementation.
+        // Note that the prototype for the object created is simply that of Object.
+        //
+        
+        createSequencerPlugin: function ( pluginName ) {
+            ///<summary>Create a pass-through plugin object which defines all the methods a sequencer plugin can override.</summary>
+            ///<param name="pluginName" type="String" optional="true">The name of the plugin in metrics (plugin followed by its creation index if not given).</param>
+            ///<returns type="Object">A new sequencer plugin pass-through object.</returns>
+            ///<remarks>Assign the method overrides right after this returns: the chain resolves which plugin overrides each method once, on its next call. Replacing an override with another one later takes effect at once, but a method which was still the pass-through then and is overridden later (such as a plugin switching its implementation at run time) is skipped by the calls of the chain and of the plugins before it until rebuildDispatchTable is called.</remarks>
+            var nextSequencer = null,
+                entry = { name: pluginName ? String(pluginName) : 'plugin' + plugins.length.toString(), plugin: null, passThroughs: {}, resolved: {} },
+                i,
+
+            dispatchNext = function ( method ) {
+                // the first plugin after this one which overrides the method, or the next one if none does
+                if (!isDispatchTableValid) {
+                    buildDispatchTable();
+                }
+                return entry.resolved[method] || nextSequencer;
+            },
+        
+            newSequencer = {
+                getNextSequencer: function () {
+                    ///<summary>Get the hidden nextSequencer value so method overrides can conditionally pass through to the next sequencer.</summary>
+                    ///<returns type="Object">A reference to the next sequencer in the plugin chain.</returns>
+                    return nextSequencer;
+                },
+
+                getSequentialPlaylistAccess: function () {
+                    ///<summary>Get the hidden sequentialPlaylistAccess value so method overrides can access the correct sequentialPlaylist.</summary>
+                    ///<returns type="Object">A reference to the sequentialPlaylist.access object for this plugin chain.</returns>
+                    return sequentialPlaylistAccess;
+                },
+
+                getPlaybackSegmentPool: function () {
+                    ///<summary>Get the hidden playbackSegmentPool value so method overrides can access the correct playback segments.</summary>
+                    ///<returns type="Object">A reference to the playback segment pool for this plugin chain.</returns>
+                    return playbackSegmentPool;
+                },
+
+                getFirstSequencer: function () {
+                    ///<summary>Get the first sequencer in the plugin chain so method overrides can invoke other methods through the whole chain.</summary>
+                    ///<returns type="Object">A reference to the first sequencer in the plugin chain.</returns>
+                    return firstSequencer;
+                },
+
+                manifestToSeekbarTime: function ( params ) {
+                    ///<summary>Convert manifest time to seekbar time. Should be called several times per second to keep seekbar updated and catch playlist changes.</summary>
+                    ///<param name="params" type="Object">An object with properties: currentSegmentId, playbackRate, currentPlaybackPosition</param>
+                    ///<returns type="Object">An object with properties: currentSeekbarPosition, minSeekbarPosition, maxSeekbarPosition, playbackPolicy, playbackRangeExceeded</returns>
+                    return dispatchNext('manifestToSeekbarTime').manifestToSeekbarTime( params );
+                },
+        
+                tick: function ( params ) {
+                    ///<summary>Periodic playback update combining isClipChanged, manifestToSeekbarTime and the current clip rendering range in one call. Should be called several times per second instead of manifestToSeekbarTime.</summary>
+                    ///<param name="params" type="Object">An object with properties: currentSegmentId, playbackRate, currentPlaybackPosition, preloadThreshold (optional time before the end of the clip to start preloading, in seconds or in ticks after scheduler.setTimescale)</param>
+                    ///<returns type="Object">An object with the manifestToSeekbarTime properties plus: isClipChanged, minRenderingTime, maxRenderingTime, isPreloadThresholdReached, playlistVersion (the sequentialPlaylist version, unchanged if nothing was scheduled or removed)</returns>
+                    return dispatchNext('tick').tick( params );
+                },
+
+                manifestToLinearTime: function ( params ) {
+                    ///<summary>Convert manifest time to linear time. Used to determine where to resume from last played position.</summary>
+                    ///<param name="params" type="Object">An object with properties: currentSegmentId, currentPlaybackPosition (in manifest time)</param>
+                    ///<returns type="Object">An object with properties: linearPosition, isOnLinearTimeline</returns>
+                    return dispatchNext('manifestToLinearTime').manifestToLinearTime( params );
+                },
+        
+                seekFromLinearPosition: function ( params ) {
+                    ///<summary>Seek to linear time. Used to resume from last played position (no currentSegmentId given0 or to seek out of a zero-linear-duration currentSegmentId.</summary>
+                    ///<param name="params" type="Object">An object with properties: currentSegmentId (optional), linearSeekPosition</param>
+                    ///<returns type="Object">A playback segment object reference</returns>
+                    return dispatchNext('seekFromLinearPosition').seekFromLinearPosition( params );
+                },
+        
+                seekFromSeekbarPosition: function ( params ) {
+                    ///<summary>Seek to a position relative to the current playback segment seekbar range.</summary>
+                    ///<param name="params" type="Object">An object with properties: currentSegmentId, seekbarSeekPosition</param>
+                    ///<returns type="Object">A playback segment object reference (may be same as that for currentSegmentId)</returns>
+                    return dispatchNext('seekFromSeekbarPosition').seekFromSeekbarPosition( params );
+                },
+        
+                onEndOfMedia: function ( params ) {
+                    ///<summary>Notify end of playing the current playback segment to get a new playback segment object for the next segment in the sequence. The Scheduler is notified the playlist entry for the current playback segment has been played.</summary>
+                    ///<param name="params" type="Object">An object with properties: currentSegmentId, currentPlaybackPosition (in manifest time), currentPlaybackRate, isNotPlayed, isEndOfSequence</param>
+                    ///<returns type="Object" mayBeNull="true">The new playback segment object reference (null when at end of list)</returns>
+                    return dispatchNext('onEndOfMedia').onEndOfMedia( params );
+                },
+        
+                onEndOfBuffering: function ( params ) {
+                    ///<summary>Notify end of buffering the playback segment to get a new playback segment object for the next segment in the sequence to buffer. The Scheduler is NOT notified the playlist entry for the current playback segment has been played.</summary>
+                    ///<param name="params" type="Object">An object with properties: currentSegmentId, currentPlaybackPosition (in manifest time), currentPlaybackRate</param>
+                    ///<returns type="Object" mayBeNull="true">The new playback segment object reference (null when at end of list)</returns>
+                    return dispatchNext('onEndOfBuffering').onEndOfBuffering( params );
+                },
+        
+                onError: function ( params ) {
+                    ///<summary>Notify playback error to get a new playback segment object for the next segment in the sequence to use after an error.</summary>
+                    ///<param name="params" type="Object">An object with properties: currentSegmentId, currentPlaybackPosition (in manifest time), currentPlaybackRate, isNotPlayed, isEndOfSequence, errorDescription</param>
+                    ///<returns type="Object" mayBeNull="true">The new playback segment object reference (null when sequence is terminated)</returns>
+                    return dispatchNext('onError').onError( params );
+                },
+
+                getUpcomingSegments: function ( params ) {
+                    ///<summary>Look ahead in play order from the current playback segment without side effects: no playback segment is created and no playlist entry is marked played, so the result can be used to plan buffering of several segments ahead.</summary>
+                    ///<param name="params" type="Object">An object with properties: currentSegmentId, currentPlaybackPosition (optional, in manifest time; defaults to the start of the current segment in the playback direction), currentPlaybackRate, maxCount (optional), horizon (optional rendering time ahead of currentPlaybackPosition, in seconds or in ticks after scheduler.setTimescale). At least one of maxCount and horizon should be given; with neither, one segment is returned.</param>
+                    ///<returns type="Array">An array, in play order, of objects with the playback segment properties clip, initialPlaybackStartTime and initialPlaybackRate (but no segmentId) plus startOffset (rendering time from currentPlaybackPosition until the segment starts, in the units of horizon)</returns>
+                    return dispatchNext('getUpcomingSegments').getUpcomingSegments( params );
+                },
+
+                releasePlaybackSegment: function ( params ) {
+                    ///<summary>Release a playback segment which is dropped without reaching its end, such as a preloaded segment invalidated by a seek.</summary>
+                    ///<param name="params" type="Object">An object with properties: currentSegmentId</param>
+                    ///<returns type="Boolean">true when the segment was released</returns>
+                    return dispatchNext('releasePlaybackSegment').releasePlaybackSegment( params );
+                },
+
+                beginScrub: function ( params ) {
+                    ///<summary>Begin a scrub (seekbar drag) session. The positions submitted during the scrub are only recorded, and a single seek to the last one is made by commitScrub. Beginning a new scrub cancels the one in progress.</summary>
+                    ///<param name="params" type="Object">An object with properties: currentSegmentId, currentPlaybackPosition (optional, in manifest time; defaults to the start of the current segment)</param>
+                    ///<returns type="Number">The scrubId to pass to the other scrub methods</returns>
+                    return dispatchNext('beginScrub').beginScrub( params );
+                },
+
+                submitScrubPosition: function ( params ) {
+                    ///<summary>Record the latest position of a scrub. No playback segment is created and the playlist is not searched, so it can be called for every seekbar move.</summary>
+                    ///<param name="params" type="Object">An object with properties: scrubId, seekbarSeekPosition</param>
+                    ///<returns type="Number">The number of positions submitted so far in the scrub</returns>
+                    return dispatchNext('submitScrubPosition').submitScrubPosition( params );
+                },
+
+                commitScrub: function ( params ) {
+                    ///<summary>End a scrub by seeking to its last submitted position, as seekFromSeekbarPosition through the whole chain. Exactly one playback segment is created (none if no position was submitted) and the scrub current segment is released.</summary>
+                    ///<param name="params" type="Object">An object with properties: scrubId, currentSegmentId (optional), eSkippedAdPolicy (optional, applied to the ads skipped over as for seekSkippingAds)</param>
+                    ///<returns type="Object">An object with properties: segment (the new playback segment object reference, null if no position was submitted), crossedAdEntryIds (the ids of the advertisement playlist entries between the scrub start and end positions, in the seek direction), submittedCount; plus the seekSkippingAds result properties when eSkippedAdPolicy is given</returns>
+                    return dispatchNext('commitScrub').commitScrub( params );
+                },
+
+                cancelScrub: function ( params ) {
+                    ///<summary>End a scrub without seeking.</summary>
+                    ///<param name="params" type="Object">An object with properties: scrubId</param>
+                    ///<returns type="Boolean">true when the scrub was in progress</returns>
+                    return dispatchNext('cancelScrub').cancelScrub( params );
+                },
+
+                seekSkippingAds: function ( params ) {
+                    ///<summary>Seek as seekFromSeekbarPosition and apply a policy to the ad breaks skipped over by a forward seek, removing the ads marked played and welding back their content in a single pass. With 'PlayLast' or 'PlayAll' the segment returned is the first ad to play, and playback resumes at the seek position after the last one.</summary>
+                    ///<param name="params" type="Object">An object with properties: currentSegmentId, currentPlaybackPosition (optional, in manifest time; defaults to the start of the current segment), seekbarSeekPosition, eSkippedAdPolicy ('PlayLast': play the last break skipped and mark the others played, 'PlayAll': play all the breaks skipped in order, 'MarkPlayed': play none and mark them all played)</param>
+                    ///<returns type="Object">An object with properties: segment (the new playback segment object reference), crossedAdEntryIds (the ids of the ads skipped over, in the seek direction), queuedAdEntryIds (the ids of the ads to be played before resuming, in play order), markedPlayedAdEntryIds, removedEntryIds (the ids of the playlist entries taken out: the ads marked played with deleteAfterPlay set and the content welded back)</returns>
+                    return dispatchNext('seekSkippingAds').seekSkippingAds( params );
+                },
+
+                testProbe: function ( params ) {
+                    ///<summary>For testing purposes: generic invocation of a test probe. This is a "tunneling" mechanism for a private contract between the caller and a specific sequencer plugin.</summary>
+                    ///<param name="params" type="Object">An object with properties dependent upon the specific probe to be performed.</param>
+                    ///<returns mayBeNull="true">An object of type and value dependent upon the specific probe that was performed.</returns>
+                    return dispatchNext('testProbe').testProbe( params );
+                }
+            }; // end of newSequencer
+            
+            nextSequencer = firstSequencer;
+            firstSequencer = newSequencer;
+            entry.plugin = newSequencer;
+            for (i = 0; i < PASS_THROUGH_METHODS.length; i += 1) {
+                entry.passThroughs[PASS_THROUGH_METHODS[i]] = newSequencer[PASS_THROUGH_METHODS[i]];
+            }
+            plugins.unshift(entry);
+            // Note: the overrides are assigned after this returns, so the dispatch table is rebuilt on the next call.
+            //       Later replacements need rebuildDispatchTable, see the remarks above.
+            isDispatchTableValid = false;
+
+            return newSequencer;
+        },
+
+        getSequencerPlugins: function () {
+            ///<summary>Get the plugins of the chain, such as for instrumentation.</summary>
+            ///<returns type="Array">An array of objects with properties: name, plugin (the plugin object), first in chain first.</returns>
+            var result = [],
+                i;
+
+            for (i = 0; i < plugins.length; i += 1) {
+                result.push({ name: plugins[i].name, plugin: plugins[i].plugin });
+            }
+            return result;
+        },
+
+        rebuildDispatchTable: function () {
+            ///<summary>Rebuild the dispatch table after overriding a plugin method which was still the pass-through when the chain was last called (such as a plugin switching its implementation at run time). Adding a plugin rebuilds it automatically.</summary>
+            buildDispatchTable();
+        },
+        
+        getFirstSequencer: function () {
+            ///<summary>Get a reference to the first sequencer in the plugin chain. This should always be used for all sequencer plugin method invocations.</summary>
+            ///<returns type="Object">A reference to the first sequencer in the plugin chain.</returns>
+            return firstSequencer;
+        },
+
+        runJSON: function ( paramsJSON ) {
+            ///<summary>Invoke a sequencer plugin method using a JSON string and returning the result as a JSON string.</summary>
+            ///<param name="paramsJSON" type="String">The method name and params expressed in a JSON string. There must be a top level property "func" string with the name of the method to invoke. Method params can either be all top level or within a containing "params" object. An optional top level "fields" array of dotted field paths limits the result to those fields, such as ["segmentId", "clip.id"].</param>
+            ///<returns type="String">The method results expressed is a JSON string. If an exception was thrown, a top level object "EXCEPTION" will contain standard Error fields.</returns>
+
+            var params, result;
+
+            try {
+                params = JSON.parse(paramsJSON);
+
+                if (!params || (typeof params.func !== 'string')) {
+                    throw new PLAYER_SEQUENCER.SequencerError('runJSON func property missing or not a string');
+                }
+
+                if (params.params) {
+                    result = dispatch(params.func)[params.func](params.params);
+                }
+                else {
+                    result = dispatch(params.func)[params.func](params);
+                }
+            }
+            catch (ex) {
+                return PLAYER_SEQUENCER.exceptionToJSON(ex);
+            }
+            return PLAYER_SEQUENCER.stringifyResult(result, params.fields);
+        },
+
+        runCompact: function ( func ) {
+            ///<summary>Invoke one of the frequently called sequencer plugin methods with positional arguments, returning the result as a fixed layout comma separated tuple. This avoids the JSON encoding and decoding of runJSON on the hot playback path.</summary>
+            ///<param name="func" type="String">The method name: tick, manifestToSeekbarTime, manifestToLinearTime, onEndOfMedia, onEndOfBuffering, seekFromSeekbarPosition or submitScrubPosition. The method params follow as additional arguments in the order of the PLAYER_SEQUENCER.compactCommands params.</param>
+            ///<returns type="String">The method results as a comma separated tuple of the PLAYER_SEQUENCER.compactCommands fields ("null" for a null playback segment). If an exception was thrown, the same "EXCEPTION" JSON string as runJSON.</returns>
+            var command = compactCommands.hasOwnProperty(func) ? compactCommands[func] : null,
+                params = {},
+                i;
+
+            try {
+                if (!command) {
+                    throw new PLAYER_SEQUENCER.SequencerError('runCompact unsupported func: ' + func);
+                }
+                for (i = 0; i < command.params.length; i += 1) {
+                    params[command.params[i]] = arguments[i + 1];
+                }
+                return encodeCompactResult(command, dispatch(func)[func](params));
+            }
+            catch (ex) {
+                return PLAYER_SEQUENCER.exceptionToJSON(ex);
+            }
+        }
+    };
+};
+
+// ------------------------------------------------------------------------------------------------
+// Default (last in chain) sequencer
+// ------------------------------------------------------------------------------------------------
+
+PLAYER_SEQUENCER.createDefaultSequencerPlugin = function (basePlugin) {
+"use strict";
+
+    // private variables and methods
+    var mySequentialPlaylist = basePlugin.getSequentialPlaylistAccess(),
+        myPlaybackSegmentPool = basePlugin.getPlaybackSegmentPool(),
+        myScrub = null,             // the scrub in progress: { scrubId, currentSegmentId, startPosition, isOnLinearTimeline, lastPosition, submittedCount }
+        myLastScrubId = 0,
+        mySkippedAds = null,        // the ads queued by a seek to be played before resuming: { adIds, resumePosition }
+        SKIPPED_AD_POLICIES = { PlayLast: true, PlayAll: true, MarkPlayed: true },
+
+    myGetScrub = function ( scrubId, callerName ) {
+        if (!myScrub || myScrub.scrubId !== scrubId) {
+            throw new PLAYER_SEQUENCER.SequencerError(callerName + ' invalid scrubId: ' + String(scrubId));
+        }
+        return myScrub;
+    },
+
+    myGetCrossedAdEntryIds = function ( fromPosition, toPosition, landedEntry ) {
+        // The ids of the advertisement entries starting after fromPosition up to toPosition (or the reverse
+        // when seeking backward), in the seek direction. The entry the seek landed on is not crossed.
+        // Note: entries before the live window start may already be evicted
+        var lowPosition = Math.max(Math.min(fromPosition, toPosition), mySequentialPlaylist.getWindowStart()),
+            highPosition = Math.max(fromPosition, toPosition),
+            entry = mySequentialPlaylist.getEntryAtTime(lowPosition),
+            crossedIds = [];
+
+        while (entry && entry.linearStartTime <= highPosition) {
+            if (entry.isAdvertisement && entry.linearStartTime > lowPosition && entry !== landedEntry) {
+                crossedIds.push(entry.id);
+            }
+            entry = mySequentialPlaylist.getEntryAfterId(entry.id);
+        }
+        if (toPosition < fromPosition) {
+            crossedIds.reverse();
+        }
+        return crossedIds;
+    },
+
+    myValidateSkippedAdPolicy = function ( eSkippedAdPolicy, callerName ) {
+        if (!SKIPPED_AD_POLICIES.hasOwnProperty(eSkippedAdPolicy)) {
+            throw new PLAYER_SEQUENCER.SequencerError(callerName + ' invalid eSkippedAdPolicy: ' + String(eSkippedAdPolicy));
+        }
+    },
+
+    myGetIds = function ( entries ) {
+        var ids = [],
+            i;
+
+        for (i = 0; i < entries.length; i += 1) {
+            ids.push(entries[i].id);
+        }
+        return ids;
+    },
+
+    mySeekSkippingAds = function ( currentSegmentId, fromPosition, toPosition, eSkippedAdPolicy, callerName ) {
+        // Seek on the linear timeline and apply eSkippedAdPolicy to the ads crossed. A break is the crossed ads
+        // with the same start time. The ads crossed by a backward seek were already passed, they are left as they are.
+        var currentSegment = myPlaybackSegmentPool.getPlaybackSegment(currentSegmentId),
+            landedEntry,
+            crossedIds,
+            crossedEntries = [],
+            lastBreakIndex = 0,         // the index in crossedEntries of the first ad of the last break
+            queuedEntries = [],
+            markedEntries = [],
+            removedEntries,
+            segment,
+            entry,
+            i;
+
+        toPosition = Math.max(toPosition, 0, mySequentialPlaylist.getWindowStart());
+        landedEntry = mySequentialPlaylist.getEntryAtTime(toPosition);
+        if (!landedEntry) {
+            throw new PLAYER_SEQUENCER.SequencerError(callerName + ' outside playlist range');
+        }
+
+        crossedIds = myGetCrossedAdEntryIds(fromPosition, toPosition, landedEntry);
+        for (i = 0; i < crossedIds.length; i += 1) {
+            entry = mySequentialPlaylist.getEntryFromId(crossedIds[i]);
+            // Note: the ads after the one landed on in its break are played next anyway, they are not skipped
+            if (!landedEntry.isAdvertisement || !mySequentialPlaylist.isSameTime(entry.linearStartTime, landedEntry.linearStartTime)) {
+                if (crossedEntries.length > 0 && !mySequentialPlaylist.isSameTime(entry.linearStartTime, crossedEntries[crossedEntries.length - 1].linearStartTime)) {
+                    lastBreakIndex = crossedEntries.length;
+                }
+                crossedEntries.push(entry);
+            }
+        }
+
+        if (fromPosition < toPosition) {
+            switch (eSkippedAdPolicy) {
+                case 'PlayLast':
+                    // Note: the break landed on is the last one played
+                    if (landedEntry.isAdvertisement) {
+                        lastBreakIndex = crossedEntries.length;
+                    }
+                    markedEntries = crossedEntries.slice(0, lastBreakIndex);
+                    queuedEntries = crossedEntries.slice(lastBreakIndex);
+                    break;
+
+                case 'PlayAll':
+                    queuedEntries = crossedEntries;
+                    break;
+
+                default:
+                    markedEntries = crossedEntries;
+                    break;
+            }
+        }
+
+        // all the skipped ads are taken out before the seek so it lands on the welded content
+        removedEntries = mySequentialPlaylist.onPlayedEntries(markedEntries);
+
+        if (queuedEntries.length > 0) {
+            segment = myPlaybackSegmentPool.createPlaybackSegment(queuedEntries[0], queuedEntries[0].minRenderingTime, currentSegment.initialPlaybackRate);
+            myPlaybackSegmentPool.releasePlaybackSegment(currentSegmentId);
+            mySkippedAds = { adIds: myGetIds(queuedEntries), resumePosition: toPosition };
+        } else {
+            // Note: go through the whole chain so any plugin overriding seekFromSeekbarPosition is used
+            segment = basePlugin.getFirstSequencer().seekFromSeekbarPosition({
+                currentSegmentId: currentSegmentId,
+                seekbarSeekPosition: toPosition
+            });
+        }
+
+        return {
+            segment: segment,
+            crossedAdEntryIds: myGetIds(crossedEntries),
+            queuedAdEntryIds: myGetIds(queuedEntries),
+            markedPlayedAdEntryIds: myGetIds(markedEntries),
+            removedEntryIds: myGetIds(removedEntries)
+        };
+    },
+
+    myGetSkippedAdsNext = function ( entry ) {
+        // When entry is one of the ads queued by mySeekSkippingAds, the entry to play after it and the rendering
+        // time to start at: the next queued ad, or the seek position after the last one. null otherwise.
+        var i = mySkippedAds ? mySkippedAds.adIds.indexOf(entry.id) : -1,
+            nextEntry;
+
+        if (i < 0) {
+            return null;
+        }
+        if (i + 1 < mySkippedAds.adIds.length) {
+            nextEntry = mySequentialPlaylist.getEntryFromId(mySkippedAds.adIds[i + 1]);
+            return { entry: nextEntry, initialPlaybackStartTime: nextEntry.minRenderingTime };
+        }
+        nextEntry = mySequentialPlaylist.getEntryAtTime(mySkippedAds.resumePosition);
+        if (!nextEntry) {
+            return null;
+        }
+        return {
+            entry: nextEntry,
+            initialPlaybackStartTime: nextEntry.minRenderingTime +
+                (nextEntry.linearDuration > 0 ? mySkippedAds.resumePosition - nextEntry.linearStartTime : 0)
+        };
+    },
+
+    myProjectWeldedEntry = function ( headEntry, tailEntry ) {
+        // A copy of the playlist entry sequentialPlaylist.change.remove will make by welding tailEntry onto headEntry.
+        // NOTE: The linearDuration of the removed entries in between is not added, they are zero for pause timeline ads.
+        return {
+            clipURI: headEntry.clipURI,
+            eClipType: headEntry.eClipType,
+            linearStartTime: headEntry.linearStartTime,
+            linearDuration: headEntry.linearDuration + tailEntry.linearDuration,
+            minRenderingTime: headEntry.minRenderingTime,
+            maxRenderingTime: tailEntry.maxRenderingTime,
+            isAdvertisement: headEntry.isAdvertisement,
+            playbackPolicyObj: headEntry.playbackPolicyObj,
+            deleteAfterPlay: headEntry.deleteAfterPlay,
+            id: headEntry.id,
+            idSplitFrom: headEntry.idSplitFrom,
+            splitCount: headEntry.splitCount + 1
+        };
+    },
+
+    myOnEnd = function ( params, isEndOfMedia ) {
+        /* params:
+        currentSegmentId            // number: the unique Id for the playback segment
+        currentPlaybackPosition     // number: the current playback position in manifest time
+        currentPlaybackRate         // number: the current playback rate
+        isNotPlayed                 // boolean: suppress any "is played" processing
+        isEndOfSequence             // boolean: do not create a new playbackSegment
+        */
+        var entry = myPlaybackSegmentPool.getPlaybackSegment(params.currentSegmentId).clip,
+            isBehindWindow = mySequentialPlaylist.isEntryBeforeWindow(entry),
+            nextEntry,
+            skippedAdsNext = null,
+            newSegment = null,
+            isPlayForward = 0 <= params.currentPlaybackRate,
+            currentLinearPosition,
+            initialPlaybackStartTime;
+        
+        if (isBehindWindow && (!isEndOfMedia || !params.isEndOfSequence)) {
+            // the entry slid out of the live window and may be evicted: continue from the window start, or
+            // end the sequence when playing backward since nothing is left before it
+            currentLinearPosition = mySequentialPlaylist.getWindowStart();
+            nextEntry = isPlayForward ? mySequentialPlaylist.getEntryAtTime(currentLinearPosition) : null;
+            if (nextEntry) {
+                initialPlaybackStartTime = nextEntry.minRenderingTime + Math.max(0, currentLinearPosition - nextEntry.linearStartTime);
+                newSegment = myPlaybackSegmentPool.createPlaybackSegment(nextEntry, initialPlaybackStartTime, params.currentPlaybackRate);
+            }
+        } else if (!isEndOfMedia || !params.isEndOfSequence) {
+            skippedAdsNext = isPlayForward ? myGetSkippedAdsNext(entry) : null;
+            if (skippedAdsNext) {
+                nextEntry = skippedAdsNext.entry;
+            } else {
+                nextEntry = isPlayForward ? mySequentialPlaylist.getEntryAfterId(entry.id) : mySequentialPlaylist.getEntryBeforeId(entry.id);
+            }
+        }
+        // nextEntry is defined to be falsey when getEntryAfter/BeforeId runs off the end of the playlist
+        if (nextEntry && !newSegment) {
+            if (skippedAdsNext) {
+                initialPlaybackStartTime = skippedAdsNext.initialPlaybackStartTime;
+            } else {
+                initialPlaybackStartTime = isPlayForward ? nextEntry.minRenderingTime : nextEntry.maxRenderingTime;
+            }
+            newSegment = myPlaybackSegmentPool.createPlaybackSegment(nextEntry, initialPlaybackStartTime, params.currentPlaybackRate);
+        }
+
+        if (isEndOfMedia) {
+            if (mySkippedAds && entry.id === mySkippedAds.adIds[mySkippedAds.adIds.length - 1]) {
+                // the last queued ad has been played, playback resumes at the seek position
+                mySkippedAds = null;
+            }
+            // Note: an entry behind the live window is evicted already or will be, instead of removed as played
+            if (!params.isNotPlayed && !isBehindWindow) {
+                mySequentialPlaylist.onPlayedEntry(entry);
+            }
+            myPlaybackSegmentPool.releasePlaybackSegment(params.currentSegmentId);
+
+            // if onPlayedEntry caused welding of nextEntry
+            if (nextEntry && newSegment.isClipChanged) {
+                // switch nextEntry to the playlist entry for the linear start time of the welded entry
+                currentLinearPosition = nextEntry.linearStartTime;
+                nextEntry = mySequentialPlaylist.getEntryAtTime(currentLinearPosition);
+                if (!nextEntry) {
+                    throw new PLAYER_SEQUENCER.SequencerError('myOnEnd failed to find anealed playlist entry at time ' + currentLinearPosition.toString());
+                }
+                // replace newSegment clip with the new playlist entry
+                newSegment.clip = nextEntry;
+            }
+        }
+
+        return newSegment;
+    };
+
+    // Replace the default pass-through methods
+    // NOTE: Any that are missed (or mis-spelled) will cause an exception when
+    //       the default pass-through uses its null 'nextSequencer' value.
+    
+    basePlugin.manifestToSeekbarTime = function ( params ) {
+        /* params:
+        currentSegmentId,           // number: the unique Id for the playback segment
+        playbackRate,               // number: the current playback rate
+        currentPlaybackPosition,    // number: the current position in manifest time
+        */
+        var currentSegment = myPlaybackSegmentPool.getPlaybackSegment(params.currentSegmentId),
+            entry = currentSegment.clip,
+            playbackRate = params.playbackRate,
+            currentPlaybackPosition = params.currentPlaybackPosition,
+            minManifestPosition = entry.minRenderingTime,
+            maxManifestPosition = entry.maxRenderingTime,
+            currentSeekbarPosition = currentPlaybackPosition - minManifestPosition,
+            minSeekbarPosition = 0,
+            maxSeekbarPosition = 0,
+            playbackPolicy = null,
+            playbackRangeExceeded = false,
+            updatedEntry;
+
+        if (currentSegment.clip.isAdvertisement) {
+            playbackPolicy = entry.playbackPolicyObj;
+            maxSeekbarPosition = maxManifestPosition - minManifestPosition;
+            // an ad which slid out of the live window may have been evicted
+            playbackRangeExceeded = mySequentialPlaylist.isEntryBeforeWindow(entry);
+
+            // currentSegment.isClipChanged cannot happen for an ad
+            
+            // clamp currentSeekbarPosition within min/max
+            if (currentSeekbarPosition < minSeekbarPosition) {
+                currentSeekbarPosition = minSeekbarPosition;
+            }
+            else if (maxSeekbarPosition < currentSeekbarPosition) {
+                currentSeekbarPosition = maxSeekbarPosition;
+            }
+        }
+        else {
+            // for non-ad the seekbar range is the playlist (min is zero except for a live window)
+            minSeekbarPosition = mySequentialPlaylist.getWindowStart();
+            maxSeekbarPosition = mySequentialPlaylist.getPlaylistLinearDuration();
+            currentSeekbarPosition += entry.linearStartTime;
+
+            if (currentSeekbarPosition < minSeekbarPosition) {
+                // playback fell behind the live window start, where the entry may have been evicted
+                playbackRangeExceeded = true;
+            }
+            else if (currentSegment.isClipChanged) {
+                updatedEntry = mySequentialPlaylist.getEntryAtTime(currentSeekbarPosition);
+                if (!updatedEntry) {
+                    throw new PLAYER_SEQUENCER.SequencerError(
+                        'manifestToSeekbarTime failed to find anealed playlist entry at time ' + currentSeekbarPosition.toString());
+                }
+                if (currentSegment.clip.idSplitFrom === updatedEntry.idSplitFrom) {
+                    // Replace currentSegment clip with the new welded/split playlist entry.
+                    currentSegment.clip = updatedEntry;
+                    // Note: the currentSeekbarPosition must be within range since the updatedEntry contains it.
+                } else {
+                    // currentPlaybackPosition changed to a different idSplitFrom clip
+                    playbackRangeExceeded = true;
+                }
+            }
+        }
+
+        if (!updatedEntry && 
+            ((playbackRate < 0 && currentPlaybackPosition < minManifestPosition) ||
+            (playbackRate >= 0 && maxManifestPosition < currentPlaybackPosition))) {
+            playbackRangeExceeded = true;
+        }
+
+        return {
+            currentSeekbarPosition: currentSeekbarPosition,
+            minSeekbarPosition: minSeekbarPosition,
+            maxSeekbarPosition: maxSeekbarPosition,
+            playbackPolicy: playbackPolicy,
+            playbackRangeExceeded: playbackRangeExceeded
+        };
+    };
+
+    basePlugin.tick = function ( params ) {
+        /* params:
+        currentSegmentId,           // number: the unique Id for the playback segment
+        playbackRate,               // number: the current playback rate
+        currentPlaybackPosition,    // number: the current position in manifest time
+        preloadThreshold            // number: optional time before the end of the clip at which the next segment should be preloaded
+        */
+        var currentSegment = myPlaybackSegmentPool.getPlaybackSegment(params.currentSegmentId),
+            isClipChanged = currentSegment.isClipChanged,
+            // Note: go through the whole chain so any plugin overriding manifestToSeekbarTime is used
+            result = basePlugin.getFirstSequencer().manifestToSeekbarTime(params);
+
+        // manifestToSeekbarTime may have switched the segment to a split or welded clip
+        result.isClipChanged = isClipChanged;
+        result.minRenderingTime = currentSegment.clip.minRenderingTime;
+        result.maxRenderingTime = currentSegment.clip.maxRenderingTime;
+        result.isPreloadThresholdReached = !result.playbackRangeExceeded &&
+            typeof params.preloadThreshold === 'number' &&
+            (result.maxRenderingTime - params.currentPlaybackPosition) < params.preloadThreshold;
+        result.playlistVersion = mySequentialPlaylist.getVersion();
+
+        return result;
+    };
+
+    basePlugin.manifestToLinearTime = function ( params ) {
+        /* params:
+        currentSegmentId,           // number: the unique Id for the playback segment
+        currentPlaybackPosition     // number: the current playback position in manifest time
+        */
+        var currentSegment = myPlaybackSegmentPool.getPlaybackSegment(params.currentSegmentId),
+            positionOffset = params.currentPlaybackPosition - currentSegment.clip.minRenderingTime,
+            result = currentSegment.clip.linearStartTime;
+
+        if (currentSegment.clip.linearDuration > 0 && positionOffset > 0) {
+            // NOTE: result is *not* clipped to maxRenderingTime
+            result += positionOffset;
+        }
+        return result;
+    };
+
+    basePlugin.seekFromLinearPosition = function ( params ) {
+        /* params:
+        currentSegmentId,           // number: optional unique Id for the currrent playback segment; 0 or undefined for no current segment
+        linearSeekPosition          // number: the linear position to seek to, used mainly for resuming from the previous session
+        */
+        var seekPlaylistEntry,
+            currentSegment,
+            initialPlaybackRate = 1,
+            initialPlaybackStartTime;
+
+        // a seek drops the ads queued by a previous seek
+        mySkippedAds = null;
+
+        // Note: positions before the live window start have been evicted, resume at the oldest position instead
+        if (params.linearSeekPosition < mySequentialPlaylist.getWindowStart()) {
+            params.linearSeekPosition = mySequentialPlaylist.getWindowStart();
+        }
+        seekPlaylistEntry = mySequentialPlaylist.getEntryAtTime(params.linearSeekPosition);
+
+        if (params.currentSegmentId) {
+            currentSegment = myPlaybackSegmentPool.getPlaybackSegment(params.currentSegmentId);
+        }
+
+        if (!seekPlaylistEntry) {
+            if (currentSegment) {
+                myPlaybackSegmentPool.releasePlaybackSegment(currentSegment.segmentId);
+            }
+            throw new PLAYER_SEQUENCER.SequencerError('seekFromLinearPosition outside playlist range');
+        }
+
+        if (currentSegment) {
+            myPlaybackSegmentPool.releasePlaybackSegment(currentSegment.segmentId);
+            initialPlaybackRate = currentSegment.initialPlaybackRate;
+        }
+        initialPlaybackStartTime = seekPlaylistEntry.minRenderingTime + (params.linearSeekPosition - seekPlaylistEntry.linearStartTime);
+        currentSegment = myPlaybackSegmentPool.createPlaybackSegment(seekPlaylistEntry, initialPlaybackStartTime, initialPlaybackRate);
+
+        return currentSegment;
+    };
+
+    basePlugin.seekFromSeekbarPosition = function ( params ) {
+        /* params:
+        currentSegmentId,           // number: the unique Id for the playback segment
+        seekbarSeekPosition         // number: the seek position in seekbar time, used for user seek
+        */
+        var currentSegment = myPlaybackSegmentPool.getPlaybackSegment(params.currentSegmentId),
+            seekPlaylistEntry,
+            seekPlaybackSegment,
+            initialPlaybackRate,
+            initialPlaybackStartTime;
+
+        // a seek drops the ads queued by a previous seek
+        mySkippedAds = null;
+
+        // Prevent seekbarSeekPosition from being non-negative
+        if (params.seekbarSeekPosition < 0) {
+            params.seekbarSeekPosition = 0;
+        }
+
+        if (currentSegment.clip.linearDuration > 0) {
+            // Note: For non-zero-duration clips, seekbar time is the same as linear time.
+            if (params.seekbarSeekPosition < mySequentialPlaylist.getWindowStart()) {
+                params.seekbarSeekPosition = mySequentialPlaylist.getWindowStart();
+            }
+            seekPlaylistEntry = mySequentialPlaylist.getEntryAtTime(params.seekbarSeekPosition);
+            if (!seekPlaylistEntry) {
+                throw new PLAYER_SEQUENCER.SequencerError('seekFromSeekbarPosition outside playlist range');
+            }
+            initialPlaybackRate = currentSegment.initialPlaybackRate;
+            initialPlaybackStartTime = seekPlaylistEntry.minRenderingTime;
+            // if new clip is not zero duration, offset initialPlaybackStartTime by the remaining seek distance
+            if (seekPlaylistEntry.linearDuration > 0) {
+                initialPlaybackStartTime += (params.seekbarSeekPosition - seekPlaylistEntry.linearStartTime);
+            }
+        }
+        else if (params.seekbarSeekPosition > currentSegment.clip.maxRenderingTime - currentSegment.clip.minRenderingTime) {
+            // for zero-duration clips seeking must be within the clip
+            throw new PLAYER_SEQUENCER.SequencerError('seekFromSeekbarPosition outside segment range');
+        }
+        else {
+            // use the same zero-duration clip to create the new segment
+            seekPlaylistEntry = currentSegment.clip;
+            initialPlaybackRate = currentSegment.initialPlaybackRate;
+            initialPlaybackStartTime = seekPlaylistEntry.minRenderingTime + params.seekbarSeekPosition;
+        }
+        seekPlaybackSegment = myPlaybackSegmentPool.createPlaybackSegment(seekPlaylistEntry, initialPlaybackStartTime, initialPlaybackRate);
+
+        // Only if there were no exceptions is the previous playbackSegment released.
+        myPlaybackSegmentPool.releasePlaybackSegment(currentSegment.segmentId);
+
+        return seekPlaybackSegment;
+    };
+
+    basePlugin.releasePlaybackSegment = function ( params ) {
+        /* params:
+        currentSegmentId            // number: the unique Id for the playback segment
+        */
+        myPlaybackSegmentPool.releasePlaybackSegment(params.currentSegmentId);
+        return true;
+    };
+
+    basePlugin.onEndOfMedia = function ( params ) {
+        return myOnEnd(params, true);
+    };
+
+    basePlugin.onEndOfBuffering = function ( params ) {
+        return myOnEnd(params, false);
+    };
+
+    basePlugin.onError = function ( params ) {
+        // NOTE: The default implementation treats onError the same as onEndOfMedia.
+        //       A sequencer plugin is required to take some other action.
+        return myOnEnd(params, true);
+    };
+
+    basePlugin.getUpcomingSegments = function ( params ) {
+        /* params:
+        currentSegmentId            // number: the unique Id for the playback segment
+        currentPlaybackPosition     // number: (optional) the current playback position in manifest time
+        currentPlaybackRate         // number: the current playback rate
+        maxCount                    // number: (optional) the maximum number of segments returned
+        horizon                     // number: (optional) only segments starting within this rendering time are returned
+        */
+        var entry = myPlaybackSegmentPool.getPlaybackSegment(params.currentSegmentId).clip,
+            isPlayForward = 0 <= params.currentPlaybackRate,
+            hasPosition = typeof params.currentPlaybackPosition === 'number',
+            maxCount = params.maxCount,
+            horizon = params.horizon,
+            upcoming = [],
+            keptEntry = entry,          // the last entry walked which stays in the playlist once played
+            nextEntry,
+            skippedAdsNext,
+            clip,
+            initialPlaybackStartTime,
+            startOffset;
+
+        if (typeof maxCount !== 'number') {
+            maxCount = (typeof horizon === 'number') ? Infinity : 1;
+        }
+        if (typeof horizon !== 'number') {
+            horizon = Infinity;
+        }
+
+        // the rendering time left in the current segment
+        if (isPlayForward) {
+            startOffset = entry.maxRenderingTime - (hasPosition ? params.currentPlaybackPosition : entry.minRenderingTime);
+        } else {
+            startOffset = (hasPosition ? params.currentPlaybackPosition : entry.maxRenderingTime) - entry.minRenderingTime;
+        }
+        startOffset = Math.max(0, startOffset);
+
+        if (entry.deleteAfterPlay) {
+            // the current entry is removed once played, so the entry before it is the one a weld would extend
+            keptEntry = isPlayForward ? mySequentialPlaylist.getEntryBeforeId(entry.id) : mySequentialPlaylist.getEntryAfterId(entry.id);
+        }
+
+        // Walk the playlist the same way myOnEnd does for each successive onEndOfMedia, predicting the welds
+        // onPlayedEntry would make as the deleteAfterPlay entries on the way are played and removed.
+        nextEntry = entry;
+        while (upcoming.length < maxCount) {
+            skippedAdsNext = isPlayForward ? myGetSkippedAdsNext(nextEntry) : null;
+            if (skippedAdsNext) {
+                nextEntry = skippedAdsNext.entry;
+                // Note: the entries jumped to are not next to keptEntry, so no weld is predicted for them
+                keptEntry = null;
+            } else {
+                nextEntry = isPlayForward ? mySequentialPlaylist.getEntryAfterId(nextEntry.id) : mySequentialPlaylist.getEntryBeforeId(nextEntry.id);
+            }
+            if (!nextEntry || startOffset > horizon) {
+                break;
+            }
+            clip = nextEntry;
+            if (skippedAdsNext) {
+                initialPlaybackStartTime = skippedAdsNext.initialPlaybackStartTime;
+            } else {
+                initialPlaybackStartTime = isPlayForward ? nextEntry.minRenderingTime : nextEntry.maxRenderingTime;
+            }
+
+            if (nextEntry.deleteAfterPlay) {
+                entry = nextEntry;
+            } else {
+                if (keptEntry && keptEntry !== entry && keptEntry.idSplitFrom === nextEntry.idSplitFrom) {
+                    // the removal of the entry just played welds nextEntry and keptEntry back together
+                    clip = myProjectWeldedEntry(isPlayForward ? keptEntry : nextEntry, isPlayForward ? nextEntry : keptEntry);
+                }
+                entry = clip;
+                keptEntry = clip;
+            }
+
+            upcoming.push({
+                clip: clip,
+                initialPlaybackStartTime: initialPlaybackStartTime,
+                initialPlaybackRate: params.currentPlaybackRate,
+                startOffset: startOffset
+            });
+            startOffset += Math.max(0, isPlayForward ? clip.maxRenderingTime - initialPlaybackStartTime : initialPlaybackStartTime - clip.minRenderingTime);
+        }
+
+        return upcoming;
+    };
+
+    basePlugin.beginScrub = function ( params ) {
+        /* params:
+        currentSegmentId            // number: the unique Id for the playback segment
+        currentPlaybackPosition     // number: (optional) the current playback position in manifest time
+        */
+        var entry = myPlaybackSegmentPool.getPlaybackSegment(params.currentSegmentId).clip,
+            startPosition = entry.linearStartTime;
+
+        if (entry.linearDuration > 0 && typeof params.currentPlaybackPosition === 'number') {
+            // Note: go through the whole chain so any plugin overriding manifestToLinearTime is used
+            startPosition = basePlugin.getFirstSequencer().manifestToLinearTime(params);
+        }
+
+        myLastScrubId += 1;
+        myScrub = {
+            scrubId: myLastScrubId,
+            currentSegmentId: params.currentSegmentId,
+            startPosition: startPosition,
+            // Note: seekbar positions within a zero-duration clip stay within the clip, so no entry can be crossed
+            isOnLinearTimeline: entry.linearDuration > 0,
+            lastPosition: 0,
+            submittedCount: 0
+        };
+        return myScrub.scrubId;
+    };
+
+    basePlugin.submitScrubPosition = function ( params ) {
+        /* params:
+        scrubId                     // number: the scrubId returned by beginScrub
+        seekbarSeekPosition         // number: the seek position in seekbar time
+        */
+        var scrub = myGetScrub(params.scrubId, 'submitScrubPosition');
+
+        scrub.lastPosition = params.seekbarSeekPosition;
+        scrub.submittedCount += 1;
+        return scrub.submittedCount;
+    };
+
+    basePlugin.commitScrub = function ( params ) {
+        /* params:
+        scrubId                     // number: the scrubId returned by beginScrub
+        currentSegmentId            // number: (optional) the current playback segment if playback moved to another one since beginScrub
+        eSkippedAdPolicy            // string: (optional) 'PlayLast', 'PlayAll' or 'MarkPlayed' as for seekSkippingAds
+        */
+        var scrub = myGetScrub(params.scrubId, 'commitScrub'),
+            segment = null,
+            crossedAdEntryIds = [],
+            result;
+
+        if (params.eSkippedAdPolicy !== undefined) {
+            myValidateSkippedAdPolicy(params.eSkippedAdPolicy, 'commitScrub');
+        }
+
+        // the scrub ends even if the seek fails, the current segment is then left unchanged
+        myScrub = null;
+
+        if (scrub.submittedCount > 0 && scrub.isOnLinearTimeline && params.eSkippedAdPolicy !== undefined) {
+            result = mySeekSkippingAds(params.currentSegmentId || scrub.currentSegmentId, scrub.startPosition, scrub.lastPosition,
+                params.eSkippedAdPolicy, 'commitScrub');
+            result.submittedCount = scrub.submittedCount;
+            return result;
+        }
+        if (scrub.submittedCount > 0) {
+            // Note: go through the whole chain so any plugin overriding seekFromSeekbarPosition is used
+            segment = basePlugin.getFirstSequencer().seekFromSeekbarPosition({
+                currentSegmentId: params.currentSegmentId || scrub.currentSegmentId,
+                seekbarSeekPosition: scrub.lastPosition
+            });
+            if (scrub.isOnLinearTimeline) {
+                crossedAdEntryIds = myGetCrossedAdEntryIds(scrub.startPosition, Math.max(mySequentialPlaylist.getWindowStart(), scrub.lastPosition), segment.clip);
+            }
+        }
+
+        return {
+            segment: segment,
+            crossedAdEntryIds: crossedAdEntryIds,
+            submittedCount: scrub.submittedCount
+        };
+    };
+
+    basePlugin.cancelScrub = function ( params ) {
+        /* params:
+        scrubId                     // number: the scrubId returned by beginScrub
+        */
+        var isInProgress = !!myScrub && myScrub.scrubId === params.scrubId;
+
+        if (isInProgress) {
+            myScrub = null;
+        }
+        return isInProgress;
+    };
+
+    basePlugin.seekSkippingAds = function ( params ) {
+        /* params:
+        currentSegmentId            // number: the unique Id for the playback segment
+        currentPlaybackPosition     // number: (optional) the current playback position in manifest time
+        seekbarSeekPosition         // number: the seek position in seekbar time
+        eSkippedAdPolicy            // string: 'PlayLast', 'PlayAll' or 'MarkPlayed'
+        */
+        var entry = myPlaybackSegmentPool.getPlaybackSegment(params.currentSegmentId).clip,
+            fromPosition = entry.linearStartTime;
+
+        myValidateSkippedAdPolicy(params.eSkippedAdPolicy, 'seekSkippingAds');
+
+        if (entry.linearDuration === 0) {
+            // Note: seekbar positions within a zero-duration clip stay within the clip, so no entry can be crossed
+            return {
+                segment: basePlugin.getFirstSequencer().seekFromSeekbarPosition({
+                    currentSegmentId: params.currentSegmentId,
+                    seekbarSeekPosition: params.seekbarSeekPosition
+                }),
+                crossedAdEntryIds: [],
+                queuedAdEntryIds: [],
+                markedPlayedAdEntryIds: [],
+                removedEntryIds: []
+            };
+        }
+        if (typeof params.currentPlaybackPosition === 'number') {
+            // Note: go through the whole chain so any plugin overriding manifestToLinearTime is used
+            fromPosition = basePlugin.getFirstSequencer().manifestToLinearTime(params);
+        }
+        return mySeekSkippingAds(params.currentSegmentId, fromPosition, params.seekbarSeekPosition, params.eSkippedAdPolicy, 'seekSkippingAds');
+    };
+
+    basePlugin.testProbe = function ( params ) {
+        // TODO: add testProbe functionallity based on 'params'
+        return "default sequencer";
+    };
+};
+
+// ------------------------------------------------------------------------------------------------
+// Singleton for the sequencer plugin chain and the creation of the base sequencer plugin.
+// Note: These are declared here for simplicity in the initial single-instance implementation.
+//       They are also the "default" session of the sessionManager below, which creates other instances.
+// ------------------------------------------------------------------------------------------------
+//
+// NOTE: The createSequencerPlugin (for the parameter to createDefaultSequencerPlugin) must be called 
+//       immediately after the createSequencerPluginChain to ensure the default plugin is the last in the chain.
+//
+PLAYER_SEQUENCER.sequencerPluginChain = PLAYER_SEQUENCER.createSequencerPluginChain(PLAYER_SEQUENCER.sequentialPlaylist.access);
+
+PLAYER_SEQUENCER.createDefaultSequencerPlugin(PLAYER_SEQUENCER.sequencerPluginChain.createSequencerPlugin('default'));
+
+// ------------------------------------------------------------------------------------------------
+// Session manager for multiple instances
+// ------------------------------------------------------------------------------------------------
+// Note: Each session is an isolated set of sequential playlist, scheduler, sequencer plugin chain and
+//       playback segment pool, so one JavaScript context can sequence many timelines (for example one per
+//       viewer on a server). The singletons above are the "default" session used by the native wrappers.
+//       Nothing is allocated up front for a session: the playlist, journal and segment pool grow on use,
+//       and destroying a session releases its playback segments and drops the references to it.
+//
+PLAYER_SEQUENCER.sessionManager = (function () {
+"use strict";
+
+    // Note: rough per-object sizes used for the memory estimate of a session (bytes, as measured on V8)
+    var SESSION_BYTES = 8192,
+        PLAYLIST_ENTRY_BYTES = 1536,
+        JOURNAL_DELTA_BYTES = 96,
+        PLAYBACK_SEGMENT_BYTES = 768,
+        DEFAULT_SESSION_ID = 'default',
+        mySessions = {},                // sessionId -> session
+        myPluginFactories = [],         // functions (plugin) applied to each new session plugin chain
+        myNextSessionNumber = 1,
+        mySessionCount = 0,
+        myCreateCount = 0,
+        myDestroyCount = 0,
+
+    // private methods
+    myGetSession = function ( sessionId, callerName ) {
+        var key = String(sessionId);
+
+        if (!mySessions.hasOwnProperty(key)) {
+            throw new PLAYER_SEQUENCER.SequencerError('sessionManager.' + callerName + ' invalid sessionId: ' + key);
+        }
+        return mySessions[key];
+    },
+
+    myAddSession = function ( sessionId, sequentialPlaylist, scheduler, sequencerPluginChain, playbackSegmentPool ) {
+        var session = {
+            sessionId: sessionId,
+            sequentialPlaylist: sequentialPlaylist,
+            scheduler: scheduler,
+            sequencerPluginChain: sequencerPluginChain,
+            playbackSegmentPool: playbackSegmentPool,
+            createTime: Date.now()
+        };
+
+        mySessions[sessionId] = session;
+        mySessionCount += 1;
+        return session;
+    },
+
+    myGetSessionStatistics = function ( session ) {
+        var playlistStatistics = session.sequentialPlaylist.access.getStatistics(),
+            segmentStatistics = session.playbackSegmentPool.getStatistics();
+
+        return {
+            sessionId: session.sessionId,
+            age: Date.now() - session.createTime,
+            entryCount: playlistStatistics.entryCount,
+            playlistVersion: playlistStatistics.version,
+            journalLength: playlistStatistics.journalLength,
+            liveSegmentCount: segmentStatistics.liveCount,
+            segmentHighWaterMark: segmentStatistics.highWaterMark,
+            estimatedBytes: SESSION_BYTES +
+                playlistStatistics.entryCount * PLAYLIST_ENTRY_BYTES +
+                playlistStatistics.journalLength * JOURNAL_DELTA_BYTES +
+                segmentStatistics.highWaterMark * PLAYBACK_SEGMENT_BYTES
+        };
+    },
+
+    mySessionManager = {
+        createSession: function ( params ) {
+            ///<summary>Create an isolated sequential playlist, scheduler, sequencer plugin chain and playback segment pool.</summary>
+            ///<param name="params" type="Object" optional="true">An object with optional properties: sessionId (string, generated if not given), segmentCapacity (maximum live playback segments), journalCapacity (minimum playlist changes kept)</param>
+            ///<returns type="String">The sessionId</returns>
+            var sessionId,
+                sequentialPlaylist,
+                playbackSegmentPool,
+                sequencerPluginChain,
+                i;
+
+            params = params || {};
+            if (params.sessionId !== undefined && params.sessionId !== null) {
+                sessionId = String(params.sessionId);
+                if (mySessions.hasOwnProperty(sessionId)) {
+                    throw new PLAYER_SEQUENCER.SequencerError('sessionManager.createSession sessionId already exists: ' + sessionId);
+                }
+            }
+            else {
+                do {
+                    sessionId = 's' + myNextSessionNumber.toString();
+                    myNextSessionNumber += 1;
+                } while (mySessions.hasOwnProperty(sessionId));
+            }
+
+            sequentialPlaylist = PLAYER_SEQUENCER.createSequentialPlaylist(params.journalCapacity);
+            playbackSegmentPool = PLAYER_SEQUENCER.createPlaybackSegmentPool();
+            if (params.segmentCapacity !== undefined) {
+                playbackSegmentPool.setCapacity(params.segmentCapacity);
+            }
+            // Note: as for the singletons, the default plugin must be created first to be the last in the chain
+            sequencerPluginChain = PLAYER_SEQUENCER.createSequencerPluginChain(sequentialPlaylist.access, playbackSegmentPool);
+            PLAYER_SEQUENCER.createDefaultSequencerPlugin(sequencerPluginChain.createSequencerPlugin('default'));
+            for (i = 0; i < myPluginFactories.length; i += 1) {
+                myPluginFactories[i](sequencerPluginChain.createSequencerPlugin());
+            }
+
+            myAddSession(sessionId, sequentialPlaylist, PLAYER_SEQUENCER.createScheduler(sequentialPlaylist), sequencerPluginChain, playbackSegmentPool);
+            myCreateCount += 1;
+            return sessionId;
+        },
+
+        destroySession: function ( sessionId ) {
+            ///<summary>Forget a session. Its live playback segments are released, so a segmentId still held for the session is rejected; its playlist entries are left to the garbage collector.</summary>
+            ///<param name="sessionId" type="String">The sessionId returned by createSession</param>
+            var session = myGetSession(sessionId, 'destroySession');
+
+            if (session.sessionId === DEFAULT_SESSION_ID) {
+                throw new PLAYER_SEQUENCER.SequencerError('sessionManager.destroySession cannot destroy the default session');
+            }
+            session.playbackSegmentPool.releaseAll();
+            delete mySessions[session.sessionId];
+            mySessionCount -= 1;
+            myDestroyCount += 1;
+        },
+
+        getSession: function ( sessionId ) {
+            ///<summary>Get the objects of a session for direct JavaScript use.</summary>
+            ///<param name="sessionId" type="String">The sessionId returned by createSession, or "default"</param>
+            ///<returns type="Object">An object with properties: sessionId, sequentialPlaylist, scheduler, sequencerPluginChain, playbackSegmentPool</returns>
+            return myGetSession(sessionId, 'getSession');
+        },
+
+        hasSession: function ( sessionId ) {
+            ///<summary>Check if a session exists.</summary>
+            ///<param name="sessionId" type="String">The sessionId to check</param>
+            ///<returns type="Boolean">true if the session exists</returns>
+            return mySessions.hasOwnProperty(String(sessionId));
+        },
+
+        addPluginFactory: function ( pluginFactory ) {
+            ///<summary>Register a function which fills in a custom sequencer plugin, such as createCustomSequencerPlugin, for every session created after this call.</summary>
+            ///<param name="pluginFactory" type="Function">function (plugin) given a new pass-through plugin of the session plugin chain</param>
+            if (typeof pluginFactory !== 'function') {
+                throw new PLAYER_SEQUENCER.SequencerError('sessionManager.addPluginFactory parameter is not a function');
+            }
+            myPluginFactories.push(pluginFactory);
+        },
+
+        runJSON: function ( sessionId, target, paramsJSON ) {
+            ///<summary>Invoke a scheduler or sequencer plugin method of a session using a JSON string, as the runJSON of the scheduler or the sequencer plugin chain.</summary>
+            ///<param name="sessionId" type="String">The sessionId returned by createSession, or "default"</param>
+            ///<param name="target" type="String">"scheduler" or "sequencer"</param>
+            ///<param name="paramsJSON" type="String">The method name and params expressed in a JSON string, passed through unchanged.</param>
+            ///<returns type="String">The method results expressed is a JSON string. If an exception was thrown, a top level object "EXCEPTION" will contain standard Error fields.</returns>
+            var session;
+
+            try {
+                session = myGetSession(sessionId, 'runJSON');
+                if (target === 'scheduler') {
+                    return session.scheduler.runJSON(paramsJSON);
+                }
+                if (target === 'sequencer') {
+                    return session.sequencerPluginChain.runJSON(paramsJSON);
+                }
+                throw new PLAYER_SEQUENCER.SequencerError('sessionManager.runJSON invalid target: ' + String(target));
+            }
+            catch (ex) {
+                return PLAYER_SEQUENCER.exceptionToJSON(ex);
+            }
+        },
+
+        runCompact: function ( sessionId ) {
+            ///<summary>Invoke one of the frequently called sequencer plugin methods of a session with positional arguments, as the runCompact of the sequencer plugin chain.</summary>
+            ///<param name="sessionId" type="String">The sessionId returned by createSession, or "default". The runCompact func and positional arguments follow.</param>
+            ///<returns type="String">The runCompact result tuple, or an "EXCEPTION" JSON string.</returns>
+            var session;
+
+            try {
+                session = myGetSession(sessionId, 'runCompact');
+            }
+            catch (ex) {
+                return PLAYER_SEQUENCER.exceptionToJSON(ex);
+            }
+            return session.sequencerPluginChain.runCompact.apply(session.sequencerPluginChain, Array.prototype.slice.call(arguments, 1));
+        },
+
+        getSessionStatistics: function ( sessionId ) {
+            ///<summary>Get the size counters and estimated memory use of a session.</summary>
+            ///<param name="sessionId" type="String">The sessionId returned by createSession, or "default"</param>
+            ///<returns type="Object">An object with properties: sessionId, age (milliseconds), entryCount, playlistVersion, journalLength, liveSegmentCount, segmentHighWaterMark, estimatedBytes</returns>
+            return myGetSessionStatistics(myGetSession(sessionId, 'getSessionStatistics'));
+        },
+
+        getStatistics: function () {
+            ///<summary>Get the session counters and the estimated memory use of all sessions.</summary>
+            ///<returns type="Object">An object with properties: sessionCount, createCount, destroyCount, estimatedBytes</returns>
+            var estimatedBytes = 0,
+                sessionId;
+
+            for (sessionId in mySessions) {
+                if (mySessions.hasOwnProperty(sessionId)) {
+                    estimatedBytes += myGetSessionStatistics(mySessions[sessionId]).estimatedBytes;
+                }
+            }
+            return {
+                sessionCount: mySessionCount,
+                createCount: myCreateCount,
+                destroyCount: myDestroyCount,
+                estimatedBytes: estimatedBytes
+            };
+        }
+    };
+
+    myAddSession(DEFAULT_SESSION_ID,
+        PLAYER_SEQUENCER.sequentialPlaylist,
+        PLAYER_SEQUENCER.scheduler,
+        PLAYER_SEQUENCER.sequencerPluginChain,
+        PLAYER_SEQUENCER.playbackSegmentPool);
+
+    return mySessionManager;
+}());
+
+// ------------------------------------------------------------------------------------------------
+// Bridge call trace recorder
+// ------------------------------------------------------------------------------------------------
+// Note: While recording, every runJSON and runCompact call made on the scheduler, sequencer plugin chain
+//       and AdResolver singletons is kept in a fixed size ring buffer with its arguments, result and timing.
+//       The entry points are wrapped only while recording so there is no cost when it is off.
+//       A trace recorded from a fresh start can be re-executed with src/Core/TraceReplayer/TraceReplayer.js.
+//
+PLAYER_SEQUENCER.traceRecorder = (function () {
+"use strict";
+
+    var TRACE_FORMAT_VERSION = 1,
+        DEFAULT_CAPACITY = 1024,
+        myNow = (typeof performance !== 'undefined' && typeof performance.now === 'function') ?
+            function () { return performance.now(); } :
+            function () { return Date.now(); },
+        myRecords = [],             // ring buffer of [target, method, args, result, startTime, duration]
+        myCapacity = DEFAULT_CAPACITY,
+        myNextIndex = 0,            // ring buffer index of the next record
+        myRecordCount = 0,          // total records since start, including those overwritten
+        myStartTime = 0,
+        myStartDate = 0,
+        myDepth = 0,                // nesting depth, so calls made by a recorded call are not recorded again
+        myWrapped = [],             // { owner, method, original, wrapper, isActive } for each wrapped entry point
+
+    // private methods
+    myTargets = function () {
+        ///<summary>The recorded entry points: [target name, owner object, method names]</summary>
+        var targets = [
+            ['scheduler', PLAYER_SEQUENCER.scheduler, ['runJSON']],
+            ['sequencer', PLAYER_SEQUENCER.sequencerPluginChain, ['runJSON', 'runCompact']]
+        ];
+
+        // Note: AdResolver.js is loaded after this file
+        if (PLAYER_SEQUENCER.theAdResolver) {
+            targets.push(['adResolver', PLAYER_SEQUENCER.theAdResolver, ['runJSON']]);
+        }
+        return targets;
+    },
+
+    myRecord = function ( target, method, args, result, startTime, duration ) {
+        myRecords[myNextIndex] = [target, method, args, result, startTime, duration];
+        myNextIndex = (myNextIndex + 1) % myCapacity;
+        myRecordCount += 1;
+    },
+
+    myWrap = function ( target, owner, method ) {
+        var wrapped = { owner: owner, method: method, original: owner[method], wrapper: null, isActive: true },
+            original = wrapped.original;
+
+        wrapped.wrapper = function () {
+            var args = Array.prototype.slice.call(arguments),
+                startTime,
+                result;
+
+            if (myDepth > 0 || !wrapped.isActive) {
+                return original.apply(owner, args);
+            }
+            myDepth += 1;
+            startTime = myNow();
+            try {
+                result = original.apply(owner, args);
+            }
+            finally {
+                myDepth -= 1;
+            }
+            // Note: runJSON takes its single JSON string as is, runCompact the positional argument array
+            myRecord(target, method, (method === 'runJSON') ? args[0] : args, result, startTime - myStartTime, myNow() - startTime);
+            return result;
+        };
+        owner[method] = wrapped.wrapper;
+        myWrapped.push(wrapped);
+    };
+
+    return {
+        start: function ( capacity ) {
+            ///<summary>Start recording, dropping any previous trace. For a trace that can be replayed, start before the first scheduler call.</summary>
+            ///<param name="capacity" type="Number" optional="true">The number of most recent calls kept (default 1024)</param>
+            ///<returns type="Boolean">true (so the native bridge gets a non-empty result)</returns>
+            var targets,
+                i,
+                j;
+
+            if (myWrapped.length > 0) {
+                PLAYER_SEQUENCER.traceRecorder.stop();
+            }
+            if (capacity !== undefined && (typeof capacity !== 'number' || capacity < 1)) {
+                throw new PLAYER_SEQUENCER.SequencerError('traceRecorder invalid capacity: ' + String(capacity));
+            }
+            myCapacity = (capacity !== undefined) ? Math.floor(capacity) : DEFAULT_CAPACITY;
+            myRecords = [];
+            myNextIndex = 0;
+            myRecordCount = 0;
+            myStartTime = myNow();
+            myStartDate = Date.now();
+
+            targets = myTargets();
+            for (i = 0; i < targets.length; i += 1) {
+                for (j = 0; j < targets[i][2].length; j += 1) {
+                    myWrap(targets[i][0], targets[i][1], targets[i][2][j]);
+                }
+            }
+            return true;
+        },
+
+        stop: function () {
+            ///<summary>Stop recording. The trace recorded so far is kept for dump.</summary>
+            ///<returns type="Boolean">true (so the native bridge gets a non-empty result)</returns>
+            var wrapped;
+
+            while (myWrapped.length > 0) {
+                wrapped = myWrapped.pop();
+                // Note: a method wrapped again since (for example by metrics.enable) is left alone, and the
+                //       inactive wrapper it calls just passes through
+                wrapped.isActive = false;
+                if (wrapped.owner[wrapped.method] === wrapped.wrapper) {
+                    wrapped.owner[wrapped.method] = wrapped.original;
+                }
+            }
+            return true;
+        },
+
+        isRecording: function () {
+            ///<summary>Check if calls are being recorded.</summary>
+            ///<returns type="Boolean">true while recording</returns>
+            return myWrapped.length > 0;
+        },
+
+        dump: function () {
+            ///<summary>Get the recorded trace, oldest call first.</summary>
+            ///<returns type="String">A JSON string with properties: version, startDate (Date.now() at start), recordCount (calls since start), droppedCount (oldest calls overwritten in the ring buffer) and records, an array of [target, method, args, result, startTime, duration] with times in milliseconds from the start</returns>
+            var records = (myRecordCount > myCapacity) ?
+                    myRecords.slice(myNextIndex).concat(myRecords.slice(0, myNextIndex)) :
+                    myRecords.slice(0);
+
+            return JSON.stringify({
+                version: TRACE_FORMAT_VERSION,
+                startDate: myStartDate,
+                recordCount: myRecordCount,
+                droppedCount: myRecordCount - records.length,
+                records: records
+            });
+        }
+    };
+}());
+
+// ------------------------------------------------------------------------------------------------
+// Preload planner
+// ------------------------------------------------------------------------------------------------
+// Note: The host reports how long each clip took from the start of buffering until it was ready to play,
+//       and the planner tells the host how many seconds before the end of the current segment to start
+//       buffering the next one (the preloadThreshold of tick) so the next clip is ready in time with a
+//       target stall probability. The latencies are kept per clip type and host, per clip type and overall,
+//       each as a streaming log-scale histogram whose older samples decay, so the estimate follows changes
+//       in the network and the ad servers. The clock is injected so the planner can be driven from synthetic
+//       latency traces in Node.
+//
+PLAYER_SEQUENCER.createPreloadPlanner = function ( options ) {
+"use strict";
+
+    // Note: bucket i holds latencies in [BUCKET_MIN * GROWTH^i, BUCKET_MIN * GROWTH^(i+1)) seconds,
+    //       which spans 10 ms to about 137 s with at most 10% quantization error
+    var BUCKET_MIN = 0.01,
+        BUCKET_GROWTH = 1.1,
+        BUCKET_COUNT = 100,
+        LOG_BUCKET_GROWTH = Math.log(BUCKET_GROWTH),
+        myClock = null,                 // function returning the current time in milliseconds
+        myTargetStallProbability = 0.05,
+        myDefaultLeadTime = 5,          // seconds, used until there are enough samples
+        myMinLeadTime = 1,
+        myMaxLeadTime = 30,
+        mySafetyMargin = 0.5,           // seconds added to the latency estimate
+        myMinSamples = 5,               // samples needed before an estimator is trusted
+        myDecay = 0.98,                 // weight kept by the older samples each time a sample is recorded
+        myEstimators = {},              // key -> { weights, totalWeight, count }
+        myLoads = {},                   // loadId -> { keys, startTime }
+        myNextLoadNumber = 1,
+        myPlanner,
+
+    // private methods
+    myValidateNumber = function ( value, minValue, maxValue, name ) {
+        if (typeof value !== 'number' || isNaN(value) || value < minValue || value > maxValue) {
+            throw new PLAYER_SEQUENCER.SequencerError('preloadPlanner invalid ' + name + ': ' + String(value));
+        }
+        return value;
+    },
+
+    myGetKeys = function ( params ) {
+        ///<summary>The estimator keys for a clip, most specific first: type|host, type| and the overall key |</summary>
+        var clipType = (params && params.eClipType) ? String(params.eClipType) : '',
+            match = (params && typeof params.clipURI === 'string') ? /^[a-zA-Z][a-zA-Z0-9+.\-]*:\/\/([^\/?#]*)/.exec(params.clipURI) : null,
+            keys = [];
+
+        if (match) {
+            keys.push(clipType + '|' + match[1].toLowerCase());
+        }
+        if (clipType) {
+            keys.push(clipType + '|');
+        }
+        keys.push('|');
+        return keys;
+    },
+
+    myRecord = function ( keys, latency ) {
+        var bucket = (latency <= BUCKET_MIN) ? 0 : Math.min(BUCKET_COUNT - 1, Math.floor(Math.log(latency / BUCKET_MIN) / LOG_BUCKET_GROWTH)),
+            estimator,
+            i,
+            j;
+
+        for (i = 0; i < keys.length; i += 1) {
+            estimator = myEstimators[keys[i]];
+            if (!estimator) {
+                estimator = { weights: [], totalWeight: 0, count: 0 };
+                for (j = 0; j < BUCKET_COUNT; j += 1) {
+                    estimator.weights.push(0);
+                }
+                myEstimators[keys[i]] = estimator;
+            }
+            if (myDecay < 1) {
+                for (j = 0; j < BUCKET_COUNT; j += 1) {
+                    estimator.weights[j] *= myDecay;
+                }
+                estimator.totalWeight *= myDecay;
+            }
+            estimator.weights[bucket] += 1;
+            estimator.totalWeight += 1;
+            estimator.count += 1;
+        }
+    },
+
+    myGetPercentile = function ( estimator, fraction ) {
+        ///<summary>The upper bound of the bucket holding the given fraction of the weight, so the estimate errs on the late side</summary>
+        var target = fraction * estimator.totalWeight,
+            sum = 0,
+            i;
+
+        for (i = 0; i < BUCKET_COUNT - 1; i += 1) {
+            sum += estimator.weights[i];
+            if (sum >= target) {
+                break;
+            }
+        }
+        return BUCKET_MIN * Math.pow(BUCKET_GROWTH, i + 1);
+    },
+
+    myGetEstimator = function ( keys ) {
+        ///<summary>The most specific estimator with enough samples, or null</summary>
+        var i;
+
+        for (i = 0; i < keys.length; i += 1) {
+            if (myEstimators[keys[i]] && myEstimators[keys[i]].count >= myMinSamples) {
+                return myEstimators[keys[i]];
+            }
+        }
+        return null;
+    };
+
+    options = options || {};
+    myClock = options.clock || function () { return Date.now(); };
+    if (options.targetStallProbability !== undefined) {
+        myTargetStallProbability = myValidateNumber(options.targetStallProbability, 0, 1, 'targetStallProbability');
+    }
+    if (options.defaultLeadTime !== undefined) {
+        myDefaultLeadTime = myValidateNumber(options.defaultLeadTime, 0, Infinity, 'defaultLeadTime');
+    }
+    if (options.minLeadTime !== undefined) {
+        myMinLeadTime = myValidateNumber(options.minLeadTime, 0, Infinity, 'minLeadTime');
+    }
+    if (options.maxLeadTime !== undefined) {
+        myMaxLeadTime = myValidateNumber(options.maxLeadTime, myMinLeadTime, Infinity, 'maxLeadTime');
+    }
+    if (options.safetyMargin !== undefined) {
+        mySafetyMargin = myValidateNumber(options.safetyMargin, 0, Infinity, 'safetyMargin');
+    }
+    if (options.minSamples !== undefined) {
+        myMinSamples = myValidateNumber(options.minSamples, 1, Infinity, 'minSamples');
+    }
+    if (options.decay !== undefined) {
+        myDecay = myValidateNumber(options.decay, 0.5, 1, 'decay');
+    }
+
+    myPlanner = {
+        beginLoad: function ( params ) {
+            ///<summary>Notify that buffering of a clip has started.</summary>
+            ///<param name="params" type="Object">An object with properties: clipURI, eClipType, loadId (optional, such as the segmentId; generated if not given)</param>
+            ///<returns type="String">The loadId to pass to endLoad or cancelLoad</returns>
+            var loadId;
+
+            if (params.loadId !== undefined && params.loadId !== null) {
+                loadId = String(params.loadId);
+            }
+            else {
+                loadId = 'load' + myNextLoadNumber.toString();
+                myNextLoadNumber += 1;
+            }
+            // Note: beginning a load again for the same loadId restarts its measurement
+            myLoads[loadId] = { keys: myGetKeys(params), startTime: myClock() };
+            return loadId;
+        },
+
+        endLoad: function ( params ) {
+            ///<summary>Notify that a clip whose buffering was started with beginLoad is ready to play, recording its latency.</summary>
+            ///<param name="params" type="Object">An object with properties: loadId</param>
+            ///<returns type="Number" mayBeNull="true">The latency in seconds, or null if the loadId is unknown (already ended or cancelled)</returns>
+            var loadId = String(params.loadId),
+                load = myLoads[loadId],
+                latency;
+
+            if (!myLoads.hasOwnProperty(loadId)) {
+                return null;
+            }
+            delete myLoads[loadId];
+            latency = Math.max(0, (myClock() - load.startTime) / 1000);
+            myRecord(load.keys, latency);
+            return latency;
+        },
+
+        cancelLoad: function ( params ) {
+            ///<summary>Drop a load which will not complete, such as a preloaded segment invalidated by a seek or failed.</summary>
+            ///<param name="params" type="Object">An object with properties: loadId</param>
+            ///<returns type="Boolean">true if the load was pending</returns>
+            var loadId = String(params.loadId),
+                isPending = myLoads.hasOwnProperty(loadId);
+
+            delete myLoads[loadId];
+            return isPending;
+        },
+
+        recordLatency: function ( params ) {
+            ///<summary>Record a latency measured by the host, or one from a synthetic trace.</summary>
+            ///<param name="params" type="Object">An object with properties: clipURI, eClipType, latency (seconds from the start of buffering until ready to play)</param>
+            ///<returns type="Boolean">true</returns>
+            myRecord(myGetKeys(params), myValidateNumber(params.latency, 0, Infinity, 'latency'));
+            return true;
+        },
+
+        getLeadTime: function ( params ) {
+            ///<summary>Get how many seconds before the end of the current segment buffering of a clip should start, to be passed as the preloadThreshold of tick (multiplied by the timescale after scheduler.setTimescale).</summary>
+            ///<param name="params" type="Object">An object with properties: clipURI, eClipType of the clip to be buffered (either may be omitted to use a broader estimate)</param>
+            ///<returns type="Number">The lead time in seconds: the (1 - targetStallProbability) latency percentile plus the safety margin, clamped to [minLeadTime, maxLeadTime], or defaultLeadTime until there are enough samples</returns>
+            var estimator = myGetEstimator(myGetKeys(params));
+
+            if (!estimator) {
+                return myDefaultLeadTime;
+            }
+            return Math.min(myMaxLeadTime, Math.max(myMinLeadTime, myGetPercentile(estimator, 1 - myTargetStallProbability) + mySafetyMargin));
+        },
+
+        shouldStartLoad: function ( params ) {
+            ///<summary>Check if buffering of the next clip should start now.</summary>
+            ///<param name="params" type="Object">An object with properties: remainingTime (seconds of the current segment left to play), clipURI, eClipType of the next clip</param>
+            ///<returns type="Boolean">true when remainingTime is within the lead time for the next clip</returns>
+            return params.remainingTime <= myPlanner.getLeadTime(params);
+        },
+
+        setTargetStallProbability: function ( params ) {
+            ///<summary>Set the acceptable probability that the next clip is not ready when the current segment ends.</summary>
+            ///<param name="params" type="Object">An object with properties: targetStallProbability (0 to 1)</param>
+            ///<returns type="Boolean">true</returns>
+            myTargetStallProbability = myValidateNumber(params.targetStallProbability, 0, 1, 'targetStallProbability');
+            return true;
+        },
+
+        getStatistics: function () {
+            ///<summary>Get the latency estimates.</summary>
+            ///<returns type="Object">An object with properties: targetStallProbability, pendingLoadCount and estimators, an object keyed by 'eClipType|host', 'eClipType|' and '|' (overall) with properties: count, p50, p90, p99 (seconds) and leadTime</returns>
+            var statistics = { targetStallProbability: myTargetStallProbability, pendingLoadCount: 0, estimators: {} },
+                estimator,
+                key;
+
+            for (key in myLoads) {
+                if (myLoads.hasOwnProperty(key)) {
+                    statistics.pendingLoadCount += 1;
+                }
+            }
+            for (key in myEstimators) {
+                if (myEstimators.hasOwnProperty(key)) {
+                    estimator = myEstimators[key];
+                    statistics.estimators[key] = {
+                        count: estimator.count,
+                        p50: myGetPercentile(estimator, 0.5),
+                        p90: myGetPercentile(estimator, 0.9),
+                        p99: myGetPercentile(estimator, 0.99),
+                        leadTime: (estimator.count >= myMinSamples) ?
+                            Math.min(myMaxLeadTime, Math.max(myMinLeadTime, myGetPercentile(estimator, 1 - myTargetStallProbability) + mySafetyMargin)) :
+                            myDefaultLeadTime
+                    };
+                }
+            }
+            return statistics;
+        },
+
+        reset: function () {
+            ///<summary>Drop all the recorded latencies and pending loads.</summary>
+            ///<returns type="Boolean">true</returns>
+            myEstimators = {};
+            myLoads = {};
+            return true;
+        },
+
+        runJSON: function ( paramsJSON ) {
+            ///<summary>Invoke a preload planner method using a JSON string and returning the result as a JSON string.</summary>
+            ///<param name="paramsJSON" type="String">The method name and params expressed in a JSON string. There must be a top level property "func" string with the name of the method to invoke. Method params can either be all top level or within a containing "params" object.</param>
+            ///<returns type="String">The method results expressed is a JSON string. If an exception was thrown, a top level object "EXCEPTION" will contain standard Error fields.</returns>
+            var params, result;
+
+            try {
+                params = JSON.parse(paramsJSON);
+
+                if (!params || (typeof params.func !== 'string') || params.func === 'runJSON' || typeof myPlanner[params.func] !== 'function') {
+                    throw new PLAYER_SEQUENCER.SequencerError('preloadPlanner.runJSON func property missing or invalid');
+                }
+                result = myPlanner[params.func](params.params || params);
+            }
+            catch (ex) {
+                return PLAYER_SEQUENCER.exceptionToJSON(ex);
+            }
+            return JSON.stringify(result);
+        }
+    };
+
+    return myPlanner;
+};
+
+// Singleton preload planner for the native players
+PLAYER_SEQUENCER.preloadPlanner = PLAYER_SEQUENCER.createPreloadPlanner();
+
+// ------------------------------------------------------------------------------------------------
+// Metrics
+// ------------------------------------------------------------------------------------------------
+// Note: While enabled, every method of every plugin in the sequencer plugin chain and the scheduler and
+//       adResolver runJSON entry points are wrapped to count calls and measure their time. The self time of a
+//       plugin method excludes the time spent in the methods it calls down the chain, so each plugin is
+//       charged only for its own work. Disabling restores the original methods, so there is no cost at all
+//       when the metrics are off. Enable after all the plugins are created; plugins created later are only
+//       instrumented by enabling again.
+//
+PLAYER_SEQUENCER.metrics = (function () {
+"use strict";
+
+    // Note: the upper bounds in milliseconds of the latency histogram buckets, plus a last bucket above
+    var HISTOGRAM_BOUNDS = [0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 1, 2, 5, 10, 20, 50, 100],
+        UNINSTRUMENTED_PLUGIN_METHODS = {
+            getNextSequencer: true,
+            getSequentialPlaylistAccess: true,
+            getPlaybackSegmentPool: true,
+            getFirstSequencer: true
+        },
+        myNow = (typeof performance !== 'undefined' && typeof performance.now === 'function') ?
+            function () { return performance.now(); } :
+            function () { return Date.now(); },
+        myStats = {},               // sequencer: { plugin name: { method: stat } }, scheduler and adResolver: { func: stat }
+        myChildTimes = [],          // stack of the time spent in nested calls, one per instrumented call in progress
+        myWrapped = [],             // { owner, method, original, wrapper, isActive } for each wrapped method
+        myStartTime = 0,
+
+    // private methods
+    myCreateStat = function () {
+        var stat = { count: 0, totalTime: 0, selfTime: 0, maxSelfTime: 0, histogram: [] },
+            i;
+
+        for (i = 0; i <= HISTOGRAM_BOUNDS.length; i += 1) {
+            stat.histogram.push(0);
+        }
+        return stat;
+    },
+
+    myGetStat = function ( group, name, method ) {
+        var stats = myStats[group] || (myStats[group] = {});
+
+        if (method !== undefined) {
+            stats = stats[name] || (stats[name] = {});
+            name = method;
+        }
+        return stats[name] || (stats[name] = myCreateStat());
+    },
+
+    myAddSample = function ( stat, elapsed, selfTime ) {
+        var i = 0;
+
+        while (i < HISTOGRAM_BOUNDS.length && elapsed > HISTOGRAM_BOUNDS[i]) {
+            i += 1;
+        }
+        stat.histogram[i] += 1;
+        stat.count += 1;
+        stat.totalTime += elapsed;
+        stat.selfTime += selfTime;
+        if (selfTime > stat.maxSelfTime) {
+            stat.maxSelfTime = selfTime;
+        }
+    },
+
+    myWrap = function ( owner, method, getStat ) {
+        ///<summary>Replace owner[method] with a measuring wrapper</summary>
+        ///<param name="getStat" type="Function">Returns the stat to update given the call arguments</param>
+        var wrapped = { owner: owner, method: method, original: owner[method], wrapper: null, isActive: true },
+            original = wrapped.original;
+
+        wrapped.wrapper = function () {
+            var startTime,
+                elapsed,
+                childTime;
+
+            if (!wrapped.isActive) {
+                return original.apply(owner, arguments);
+            }
+            myChildTimes.push(0);
+            startTime = myNow();
+            try {
+                return original.apply(owner, arguments);
+            }
+            finally {
+                elapsed = myNow() - startTime;
+                childTime = myChildTimes.pop();
+                if (myChildTimes.length > 0) {
+                    myChildTimes[myChildTimes.length - 1] += elapsed;
+                }
+                myAddSample(getStat(arguments), elapsed, elapsed - childTime);
+            }
+        };
+
+        owner[method] = wrapped.wrapper;
+        myWrapped.push(wrapped);
+    },
+
+    myGetFuncName = function ( paramsJSON ) {
+        // Note: a regular expression is used instead of JSON.parse to keep the wrapper cheap
+        var match = /"func"\s*:\s*"([^"]*)"/.exec(String(paramsJSON));
+        return match ? match[1] : '(unknown)';
+    },
+
+    myWrapPlugin = function ( pluginName, plugin ) {
+        var method,
+            stat;
+
+        for (method in plugin) {
+            if (plugin.hasOwnProperty(method) && typeof plugin[method] === 'function' && !UNINSTRUMENTED_PLUGIN_METHODS[method]) {
+                stat = myGetStat('sequencer', pluginName, method);
+                myWrap(plugin, method, (function ( pluginStat ) {
+                    return function () { return pluginStat; };
+                }(stat)));
+            }
+        }
+    },
+
+    myWrapRunJSON = function ( group, owner ) {
+        myWrap(owner, 'runJSON', function ( args ) {
+            return myGetStat(group, myGetFuncName(args[0]));
+        });
+    },
+
+    myMetrics = {
+        enable: function () {
+            ///<summary>Start collecting metrics for the sequencerPluginChain singleton plugins and the scheduler and theAdResolver runJSON entry points. Collected metrics are kept.</summary>
+            ///<returns type="Boolean">true (so the native bridge gets a non-empty result)</returns>
+            var plugins = PLAYER_SEQUENCER.sequencerPluginChain.getSequencerPlugins(),
+                i;
+
+            // Note: enabling again re-wraps, which instruments the plugins created since
+            myMetrics.disable();
+            if (myStartTime === 0) {
+                myStartTime = Date.now();
+            }
+            for (i = 0; i < plugins.length; i += 1) {
+                myWrapPlugin(plugins[i].name, plugins[i].plugin);
+            }
+            PLAYER_SEQUENCER.sequencerPluginChain.rebuildDispatchTable();
+            myWrapRunJSON('scheduler', PLAYER_SEQUENCER.scheduler);
+            // Note: AdResolver.js is loaded after this file
+            if (PLAYER_SEQUENCER.theAdResolver) {
+                myWrapRunJSON('adResolver', PLAYER_SEQUENCER.theAdResolver);
+            }
+            return true;
+        },
+
+        disable: function () {
+            ///<summary>Stop collecting metrics and restore the original methods. Collected metrics are kept.</summary>
+            ///<returns type="Boolean">true</returns>
+            var wrapped;
+
+            while (myWrapped.length > 0) {
+                wrapped = myWrapped.pop();
+                // Note: a method wrapped again since (for example by traceRecorder.start) is left alone, and the
+                //       inactive wrapper it calls just passes through
+                wrapped.isActive = false;
+                if (wrapped.owner[wrapped.method] === wrapped.wrapper) {
+                    wrapped.owner[wrapped.method] = wrapped.original;
+                }
+            }
+            myChildTimes = [];
+            PLAYER_SEQUENCER.sequencerPluginChain.rebuildDispatchTable();
+            return true;
+        },
+
+        isEnabled: function () {
+            ///<summary>Check if metrics are being collected.</summary>
+            ///<returns type="Boolean">true while enabled</returns>
+            return myWrapped.length > 0;
+        },
+
+        getMetrics: function ( params ) {
+            ///<summary>Get the metrics collected since enabled or reset.</summary>
+            ///<param name="params" type="Object" optional="true">An object with properties: reset (optional boolean, reset the metrics after getting them)</param>
+            ///<returns type="Object">An object with properties: isEnabled, duration (milliseconds since collecting started), histogramBounds (the histogram bucket upper bounds in milliseconds), sequencer ({ plugin name: { method: stat } }), scheduler and adResolver ({ func: stat }) where stat has properties: count, totalTime, selfTime, maxSelfTime (milliseconds) and histogram (call counts per bucket of total time)</returns>
+            var metrics = {
+                isEnabled: myMetrics.isEnabled(),
+                duration: (myStartTime === 0) ? 0 : Date.now() - myStartTime,
+                histogramBounds: HISTOGRAM_BOUNDS.slice(0),
+                sequencer: myStats.sequencer || {},
+                scheduler: myStats.scheduler || {},
+                adResolver: myStats.adResolver || {}
+            };
+
+            if (params && params.reset) {
+                myMetrics.reset();
+            }
+            return metrics;
+        },
+
+        reset: function () {
+            ///<summary>Drop the collected metrics.</summary>
+            ///<returns type="Boolean">true</returns>
+            var wasEnabled = myMetrics.isEnabled();
+
+            myStats = {};
+            myStartTime = 0;
+            // Note: the plugin wrappers hold their stat objects, so they are wrapped again with new ones
+            if (wasEnabled) {
+                myMetrics.enable();
+            }
+            return true;
+        },
+
+        runJSON: function ( paramsJSON ) {
+            ///<summary>Invoke a metrics method using a JSON string and returning the result as a JSON string.</summary>
+            ///<param name="paramsJSON" type="String">The method name and params expressed in a JSON string. There must be a top level property "func" string with the name of the method to invoke. Method params can either be all top level or within a containing "params" object.</param>
+            ///<returns type="String">The method results expressed is a JSON string. If an exception was thrown, a top level object "EXCEPTION" will contain standard Error fields.</returns>
+            var params, result;
+
+            try {
+                params = JSON.parse(paramsJSON);
+
+                if (!params || (typeof params.func !== 'string') || params.func === 'runJSON' || typeof myMetrics[params.func] !== 'function') {
+                    throw new PLAYER_SEQUENCER.SequencerError('metrics.runJSON func property missing or invalid');
+                }
+                result = myMetrics[params.func](params.params || params);
+            }
+            catch (ex) {
+                return PLAYER_SEQUENCER.exceptionToJSON(ex);
+            }
+            return JSON.stringify(result);
+        }
+    };
+
+    return myMetrics;
+}());
+
+// ------------------------------------------------------------------------------------------------
+// Readiness
+// ------------------------------------------------------------------------------------------------
+// Note: signalReady is called once all the scripts are loaded: by the last line of the single-bundle build
+//       (src/Core/Build/BuildBundle.js) or by a last inline script after separate script files. In a web view
+//       it also loads READY_URL in a hidden iframe, which the host intercepts so it is told the scripts are
+//       ready instead of polling for them.
+//
+PLAYER_SEQUENCER.readiness = (function () {
+"use strict";
+
+    var READY_URL = 'playersequencer://ready',
+        myIsReady = false,
+        myListeners = [],
+
+    myNotifyHost = function () {
+        var frame;
+
+        if (typeof document === 'undefined' || !document.documentElement) {
+            return;
+        }
+        frame = document.createElement('iframe');
+        frame.style.display = 'none';
+        frame.src = READY_URL;
+        document.documentElement.appendChild(frame);
+        document.documentElement.removeChild(frame);
+    };
+
+    return {
+        signalReady: function () {
+            ///<summary>Signal that all the scripts are loaded: the listeners are called and the host is notified. Later calls are ignored.</summary>
+            var listeners = myListeners,
+                i;
+
+            if (myIsReady) {
+                return;
+            }
+            myIsReady = true;
+            myListeners = [];
+            for (i = 0; i < listeners.length; i += 1) {
+                listeners[i]();
+            }
+            myNotifyHost();
+        },
+
+        isReady: function () {
+            ///<summary>Check if signalReady has been called.</summary>
+            ///<returns type="Boolean">true once all the scripts are loaded</returns>
+            return myIsReady;
+        },
+
+        onReady: function ( listener ) {
+            ///<summary>Call a function once all the scripts are loaded, immediately if they already are.</summary>
+            ///<param name="listener" type="Function">The function to call, with no arguments.</param>
+            if (typeof listener !== 'function') {
+                throw new PLAYER_SEQUENCER.SequencerError('readiness.onReady listener is not a function');
+            }
+            if (myIsReady) {
+                listener();
+            } else {
+                myListeners.push(listener);
+            }
+        }
+    };
+}());
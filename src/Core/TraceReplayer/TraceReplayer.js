@@ -0,0 +1,238 @@
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+// This file is a Node.js command line tool which re-executes a trace recorded with PLAYER_SEQUENCER.traceRecorder
+// at full speed against the Core modules, reports the latency distribution of each call and flags the calls
+// whose results differ from the recorded ones.
+//
+// Usage: node TraceReplayer.js <trace file> [--repeat <count>] [--load <extra script>]... [--json]
+//     --repeat    replay the trace count times, each time in a fresh context (default 1)
+//     --load      an additional script to load after the Core modules, such as a custom sequencer plugin
+//     --json      write the report as JSON instead of text
+//
+// Note: The replay is only faithful for a trace recorded from a fresh start (droppedCount 0). Results which
+//       depend on the wall clock (ages in statistics) or on asynchronous ad fetches are reported as divergent.
+
+/*jslint node: true */
+"use strict";
+
+var fs = require('fs'),
+    path = require('path'),
+    harness = require(path.join(__dirname, '..', 'Benchmark', 'Harness.js')),
+
+    MAX_REPORTED_DIVERGENCES = 10,
+    MAX_PRINTED_RESULT_LENGTH = 200,
+
+    parseArguments = function (argv) {
+        var options = { traceFile: null, repeat: 1, scripts: [], isJSON: false },
+            i;
+
+        for (i = 0; i < argv.length; i += 1) {
+            if (argv[i] === '--repeat') {
+                i += 1;
+                options.repeat = parseInt(argv[i], 10);
+            } else if (argv[i] === '--load') {
+                i += 1;
+                options.scripts.push(path.resolve(argv[i]));
+            } else if (argv[i] === '--json') {
+                options.isJSON = true;
+            } else {
+                options.traceFile = argv[i];
+            }
+        }
+        if (!options.traceFile || !(options.repeat >= 1)) {
+            throw new Error('usage: node TraceReplayer.js <trace file> [--repeat <count>] [--load <extra script>]... [--json]');
+        }
+        return options;
+    },
+
+    createContext = function (scripts) {
+        ///<summary>Load the Core modules (and extra scripts) into a fresh context</summary>
+        ///<returns type="Object">The PLAYER_SEQUENCER namespace of the context</returns>
+        return harness.loadScripts(harness.CORE_SCRIPTS.concat(scripts));
+    },
+
+    getTargetObject = function (namespace, target) {
+        switch (target) {
+            case 'scheduler':
+                return namespace.scheduler;
+            case 'sequencer':
+                return namespace.sequencerPluginChain;
+            case 'adResolver':
+                return namespace.theAdResolver;
+            default:
+                throw new Error('unknown trace target: ' + target);
+        }
+    },
+
+    getCallName = function (record) {
+        ///<summary>The name used to group the latencies of a record: target.method:func</summary>
+        var func = '?';
+
+        if (record[1] === 'runJSON') {
+            try {
+                func = JSON.parse(record[2]).func;
+            }
+            catch (ex) {
+                func = '(invalid JSON)';
+            }
+        } else {
+            func = record[2][0];
+        }
+        return record[0] + '.' + record[1] + ':' + func;
+    },
+
+    normalizeResult = function (result) {
+        ///<summary>Drop the stack of an exception result since it contains file names which differ between hosts</summary>
+        var parsed;
+
+        if (result === undefined || result === null) {
+            // Note: the trace JSON records an undefined result as null
+            return null;
+        }
+        if (typeof result === 'string' && result.indexOf('{"EXCEPTION":') === 0) {
+            try {
+                parsed = JSON.parse(result);
+                return JSON.stringify({ EXCEPTION: { name: parsed.EXCEPTION.name, message: parsed.EXCEPTION.message } });
+            }
+            catch (ex) {
+                return result;
+            }
+        }
+        return result;
+    },
+
+    percentile = function (sorted, fraction) {
+        return sorted[Math.min(sorted.length - 1, Math.floor(fraction * sorted.length))];
+    },
+
+    replay = function (trace, options) {
+        var latencies = {},         // call name -> array of milliseconds
+            divergences = [],
+            divergentCount = 0,
+            namespace,
+            owner,
+            record,
+            result,
+            startTime,
+            duration,
+            pass,
+            i;
+
+        for (pass = 0; pass < options.repeat; pass += 1) {
+            namespace = createContext(options.scripts);
+            for (i = 0; i < trace.records.length; i += 1) {
+                record = trace.records[i];
+                owner = getTargetObject(namespace, record[0]);
+
+                startTime = process.hrtime();
+                if (record[1] === 'runJSON') {
+                    result = owner.runJSON(record[2]);
+                } else {
+                    result = owner[record[1]].apply(owner, record[2]);
+                }
+                duration = process.hrtime(startTime);
+
+                if (!latencies.hasOwnProperty(getCallName(record))) {
+                    latencies[getCallName(record)] = [];
+                }
+                latencies[getCallName(record)].push(duration[0] * 1000 + duration[1] / 1e6);
+
+                if (pass === 0 && normalizeResult(result) !== normalizeResult(record[3])) {
+                    divergentCount += 1;
+                    if (divergences.length < MAX_REPORTED_DIVERGENCES) {
+                        divergences.push({ index: i, call: getCallName(record), recorded: record[3], replayed: result });
+                    }
+                }
+            }
+        }
+        return { latencies: latencies, divergentCount: divergentCount, divergences: divergences };
+    },
+
+    buildReport = function (trace, options, replayResult) {
+        var calls = [],
+            name,
+            samples,
+            total,
+            i;
+
+        for (name in replayResult.latencies) {
+            if (replayResult.latencies.hasOwnProperty(name)) {
+                samples = replayResult.latencies[name].sort(function (a, b) { return a - b; });
+                total = 0;
+                for (i = 0; i < samples.length; i += 1) {
+                    total += samples[i];
+                }
+                calls.push({
+                    call: name,
+                    count: samples.length,
+                    mean: total / samples.length,
+                    p50: percentile(samples, 0.5),
+                    p90: percentile(samples, 0.9),
+                    p99: percentile(samples, 0.99),
+                    max: samples[samples.length - 1]
+                });
+            }
+        }
+        calls.sort(function (a, b) { return (b.mean * b.count) - (a.mean * a.count); });
+
+        return {
+            recordCount: trace.records.length,
+            droppedCount: trace.droppedCount,
+            repeat: options.repeat,
+            calls: calls,
+            divergentCount: replayResult.divergentCount,
+            divergences: replayResult.divergences
+        };
+    },
+
+    printReport = function (report) {
+        var fixed = function (value) { return value.toFixed(4); },
+            shorten = function (value) {
+                var text = String(value);
+                return (text.length > MAX_PRINTED_RESULT_LENGTH) ? text.slice(0, MAX_PRINTED_RESULT_LENGTH) + '...' : text;
+            },
+            i;
+
+        console.log('records: ' + report.recordCount + ', repeat: ' + report.repeat + ', divergent results: ' + report.divergentCount);
+        if (report.droppedCount > 0) {
+            console.log('WARNING: the trace lost its first ' + report.droppedCount + ' calls, results are expected to diverge');
+        }
+        console.log('call\tcount\tmean ms\tp50 ms\tp90 ms\tp99 ms\tmax ms');
+        for (i = 0; i < report.calls.length; i += 1) {
+            console.log([report.calls[i].call, report.calls[i].count, fixed(report.calls[i].mean), fixed(report.calls[i].p50),
+                fixed(report.calls[i].p90), fixed(report.calls[i].p99), fixed(report.calls[i].max)].join('\t'));
+        }
+        for (i = 0; i < report.divergences.length; i += 1) {
+            console.log('DIVERGENT #' + report.divergences[i].index + ' ' + report.divergences[i].call);
+            console.log('  recorded: ' + shorten(report.divergences[i].recorded));
+            console.log('  replayed: ' + shorten(report.divergences[i].replayed));
+        }
+    },
+
+    main = function () {
+        var options = parseArguments(process.argv.slice(2)),
+            trace = JSON.parse(fs.readFileSync(options.traceFile, 'utf8')),
+            report = buildReport(trace, options, replay(trace, options));
+
+        if (options.isJSON) {
+            console.log(JSON.stringify(report));
+        } else {
+            printReport(report);
+        }
+        process.exitCode = (report.divergentCount > 0) ? 1 : 0;
+    };
+
+main();
@@ -1,51 +1,83 @@
-// ----------------------------------------------------------------------------
-// Copyright (c) Microsoft Corporation. All rights reserved.
-// ----------------------------------------------------------------------------
-//
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-// http://www.apache.org/licenses/LICENSE-2.0
-//
-// THIS CODE IS PROVIDED *AS IS* BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
-// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
-// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
-//
-
-#import <Foundation/Foundation.h>
-#import <UIKit/UIkit.h>
-
-#import "SeekbarTime.h"
-#import "AdResolver.h"
-#import "Scheduler.h"
-
-@class PlaybackSegment;
-
-@interface Sequencer : NSObject
-{
-@private
-    UIWebView *webView;
-    AdResolver *adResolver;
-    Scheduler *scheduler;
-    NSError *lastError;
-}
-
-@property(nonatomic, retain) AdResolver *adResolver;
-@property(nonatomic, retain) Scheduler *scheduler;
-@property(nonatomic, retain) NSError *lastError;
-
-- (id)init;
-- (BOOL) getSeekbarTime:(SeekbarTime **)seekTime andPlaybackPolicy:(PlaybackPolicy **)policy withManifestTime:(ManifestTime *)aManifestTime playbackRate:(double)aRate currentSegment:(PlaybackSegment *)aSegment playbackRangeExceeded:(BOOL *)rangeExceeded;
-- (BOOL) getLinearTime:(NSTimeInterval *)linearTime withManifestTime:(ManifestTime *)aManifestTime currentSegment:(PlaybackSegment *)aSegment;
-- (BOOL) getSegmentAfterSeek:(PlaybackSegment **)seekSegment withLinearPosition:(NSTimeInterval)linearSeekPosition;
-- (BOOL) getSegmentAfterSeek:(PlaybackSegment **)seekSegment withSeekbarPosition:(SeekbarTime *)seekbarPosition currentSegment:(PlaybackSegment *)aSegment;
-- (BOOL) getSegmentOnEndOfMedia:(PlaybackSegment **)nextSegment withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition currentPlaybackRate:(double)playbackRate isNotPlayed:(BOOL)isNotPlayed isEndOfSequence:(BOOL)isEndOfSequence;
-- (BOOL) getSegmentOnEndOfBuffering:(PlaybackSegment **)nextSegment withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition currentPlaybackRate:(double)playbackRate;
-- (BOOL) getSegmentOnError:(PlaybackSegment **)nextSegment withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition currentPlaybackRate:(double)playbackRate error:(NSString *)error isNotPlayed:(BOOL)isNotPlayed isEndOfSequence:(BOOL)isEndOfSequence;
-
-@end
-
-extern NSString * const PlayerSequencerErrorNotification;
-extern NSString * const PlayerSequencerErrorArgsUserInfoKey;
-
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIkit.h>
+
+#import "SeekbarTime.h"
+#import "AdResolver.h"
+#import "Scheduler.h"
+
+@class PlaybackSegment;
+
+typedef enum
+{
+    SkippedAdPolicy_None,           // a plain seek, the ads skipped over are left as they are
+    SkippedAdPolicy_PlayLast,       // play the last ad break skipped over and mark the others as played
+    SkippedAdPolicy_PlayAll,        // play all the ad breaks skipped over in order
+    SkippedAdPolicy_MarkPlayed      // play none of the ad breaks skipped over and mark them all as played
+} SkippedAdPolicy;
+
+@interface Sequencer : NSObject <UIWebViewDelegate>
+{
+@private
+    UIWebView *webView;
+    AdResolver *adResolver;
+    Scheduler *scheduler;
+    NSError *lastError;
+    int32_t playlistVersion;
+    BOOL isReady;
+}
+
+@property(nonatomic, retain) AdResolver *adResolver;
+@property(nonatomic, retain) Scheduler *scheduler;
+@property(nonatomic, retain) NSError *lastError;
+@property(nonatomic, readonly) int32_t playlistVersion;
+@property(nonatomic, readonly) BOOL isReady;
+
+- (id)init;
+- (BOOL) getSeekbarTime:(SeekbarTime **)seekTime andPlaybackPolicy:(PlaybackPolicy **)policy withManifestTime:(ManifestTime *)aManifestTime playbackRate:(double)aRate currentSegment:(PlaybackSegment *)aSegment playbackRangeExceeded:(BOOL *)rangeExceeded;
+- (BOOL) getSeekbarTime:(SeekbarTime **)seekTime andPlaybackPolicy:(PlaybackPolicy **)policy withManifestTime:(ManifestTime *)aManifestTime playbackRate:(double)aRate currentSegment:(PlaybackSegment *)aSegment playbackRangeExceeded:(BOOL *)rangeExceeded preloadThreshold:(NSTimeInterval)preloadThreshold isPreloadThresholdReached:(BOOL *)preloadThresholdReached;
+- (BOOL) getLinearTime:(NSTimeInterval *)linearTime withManifestTime:(ManifestTime *)aManifestTime currentSegment:(PlaybackSegment *)aSegment;
+- (BOOL) getSegmentAfterSeek:(PlaybackSegment **)seekSegment withLinearPosition:(NSTimeInterval)linearSeekPosition;
+- (BOOL) getSegmentAfterSeek:(PlaybackSegment **)seekSegment withSeekbarPosition:(SeekbarTime *)seekbarPosition currentSegment:(PlaybackSegment *)aSegment;
+- (BOOL) getSegmentAfterSeek:(PlaybackSegment **)seekSegment skippedAds:(NSDictionary **)skippedAds withSeekbarPosition:(SeekbarTime *)seekbarPosition currentSegment:(PlaybackSegment *)aSegment manifestTime:(NSTimeInterval)playbackPosition skippedAdPolicy:(SkippedAdPolicy)policy;
+- (BOOL) getSegmentOnEndOfMedia:(PlaybackSegment **)nextSegment withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition currentPlaybackRate:(double)playbackRate isNotPlayed:(BOOL)isNotPlayed isEndOfSequence:(BOOL)isEndOfSequence;
+- (BOOL) getSegmentOnEndOfBuffering:(PlaybackSegment **)nextSegment withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition currentPlaybackRate:(double)playbackRate;
+- (BOOL) getSegmentOnError:(PlaybackSegment **)nextSegment withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition currentPlaybackRate:(double)playbackRate error:(NSString *)error isNotPlayed:(BOOL)isNotPlayed isEndOfSequence:(BOOL)isEndOfSequence;
+- (BOOL) getUpcomingSegments:(NSArray **)segments withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition currentPlaybackRate:(double)playbackRate maxCount:(int32_t)maxCount horizon:(NSTimeInterval)horizon;
+- (BOOL) getPreloadLeadTime:(NSTimeInterval *)leadTime forSegment:(PlaybackSegment *)aSegment;
+- (BOOL) beginPreloadOfSegment:(PlaybackSegment *)aSegment;
+- (BOOL) endPreloadOfSegment:(PlaybackSegment *)aSegment;
+- (BOOL) cancelPreloadOfSegment:(PlaybackSegment *)aSegment;
+- (BOOL) releaseSegment:(PlaybackSegment *)aSegment;
+- (BOOL) beginScrub:(int32_t *)scrubId withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition;
+- (BOOL) submitScrubPosition:(NSTimeInterval)seekbarPosition scrubId:(int32_t)scrubId;
+- (BOOL) commitScrub:(PlaybackSegment **)seekSegment crossedAdEntryIds:(NSArray **)crossedIds scrubId:(int32_t)scrubId currentSegment:(PlaybackSegment *)aSegment;
+- (BOOL) commitScrub:(PlaybackSegment **)seekSegment skippedAds:(NSDictionary **)skippedAds scrubId:(int32_t)scrubId currentSegment:(PlaybackSegment *)aSegment skippedAdPolicy:(SkippedAdPolicy)policy;
+- (BOOL) cancelScrub:(int32_t)scrubId;
+- (BOOL) getSegmentPoolStatistics:(NSDictionary **)statistics;
+- (BOOL) startTraceRecordingWithCapacity:(int32_t)capacity;
+- (BOOL) stopTraceRecording;
+- (BOOL) getTrace:(NSString **)trace;
+- (BOOL) setMetricsEnabled:(BOOL)enabled;
+- (BOOL) getMetrics:(NSString **)metrics reset:(BOOL)reset;
+
+@end
+
+extern NSString * const PlayerSequencerErrorNotification;
+extern NSString * const PlayerSequencerErrorArgsUserInfoKey;
+extern NSString * const SequencerReadyNotification;
+
@@ -1,63 +1,63 @@
-// ----------------------------------------------------------------------------
-// Copyright (c) Microsoft Corporation. All rights reserved.
-// ----------------------------------------------------------------------------
-//
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-// http://www.apache.org/licenses/LICENSE-2.0
-//
-// THIS CODE IS PROVIDED *AS IS* BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
-// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
-// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
-//
-
-#import "AVPlayerLayerView.h"
-
-#import <AVFoundation/AVFoundation.h>
-
-/* ---------------------------------------------------------
-**  To play the visual component of an asset, you need a view 
-**  containing an AVPlayerLayer layer to which the output of an 
-**  AVPlayer object can be directed. You can create a simple 
-**  subclass of UIView to accommodate this. Use the view?s Core 
-**  Animation layer (see the 'layer' property) for rendering.  
-**  This class is a subclass of UIView that is used for this 
-**  purpose.
-** ------------------------------------------------------- */
-
-@implementation AVPlayerLayerView
-
-@synthesize status;
-
-+ (Class)layerClass
-{
-	return [AVPlayerLayer class];
-}
-
-- (AVPlayerLayer *)playerLayer
-{
-	return (AVPlayerLayer *)self.layer;
-}
-
-- (void)setPlayer:(AVPlayer*)anAVPlayer
-{
-	[(AVPlayerLayer*)[self layer] setPlayer:anAVPlayer];
-}
-
-- (AVPlayer *)player
-{
-    return ((AVPlayerLayer *)[self layer]).player;
-}
-
-/* Specifies how the video is displayed within a player layer?s bounds. 
- (AVLayerVideoGravityResizeAspect is default) */
-- (void)setVideoFillMode:(NSString *)fillMode
-{
-	AVPlayerLayer *playerLayer = (AVPlayerLayer*)[self layer];
-	playerLayer.videoGravity = fillMode;
-}
-
-
-@end
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+#import "AVPlayerLayerView.h"
+
+#import <AVFoundation/AVFoundation.h>
+
+/* ---------------------------------------------------------
+**  To play the visual component of an asset, you need a view 
+**  containing an AVPlayerLayer layer to which the output of an 
+**  AVPlayer object can be directed. You can create a simple 
+**  subclass of UIView to accommodate this. Use the view?s Core 
+**  Animation layer (see the 'layer' property) for rendering.  
+**  This class is a subclass of UIView that is used for this 
+**  purpose.
+** ------------------------------------------------------- */
+
+@implementation AVPlayerLayerView
+
+@synthesize status;
+
++ (Class)layerClass
+{
+	return [AVPlayerLayer class];
+}
+
+- (AVPlayerLayer *)playerLayer
+{
+	return (AVPlayerLayer *)self.layer;
+}
+
+- (void)setPlayer:(AVPlayer*)anAVPlayer
+{
+	[(AVPlayerLayer*)[self layer] setPlayer:anAVPlayer];
+}
+
+- (AVPlayer *)player
+{
+    return ((AVPlayerLayer *)[self layer]).player;
+}
+
+/* Specifies how the video is displayed within a player layer?s bounds. 
+ (AVLayerVideoGravityResizeAspect is default) */
+- (void)setVideoFillMode:(NSString *)fillMode
+{
+	AVPlayerLayer *playerLayer = (AVPlayerLayer*)[self layer];
+	playerLayer.videoGravity = fillMode;
+}
+
+
+@end
@@ -1,280 +1,525 @@
-// ----------------------------------------------------------------------------
-// Copyright (c) Microsoft Corporation. All rights reserved.
-// ----------------------------------------------------------------------------
-//
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-// http://www.apache.org/licenses/LICENSE-2.0
-//
-// THIS CODE IS PROVIDED *AS IS* BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
-// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
-// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
-//
-
-#import "Scheduler_Internal.h"
-#import "Sequencer_Internal.h"
-
-// Define constant like: NSString * const NotImplementedException = @"NotImplementedException";
-
-@implementation Scheduler
-
-@synthesize lastError;
-
-#pragma mark -
-#pragma mark Internal class methods:
-
-
-#pragma mark -
-#pragma mark Private instance methods:
-
-- (NSString *) callJavaScriptWithString:(NSString *)aString
-{
-    NSLog(@"JavaScript call: %s", [aString cStringUsingEncoding:NSUTF8StringEncoding]);
-    NSString *result = [webView stringByEvaluatingJavaScriptFromString:aString];
-    
-    NSLog(@"JavaScript result is %@", result);
-
-    NSError *error = [Sequencer parseJSONException:result];
-    if (nil != error)
-    {
-        self.lastError = error;
-        result = nil;
-    }
-
-    return result;
-}
-
-#pragma mark -
-#pragma mark Notification callbacks:
-
-
-#pragma mark -
-#pragma mark Public instance methods:
-
-
-//
-// Constructor for the sequencer
-//
-// Arguments:
-// [aWebView]    UIWebView used for JavaScript calls
-//
-// Returns: The scheduler instance.
-//
-- (id) initWithUIWebView:(UIWebView *)aWebView;
-{
-    self = [super init];
-    
-    if (self){
-        webView = aWebView;
-        lastError = nil;
-    }
-    
-    return self;
-}
-
-//
-// schedule an ad clip in the framework
-//
-// Arguments:
-// [ad]: The ad clip to be scheduled
-// [linearTime]: The time when the ad should be played in the linear timeline
-// [type]: The type of the ad
-// [clipId]: The output clipId for the scheduled clip
-//
-// Returns: YES for success and NO for failure
-//
-- (BOOL) scheduleClip:(AdInfo *)ad atTime:(LinearTime *)linearTime forType:(PlaylistEntryType)type andGetClipId:(int32_t *)clipId
-{
-    assert (nil != clipId);
-    NSString *result = nil;
-
-    // TODO: ignore the playback policy object for now
-    NSString *eRollType = nil;
-    switch (ad.type) {
-        case AdType_Preroll:
-            eRollType = @"Pre";
-            break;
-            
-        case AdType_Midroll:
-            eRollType = @"Mid";
-            break;
-            
-        case AdType_Postroll:
-            eRollType = @"Post";
-            break;
-            
-        case AdType_Pod:
-            eRollType = @"Pod";
-            break;
-            
-        default:
-            eRollType = @"Mid";
-            break;
-    }
-    
-    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.scheduler.runJSON("
-                          "\"{\\\"func\\\": \\\"scheduleClip\\\","
-                          "\\\"params\\\": "
-                          "{ \\\"clipURI\\\": \\\"%s\\\", "
-                          "\\\"eClipType\\\": \\\"Media\\\", "
-                          "\\\"minManifestPosition\\\": %f, "
-                          "\\\"maxManifestPosition\\\": %f, "
-                          "\\\"startTime\\\": %f, "
-                          "\\\"linearDuration\\\": %f, "
-                          "\\\"deleteAfterPlay\\\": %s, "
-                          "\\\"eRollType\\\": \\\"%@\\\", "
-                          "\\\"appendTo\\\": %d } }\")",
-                          [[ad.clipURL absoluteString] cStringUsingEncoding:NSUTF8StringEncoding],
-                          ad.renderTime.minManifestPosition,
-                          ad.renderTime.maxManifestPosition,
-                          linearTime.startTime,
-                          linearTime.duration,
-                          ad.deleteAfterPlay ? "true" : "false",
-                          eRollType,
-                          ad.appendTo] autorelease];
-    result = [self callJavaScriptWithString:function];
-
-    if (nil != result)
-    {
-        NSData* data = [result dataUsingEncoding:[NSString defaultCStringEncoding]];
-        NSError* error = nil;
-        NSDictionary* json_out = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
-        assert (nil == error);
-        NSNumber *nId = [json_out objectForKey:@"id"];
-        *clipId = [nId intValue];
-    }
-    
-    return (nil != result);
-}
-
-//
-// cancel a specific ad in the framework
-//
-// Arguments:
-// [clipId] the clipId of the ad to be cancelled
-//
-// Returns: YES for success and NO for failure
-//
-- (BOOL) cancelClip:(int32_t)clipId
-{
-    BOOL success = YES;
-
-    // TODO: implement this
-    
-    return success;
-}
-
-//
-// append main content to the playlist in the framework
-//
-// Arguments:
-// [clipURL]: The URL of the clip to be appended
-// [manifestTime]: The minimum and maximum rendering time in the manifest time
-// [clipId]: The output clipId for the content that is appended
-//
-// Returns: YES for success and NO for failure
-//
-- (BOOL) appendContentClip:(NSURL *)clipURL withManifestTime:(ManifestTime *)manifestTime andGetClipId:(int32_t *)clipId
-{
-    assert (nil != clipId);
-    NSString *result = nil;
-    
-    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.scheduler.runJSON("
-                          "\"{\\\"func\\\": \\\"appendContentClip\\\", "
-                          "\\\"params\\\": "
-                          "{ \\\"clipURI\\\": \\\"%s\\\", "
-                          "\\\"minManifestPosition\\\": %f, "
-                          "\\\"maxManifestPosition\\\": %f } }\")",
-                          [[clipURL absoluteString] cStringUsingEncoding:NSUTF8StringEncoding],
-                          manifestTime.minManifestPosition,
-                          manifestTime.maxManifestPosition] autorelease];
-    result = [self callJavaScriptWithString:function];
-    
-    if (nil != result)
-    {
-        NSData* data = [result dataUsingEncoding:[NSString defaultCStringEncoding]];
-        NSError* error = nil;
-        NSDictionary* json_out = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
-        NSNumber *nId = [json_out objectForKey:@"id"];
-        *clipId = [nId intValue];
-    }
-    
-    return (nil != result);
-}
-
-//
-// set the SeekToStart entry in the sequential playlist
-//
-// Arguments: none
-//
-// Returns: YES for success and NO for failure
-//
-- (BOOL) setSeekToStart
-{
-    return [self setSeekToStartWithURL:nil];
-}
-
-//
-// set the SeekToStart entry in the sequential playlist
-//
-// Arguments:
-// [clipURI]: The URL of the clip to start first after all the preroll ads
-//
-// Returns: YES for success and NO for failure
-//
-- (BOOL) setSeekToStartWithURL:(NSURL *)clipURI
-{
-    NSString *result = nil;
-    NSString *function = nil;
-    
-    if (nil != clipURI)
-    {
-        function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.scheduler.runJSON("
-                     "\"{\\\"func\\\": \\\"setSeekToStart\\\", "
-                     "\\\"params\\\": "
-                     "{ \\\"clipURI\\\": \\\"%s\\\" } }\")",
-                     [[clipURI absoluteString] cStringUsingEncoding:NSUTF8StringEncoding]] autorelease];        
-    }
-    else
-    {
-        function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.scheduler.runJSON("
-                     "\"{\\\"func\\\": \\\"setSeekToStart\\\" }\")"] autorelease];
-    }
-    result = [self callJavaScriptWithString:function];
-
-    return (nil != result);
-}
-
-#pragma mark -
-#pragma mark Properties:
-
-- (BOOL) isReady
-{
-    NSString *result = nil;
-    NSString *function = nil;
-    
-    function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.scheduler.runJSON("
-                 "\"{\\\"func\\\": \\\"createContentClipParams\\\" }\")"] autorelease];
-    NSLog(@"JavaScript call: %s", [function cStringUsingEncoding:NSUTF8StringEncoding]);
-    result = [webView stringByEvaluatingJavaScriptFromString:function];
-    
-    NSLog(@"JavaScript result is %@", result);
-    
-    return (0 < [result length]);
-}
-
-#pragma mark -
-#pragma mark Destructor:
-
-- (void) dealloc
-{
-    NSLog(@"Scheduler dealloc called.");
-    
-    [lastError release];
-    
-    [super dealloc];
-}
-
-@end
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+#import "Scheduler_Internal.h"
+#import "Sequencer_Internal.h"
+
+// Define constant like: NSString * const NotImplementedException = @"NotImplementedException";
+
+@implementation Scheduler
+
+@synthesize lastError;
+
+#pragma mark -
+#pragma mark Internal class methods:
+
++ (NSString *) rollTypeFromAdType:(AdType)type
+{
+    NSString *eRollType = nil;
+    switch (type) {
+        case AdType_Preroll:
+            eRollType = @"Pre";
+            break;
+            
+        case AdType_Midroll:
+            eRollType = @"Mid";
+            break;
+            
+        case AdType_Postroll:
+            eRollType = @"Post";
+            break;
+            
+        case AdType_Pod:
+            eRollType = @"Pod";
+            break;
+            
+        default:
+            eRollType = @"Mid";
+            break;
+    }
+    
+    return eRollType;
+}
+
+#pragma mark -
+#pragma mark Private instance methods:
+
+- (void) setSecondsOnlyError:(NSString *)function
+{
+    NSMutableDictionary *userInfo = [[NSMutableDictionary alloc] init];
+    [userInfo setObject:@"PLAYER_SEQUENCER:SchedulerError" forKey:NSLocalizedDescriptionKey];
+    [userInfo setObject:[NSString stringWithFormat:@"%@ of a timescale: the times of this schedule are in seconds", function]
+                 forKey:NSLocalizedFailureReasonErrorKey];
+    self.lastError = [NSError errorWithDomain:@"PLAYER_SEQUENCER" code:0 userInfo:userInfo];
+    [userInfo release];
+}
+
+- (NSString *) callJavaScriptWithString:(NSString *)aString
+{
+    NSLog(@"JavaScript call: %s", [aString cStringUsingEncoding:NSUTF8StringEncoding]);
+    NSString *result = [webView stringByEvaluatingJavaScriptFromString:aString];
+    
+    NSLog(@"JavaScript result is %@", result);
+
+    NSError *error = [Sequencer parseJSONException:result];
+    if (nil != error)
+    {
+        self.lastError = error;
+        result = nil;
+    }
+
+    return result;
+}
+
+#pragma mark -
+#pragma mark Notification callbacks:
+
+
+#pragma mark -
+#pragma mark Public instance methods:
+
+
+//
+// Constructor for the sequencer
+//
+// Arguments:
+// [aWebView]    UIWebView used for JavaScript calls
+//
+// Returns: The scheduler instance.
+//
+- (id) initWithUIWebView:(UIWebView *)aWebView;
+{
+    self = [super init];
+    
+    if (self){
+        webView = aWebView;
+        lastError = nil;
+        isSecondsOnly = NO;
+    }
+    
+    return self;
+}
+
+//
+// keep the times of the schedule in seconds, for an owner such as SequencerAVPlayerFramework which passes
+// and reads all the times in seconds. setTimescale and restoreSnapshot then refuse a timescale in ticks.
+//
+// Arguments:
+// [secondsOnly]: YES to refuse a timescale in ticks
+//
+- (void) setSecondsOnly:(BOOL)secondsOnly
+{
+    isSecondsOnly = secondsOnly;
+}
+
+//
+// schedule an ad clip in the framework
+//
+// Arguments:
+// [ad]: The ad clip to be scheduled
+// [linearTime]: The time when the ad should be played in the linear timeline
+// [type]: The type of the ad
+// [clipId]: The output clipId for the scheduled clip
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) scheduleClip:(AdInfo *)ad atTime:(LinearTime *)linearTime forType:(PlaylistEntryType)type andGetClipId:(int32_t *)clipId
+{
+    assert (nil != clipId);
+    NSString *result = nil;
+
+    // TODO: ignore the playback policy object for now
+    NSString *eRollType = [Scheduler rollTypeFromAdType:ad.type];
+    
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.scheduler.runJSON("
+                          "\"{\\\"func\\\": \\\"scheduleClip\\\","
+                          "\\\"params\\\": "
+                          "{ \\\"clipURI\\\": \\\"%s\\\", "
+                          "\\\"eClipType\\\": \\\"Media\\\", "
+                          "\\\"minManifestPosition\\\": %f, "
+                          "\\\"maxManifestPosition\\\": %f, "
+                          "\\\"startTime\\\": %f, "
+                          "\\\"linearDuration\\\": %f, "
+                          "\\\"deleteAfterPlay\\\": %s, "
+                          "\\\"eRollType\\\": \\\"%@\\\", "
+                          "\\\"appendTo\\\": %d } }\")",
+                          [[ad.clipURL absoluteString] cStringUsingEncoding:NSUTF8StringEncoding],
+                          ad.renderTime.minManifestPosition,
+                          ad.renderTime.maxManifestPosition,
+                          linearTime.startTime,
+                          linearTime.duration,
+                          ad.deleteAfterPlay ? "true" : "false",
+                          eRollType,
+                          ad.appendTo] autorelease];
+    result = [self callJavaScriptWithString:function];
+
+    if (nil != result)
+    {
+        NSData* data = [result dataUsingEncoding:[NSString defaultCStringEncoding]];
+        NSError* error = nil;
+        NSDictionary* json_out = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
+        assert (nil == error);
+        NSNumber *nId = [json_out objectForKey:@"id"];
+        *clipId = [nId intValue];
+    }
+    
+    return (nil != result);
+}
+
+//
+// schedule several ad clips in the framework with a single call
+//
+// Arguments:
+// [ads]: The AdInfo objects of the ad clips to be scheduled
+// [linearTimes]: The LinearTime object for each ad clip, in the same order as ads
+// [clipIds]: The output array of NSNumber clipIds for the scheduled clips, in the same order as ads
+//
+// Returns: YES for success and NO for failure. Nothing is scheduled on failure.
+//
+- (BOOL) scheduleClips:(NSArray *)ads atTimes:(NSArray *)linearTimes andGetClipIds:(NSArray **)clipIds
+{
+    assert (nil != clipIds);
+    assert ([ads count] == [linearTimes count]);
+    NSString *result = nil;
+    BOOL success = NO;
+    *clipIds = nil;
+
+    NSMutableString *function = [[[NSMutableString alloc] initWithString:@"PLAYER_SEQUENCER.scheduler.runJSON("
+                                  "\"{\\\"func\\\": \\\"scheduleClips\\\","
+                                  "\\\"params\\\": [ "] autorelease];
+    for (NSUInteger i = 0; i < [ads count]; ++i)
+    {
+        AdInfo *ad = [ads objectAtIndex:i];
+        LinearTime *linearTime = [linearTimes objectAtIndex:i];
+        
+        // TODO: ignore the playback policy object for now
+        [function appendFormat:@"%@{ \\\"clipURI\\\": \\\"%s\\\", "
+                               "\\\"eClipType\\\": \\\"Media\\\", "
+                               "\\\"minManifestPosition\\\": %f, "
+                               "\\\"maxManifestPosition\\\": %f, "
+                               "\\\"startTime\\\": %f, "
+                               "\\\"linearDuration\\\": %f, "
+                               "\\\"deleteAfterPlay\\\": %s, "
+                               "\\\"eRollType\\\": \\\"%@\\\", "
+                               "\\\"appendTo\\\": %d }",
+                               (0 == i) ? @"" : @", ",
+                               [[ad.clipURL absoluteString] cStringUsingEncoding:NSUTF8StringEncoding],
+                               ad.renderTime.minManifestPosition,
+                               ad.renderTime.maxManifestPosition,
+                               linearTime.startTime,
+                               linearTime.duration,
+                               ad.deleteAfterPlay ? "true" : "false",
+                               [Scheduler rollTypeFromAdType:ad.type],
+                               ad.appendTo];
+    }
+    [function appendString:@" ] }\")"];
+    result = [self callJavaScriptWithString:function];
+
+    if (nil != result)
+    {
+        NSData* data = [result dataUsingEncoding:[NSString defaultCStringEncoding]];
+        NSError* error = nil;
+        NSDictionary* json_out = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
+        assert (nil == error);
+        NSArray *nErrors = [json_out objectForKey:@"errors"];
+        NSArray *nEntries = [json_out objectForKey:@"entries"];
+        
+        if (0 < [nErrors count])
+        {
+            // Report the first invalid clip; none of the clips were scheduled
+            NSDictionary *nError = [nErrors objectAtIndex:0];
+            NSMutableDictionary *userInfo = [[NSMutableDictionary alloc] init];
+            [userInfo setObject:[nError objectForKey:@"name"] forKey:NSLocalizedDescriptionKey];
+            [userInfo setObject:[NSString stringWithFormat:@"clip %@: %@", [nError objectForKey:@"index"], [nError objectForKey:@"message"]]
+                         forKey:NSLocalizedFailureReasonErrorKey];
+            self.lastError = [NSError errorWithDomain:@"PLAYER_SEQUENCER" code:0 userInfo:userInfo];
+            [userInfo release];
+        }
+        else
+        {
+            NSMutableArray *ids = [NSMutableArray arrayWithCapacity:[nEntries count]];
+            for (NSDictionary *nEntry in nEntries)
+            {
+                [ids addObject:[nEntry objectForKey:@"id"]];
+            }
+            *clipIds = ids;
+            success = YES;
+        }
+    }
+    
+    return success;
+}
+
+//
+// cancel a specific ad in the framework
+//
+// Arguments:
+// [clipId] the clipId of the ad to be cancelled
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) cancelClip:(int32_t)clipId
+{
+    BOOL success = YES;
+
+    // TODO: implement this
+    
+    return success;
+}
+
+//
+// append main content to the playlist in the framework
+//
+// Arguments:
+// [clipURL]: The URL of the clip to be appended
+// [manifestTime]: The minimum and maximum rendering time in the manifest time
+// [clipId]: The output clipId for the content that is appended
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) appendContentClip:(NSURL *)clipURL withManifestTime:(ManifestTime *)manifestTime andGetClipId:(int32_t *)clipId
+{
+    assert (nil != clipId);
+    NSString *result = nil;
+    
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.scheduler.runJSON("
+                          "\"{\\\"func\\\": \\\"appendContentClip\\\", "
+                          "\\\"params\\\": "
+                          "{ \\\"clipURI\\\": \\\"%s\\\", "
+                          "\\\"minManifestPosition\\\": %f, "
+                          "\\\"maxManifestPosition\\\": %f } }\")",
+                          [[clipURL absoluteString] cStringUsingEncoding:NSUTF8StringEncoding],
+                          manifestTime.minManifestPosition,
+                          manifestTime.maxManifestPosition] autorelease];
+    result = [self callJavaScriptWithString:function];
+    
+    if (nil != result)
+    {
+        NSData* data = [result dataUsingEncoding:[NSString defaultCStringEncoding]];
+        NSError* error = nil;
+        NSDictionary* json_out = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
+        NSNumber *nId = [json_out objectForKey:@"id"];
+        *clipId = [nId intValue];
+    }
+    
+    return (nil != result);
+}
+
+//
+// set the SeekToStart entry in the sequential playlist
+//
+// Arguments: none
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) setSeekToStart
+{
+    return [self setSeekToStartWithURL:nil];
+}
+
+//
+// set the SeekToStart entry in the sequential playlist
+//
+// Arguments:
+// [clipURI]: The URL of the clip to start first after all the preroll ads
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) setSeekToStartWithURL:(NSURL *)clipURI
+{
+    NSString *result = nil;
+    NSString *function = nil;
+    
+    if (nil != clipURI)
+    {
+        function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.scheduler.runJSON("
+                     "\"{\\\"func\\\": \\\"setSeekToStart\\\", "
+                     "\\\"params\\\": "
+                     "{ \\\"clipURI\\\": \\\"%s\\\" } }\")",
+                     [[clipURI absoluteString] cStringUsingEncoding:NSUTF8StringEncoding]] autorelease];        
+    }
+    else
+    {
+        function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.scheduler.runJSON("
+                     "\"{\\\"func\\\": \\\"setSeekToStart\\\" }\")"] autorelease];
+    }
+    result = [self callJavaScriptWithString:function];
+
+    return (nil != result);
+}
+
+//
+// switch the sequential playlist to live mode with a sliding DVR window, or back to VOD mode
+//
+// Arguments:
+// [windowDuration]: the DVR depth in seconds, or in whole ticks after setTimescale. Content and ads entirely before
+//                   the live edge minus this duration are evicted as content is appended, and the minimum seekbar
+//                   position follows. 0 for VOD mode.
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) setLiveWindow:(NSTimeInterval)windowDuration
+{
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.scheduler.runJSON("
+                          "\"{\\\"func\\\": \\\"setLiveWindow\\\", "
+                          "\\\"params\\\": "
+                          "{ \\\"windowDuration\\\": %f } }\")",
+                          windowDuration] autorelease];
+    
+    return (nil != [self callJavaScriptWithString:function]);
+}
+
+//
+// set the time representation of the schedule: floating point seconds, or integer ticks which the sequential
+// playlist adds and compares exactly, such as for a long live timeline. Must be called while the schedule is empty.
+//
+// Arguments:
+// [timescale]: 0 for seconds, else the ticks per second (such as 90000). All the NSTimeInterval times passed to and
+//              returned by the Scheduler and Sequencer are then whole numbers of ticks instead of seconds.
+//
+// Returns: YES for success and NO for failure. It fails for a timescale in ticks when the schedule is owned by
+//          SequencerAVPlayerFramework, which passes all the times in seconds.
+//
+- (BOOL) setTimescale:(int32_t)timescale
+{
+    if (isSecondsOnly && 0 != timescale)
+    {
+        [self setSecondsOnlyError:@"setTimescale"];
+        return NO;
+    }
+
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.scheduler.runJSON("
+                          "\"{\\\"func\\\": \\\"setTimescale\\\", "
+                          "\\\"params\\\": "
+                          "{ \\\"timescale\\\": %d } }\")",
+                          timescale] autorelease];
+    
+    return (nil != [self callJavaScriptWithString:function]);
+}
+
+//
+// get the changes made to the sequential playlist since a given version
+//
+// Arguments:
+// [changes]: the output array of change dictionaries (version, change, id and otherId), oldest first
+// [sinceVersion]: 0 or the currentVersion returned by the previous call (also given by Sequencer playlistVersion)
+// [currentVersion]: the output current playlist version
+// [isTruncated]: the output flag set if older changes were dropped from the journal and the whole playlist must be re-read
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getPlaylistChanges:(NSArray **)changes sinceVersion:(int32_t)sinceVersion currentVersion:(int32_t *)currentVersion isTruncated:(BOOL *)isTruncated
+{
+    assert (nil != changes && nil != currentVersion && nil != isTruncated);
+    NSString *result = nil;
+    *changes = nil;
+    
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.scheduler.runJSON("
+                          "\"{\\\"func\\\": \\\"getPlaylistChanges\\\", "
+                          "\\\"params\\\": "
+                          "{ \\\"sinceVersion\\\": %d } }\")",
+                          sinceVersion] autorelease];
+    result = [self callJavaScriptWithString:function];
+    
+    if (nil != result)
+    {
+        NSData* data = [result dataUsingEncoding:[NSString defaultCStringEncoding]];
+        NSError* error = nil;
+        NSDictionary* json_out = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
+        *currentVersion = [[json_out objectForKey:@"version"] intValue];
+        *isTruncated = [[json_out objectForKey:@"isTruncated"] boolValue];
+        *changes = [json_out objectForKey:@"changes"];
+    }
+    
+    return (nil != *changes);
+}
+
+//
+// get a snapshot of the sequential playlist, such as to save the schedule of a viewer session
+//
+// Arguments:
+// [snapshot]: the output snapshot JSON string, to be passed to restoreSnapshot later
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getSnapshot:(NSString **)snapshot
+{
+    assert (nil != snapshot);
+    *snapshot = [self callJavaScriptWithString:@"PLAYER_SEQUENCER.scheduler.runJSON(\"{\\\"func\\\": \\\"getSnapshot\\\"}\")"];
+    
+    return (nil != *snapshot);
+}
+
+//
+// replace the schedule with a snapshot, instead of scheduling all its clips again
+//
+// Arguments:
+// [snapshot]: a snapshot JSON string returned by getSnapshot
+//
+// Returns: YES for success and NO for failure. The schedule is unchanged on failure. It fails for a snapshot
+//          with a timescale in ticks when the schedule is owned by SequencerAVPlayerFramework.
+//
+- (BOOL) restoreSnapshot:(NSString *)snapshot
+{
+    if (isSecondsOnly)
+    {
+        NSData *data = [snapshot dataUsingEncoding:NSUTF8StringEncoding];
+        NSDictionary *json_out = (nil == data) ? nil : [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:nil];
+        if ([json_out isKindOfClass:[NSDictionary class]] && 0 != [[json_out objectForKey:@"timescale"] intValue])
+        {
+            [self setSecondsOnlyError:@"restoreSnapshot"];
+            return NO;
+        }
+    }
+
+    // Note: the snapshot JSON is inserted as a JavaScript object literal, which JSON.stringify turns back into the runJSON string
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.scheduler.runJSON(JSON.stringify("
+                           "{ func: \"restoreSnapshot\", params: { snapshot: %@ } }))",
+                           snapshot] autorelease];
+    
+    return (nil != [self callJavaScriptWithString:function]);
+}
+
+#pragma mark -
+#pragma mark Properties:
+
+- (BOOL) isReady
+{
+    NSString *result = nil;
+    NSString *function = nil;
+    
+    function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.scheduler.runJSON("
+                 "\"{\\\"func\\\": \\\"createContentClipParams\\\" }\")"] autorelease];
+    NSLog(@"JavaScript call: %s", [function cStringUsingEncoding:NSUTF8StringEncoding]);
+    result = [webView stringByEvaluatingJavaScriptFromString:function];
+    
+    NSLog(@"JavaScript result is %@", result);
+    
+    return (0 < [result length]);
+}
+
+#pragma mark -
+#pragma mark Destructor:
+
+- (void) dealloc
+{
+    NSLog(@"Scheduler dealloc called.");
+    
+    [lastError release];
+    
+    [super dealloc];
+}
+
+@end
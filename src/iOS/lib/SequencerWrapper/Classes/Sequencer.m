@@ -1,524 +1,1123 @@
-// ----------------------------------------------------------------------------
-// Copyright (c) Microsoft Corporation. All rights reserved.
-// ----------------------------------------------------------------------------
-//
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-// http://www.apache.org/licenses/LICENSE-2.0
-//
-// THIS CODE IS PROVIDED *AS IS* BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
-// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
-// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
-//
-
-#import "Sequencer_Internal.h"
-#import "PlaybackSegment_Internal.h"
-#import "Scheduler_Internal.h"
-#import "AdResolver_Internal.h"
-
-// Define constant like: NSString * const NotImplementedException = @"NotImplementedException";
-NSString * const ErrorDomain = @"PLAYER_SEQUENCER";
-NSString * const UnexpectedError = @"PLAYER_SEQUENCER:UnexpectedError";
-
-@implementation Sequencer
-
-@synthesize adResolver;
-@synthesize scheduler;
-@synthesize lastError;
-
-#pragma mark -
-#pragma mark Internal class methods:
-
-+ (NSError *) parseJSONException:(NSString *)jsonResult
-{
-    NSError *error = nil;
-    
-    if (0 == [jsonResult length])
-    {
-        // Empty return from the JavaScript call, which means unexpected error happened.
-        NSMutableDictionary *userInfo = [[NSMutableDictionary alloc] init];
-        [userInfo setObject:UnexpectedError forKey:NSLocalizedDescriptionKey];
-        [userInfo setObject:@"Unexpected JavaScript error happened" forKey:NSLocalizedFailureReasonErrorKey];
-        error = [NSError errorWithDomain:ErrorDomain code:0 userInfo:userInfo];
-        [userInfo release];
-    }
-    else if ([jsonResult hasPrefix:@"{\"EXCEPTION\":"])
-    {
-        // JavaScript code throws an exception
-        do {
-            NSData* data = [jsonResult dataUsingEncoding:[NSString defaultCStringEncoding]];
-            NSDictionary* json_out = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
-            if (nil != error)
-            {
-                break;
-            }
-            
-            NSDictionary *nException = [json_out objectForKey:@"EXCEPTION"];
-            if ([NSNull null] == (NSNull *)nException)
-            {
-                break;
-            }
-            
-            NSString *nName = [nException objectForKey:@"name"];
-            NSString *nMessage = [nException objectForKey:@"message"];
-            
-            NSMutableDictionary *userInfo = [[NSMutableDictionary alloc] init];
-            [userInfo setObject:nName forKey:NSLocalizedDescriptionKey];
-            [userInfo setObject:nMessage forKey:NSLocalizedFailureReasonErrorKey];
-            error = [NSError errorWithDomain:ErrorDomain code:0 userInfo:userInfo];
-            [userInfo release];
-        } while (NO);
-    }        
-    
-    return error;
-}
-
-#pragma mark -
-#pragma mark Private instance methods:
-
-- (PlaybackSegment *) parseJSONPlaybackSegment:(NSString *)jsonResult
-{    
-    NSData* data = [jsonResult dataUsingEncoding:[NSString defaultCStringEncoding]];
-    NSError* error = nil;
-    NSDictionary* json_out = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
-    NSDictionary *nClip = [json_out objectForKey:@"clip"];
-    
-    if ([NSNull null] == (NSNull *)nClip)
-    {
-        return nil;
-    }
-
-    NSNumber *nInitialPlaybackTime = [json_out objectForKey:@"initialPlaybackStartTime"];
-    NSNumber *nInitialPlaybackRate = [json_out objectForKey:@"initialPlaybackRate"];
-    NSNumber *nSegmentId = [json_out objectForKey:@"segmentId"];
-    
-    NSString *nClipURI = [nClip objectForKey:@"clipURI"];
-    NSString *nClipType = [nClip objectForKey:@"eClipType"];
-    NSNumber *nLinearStartTime = [nClip objectForKey:@"linearStartTime"];
-    NSNumber *nLinearDuration = [nClip objectForKey:@"linearDuration"];
-    NSNumber *nMinRenderingTime = [nClip objectForKey:@"minRenderingTime"];
-    NSNumber *nMaxRenderingTime = [nClip objectForKey:@"maxRenderingTime"];
-    NSString *nIsAdvertisement = [nClip objectForKey:@"isAdvertisement"];
-    NSDictionary *nPlaybackPolicy = [nClip objectForKey:@"playbackPolicyObj"];
-    NSString *nDeleteAfterPlay = [nClip objectForKey:@"deleteAfterPlay"];
-    NSNumber *nId = [nClip objectForKey:@"id"];
-    NSNumber *nIdSplitFrom = [nClip objectForKey:@"idSplitFrom"];
-    
-    PlaylistEntry *clip = [[[PlaylistEntry alloc] init] autorelease];
-    PlaybackSegment *segment = [[PlaybackSegment alloc] init];
-    
-    if (![nClipType isEqualToString:@"SeekToStart"])
-    {
-        clip.clipURI = [NSURL URLWithString:nClipURI];
-    }
-    clip.linearTime = [[[LinearTime alloc] init] autorelease];
-    clip.linearTime.startTime = [nLinearStartTime floatValue];
-    clip.linearTime.duration = [nLinearDuration floatValue];
-    clip.renderTime = [[[ManifestTime alloc] init] autorelease];
-    clip.renderTime.minManifestPosition = [nMinRenderingTime floatValue];
-    clip.renderTime.maxManifestPosition = [nMaxRenderingTime floatValue];
-    clip.isAdvertisement = [nIsAdvertisement boolValue];
-    clip.deleteAfterPlaying = [nDeleteAfterPlay boolValue];
-    clip.entryId = [nId intValue];
-    clip.originalId = [nIdSplitFrom intValue];
-    
-    if ([nClipType isEqualToString:@"Media"] || [nClipType isEqualToString:@"ProgramContent"])
-    {
-        clip.type = PlaylistEntryType_Media;
-    }
-    else if ([nClipType isEqualToString:@"SeekToStart"])
-    {
-        clip.type = PlaylistEntryType_SeekToStart;
-    }
-    else if ([nClipType isEqualToString:@"VAST"])
-    {
-        clip.type = PlaylistEntryType_VAST;
-    }
-    else
-    {
-        clip.type = PlaylistEntryType_Static;
-    }
-    
-    segment.clip = clip;
-    segment.initialPlaybackTime = [nInitialPlaybackTime floatValue];
-    segment.initialPlaybackRate = [nInitialPlaybackRate floatValue];
-    segment.segmentId = [nSegmentId intValue];
-    segment.error = nil;
-    
-    return segment;
-}
-
-- (NSString *) callJavaScriptWithString:(NSString *)aString
-{
-    NSLog(@"JavaScript call: %s", [aString cStringUsingEncoding:NSUTF8StringEncoding]);
-    NSString *result = [webView stringByEvaluatingJavaScriptFromString:aString];
-    
-    NSLog(@"JavaScript result is %@", result);
-
-    NSError *error = [Sequencer parseJSONException:result];
-    if (nil != error)
-    {
-        self.lastError = error;
-        result = nil;
-    }
-    
-    return result;
-}
-
-#pragma mark -
-#pragma mark Notification callbacks:
-
-
-#pragma mark -
-#pragma mark Public instance methods:
-
-//
-// Constructor for the sequencer
-//
-// Arguments: none
-//
-// Returns: The sequencer instance.
-//
-- (id) init
-{
-    self = [super init];
-    
-    if (self){
-        webView = [[UIWebView alloc] init];
-        [webView loadHTMLString:@"<script src=\"Scheduler.js\"></script>"
-         "<script src=\"Sequencer.js\"></script>"
-         "<script src=\"AdResolver.js\"></script>"
-         "<script src=\"SequencerPlugin.js\"></script>" baseURL:[NSURL fileURLWithPath:[[NSBundle mainBundle] resourcePath]]];
-        adResolver = [[AdResolver alloc] initWithUIWebView:webView];
-        scheduler = [[Scheduler alloc] initWithUIWebView:webView];
-        lastError = nil;
-    }
-    
-    return self;
-}
-
-//
-// get seekbar time from manifest time
-//
-// Arguments:
-// [seekTime]: the output seekbar time
-// [policy]: the output ad policy object
-// [aManifestTime]: the current playback time in manifest time
-// [aRate]: the current playback rate
-// [aSegment]: the current playback segment
-// [rangeExceeded]: output boolean indicating if the playback range has been exceeded.
-//
-// Returns: YES for success and NO for failure
-//
-- (BOOL) getSeekbarTime:(SeekbarTime **)seekTime andPlaybackPolicy:(PlaybackPolicy **)policy withManifestTime:(ManifestTime *)aManifestTime playbackRate:(double)aRate currentSegment:(PlaybackSegment *)aSegment playbackRangeExceeded:(BOOL *)rangeExceeded
-{
-    assert(nil != rangeExceeded);
-    *rangeExceeded = NO;
-    BOOL isClipChanged = NO;
-    BOOL success = NO;
-
-    do {
-        NSString *result = nil;
-        
-        // Check if the clip has changed
-        NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.playbackSegmentPool.getPlaybackSegment(%d).isClipChanged",
-                               aSegment.segmentId] autorelease];
-        result = [self callJavaScriptWithString:function];
-        if (nil == result)
-        {
-            break;
-        }
-        isClipChanged = [result isEqualToString:@"true"];
-        
-        function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
-                     "\"{\\\"func\\\": \\\"manifestToSeekbarTime\\\", "
-                     "\\\"params\\\": "
-                     "{ \\\"currentSegmentId\\\": %d, "
-                     "\\\"playbackRate\\\": %f, "
-                     "\\\"currentPlaybackPosition\\\": %f, "
-                     "\\\"minManifestPosition\\\": %f, "
-                     "\\\"maxManifestPosition\\\": %f } }\")",
-                     aSegment.segmentId,
-                     aRate,
-                     aManifestTime.currentPlaybackPosition,
-                     aManifestTime.minManifestPosition,
-                     aManifestTime.maxManifestPosition] autorelease];
-        result = [self callJavaScriptWithString:function];
-        if (nil == result)
-        {
-            break;
-        }
-        
-        NSData* data = [result dataUsingEncoding:[NSString defaultCStringEncoding]];
-        NSError* error = nil;
-        NSDictionary* json_out = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
-        NSNumber *nCurrentSeekbarPosition = [json_out objectForKey:@"currentSeekbarPosition"];
-        NSNumber *nMinSeekbarPosition = [json_out objectForKey:@"minSeekbarPosition"];
-        NSNumber *nMaxSeekbarPosition = [json_out objectForKey:@"maxSeekbarPosition"];
-        NSDictionary *nPlaybackPolicy = [json_out objectForKey:@"playbackPolicy"];
-        NSString *nPlaybackRangeExceeded = [json_out objectForKey:@"playbackRangeExceeded"];
-        
-        (*seekTime) = [[SeekbarTime alloc] init];
-        (*seekTime).currentSeekbarPosition = [nCurrentSeekbarPosition floatValue];
-        (*seekTime).minSeekbarPosition = [nMinSeekbarPosition floatValue];
-        (*seekTime).maxSeekbarPosition = [nMaxSeekbarPosition floatValue];
-        *rangeExceeded = [nPlaybackRangeExceeded boolValue];
-        
-        // Update the current segment boundary if the clip has changed
-        if (isClipChanged)
-        {
-            // We need to update the current segment boundary
-            function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.playbackSegmentPool.getPlaybackSegment(%d).clip.minRenderingTime",
-                         aSegment.segmentId] autorelease];
-            result = [self callJavaScriptWithString:function];
-            if (nil == result)
-            {
-                break;
-            }
-            aSegment.clip.renderTime.minManifestPosition = [result floatValue];
-            
-            function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.playbackSegmentPool.getPlaybackSegment(%d).clip.maxRenderingTime",
-                         aSegment.segmentId] autorelease];
-            result = [self callJavaScriptWithString:function];
-            if (nil == result)
-            {
-                break;
-            }
-            aSegment.clip.renderTime.maxManifestPosition = [result floatValue];
-        }
-        
-        success = YES;
-    } while (NO);
-    
-    return success;
-}
-
-//
-// get linear time from manifest time
-//
-// Arguments:
-// [linearTime]: the time in linear time
-// [aManifestTime]: the time in manifest time
-// [aSegment]: the current playback segment
-//
-// Returns: YES for success and NO for failure
-//
-- (BOOL) getLinearTime:(NSTimeInterval *)linearTime withManifestTime:(ManifestTime *)aManifestTime currentSegment:(PlaybackSegment *)aSegment
-{
-    assert (nil != linearTime);
-    NSString *result = nil;
-    
-    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
-                           "\"{\\\"func\\\": \\\"manifestToLinearTime\\\", "
-                           "\\\"params\\\": "
-                           "{ \\\"currentSegmentId\\\": %d, "
-                           "\\\"currentPlaybackPosition\\\": %f } }\")",
-                           aSegment.segmentId,
-                           aManifestTime.currentPlaybackPosition] autorelease];
-    result = [self callJavaScriptWithString:function];
-    if (nil != result)
-    {
-        *linearTime = [result intValue];
-    }
-
-    return (nil != result);
-}
-
-//
-// get segment after a seek in the linear position
-//
-// Arguments:
-// [seekSegment]: the output playback segment
-// [linearSeekPosition]: the linear position to seek to
-//
-// Returns: YES for success and NO for failure
-//
-- (BOOL) getSegmentAfterSeek:(PlaybackSegment **)seekSegment withLinearPosition:(NSTimeInterval)linearSeekPosition
-{
-    NSString *result = nil;
-    *seekSegment = nil;
-    
-    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
-                          "\"{\\\"func\\\": \\\"seekFromLinearPosition\\\", "
-                          "\\\"params\\\": { \\\"linearSeekPosition\\\": %f } }\")",
-                          linearSeekPosition] autorelease];
-    result = [self callJavaScriptWithString:function];    
-    if (nil != result && ![result isEqualToString:@"null"])
-    {
-        *seekSegment = [self parseJSONPlaybackSegment:result];
-    }
-    
-    return (nil != result);
-}
-
-//
-// get segment after a seekbar seek
-//
-// Arguments:
-// [seekSegment]: the output playback segment
-// [seekbarPostion]: the current seekbar position
-// [aSegment]: the current playback segment
-//
-// Returns: YES for success and NO for failure
-//
-- (BOOL) getSegmentAfterSeek:(PlaybackSegment **)seekSegment withSeekbarPosition:(SeekbarTime *)seekbarPosition currentSegment:(PlaybackSegment *)aSegment
-{
-    NSString *result = nil;
-    *seekSegment = nil;
-    
-    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
-                           "\"{\\\"func\\\": \\\"seekFromSeekbarPosition\\\", "
-                           "\\\"params\\\": { \\\"seekbarSeekPosition\\\": %f, "
-                           "\\\"currentSegmentId\\\": %d } }\")",
-                           seekbarPosition.currentSeekbarPosition,
-                           aSegment.segmentId] autorelease];
-    result = [self callJavaScriptWithString:function];
-    if (nil != result && ![result isEqualToString:@"null"])
-    {
-        *seekSegment = [self parseJSONPlaybackSegment:result];
-    }
-    
-    return (nil != result);
-}
-
-//
-// get the next segment after the current playlist entry ended
-//
-// Arguments:
-// [nextSegment]: the output playback segment
-// [currentSegment]: the current playback segment
-// [playbackPosition]: the current playback time in manifest time
-// [playbackRate]: the current playback rate
-//
-// Returns: YES for success and NO for failure
-//
-- (BOOL) getSegmentOnEndOfMedia:(PlaybackSegment **)nextSegment withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition currentPlaybackRate:(double)playbackRate isNotPlayed:(BOOL)isNotPlayed isEndOfSequence:(BOOL)isEndOfSequence
-{
-    NSString *result = nil;
-    *nextSegment = nil;
-    
-    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
-                          "\"{\\\"func\\\": \\\"onEndOfMedia\\\", "
-                          "\\\"params\\\": "
-                          "{ \\\"currentSegmentId\\\": %d, "
-                          "\\\"currentPlaybackPosition\\\": %f, "
-                           "\\\"currentPlaybackRate\\\": %f, "
-                           "\\\"isNotPlayed\\\": %@, "
-                          "\\\"isEndOfSequence\\\": %@ } }\")",
-                          currentSegment.segmentId,
-                          playbackPosition,
-                          playbackRate,
-                          isNotPlayed ? @"true" : @"false",
-                          isEndOfSequence ? @"true" : @"false"] autorelease];
-    result = [self callJavaScriptWithString:function];
-    if (nil != result && ![result isEqualToString:@"null"])
-    {
-        *nextSegment = [self parseJSONPlaybackSegment:result];
-    }
-    
-    // Dump the playlist
-    function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequentialPlaylist.testProbe_toJSON()"] autorelease];
-    [self callJavaScriptWithString:function];
-
-    return (nil != result);    
-}
-
-//
-// get the next segment after the current playlist entry finished buffering
-//
-// Arguments:
-// [nextSegment]: the output playback segment
-// [currentSegment]: the current playback segment
-// [playbackPosition]: the current playback time in manifest time
-// [playbackRate]: the current playback rate
-//
-// Returns: YES for success and NO for failure
-//
-- (BOOL) getSegmentOnEndOfBuffering:(PlaybackSegment **)nextSegment withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition currentPlaybackRate:(double)playbackRate
-{
-    NSString *result = nil;
-    *nextSegment = nil;
-    
-    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
-                           "\"{\\\"func\\\": \\\"onEndOfBuffering\\\", "
-                           "\\\"params\\\": "
-                           "{ \\\"currentSegmentId\\\": %d, "
-                           "\\\"currentPlaybackPosition\\\": %f, "
-                           "\\\"currentPlaybackRate\\\": %f } }\")",
-                           currentSegment.segmentId,
-                           playbackPosition,
-                           playbackRate] autorelease];
-    result = [self callJavaScriptWithString:function];    
-    if (nil != result && ![result isEqualToString:@"null"])
-    {
-        *nextSegment = [self parseJSONPlaybackSegment:result];
-    }
-
-    return (nil != result);
-}
-
-//
-// get the next segment after the current playlist entry has an error
-//
-// Arguments:
-// [nextSegment]: the output playback segment
-// [currentSegment]: the current playback segment
-// [playbackPosition]: the current playback time in manifest time
-// [playbackRate]: the current playback rate
-// [error]: the error for the playlist entry
-//
-// Returns: YES for success and NO for failure
-//
-- (BOOL) getSegmentOnError:(PlaybackSegment **)nextSegment withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition currentPlaybackRate:(double)playbackRate error:(NSString *)error isNotPlayed:(BOOL)isNotPlayed isEndOfSequence:(BOOL)isEndOfSequence
-{
-    NSString *result = nil;
-    *nextSegment = nil;
-    
-    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
-                           "\"{\\\"func\\\": \\\"onError\\\", "
-                           "\\\"params\\\": "
-                           "{ \\\"currentSegmentId\\\": %d, "
-                           "\\\"currentPlaybackPosition\\\": %f, "
-                           "\\\"currentPlaybackRate\\\": %f, "
-                           "\\\"errorDescription\\\": \\\"%@\\\", "
-                           "\\\"isNotPlayed\\\": %@, "
-                           "\\\"isEndOfSequence\\\": %@ } }\")",
-                           currentSegment.segmentId,
-                           playbackPosition,
-                           playbackRate,
-                           error,
-                           isNotPlayed ? @"true" : @"false",
-                           isEndOfSequence ? @"true" : @"false"] autorelease];
-    result = [self callJavaScriptWithString:function];
-    if (nil != result && ![result isEqualToString:@"null"])
-    {
-        *nextSegment = [self parseJSONPlaybackSegment:result];
-    }
-    
-    // Dump the playlist
-    function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequentialPlaylist.testProbe_toJSON()"] autorelease];
-    [self callJavaScriptWithString:function];
-    
-    return (nil != result);
-}
-
-#pragma mark -
-#pragma mark Properties:
-
-#pragma mark -
-#pragma mark Destructor:
-
-- (void) dealloc
-{
-    NSLog(@"Sequencer dealloc called.");
-    
-    [adResolver release];
-    [scheduler release];
-    [lastError release];
-    
-    [super dealloc];
-}
-
-@end
+// ----------------------------------------------------------------------------
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// ----------------------------------------------------------------------------
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// THIS CODE IS PROVIDED *AS IS* BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+// INCLUDING WITHOUT LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE,
+// FITNESS FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+//
+
+#import "Sequencer_Internal.h"
+#import "PlaybackSegment_Internal.h"
+#import "Scheduler_Internal.h"
+#import "AdResolver_Internal.h"
+
+// Define constant like: NSString * const NotImplementedException = @"NotImplementedException";
+NSString * const ErrorDomain = @"PLAYER_SEQUENCER";
+NSString * const UnexpectedError = @"PLAYER_SEQUENCER:UnexpectedError";
+NSString * const SequencerReadyNotification = @"SequencerReadyNotification";
+
+// The single-bundle script built by src/Core/Build/BuildBundle.js, loaded instead of the separate scripts when it is in the app resources
+#define JAVASCRIPT_BUNDLE_NAME @"PlayerSequencer"
+// The URL the JavaScript PLAYER_SEQUENCER.readiness.signalReady loads to tell the scripts are loaded
+#define JAVASCRIPT_READY_SCHEME @"playersequencer"
+#define JAVASCRIPT_READY_HOST @"ready"
+
+@implementation Sequencer
+
+@synthesize adResolver;
+@synthesize scheduler;
+@synthesize lastError;
+@synthesize playlistVersion;
+@synthesize isReady;
+
+#pragma mark -
+#pragma mark Internal class methods:
+
++ (NSError *) parseJSONException:(NSString *)jsonResult
+{
+    NSError *error = nil;
+    
+    if (0 == [jsonResult length])
+    {
+        // Empty return from the JavaScript call, which means unexpected error happened.
+        NSMutableDictionary *userInfo = [[NSMutableDictionary alloc] init];
+        [userInfo setObject:UnexpectedError forKey:NSLocalizedDescriptionKey];
+        [userInfo setObject:@"Unexpected JavaScript error happened" forKey:NSLocalizedFailureReasonErrorKey];
+        error = [NSError errorWithDomain:ErrorDomain code:0 userInfo:userInfo];
+        [userInfo release];
+    }
+    else if ([jsonResult hasPrefix:@"{\"EXCEPTION\":"])
+    {
+        // JavaScript code throws an exception
+        do {
+            NSData* data = [jsonResult dataUsingEncoding:[NSString defaultCStringEncoding]];
+            NSDictionary* json_out = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
+            if (nil != error)
+            {
+                break;
+            }
+            
+            NSDictionary *nException = [json_out objectForKey:@"EXCEPTION"];
+            if (![nException isKindOfClass:[NSDictionary class]])
+            {
+                break;
+            }
+            
+            // exceptionToJSON emits string name and message, but a missing or null one must not be set in userInfo
+            NSString *nName = [nException objectForKey:@"name"];
+            NSString *nMessage = [nException objectForKey:@"message"];
+            if (![nName isKindOfClass:[NSString class]])
+            {
+                nName = UnexpectedError;
+            }
+            if (![nMessage isKindOfClass:[NSString class]])
+            {
+                nMessage = @"Unexpected JavaScript error happened";
+            }
+            
+            NSMutableDictionary *userInfo = [[NSMutableDictionary alloc] init];
+            [userInfo setObject:nName forKey:NSLocalizedDescriptionKey];
+            [userInfo setObject:nMessage forKey:NSLocalizedFailureReasonErrorKey];
+            error = [NSError errorWithDomain:ErrorDomain code:0 userInfo:userInfo];
+            [userInfo release];
+        } while (NO);
+    }        
+    
+    return error;
+}
+
+#pragma mark -
+#pragma mark UIWebViewDelegate methods:
+
+//
+// intercept the URL loaded by the JavaScript readiness signal
+//
+// Arguments:
+// [aWebView]: the web view running the JavaScript
+// [request]: the request to be loaded
+// [navigationType]: the type of the navigation
+//
+// Returns: NO for the readiness signal, YES for any other request
+//
+- (BOOL) webView:(UIWebView *)aWebView shouldStartLoadWithRequest:(NSURLRequest *)request navigationType:(UIWebViewNavigationType)navigationType
+{
+    NSURL *url = [request URL];
+    
+    if (![[url scheme] isEqualToString:JAVASCRIPT_READY_SCHEME])
+    {
+        return YES;
+    }
+    if ([[url host] isEqualToString:JAVASCRIPT_READY_HOST] && !isReady)
+    {
+        isReady = YES;
+        [[NSNotificationCenter defaultCenter] postNotificationName:SequencerReadyNotification object:self];
+    }
+    
+    return NO;
+}
+
+#pragma mark -
+#pragma mark Private instance methods:
+
+- (PlaybackSegment *) parseJSONPlaybackSegment:(NSString *)jsonResult
+{    
+    NSData* data = [jsonResult dataUsingEncoding:[NSString defaultCStringEncoding]];
+    NSError* error = nil;
+    NSDictionary* json_out = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
+    
+    return [self parsePlaybackSegmentDictionary:json_out];
+}
+
+- (PlaybackSegment *) parsePlaybackSegmentDictionary:(NSDictionary *)json_out
+{
+    NSDictionary *nClip = [json_out objectForKey:@"clip"];
+    
+    if ([NSNull null] == (NSNull *)nClip)
+    {
+        return nil;
+    }
+
+    NSNumber *nInitialPlaybackTime = [json_out objectForKey:@"initialPlaybackStartTime"];
+    NSNumber *nInitialPlaybackRate = [json_out objectForKey:@"initialPlaybackRate"];
+    NSNumber *nSegmentId = [json_out objectForKey:@"segmentId"];
+    
+    NSString *nClipURI = [nClip objectForKey:@"clipURI"];
+    NSString *nClipType = [nClip objectForKey:@"eClipType"];
+    NSNumber *nLinearStartTime = [nClip objectForKey:@"linearStartTime"];
+    NSNumber *nLinearDuration = [nClip objectForKey:@"linearDuration"];
+    NSNumber *nMinRenderingTime = [nClip objectForKey:@"minRenderingTime"];
+    NSNumber *nMaxRenderingTime = [nClip objectForKey:@"maxRenderingTime"];
+    NSString *nIsAdvertisement = [nClip objectForKey:@"isAdvertisement"];
+    NSDictionary *nPlaybackPolicy = [nClip objectForKey:@"playbackPolicyObj"];
+    NSString *nDeleteAfterPlay = [nClip objectForKey:@"deleteAfterPlay"];
+    NSNumber *nId = [nClip objectForKey:@"id"];
+    NSNumber *nIdSplitFrom = [nClip objectForKey:@"idSplitFrom"];
+    
+    PlaylistEntry *clip = [[[PlaylistEntry alloc] init] autorelease];
+    PlaybackSegment *segment = [[PlaybackSegment alloc] init];
+    
+    if (![nClipType isEqualToString:@"SeekToStart"])
+    {
+        clip.clipURI = [NSURL URLWithString:nClipURI];
+    }
+    clip.linearTime = [[[LinearTime alloc] init] autorelease];
+    clip.linearTime.startTime = [nLinearStartTime doubleValue];
+    clip.linearTime.duration = [nLinearDuration doubleValue];
+    clip.renderTime = [[[ManifestTime alloc] init] autorelease];
+    clip.renderTime.minManifestPosition = [nMinRenderingTime doubleValue];
+    clip.renderTime.maxManifestPosition = [nMaxRenderingTime doubleValue];
+    clip.isAdvertisement = [nIsAdvertisement boolValue];
+    clip.deleteAfterPlaying = [nDeleteAfterPlay boolValue];
+    clip.entryId = [nId intValue];
+    clip.originalId = [nIdSplitFrom intValue];
+    
+    if ([nClipType isEqualToString:@"Media"] || [nClipType isEqualToString:@"ProgramContent"])
+    {
+        clip.type = PlaylistEntryType_Media;
+    }
+    else if ([nClipType isEqualToString:@"SeekToStart"])
+    {
+        clip.type = PlaylistEntryType_SeekToStart;
+    }
+    else if ([nClipType isEqualToString:@"VAST"])
+    {
+        clip.type = PlaylistEntryType_VAST;
+    }
+    else
+    {
+        clip.type = PlaylistEntryType_Static;
+    }
+    
+    segment.clip = clip;
+    segment.initialPlaybackTime = [nInitialPlaybackTime doubleValue];
+    segment.initialPlaybackRate = [nInitialPlaybackRate doubleValue];
+    segment.segmentId = [nSegmentId intValue];
+    segment.error = nil;
+    
+    return segment;
+}
+
+- (PlaybackSegment *) parseCompactPlaybackSegment:(NSString *)compactResult
+{
+    // The field positions of the playback segment tuple are defined by PLAYER_SEQUENCER.compactCommands in Sequencer.js
+    NSArray *fields = [compactResult componentsSeparatedByString:@","];
+    
+    if (13 > [fields count])
+    {
+        return nil;
+    }
+    
+    NSString *nClipType = [fields objectAtIndex:3];
+    // clipURI is the last field and may itself contain commas
+    NSString *nClipURI = [[fields subarrayWithRange:NSMakeRange(12, [fields count] - 12)] componentsJoinedByString:@","];
+    
+    PlaylistEntry *clip = [[[PlaylistEntry alloc] init] autorelease];
+    PlaybackSegment *segment = [[PlaybackSegment alloc] init];
+    
+    if (![nClipType isEqualToString:@"SeekToStart"])
+    {
+        clip.clipURI = [NSURL URLWithString:nClipURI];
+    }
+    clip.linearTime = [[[LinearTime alloc] init] autorelease];
+    clip.linearTime.startTime = [[fields objectAtIndex:4] doubleValue];
+    clip.linearTime.duration = [[fields objectAtIndex:5] doubleValue];
+    clip.renderTime = [[[ManifestTime alloc] init] autorelease];
+    clip.renderTime.minManifestPosition = [[fields objectAtIndex:6] doubleValue];
+    clip.renderTime.maxManifestPosition = [[fields objectAtIndex:7] doubleValue];
+    clip.isAdvertisement = [[fields objectAtIndex:8] boolValue];
+    clip.deleteAfterPlaying = [[fields objectAtIndex:9] boolValue];
+    clip.entryId = [[fields objectAtIndex:10] intValue];
+    clip.originalId = [[fields objectAtIndex:11] intValue];
+    
+    if ([nClipType isEqualToString:@"Media"] || [nClipType isEqualToString:@"ProgramContent"])
+    {
+        clip.type = PlaylistEntryType_Media;
+    }
+    else if ([nClipType isEqualToString:@"SeekToStart"])
+    {
+        clip.type = PlaylistEntryType_SeekToStart;
+    }
+    else if ([nClipType isEqualToString:@"VAST"])
+    {
+        clip.type = PlaylistEntryType_VAST;
+    }
+    else
+    {
+        clip.type = PlaylistEntryType_Static;
+    }
+    
+    segment.clip = clip;
+    segment.initialPlaybackTime = [[fields objectAtIndex:1] doubleValue];
+    segment.initialPlaybackRate = [[fields objectAtIndex:2] doubleValue];
+    segment.segmentId = [[fields objectAtIndex:0] intValue];
+    segment.error = nil;
+    
+    return segment;
+}
+
+- (NSString *) callPreloadPlanner:(NSString *)func withSegment:(PlaybackSegment *)aSegment
+{
+    // The params are built with NSJSONSerialization so the clip URI is escaped; the resulting JSON is a valid JavaScript object literal
+    NSString *clipType = nil;
+    switch (aSegment.clip.type)
+    {
+        case PlaylistEntryType_Media:
+            clipType = @"Media";
+            break;
+        case PlaylistEntryType_VAST:
+            clipType = @"VAST";
+            break;
+        case PlaylistEntryType_SeekToStart:
+            clipType = @"SeekToStart";
+            break;
+        default:
+            clipType = @"Static";
+            break;
+    }
+    NSDictionary *params = [NSDictionary dictionaryWithObjectsAndKeys:
+                            [NSNumber numberWithInt:aSegment.segmentId], @"loadId",
+                            clipType, @"eClipType",
+                            (nil != aSegment.clip.clipURI) ? [aSegment.clip.clipURI absoluteString] : @"", @"clipURI",
+                            nil];
+    NSData *data = [NSJSONSerialization dataWithJSONObject:params options:kNilOptions error:nil];
+    NSString *paramsJSON = [[[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding] autorelease];
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.preloadPlanner.runJSON(JSON.stringify("
+                           "{ \"func\": \"%@\", \"params\": %@ }))",
+                           func,
+                           paramsJSON] autorelease];
+    
+    return [self callJavaScriptWithString:function];
+}
+
+- (NSString *) skippedAdPolicyName:(SkippedAdPolicy)policy
+{
+    NSString *name = nil;
+    switch (policy)
+    {
+        case SkippedAdPolicy_PlayLast:
+            name = @"PlayLast";
+            break;
+        case SkippedAdPolicy_PlayAll:
+            name = @"PlayAll";
+            break;
+        case SkippedAdPolicy_MarkPlayed:
+            name = @"MarkPlayed";
+            break;
+        default:
+            break;
+    }
+    return name;
+}
+
+- (void) parseSkippedAdsResult:(NSString *)result seekSegment:(PlaybackSegment **)seekSegment skippedAds:(NSDictionary **)skippedAds
+{
+    NSData* data = [result dataUsingEncoding:[NSString defaultCStringEncoding]];
+    NSError* error = nil;
+    NSDictionary *json_out = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
+    id segment = [json_out objectForKey:@"segment"];
+    
+    if ([segment isKindOfClass:[NSDictionary class]])
+    {
+        *seekSegment = [self parsePlaybackSegmentDictionary:segment];
+    }
+    *skippedAds = json_out;
+}
+
+- (NSString *) callJavaScriptWithString:(NSString *)aString
+{
+    NSLog(@"JavaScript call: %s", [aString cStringUsingEncoding:NSUTF8StringEncoding]);
+    NSString *result = [webView stringByEvaluatingJavaScriptFromString:aString];
+    
+    NSLog(@"JavaScript result is %@", result);
+
+    NSError *error = [Sequencer parseJSONException:result];
+    if (nil != error)
+    {
+        self.lastError = error;
+        result = nil;
+    }
+    
+    return result;
+}
+
+#pragma mark -
+#pragma mark Notification callbacks:
+
+
+#pragma mark -
+#pragma mark Public instance methods:
+
+//
+// Constructor for the sequencer
+//
+// Arguments: none
+//
+// Returns: The sequencer instance.
+//
+- (id) init
+{
+    self = [super init];
+    
+    if (self){
+        isReady = NO;
+        webView = [[UIWebView alloc] init];
+        webView.delegate = self;
+        if (nil != [[NSBundle mainBundle] pathForResource:JAVASCRIPT_BUNDLE_NAME ofType:@"js"])
+        {
+            // The bundle signals readiness in its last line
+            [webView loadHTMLString:@"<script src=\"" JAVASCRIPT_BUNDLE_NAME ".js\"></script>"
+                            baseURL:[NSURL fileURLWithPath:[[NSBundle mainBundle] resourcePath]]];
+        }
+        else
+        {
+            [webView loadHTMLString:@"<script src=\"Scheduler.js\"></script>"
+             "<script src=\"Sequencer.js\"></script>"
+             "<script src=\"AdResolver.js\"></script>"
+             "<script src=\"SequencerPlugin.js\"></script>"
+             "<script>PLAYER_SEQUENCER.readiness.signalReady();</script>" baseURL:[NSURL fileURLWithPath:[[NSBundle mainBundle] resourcePath]]];
+        }
+        adResolver = [[AdResolver alloc] initWithUIWebView:webView];
+        scheduler = [[Scheduler alloc] initWithUIWebView:webView];
+        lastError = nil;
+    }
+    
+    return self;
+}
+
+//
+// get seekbar time from manifest time
+//
+// Arguments:
+// [seekTime]: the output seekbar time
+// [policy]: the output ad policy object
+// [aManifestTime]: the current playback time in manifest time
+// [aRate]: the current playback rate
+// [aSegment]: the current playback segment
+// [rangeExceeded]: output boolean indicating if the playback range has been exceeded.
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getSeekbarTime:(SeekbarTime **)seekTime andPlaybackPolicy:(PlaybackPolicy **)policy withManifestTime:(ManifestTime *)aManifestTime playbackRate:(double)aRate currentSegment:(PlaybackSegment *)aSegment playbackRangeExceeded:(BOOL *)rangeExceeded
+{
+    return [self getSeekbarTime:seekTime andPlaybackPolicy:policy withManifestTime:aManifestTime playbackRate:aRate currentSegment:aSegment playbackRangeExceeded:rangeExceeded preloadThreshold:0 isPreloadThresholdReached:NULL];
+}
+
+//
+// get seekbar time from manifest time and check whether the next segment should be preloaded
+//
+// Arguments:
+// [seekTime]: the output seekbar time
+// [policy]: the output ad policy object
+// [aManifestTime]: the current playback time in manifest time
+// [aRate]: the current playback rate
+// [aSegment]: the current playback segment
+// [rangeExceeded]: output boolean indicating if the playback range has been exceeded.
+// [preloadThreshold]: the time before the end of the current segment at which the next segment should be preloaded
+// [preloadThresholdReached]: optional output boolean indicating if the preload threshold has been reached.
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getSeekbarTime:(SeekbarTime **)seekTime andPlaybackPolicy:(PlaybackPolicy **)policy withManifestTime:(ManifestTime *)aManifestTime playbackRate:(double)aRate currentSegment:(PlaybackSegment *)aSegment playbackRangeExceeded:(BOOL *)rangeExceeded preloadThreshold:(NSTimeInterval)preloadThreshold isPreloadThresholdReached:(BOOL *)preloadThresholdReached
+{
+    assert(nil != rangeExceeded);
+    *rangeExceeded = NO;
+    if (NULL != preloadThresholdReached)
+    {
+        *preloadThresholdReached = NO;
+    }
+    BOOL success = NO;
+
+    do {
+        NSString *result = nil;
+        
+        // A single tick call returns the seekbar time, the clip changed flag and the current segment boundary
+        NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runCompact("
+                               "\"tick\", %d, %f, %f, %f, %f, %f)",
+                               aSegment.segmentId,
+                               aRate,
+                               aManifestTime.currentPlaybackPosition,
+                               aManifestTime.minManifestPosition,
+                               aManifestTime.maxManifestPosition,
+                               preloadThreshold] autorelease];
+        result = [self callJavaScriptWithString:function];
+        if (nil == result)
+        {
+            break;
+        }
+        
+        // The field positions of the tick tuple are defined by PLAYER_SEQUENCER.compactCommands in Sequencer.js
+        NSArray *fields = [result componentsSeparatedByString:@","];
+        if (9 != [fields count])
+        {
+            break;
+        }
+        
+        (*seekTime) = [[SeekbarTime alloc] init];
+        (*seekTime).currentSeekbarPosition = [[fields objectAtIndex:0] doubleValue];
+        (*seekTime).minSeekbarPosition = [[fields objectAtIndex:1] doubleValue];
+        (*seekTime).maxSeekbarPosition = [[fields objectAtIndex:2] doubleValue];
+        *rangeExceeded = [[fields objectAtIndex:3] boolValue];
+        if (NULL != preloadThresholdReached)
+        {
+            *preloadThresholdReached = [[fields objectAtIndex:7] boolValue];
+        }
+        
+        // Update the current segment boundary if the clip has changed
+        if ([[fields objectAtIndex:4] boolValue])
+        {
+            aSegment.clip.renderTime.minManifestPosition = [[fields objectAtIndex:5] doubleValue];
+            aSegment.clip.renderTime.maxManifestPosition = [[fields objectAtIndex:6] doubleValue];
+        }
+        
+        // The playlist version only changes when clips are scheduled or removed, see Scheduler getPlaylistChanges
+        playlistVersion = [[fields objectAtIndex:8] intValue];
+        
+        success = YES;
+    } while (NO);
+    
+    return success;
+}
+
+//
+// get linear time from manifest time
+//
+// Arguments:
+// [linearTime]: the time in linear time
+// [aManifestTime]: the time in manifest time
+// [aSegment]: the current playback segment
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getLinearTime:(NSTimeInterval *)linearTime withManifestTime:(ManifestTime *)aManifestTime currentSegment:(PlaybackSegment *)aSegment
+{
+    assert (nil != linearTime);
+    NSString *result = nil;
+    
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runCompact("
+                           "\"manifestToLinearTime\", %d, %f)",
+                           aSegment.segmentId,
+                           aManifestTime.currentPlaybackPosition] autorelease];
+    result = [self callJavaScriptWithString:function];
+    if (nil != result)
+    {
+        *linearTime = [result doubleValue];
+    }
+
+    return (nil != result);
+}
+
+//
+// get segment after a seek in the linear position
+//
+// Arguments:
+// [seekSegment]: the output playback segment
+// [linearSeekPosition]: the linear position to seek to
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getSegmentAfterSeek:(PlaybackSegment **)seekSegment withLinearPosition:(NSTimeInterval)linearSeekPosition
+{
+    NSString *result = nil;
+    *seekSegment = nil;
+    
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
+                          "\"{\\\"func\\\": \\\"seekFromLinearPosition\\\", "
+                          "\\\"params\\\": { \\\"linearSeekPosition\\\": %f } }\")",
+                          linearSeekPosition] autorelease];
+    result = [self callJavaScriptWithString:function];    
+    if (nil != result && ![result isEqualToString:@"null"])
+    {
+        *seekSegment = [self parseJSONPlaybackSegment:result];
+    }
+    
+    return (nil != result);
+}
+
+//
+// get segment after a seekbar seek
+//
+// Arguments:
+// [seekSegment]: the output playback segment
+// [seekbarPostion]: the current seekbar position
+// [aSegment]: the current playback segment
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getSegmentAfterSeek:(PlaybackSegment **)seekSegment withSeekbarPosition:(SeekbarTime *)seekbarPosition currentSegment:(PlaybackSegment *)aSegment
+{
+    NSString *result = nil;
+    *seekSegment = nil;
+    
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runCompact("
+                           "\"seekFromSeekbarPosition\", %f, %d)",
+                           seekbarPosition.currentSeekbarPosition,
+                           aSegment.segmentId] autorelease];
+    result = [self callJavaScriptWithString:function];
+    if (nil != result && ![result isEqualToString:@"null"])
+    {
+        *seekSegment = [self parseCompactPlaybackSegment:result];
+    }
+    
+    return (nil != result);
+}
+
+//
+// get segment after a seekbar seek, applying a policy to the ad breaks the seek skips over
+//
+// Arguments:
+// [seekSegment]: the output playback segment: the first skipped ad to play, or the segment at the seek position
+// [skippedAds]: the output dictionary of the arrays of ad entry ids (NSNumber) crossedAdEntryIds, queuedAdEntryIds
+//               (played before playback resumes at the seek position) and markedPlayedAdEntryIds, and of the
+//               removedEntryIds. nil for SkippedAdPolicy_None.
+// [seekbarPostion]: the seekbar position to seek to
+// [aSegment]: the current playback segment
+// [playbackPosition]: the current playback time in manifest time, where the seek starts from
+// [policy]: the policy for the skipped ad breaks
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getSegmentAfterSeek:(PlaybackSegment **)seekSegment skippedAds:(NSDictionary **)skippedAds withSeekbarPosition:(SeekbarTime *)seekbarPosition currentSegment:(PlaybackSegment *)aSegment manifestTime:(NSTimeInterval)playbackPosition skippedAdPolicy:(SkippedAdPolicy)policy
+{
+    NSString *result = nil;
+    NSString *policyName = [self skippedAdPolicyName:policy];
+    *seekSegment = nil;
+    *skippedAds = nil;
+    
+    if (nil == policyName)
+    {
+        return [self getSegmentAfterSeek:seekSegment withSeekbarPosition:seekbarPosition currentSegment:aSegment];
+    }
+    
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
+                           "\"{\\\"func\\\": \\\"seekSkippingAds\\\", "
+                           "\\\"params\\\": "
+                           "{ \\\"currentSegmentId\\\": %d, "
+                           "\\\"currentPlaybackPosition\\\": %f, "
+                           "\\\"seekbarSeekPosition\\\": %f, "
+                           "\\\"eSkippedAdPolicy\\\": \\\"%@\\\" } }\")",
+                           aSegment.segmentId,
+                           playbackPosition,
+                           seekbarPosition.currentSeekbarPosition,
+                           policyName] autorelease];
+    result = [self callJavaScriptWithString:function];
+    if (nil != result)
+    {
+        [self parseSkippedAdsResult:result seekSegment:seekSegment skippedAds:skippedAds];
+    }
+    
+    return (nil != result);
+}
+
+//
+// get the next segment after the current playlist entry ended
+//
+// Arguments:
+// [nextSegment]: the output playback segment
+// [currentSegment]: the current playback segment
+// [playbackPosition]: the current playback time in manifest time
+// [playbackRate]: the current playback rate
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getSegmentOnEndOfMedia:(PlaybackSegment **)nextSegment withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition currentPlaybackRate:(double)playbackRate isNotPlayed:(BOOL)isNotPlayed isEndOfSequence:(BOOL)isEndOfSequence
+{
+    NSString *result = nil;
+    *nextSegment = nil;
+    
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runCompact("
+                          "\"onEndOfMedia\", %d, %f, %f, %@, %@)",
+                          currentSegment.segmentId,
+                          playbackPosition,
+                          playbackRate,
+                          isNotPlayed ? @"true" : @"false",
+                          isEndOfSequence ? @"true" : @"false"] autorelease];
+    result = [self callJavaScriptWithString:function];
+    if (nil != result && ![result isEqualToString:@"null"])
+    {
+        *nextSegment = [self parseCompactPlaybackSegment:result];
+    }
+    
+    // Dump the playlist
+    function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequentialPlaylist.testProbe_toJSON()"] autorelease];
+    [self callJavaScriptWithString:function];
+
+    return (nil != result);    
+}
+
+//
+// get the next segment after the current playlist entry finished buffering
+//
+// Arguments:
+// [nextSegment]: the output playback segment
+// [currentSegment]: the current playback segment
+// [playbackPosition]: the current playback time in manifest time
+// [playbackRate]: the current playback rate
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getSegmentOnEndOfBuffering:(PlaybackSegment **)nextSegment withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition currentPlaybackRate:(double)playbackRate
+{
+    NSString *result = nil;
+    *nextSegment = nil;
+    
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runCompact("
+                           "\"onEndOfBuffering\", %d, %f, %f)",
+                           currentSegment.segmentId,
+                           playbackPosition,
+                           playbackRate] autorelease];
+    result = [self callJavaScriptWithString:function];    
+    if (nil != result && ![result isEqualToString:@"null"])
+    {
+        *nextSegment = [self parseCompactPlaybackSegment:result];
+    }
+
+    return (nil != result);
+}
+
+//
+// get the next segment after the current playlist entry has an error
+//
+// Arguments:
+// [nextSegment]: the output playback segment
+// [currentSegment]: the current playback segment
+// [playbackPosition]: the current playback time in manifest time
+// [playbackRate]: the current playback rate
+// [error]: the error for the playlist entry
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getSegmentOnError:(PlaybackSegment **)nextSegment withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition currentPlaybackRate:(double)playbackRate error:(NSString *)error isNotPlayed:(BOOL)isNotPlayed isEndOfSequence:(BOOL)isEndOfSequence
+{
+    NSString *result = nil;
+    *nextSegment = nil;
+    
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
+                           "\"{\\\"func\\\": \\\"onError\\\", "
+                           "\\\"params\\\": "
+                           "{ \\\"currentSegmentId\\\": %d, "
+                           "\\\"currentPlaybackPosition\\\": %f, "
+                           "\\\"currentPlaybackRate\\\": %f, "
+                           "\\\"errorDescription\\\": \\\"%@\\\", "
+                           "\\\"isNotPlayed\\\": %@, "
+                           "\\\"isEndOfSequence\\\": %@ } }\")",
+                           currentSegment.segmentId,
+                           playbackPosition,
+                           playbackRate,
+                           error,
+                           isNotPlayed ? @"true" : @"false",
+                           isEndOfSequence ? @"true" : @"false"] autorelease];
+    result = [self callJavaScriptWithString:function];
+    if (nil != result && ![result isEqualToString:@"null"])
+    {
+        *nextSegment = [self parseJSONPlaybackSegment:result];
+    }
+    
+    // Dump the playlist
+    function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequentialPlaylist.testProbe_toJSON()"] autorelease];
+    [self callJavaScriptWithString:function];
+    
+    return (nil != result);
+}
+
+//
+// look ahead at the segments which will play after the current one, without creating them or marking anything played
+//
+// Arguments:
+// [segments]: the output array of playback segments in play order, each with a segmentId of 0
+// [currentSegment]: the current playback segment
+// [playbackPosition]: the current playback time in manifest time
+// [playbackRate]: the current playback rate
+// [maxCount]: the maximum number of segments returned
+// [horizon]: only segments starting within this many seconds of rendering time are returned
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getUpcomingSegments:(NSArray **)segments withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition currentPlaybackRate:(double)playbackRate maxCount:(int32_t)maxCount horizon:(NSTimeInterval)horizon
+{
+    NSString *result = nil;
+    *segments = nil;
+    
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
+                           "\"{\\\"func\\\": \\\"getUpcomingSegments\\\", "
+                           "\\\"params\\\": "
+                           "{ \\\"currentSegmentId\\\": %d, "
+                           "\\\"currentPlaybackPosition\\\": %f, "
+                           "\\\"currentPlaybackRate\\\": %f, "
+                           "\\\"maxCount\\\": %d, "
+                           "\\\"horizon\\\": %f } }\")",
+                           currentSegment.segmentId,
+                           playbackPosition,
+                           playbackRate,
+                           maxCount,
+                           horizon] autorelease];
+    result = [self callJavaScriptWithString:function];
+    if (nil != result)
+    {
+        NSData* data = [result dataUsingEncoding:[NSString defaultCStringEncoding]];
+        NSError* error = nil;
+        NSArray *json_out = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
+        NSMutableArray *upcoming = [NSMutableArray arrayWithCapacity:[json_out count]];
+        
+        for (NSDictionary *item in json_out)
+        {
+            PlaybackSegment *segment = [self parsePlaybackSegmentDictionary:item];
+            if (nil != segment)
+            {
+                [upcoming addObject:segment];
+                [segment release];
+            }
+        }
+        *segments = upcoming;
+    }
+    
+    return (nil != *segments);
+}
+
+//
+// get how many seconds before the end of the current segment to start buffering a segment, from the measured clip startup latencies
+//
+// Arguments:
+// [leadTime]: the output lead time in seconds, to be used as the preload threshold
+// [aSegment]: the playback segment to be buffered
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getPreloadLeadTime:(NSTimeInterval *)leadTime forSegment:(PlaybackSegment *)aSegment
+{
+    NSString *result = [self callPreloadPlanner:@"getLeadTime" withSegment:aSegment];
+    if (nil != result)
+    {
+        *leadTime = [result doubleValue];
+    }
+    
+    return (nil != result);
+}
+
+//
+// notify that buffering of a playback segment started
+//
+// Arguments:
+// [aSegment]: the playback segment being buffered
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) beginPreloadOfSegment:(PlaybackSegment *)aSegment
+{
+    return (nil != [self callPreloadPlanner:@"beginLoad" withSegment:aSegment]);
+}
+
+//
+// notify that a playback segment whose buffering was started is ready to play, recording its startup latency
+//
+// Arguments:
+// [aSegment]: the playback segment ready to play
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) endPreloadOfSegment:(PlaybackSegment *)aSegment
+{
+    return (nil != [self callPreloadPlanner:@"endLoad" withSegment:aSegment]);
+}
+
+//
+// notify that buffering of a playback segment failed, so no startup latency is recorded for it
+//
+// Arguments:
+// [aSegment]: the playback segment which failed
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) cancelPreloadOfSegment:(PlaybackSegment *)aSegment
+{
+    return (nil != [self callPreloadPlanner:@"cancelLoad" withSegment:aSegment]);
+}
+
+//
+// release a playback segment which is dropped without being played to the end, such as a preloaded segment invalidated by a seek
+//
+// Arguments:
+// [aSegment]: the playback segment to release
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) releaseSegment:(PlaybackSegment *)aSegment
+{
+    // A released segment will not finish buffering
+    [self callPreloadPlanner:@"cancelLoad" withSegment:aSegment];
+    
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
+                           "\"{\\\"func\\\": \\\"releasePlaybackSegment\\\", "
+                           "\\\"params\\\": { \\\"currentSegmentId\\\": %d } }\")",
+                           aSegment.segmentId] autorelease];
+    NSString *result = [self callJavaScriptWithString:function];
+    
+    return (nil != result);
+}
+
+//
+// begin a scrub (seekbar drag), so the positions of the drag are only recorded until commitScrub seeks to the last one
+//
+// Arguments:
+// [scrubId]: the output id of the scrub
+// [currentSegment]: the current playback segment
+// [playbackPosition]: the current playback time in manifest time
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) beginScrub:(int32_t *)scrubId withCurrentSegment:(PlaybackSegment *)currentSegment manifestTime:(NSTimeInterval)playbackPosition
+{
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
+                           "\"{\\\"func\\\": \\\"beginScrub\\\", "
+                           "\\\"params\\\": "
+                           "{ \\\"currentSegmentId\\\": %d, "
+                           "\\\"currentPlaybackPosition\\\": %f } }\")",
+                           currentSegment.segmentId,
+                           playbackPosition] autorelease];
+    NSString *result = [self callJavaScriptWithString:function];
+    if (nil != result)
+    {
+        *scrubId = [result intValue];
+    }
+    
+    return (nil != result);
+}
+
+//
+// record the latest seekbar position of a scrub, without creating a playback segment
+//
+// Arguments:
+// [seekbarPosition]: the seekbar position to seek to
+// [scrubId]: the id returned by beginScrub
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) submitScrubPosition:(NSTimeInterval)seekbarPosition scrubId:(int32_t)scrubId
+{
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runCompact("
+                           "\"submitScrubPosition\", %d, %f)",
+                           scrubId,
+                           seekbarPosition] autorelease];
+    
+    return (nil != [self callJavaScriptWithString:function]);
+}
+
+//
+// end a scrub by seeking to its last recorded position
+//
+// Arguments:
+// [seekSegment]: the output playback segment, nil if no position was recorded (the current segment is then kept)
+// [crossedIds]: the output array of the ids (NSNumber) of the ad playlist entries the seek skipped over, in seek order
+// [scrubId]: the id returned by beginScrub
+// [aSegment]: the current playback segment
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) commitScrub:(PlaybackSegment **)seekSegment crossedAdEntryIds:(NSArray **)crossedIds scrubId:(int32_t)scrubId currentSegment:(PlaybackSegment *)aSegment
+{
+    NSDictionary *skippedAds = nil;
+    BOOL success = [self commitScrub:seekSegment skippedAds:&skippedAds scrubId:scrubId currentSegment:aSegment skippedAdPolicy:SkippedAdPolicy_None];
+    
+    *crossedIds = [skippedAds objectForKey:@"crossedAdEntryIds"];
+    return success;
+}
+
+//
+// end a scrub by seeking to its last recorded position, applying a policy to the ad breaks the seek skips over
+//
+// Arguments:
+// [seekSegment]: the output playback segment, nil if no position was recorded (the current segment is then kept)
+// [skippedAds]: the output dictionary of the arrays of ad entry ids (NSNumber) crossedAdEntryIds and, unless the
+//               policy is SkippedAdPolicy_None, queuedAdEntryIds, markedPlayedAdEntryIds and removedEntryIds
+// [scrubId]: the id returned by beginScrub
+// [aSegment]: the current playback segment
+// [policy]: the policy for the skipped ad breaks
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) commitScrub:(PlaybackSegment **)seekSegment skippedAds:(NSDictionary **)skippedAds scrubId:(int32_t)scrubId currentSegment:(PlaybackSegment *)aSegment skippedAdPolicy:(SkippedAdPolicy)policy
+{
+    NSString *result = nil;
+    NSString *policyName = [self skippedAdPolicyName:policy];
+    NSString *policyParam = @"";
+    *seekSegment = nil;
+    *skippedAds = nil;
+    
+    if (nil != policyName)
+    {
+        policyParam = [NSString stringWithFormat:@", \\\"eSkippedAdPolicy\\\": \\\"%@\\\"", policyName];
+    }
+    
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
+                           "\"{\\\"func\\\": \\\"commitScrub\\\", "
+                           "\\\"params\\\": "
+                           "{ \\\"scrubId\\\": %d, "
+                           "\\\"currentSegmentId\\\": %d%@ } }\")",
+                           scrubId,
+                           aSegment.segmentId,
+                           policyParam] autorelease];
+    result = [self callJavaScriptWithString:function];
+    if (nil != result)
+    {
+        [self parseSkippedAdsResult:result seekSegment:seekSegment skippedAds:skippedAds];
+    }
+    
+    return (nil != result);
+}
+
+//
+// end a scrub without seeking
+//
+// Arguments:
+// [scrubId]: the id returned by beginScrub
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) cancelScrub:(int32_t)scrubId
+{
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.sequencerPluginChain.runJSON("
+                           "\"{\\\"func\\\": \\\"cancelScrub\\\", "
+                           "\\\"params\\\": { \\\"scrubId\\\": %d } }\")",
+                           scrubId] autorelease];
+    
+    return (nil != [self callJavaScriptWithString:function]);
+}
+
+//
+// get the playback segment pool usage counters
+//
+// Arguments:
+// [statistics]: the output dictionary with liveCount, highWaterMark, capacity, createCount, releaseCount and oldestLiveAge (milliseconds)
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getSegmentPoolStatistics:(NSDictionary **)statistics
+{
+    NSString *result = nil;
+    *statistics = nil;
+    
+    NSString *function = [[[NSString alloc] initWithFormat:@"JSON.stringify(PLAYER_SEQUENCER.playbackSegmentPool.getStatistics())"] autorelease];
+    result = [self callJavaScriptWithString:function];
+    if (nil != result)
+    {
+        NSData* data = [result dataUsingEncoding:[NSString defaultCStringEncoding]];
+        NSError* error = nil;
+        *statistics = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:&error];
+    }
+    
+    return (nil != *statistics);
+}
+
+//
+// start recording every runJSON and runCompact call made to the JavaScript core, dropping any previous trace
+//
+// Arguments:
+// [capacity]: the number of most recent calls kept
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) startTraceRecordingWithCapacity:(int32_t)capacity
+{
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.traceRecorder.start(%d).toString()", capacity] autorelease];
+    NSString *result = [self callJavaScriptWithString:function];
+    
+    return (nil != result);
+}
+
+//
+// stop recording calls to the JavaScript core, keeping the trace recorded so far
+//
+// Arguments: none
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) stopTraceRecording
+{
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.traceRecorder.stop().toString()"] autorelease];
+    NSString *result = [self callJavaScriptWithString:function];
+    
+    return (nil != result);
+}
+
+//
+// get the recorded call trace, to be saved and replayed offline with TraceReplayer.js
+//
+// Arguments:
+// [trace]: the output JSON string of the trace
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getTrace:(NSString **)trace
+{
+    assert (nil != trace);
+    *trace = [self callJavaScriptWithString:@"PLAYER_SEQUENCER.traceRecorder.dump()"];
+    
+    return (nil != *trace);
+}
+
+//
+// turn the per-plugin and per-method call metrics on or off, keeping the metrics collected so far
+//
+// Arguments:
+// [enabled]: YES to collect metrics, NO to stop collecting them at no cost
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) setMetricsEnabled:(BOOL)enabled
+{
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.metrics.runJSON("
+                           "\"{\\\"func\\\": \\\"%@\\\"}\")",
+                           enabled ? @"enable" : @"disable"] autorelease];
+    NSString *result = [self callJavaScriptWithString:function];
+    
+    return (nil != result);
+}
+
+//
+// get the call counts, cumulative and maximum self times and latency histograms of the plugin methods
+// and of the scheduler and ad resolver entry points
+//
+// Arguments:
+// [metrics]: the output JSON string of the metrics
+// [reset]: YES to reset the metrics after getting them
+//
+// Returns: YES for success and NO for failure
+//
+- (BOOL) getMetrics:(NSString **)metrics reset:(BOOL)reset
+{
+    assert (nil != metrics);
+    NSString *function = [[[NSString alloc] initWithFormat:@"PLAYER_SEQUENCER.metrics.runJSON("
+                           "\"{\\\"func\\\": \\\"getMetrics\\\", "
+                           "\\\"params\\\": { \\\"reset\\\": %@ } }\")",
+                           reset ? @"true" : @"false"] autorelease];
+    *metrics = [self callJavaScriptWithString:function];
+    
+    return (nil != *metrics);
+}
+
+#pragma mark -
+#pragma mark Properties:
+
+#pragma mark -
+#pragma mark Destructor:
+
+- (void) dealloc
+{
+    NSLog(@"Sequencer dealloc called.");
+    
+    webView.delegate = nil;
+    [webView release];
+    [adResolver release];
+    [scheduler release];
+    [lastError release];
+    
+    [super dealloc];
+}
+
+@end